@@ -5,4 +5,22 @@ MxxRu::Cpp::composite_target {
 	required_prj "benches/single_handler/prj.rb"
 	required_prj "benches/single_handler_so5_timer/prj.rb"
 	required_prj "benches/single_handler_no_timer/prj.rb"
+	required_prj "benches/timer_managers/prj.rb"
+	required_prj "benches/header_serializer/prj.rb"
+	required_prj "benches/header_fields_lookup/prj.rb"
+	required_prj "benches/http_parser_backends/prj.rb"
+	required_prj "benches/express_router_dispatch/prj.rb"
+	required_prj "benches/express_route_matcher/prj.rb"
+	required_prj "benches/easy_parser_router_dispatch/prj.rb"
+	required_prj "benches/ws_masking/prj.rb"
+	required_prj "benches/utf8_validation/prj.rb"
+	required_prj "benches/ws_permessage_deflate/prj.rb"
+	required_prj "benches/ws_small_messages/prj.rb"
+	required_prj "benches/zlib_stream_pool/prj.rb"
+
+	required_prj "benches/reactor_load/prj.rb"
+
+	if 'unix' == toolset.tag( 'target_os' ) && ENV.has_key?( 'RESTINIO_ASIO_IO_URING' )
+		required_prj "benches/reactor_load_io_uring/prj.rb"
+	end
 }
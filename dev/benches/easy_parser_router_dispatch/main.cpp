@@ -0,0 +1,301 @@
+/*
+	restinio bench for dispatching of requests by easy_parser_router.
+
+	Compares the linear dispatching (every route is tried one by one,
+	as easy_parser_router_t did before v.0.6.18) with dispatching
+	by the index of leading literals for 100, 300 and 1000 registered routes.
+	For the table with 9 routes the static router (routes are known at
+	the compile time) is also measured.
+
+	Every resource has three routes:
+
+	- GET /api/v1/resN
+	- GET /api/v1/resN/<id>
+	- DELETE /api/v1/resN/<id>/items/<item>
+
+	Requests are sent to the first, the middle and the last resources
+	and to a missing one.
+*/
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <string>
+
+#include <restinio/all.hpp>
+#include <restinio/router/easy_parser_router.hpp>
+#include <restinio/router/static_easy_parser_router.hpp>
+
+namespace epr = restinio::router::easy_parser_router;
+
+//
+// fake_connection_t
+//
+
+//! Connection that is never used (required to create requests).
+struct fake_connection_t : public restinio::impl::connection_base_t
+{
+	fake_connection_t() : restinio::impl::connection_base_t{ 0 }
+	{}
+
+	void
+	check_timeout(
+		std::shared_ptr< restinio::tcp_connection_ctx_base_t > & ) override
+	{}
+
+	void
+	write_response_parts(
+		restinio::request_id_t ,
+		restinio::response_output_flags_t ,
+		restinio::write_group_t ) override
+	{}
+};
+
+restinio::request_handle_t
+make_request( restinio::http_method_id_t method, std::string target )
+{
+	restinio::no_extra_data_factory_t extra_data_factory;
+	return std::make_shared< restinio::request_t >(
+			0,
+			restinio::http_request_header_t{ method, std::move( target ) },
+			"",
+			std::make_shared< fake_connection_t >(),
+			restinio::endpoint_t{
+				restinio::asio_ns::ip::make_address_v4( "127.0.0.1" ),
+				3000 },
+			extra_data_factory );
+}
+
+//
+// linear_router_t
+//
+
+//! Router that tries every route one by one.
+class linear_router_t
+{
+public:
+	restinio::request_handling_status_t
+	operator()( restinio::request_handle_t req ) const
+	{
+		restinio::string_view_t path_to_inspect{ req->header().path() };
+		if( path_to_inspect.size() > 1u && '/' == path_to_inspect.back() )
+			path_to_inspect.remove_suffix( 1u );
+
+		epr::impl::target_path_holder_t target_path{ path_to_inspect };
+		for( const auto & entry : m_entries )
+		{
+			const auto r = entry->try_handle( req, target_path );
+			if( r )
+				return *r;
+		}
+
+		return restinio::request_not_handled();
+	}
+
+	template< typename Method_Matcher, typename Route_Producer, typename Handler >
+	void
+	add_handler(
+		Method_Matcher && method_matcher,
+		Route_Producer && route,
+		Handler && handler )
+	{
+		using actual_entry_type = epr::impl::actual_router_entry_t<
+				restinio::no_extra_data_factory_t::data_t,
+				std::decay_t< Route_Producer >,
+				std::decay_t< Handler > >;
+
+		m_entries.push_back( std::make_unique< actual_entry_type >(
+				std::forward<Method_Matcher>(method_matcher),
+				std::forward<Route_Producer>(route),
+				std::forward<Handler>(handler) ) );
+	}
+
+private:
+	std::vector< epr::impl::router_entry_unique_ptr_t<
+			restinio::no_extra_data_factory_t::data_t > > m_entries;
+};
+
+template< typename Router >
+void
+fill_router( Router & router, std::size_t routes, std::size_t & handled )
+{
+	const auto id_p = epr::non_negative_decimal_number_p< std::uint32_t >();
+
+	for( std::size_t i = 0u; i < routes / 3u; ++i )
+	{
+		const auto resource = "/api/v1/res" + std::to_string( i );
+		router.add_handler( restinio::http_method_get(),
+				epr::path_to_params( resource ),
+				[&handled]( const auto & ) {
+					++handled;
+					return restinio::request_accepted();
+				} );
+		router.add_handler( restinio::http_method_get(),
+				epr::path_to_params( resource + "/", id_p ),
+				[&handled]( const auto &, std::uint32_t id ) {
+					handled += id;
+					return restinio::request_accepted();
+				} );
+		router.add_handler( restinio::http_method_delete(),
+				epr::path_to_params(
+					resource + "/", id_p, "/items/", epr::path_fragment_p() ),
+				[&handled]( const auto &, std::uint32_t id, const std::string & item ) {
+					handled += id + item.size();
+					return restinio::request_accepted();
+				} );
+	}
+
+	// The rest of routes.
+	for( std::size_t i = 0u; i < routes % 3u; ++i )
+		router.add_handler( restinio::http_method_post(),
+				epr::path_to_params( "/api/v1/extra" + std::to_string( i ) ),
+				[]( const auto & ) { return restinio::request_accepted(); } );
+}
+
+//! Routes of one resource for the static router.
+template< std::size_t Resource_Size, std::size_t Prefix_Size >
+auto
+make_resource_routes(
+	const char (&resource)[Resource_Size],
+	const char (&prefix)[Prefix_Size],
+	std::size_t & handled )
+{
+	const auto id_p = epr::non_negative_decimal_number_p< std::uint32_t >();
+
+	return std::make_tuple(
+		epr::route( restinio::http_method_get(),
+			epr::path_to_params( resource ),
+			[&handled]( const auto & ) {
+				++handled;
+				return restinio::request_accepted();
+			} ),
+		epr::route( restinio::http_method_get(),
+			epr::path_to_params( prefix, id_p ),
+			[&handled]( const auto &, std::uint32_t id ) {
+				handled += id;
+				return restinio::request_accepted();
+			} ),
+		epr::route( restinio::http_method_delete(),
+			epr::path_to_params(
+				prefix, id_p, "/items/", epr::path_fragment_p() ),
+			[&handled]( const auto &, std::uint32_t id, const std::string & item ) {
+				handled += id + item.size();
+				return restinio::request_accepted();
+			} ) );
+}
+
+template< typename Routes, std::size_t... I >
+auto
+make_static_router_from_tuple( Routes && routes, std::index_sequence< I... > )
+{
+	auto router = restinio::router::make_static_easy_parser_router(
+			std::get< I >( std::move(routes) )... );
+
+	return std::make_unique< decltype(router) >( std::move(router) );
+}
+
+//! The same routes as fill_router() makes for 9 routes.
+auto
+make_static_router( std::size_t & handled )
+{
+	auto routes = std::tuple_cat(
+			make_resource_routes( "/api/v1/res0", "/api/v1/res0/", handled ),
+			make_resource_routes( "/api/v1/res1", "/api/v1/res1/", handled ),
+			make_resource_routes( "/api/v1/res2", "/api/v1/res2/", handled ) );
+
+	return make_static_router_from_tuple( std::move(routes),
+			std::make_index_sequence< std::tuple_size< decltype(routes) >::value >{} );
+}
+
+template< typename Router >
+auto
+make_dynamic_router( std::size_t routes, std::size_t & handled )
+{
+	auto router = std::make_unique< Router >();
+	fill_router( *router, routes, handled );
+
+	return router;
+}
+
+template< typename Router_Factory >
+void
+run_bench(
+	const char * tag,
+	std::size_t routes,
+	std::size_t iterations,
+	Router_Factory && make_router )
+{
+	std::size_t handled{ 0u };
+	const auto router = make_router( handled );
+
+	const auto first = std::string{ "/api/v1/res0" };
+	const auto middle = "/api/v1/res" + std::to_string( routes / 6u );
+	const auto last = "/api/v1/res" + std::to_string( routes / 3u - 1u );
+
+	const std::vector< restinio::request_handle_t > requests{
+		make_request( restinio::http_method_get(), first + "/42" ),
+		make_request( restinio::http_method_delete(), middle + "/42/items/abc" ),
+		make_request( restinio::http_method_get(), last ),
+		make_request( restinio::http_method_get(), last + "/42" ),
+		make_request( restinio::http_method_delete(), last + "/42/items/abc" ),
+		make_request( restinio::http_method_get(), "/api/v1/missing/42" ),
+	};
+
+	const auto started_at = std::chrono::steady_clock::now();
+	for( std::size_t i = 0u; i != iterations; ++i )
+		for( const auto & req : requests )
+			(void)(*router)( req );
+	const auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+			std::chrono::steady_clock::now() - started_at ).count();
+
+	std::cout << tag << " (" << routes << " routes): "
+		<< ( static_cast< double >( ns ) /
+				static_cast< double >( iterations * requests.size() ) )
+		<< " ns/request (" << handled / iterations << ")" << std::endl;
+}
+
+int
+main( int argc, const char * argv[] )
+{
+	try
+	{
+		std::size_t iterations = 10000u;
+		if( 1 < argc )
+			iterations = std::stoul( argv[ 1 ] );
+
+		const auto linear = []( std::size_t routes ) {
+			return [routes]( std::size_t & handled ) {
+				return make_dynamic_router< linear_router_t >( routes, handled );
+			};
+		};
+		const auto indexed = []( std::size_t routes ) {
+			return [routes]( std::size_t & handled ) {
+				return make_dynamic_router<
+						restinio::router::easy_parser_router_t >( routes, handled );
+			};
+		};
+
+		run_bench( "linear", 9u, iterations, linear( 9u ) );
+		run_bench( "easy_parser_router_t", 9u, iterations, indexed( 9u ) );
+		run_bench( "static_easy_parser_router_t", 9u, iterations,
+				[]( std::size_t & handled ) {
+					return make_static_router( handled );
+				} );
+
+		for( const std::size_t routes : { 100u, 300u, 1000u } )
+		{
+			// Linear router is too slow for many routes.
+			const auto linear_iterations = iterations * 10u / routes;
+
+			run_bench( "linear", routes, linear_iterations, linear( routes ) );
+			run_bench( "easy_parser_router_t", routes, iterations,
+					indexed( routes ) );
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,95 @@
+/*
+	restinio bench for matching of a single express route.
+
+	Compares matching by regex with matching by
+	path2regex::impl::simple_route_matcher_t that is used for
+	routes without custom patterns since v.0.6.18.
+*/
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <string>
+
+#include <restinio/router/express.hpp>
+
+using route_matcher_t =
+		restinio::router::impl::route_matcher_t< restinio::router::std_regex_engine_t >;
+
+route_matcher_t
+make_matcher( const char * route, bool use_simple_matcher )
+{
+	auto matcher_data = restinio::path2regex::path2regex<
+			restinio::router::impl::route_params_appender_t,
+			restinio::router::std_regex_engine_t >(
+				route,
+				restinio::path2regex::options_t{} );
+
+	return route_matcher_t{
+			restinio::http_method_get(),
+			std::move( matcher_data.m_regex ),
+			std::move( matcher_data.m_named_params_buffer ),
+			std::move( matcher_data.m_param_appender_sequence ),
+			use_simple_matcher ?
+				std::move( matcher_data.m_simple_matcher ) :
+				restinio::nullopt };
+}
+
+void
+run_bench(
+	const char * tag,
+	const char * route,
+	const std::vector< std::string > & targets,
+	std::size_t iterations )
+{
+	for( const bool use_simple_matcher : { false, true } )
+	{
+		const auto matcher = make_matcher( route, use_simple_matcher );
+
+		std::size_t matched{ 0u };
+		const auto started_at = std::chrono::steady_clock::now();
+		for( std::size_t i = 0u; i != iterations; ++i )
+			for( const auto & target : targets )
+			{
+				restinio::router::impl::target_path_holder_t target_path{ target };
+				restinio::router::route_params_t params;
+				if( matcher.match_route( target_path, params ) )
+					matched += params.named_parameters_size();
+			}
+		const auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+				std::chrono::steady_clock::now() - started_at ).count();
+
+		std::cout << tag << " (" << ( use_simple_matcher ? "simple" : "regex" )
+			<< "): "
+			<< ( static_cast< double >( ns ) /
+					static_cast< double >( iterations * targets.size() ) )
+			<< " ns/match (" << matched / iterations << ")" << std::endl;
+	}
+}
+
+int
+main( int argc, const char * argv[] )
+{
+	try
+	{
+		std::size_t iterations = 100000u;
+		if( 1 < argc )
+			iterations = std::stoul( argv[ 1 ] );
+
+		run_bench( "hit",
+				"/api/v1/users/:id/orders/:order",
+				{ "/api/v1/users/42/orders/7", "/api/v1/users/john/orders/abc/" },
+				iterations );
+
+		run_bench( "miss",
+				"/api/v1/users/:id/orders/:order",
+				{ "/api/v1/items/42", "/api/v1/users/42/invoices/7", "/" },
+				iterations );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,150 @@
+/*
+	restinio bench for dispatching of requests by express routers.
+
+	Compares express_router_t (routes are checked one by one by regexes)
+	with radix_express_router_t (routes are placed into a radix tree)
+	for 10, 100 and 1000 registered routes.
+
+	Every resource has three routes:
+
+	- /api/v1/resN
+	- /api/v1/resN/:id(\d+)
+	- /api/v1/resN/:id/items/:item
+
+	Requests are sent to the first, the middle and the last resources
+	and to a missing one.
+*/
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <string>
+
+#include <restinio/all.hpp>
+#include <restinio/router/radix_express.hpp>
+
+//
+// fake_connection_t
+//
+
+//! Connection that is never used (required to create requests).
+struct fake_connection_t : public restinio::impl::connection_base_t
+{
+	fake_connection_t() : restinio::impl::connection_base_t{ 0 }
+	{}
+
+	void
+	check_timeout(
+		std::shared_ptr< restinio::tcp_connection_ctx_base_t > & ) override
+	{}
+
+	void
+	write_response_parts(
+		restinio::request_id_t ,
+		restinio::response_output_flags_t ,
+		restinio::write_group_t ) override
+	{}
+};
+
+restinio::request_handle_t
+make_request( std::string target )
+{
+	restinio::no_extra_data_factory_t extra_data_factory;
+	return std::make_shared< restinio::request_t >(
+			0,
+			restinio::http_request_header_t{
+				restinio::http_method_get(), std::move( target ) },
+			"",
+			std::make_shared< fake_connection_t >(),
+			restinio::endpoint_t{
+				restinio::asio_ns::ip::make_address_v4( "127.0.0.1" ),
+				3000 },
+			extra_data_factory );
+}
+
+template< typename Router >
+void
+fill_router( Router & router, std::size_t routes, std::size_t & handled )
+{
+	const auto handler = [&handled]( auto, restinio::router::route_params_t p ) {
+		handled += p.match().size();
+		return restinio::request_accepted();
+	};
+
+	for( std::size_t i = 0u; i < routes / 3u; ++i )
+	{
+		const auto resource = "/api/v1/res" + std::to_string( i );
+		router.http_get( resource, handler );
+		router.http_get( resource + "/:id(\\d+)", handler );
+		router.http_get( resource + "/:id/items/:item", handler );
+	}
+
+	// The rest of routes.
+	for( std::size_t i = 0u; i < routes % 3u; ++i )
+		router.http_post( "/api/v1/extra" + std::to_string( i ), handler );
+}
+
+template< typename Router >
+void
+run_bench(
+	const char * tag,
+	std::size_t routes,
+	std::size_t iterations )
+{
+	std::size_t handled{ 0u };
+	Router router;
+	fill_router( router, routes, handled );
+
+	const auto first = std::string{ "/api/v1/res0" };
+	const auto middle = "/api/v1/res" + std::to_string( routes / 6u );
+	const auto last = "/api/v1/res" + std::to_string( routes / 3u - 1u );
+
+	const std::vector< restinio::request_handle_t > requests{
+		make_request( first + "/42" ),
+		make_request( middle + "/42/items/abc" ),
+		make_request( last ),
+		make_request( last + "/42" ),
+		make_request( last + "/42/items/abc" ),
+		make_request( "/api/v1/missing/42" ),
+	};
+
+	const auto started_at = std::chrono::steady_clock::now();
+	for( std::size_t i = 0u; i != iterations; ++i )
+		for( const auto & req : requests )
+			(void)router( req );
+	const auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+			std::chrono::steady_clock::now() - started_at ).count();
+
+	std::cout << tag << " (" << routes << " routes): "
+		<< ( static_cast< double >( ns ) /
+				static_cast< double >( iterations * requests.size() ) )
+		<< " ns/request (" << handled / iterations << ")" << std::endl;
+}
+
+int
+main( int argc, const char * argv[] )
+{
+	try
+	{
+		std::size_t iterations = 10000u;
+		if( 1 < argc )
+			iterations = std::stoul( argv[ 1 ] );
+
+		for( const std::size_t routes : { 10u, 100u, 1000u } )
+		{
+			// Linear router is too slow for many routes.
+			const auto linear_iterations = iterations * 10u / routes;
+
+			run_bench< restinio::router::express_router_t<> >(
+					"express_router_t", routes, linear_iterations );
+			run_bench< restinio::router::radix_express_router_t<> >(
+					"radix_express_router_t", routes, iterations );
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,192 @@
+/*
+	restinio bench for lookups of header fields.
+
+	Compares lookups by linear scan of a vector of fields (the way it was
+	done before v.0.6.18) with lookups in http_header_fields_t that uses
+	an index for known fields and a hash table for names of fields.
+
+	Every iteration performs lookups that are typical for handling of
+	a request: several known fields by ID and several fields by name
+	(some of them are absent).
+*/
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <string>
+
+#include <restinio/http_headers.hpp>
+
+//
+// legacy_fields_t
+//
+
+//! Fields container that is searched by linear scan.
+class legacy_fields_t
+{
+	public:
+		void
+		add_field( restinio::http_header_field_t f )
+		{
+			m_fields.push_back( std::move( f ) );
+		}
+
+		const std::string *
+		try_get_field( restinio::http_field_t field_id ) const noexcept
+		{
+			const auto it = std::find_if(
+					m_fields.begin(), m_fields.end(),
+					[&]( const auto & f ) { return f.field_id() == field_id; } );
+			return m_fields.end() == it ? nullptr : &it->value();
+		}
+
+		const std::string *
+		try_get_field( restinio::string_view_t name ) const noexcept
+		{
+			const auto it = std::find_if(
+					m_fields.begin(), m_fields.end(),
+					[&]( const auto & f ) {
+						return restinio::impl::is_equal_caseless( f.name(), name );
+					} );
+			return m_fields.end() == it ? nullptr : &it->value();
+		}
+
+	private:
+		std::vector< restinio::http_header_field_t > m_fields;
+};
+
+//
+// make_fields
+//
+
+//! Make a list of fields of a typical request from a browser.
+std::vector< std::pair< std::string, std::string > >
+make_fields()
+{
+	return {
+		{ "Host", "localhost:8080" },
+		{ "User-Agent", "Mozilla/5.0 (X11; Linux x86_64; rv:109.0) Gecko/20100101" },
+		{ "Accept", "text/html,application/xhtml+xml,application/xml;q=0.9" },
+		{ "Accept-Language", "en-US,en;q=0.5" },
+		{ "Accept-Encoding", "gzip, deflate, br" },
+		{ "Referer", "http://localhost:8080/index.html" },
+		{ "Connection", "keep-alive" },
+		{ "Cookie", "session=0123456789abcdef" },
+		{ "Upgrade-Insecure-Requests", "1" },
+		{ "Sec-Fetch-Dest", "document" },
+		{ "Sec-Fetch-Mode", "navigate" },
+		{ "Sec-Fetch-Site", "same-origin" },
+		{ "X-Request-Id", "f81d4fae-7dec-11d0-a765-00a0c91e6bf6" },
+		{ "X-Forwarded-For", "192.168.0.1" },
+		{ "Cache-Control", "max-age=0" },
+	};
+}
+
+//! Lookups of known fields by ID (some of them are absent).
+struct lookups_by_id_t
+{
+	static constexpr const char * name = "by id";
+
+	template< typename Fields >
+	static std::size_t
+	run( const Fields & fields )
+	{
+		using restinio::http_field_t;
+
+		std::size_t found = 0u;
+		const auto check = [&found]( const std::string * v ) {
+			if( v ) found += v->size();
+		};
+
+		check( fields.try_get_field( http_field_t::host ) );
+		check( fields.try_get_field( http_field_t::if_modified_since ) );
+		check( fields.try_get_field( http_field_t::transfer_encoding ) );
+		check( fields.try_get_field( http_field_t::authorization ) );
+		check( fields.try_get_field( http_field_t::accept_encoding ) );
+		check( fields.try_get_field( http_field_t::cache_control ) );
+		check( fields.try_get_field( http_field_t::if_none_match ) );
+		check( fields.try_get_field( http_field_t::content_type ) );
+
+		return found;
+	}
+};
+
+//! Lookups of fields by name (some of them are absent).
+struct lookups_by_name_t
+{
+	static constexpr const char * name = "by name";
+
+	template< typename Fields >
+	static std::size_t
+	run( const Fields & fields )
+	{
+		using restinio::string_view_t;
+
+		std::size_t found = 0u;
+		const auto check = [&found]( const std::string * v ) {
+			if( v ) found += v->size();
+		};
+
+		check( fields.try_get_field( string_view_t{ "X-Request-Id" } ) );
+		check( fields.try_get_field( string_view_t{ "x-forwarded-for" } ) );
+		check( fields.try_get_field( string_view_t{ "Cookie" } ) );
+		check( fields.try_get_field( string_view_t{ "Origin" } ) );
+		check( fields.try_get_field( string_view_t{ "X-Real-IP" } ) );
+		check( fields.try_get_field( string_view_t{ "Sec-Fetch-Site" } ) );
+
+		return found;
+	}
+};
+
+template< typename Lookups, typename Fields >
+void
+run_bench(
+	const char * tag,
+	const Fields & fields,
+	std::size_t iterations )
+{
+	std::size_t total{ 0u };
+
+	// Prevents hoisting of lookups out of the loop.
+	const Fields * volatile fields_ptr = &fields;
+
+	const auto started_at = std::chrono::steady_clock::now();
+	for( std::size_t i = 0u; i != iterations; ++i )
+		total += Lookups::run( *fields_ptr );
+	const auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+			std::chrono::steady_clock::now() - started_at ).count();
+
+	std::cout << tag << " (" << Lookups::name << "): "
+		<< ( static_cast< double >( ns ) / static_cast< double >( iterations ) )
+		<< " ns/request (" << total / iterations << ")" << std::endl;
+}
+
+int
+main( int argc, const char * argv[] )
+{
+	try
+	{
+		std::size_t iterations = 1000000u;
+		if( 1 < argc )
+			iterations = std::stoul( argv[ 1 ] );
+
+		legacy_fields_t legacy;
+		restinio::http_header_fields_t indexed;
+		for( const auto & f : make_fields() )
+		{
+			legacy.add_field( restinio::http_header_field_t{ f.first, f.second } );
+			indexed.add_field( f.first, f.second );
+		}
+
+		run_bench< lookups_by_id_t >( "linear scan", legacy, iterations );
+		run_bench< lookups_by_id_t >( "http_header_fields_t", indexed, iterations );
+		run_bench< lookups_by_name_t >( "linear scan", legacy, iterations );
+		run_bench< lookups_by_name_t >( "http_header_fields_t", indexed, iterations );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,16 @@
+require 'mxx_ru/cpp'
+require 'restinio/asio_helper.rb'
+
+MxxRu::Cpp::exe_target {
+
+	RestinioAsioHelper.attach_propper_asio( self )
+
+	required_prj 'nodejs/http_parser_mxxru/prj.rb'
+	required_prj 'fmt_mxxru/prj.rb'
+	required_prj 'restinio/platform_specific_libs.rb'
+
+	target( "_bench.restinio.header_fields_lookup" )
+
+	cpp_source( "main.cpp" )
+}
+
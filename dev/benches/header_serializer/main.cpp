@@ -0,0 +1,185 @@
+/*
+	restinio bench for serialization of response headers.
+
+	Compares the serialization that appends every part of a header
+	to std::string (the way it was done before v.0.6.18) with
+	response_header_serializer_t. Headers with 5, 10 and 15 fields
+	are used.
+*/
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include <restinio/impl/header_helpers.hpp>
+
+//
+// legacy_create_header_string
+//
+
+//! Serialization of a header as it was done before v.0.6.18.
+std::string
+legacy_create_header_string( const restinio::http_response_header_t & h )
+{
+	std::string result;
+	result.reserve( restinio::impl::calculate_approx_buffer_size_for_header( h ) );
+
+	result.append( "HTTP/" );
+	result += static_cast<char>( '0' + h.http_major() );
+	result += '.';
+	result += static_cast<char>( '0' + h.http_minor() );
+	result += ' ';
+
+	const auto sc = h.status_code().raw_code();
+	result += static_cast<char>( '0' + ( sc / 100 ) % 10 );
+	result += static_cast<char>( '0' + ( sc / 10 ) % 10 );
+	result += static_cast<char>( '0' + ( sc ) % 10 );
+
+	result += ' ';
+	result += h.reason_phrase();
+	result.append( "\r\n" );
+
+	switch( h.connection() )
+	{
+		case restinio::http_connection_header_t::keep_alive:
+			result.append( "Connection: keep-alive\r\n" ); break;
+
+		case restinio::http_connection_header_t::close:
+			result.append( "Connection: close\r\n" ); break;
+
+		case restinio::http_connection_header_t::upgrade:
+			result.append( "Connection: Upgrade\r\n" ); break;
+	}
+
+	char buf[ 64 ];
+	const auto n = std::snprintf(
+			buf, sizeof(buf),
+			"Content-Length: %llu\r\n",
+			static_cast< unsigned long long >( h.content_length() ) );
+	result.append( buf, static_cast< std::size_t >( n ) );
+
+	h.for_each_field( [&result]( const auto & f ) {
+			result += f.name();
+			result.append( ": " );
+			result += f.value();
+			result.append( "\r\n" );
+		} );
+
+	result.append( "\r\n" );
+
+	return result;
+}
+
+//
+// make_header
+//
+
+//! Make a header with typical fields.
+restinio::http_response_header_t
+make_header( std::size_t fields_count )
+{
+	using restinio::http_field_t;
+
+	static const std::pair< http_field_t, const char * > typical_fields[] = {
+		{ http_field_t::server, "RESTinio" },
+		{ http_field_t::content_type, "application/json; charset=utf-8" },
+		{ http_field_t::cache_control, "no-cache, no-store, must-revalidate" },
+		{ http_field_t::date, "Sun, 06 Nov 1994 08:49:37 GMT" },
+		{ http_field_t::etag, "\"33a64df551425fcc55e4d42a148795d9f25f89d4\"" },
+		{ http_field_t::last_modified, "Wed, 21 Oct 2015 07:28:00 GMT" },
+		{ http_field_t::vary, "Accept-Encoding" },
+		{ http_field_t::access_control_allow_origin, "*" },
+		{ http_field_t::x_frame_options, "DENY" },
+		{ http_field_t::strict_transport_security, "max-age=31536000" },
+		{ http_field_t::expires, "Thu, 01 Dec 1994 16:00:00 GMT" },
+		{ http_field_t::pragma, "no-cache" },
+		{ http_field_t::content_language, "en-US" },
+		{ http_field_t::accept_ranges, "bytes" },
+		{ http_field_t::content_encoding, "gzip" },
+	};
+	const std::size_t fields_total =
+			sizeof(typical_fields) / sizeof(typical_fields[ 0 ]);
+
+	restinio::http_response_header_t h{ restinio::status_ok() };
+	h.should_keep_alive( true );
+	h.content_length( 4096 );
+
+	for( std::size_t i = 0u; i != fields_count; ++i )
+	{
+		const auto & f = typical_fields[ i % fields_total ];
+		h.set_field( f.first, f.second );
+	}
+
+	return h;
+}
+
+template< typename Serializer >
+void
+run_bench(
+	const char * tag,
+	const restinio::http_response_header_t & h,
+	std::size_t iterations,
+	Serializer && serializer )
+{
+	std::size_t total_bytes{ 0u };
+
+	const auto started_at = std::chrono::steady_clock::now();
+	for( std::size_t i = 0u; i != iterations; ++i )
+		total_bytes += serializer( h );
+	const auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+			std::chrono::steady_clock::now() - started_at ).count();
+
+	std::cout << tag << ", " << h.fields_count() << " fields: "
+		<< ( static_cast< double >( ns ) / static_cast< double >( iterations ) )
+		<< " ns/header (" << total_bytes / iterations << " bytes)" << std::endl;
+}
+
+int
+main( int argc, const char * argv[] )
+{
+	try
+	{
+		std::size_t iterations = 1000000u;
+		if( 1 < argc )
+			iterations = std::stoul( argv[ 1 ] );
+
+		std::vector< char > buffer;
+
+		for( const std::size_t fields_count : { 5u, 10u, 15u } )
+		{
+			const auto h = make_header( fields_count );
+
+			run_bench( "legacy std::string appends", h, iterations,
+				[]( const auto & header ) {
+					return legacy_create_header_string( header ).size();
+				} );
+
+			run_bench( "create_header_string", h, iterations,
+				[]( const auto & header ) {
+					return restinio::impl::create_header_string( header ).size();
+				} );
+
+			// Writing into a buffer that is reused between responses.
+			run_bench( "response_header_serializer_t (reused buffer)",
+				h, iterations,
+				[&buffer]( const auto & header ) {
+					const restinio::impl::response_header_serializer_t serializer{
+							header,
+							restinio::impl::content_length_field_presence_t::
+									add_content_length };
+					if( buffer.size() < serializer.size() )
+						buffer.resize( serializer.size() );
+					return static_cast< std::size_t >(
+							serializer.write( buffer.data() ) - buffer.data() );
+				} );
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
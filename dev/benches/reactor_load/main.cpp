@@ -0,0 +1,211 @@
+/*
+	restinio bench for comparison of asio reactors.
+
+	Starts the same server as in single_handler bench and loads it from
+	the same process: every client thread has its own keep-alive
+	connection and sends a new request only after receiving the
+	response to the previous one. Shows the count of requests per second
+	and percentiles of response latency.
+
+	The client uses synchronous operations only, so it doesn't depend on
+	the reactor of asio. It allows to compare the reactors under the same
+	load: this bench uses the default reactor (epoll on Linux) and
+	reactor_load_io_uring is the same bench built with
+	RESTINIO_ASIO_USE_IO_URING. Both should be run with the same
+	arguments.
+
+	Usage:
+		_bench.restinio.reactor_load [CONNECTIONS [SECONDS [THREADS [PORT]]]]
+*/
+#include <algorithm>
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <restinio/all.hpp>
+
+const std::string resp_body{ "Hello world!" };
+
+struct req_handler_t
+{
+	auto operator () ( restinio::request_handle_t req ) const
+	{
+		if( restinio::http_method_get() == req->header().method() &&
+			req->header().request_target() == "/" )
+		{
+			return
+				req->create_response()
+					.append_header( "Server", "RESTinio Benchmark" )
+					.append_header( "Content-Type", "text/plain; charset=utf-8" )
+					.set_body( resp_body )
+					.done();
+		}
+
+		return restinio::request_rejected();
+	}
+};
+
+struct traits_t : public restinio::traits_t<
+		restinio::asio_timer_manager_t,
+		restinio::null_logger_t,
+		req_handler_t >
+{};
+
+using clock_type_t = std::chrono::steady_clock;
+
+//! Latencies of responses in nanoseconds.
+using latencies_t = std::vector< std::int64_t >;
+
+latencies_t
+run_client(
+	std::uint16_t port,
+	clock_type_t::time_point finish_at )
+{
+	restinio::asio_ns::io_context io_context;
+	restinio::asio_ns::ip::tcp::socket socket{ io_context };
+	socket.connect( restinio::asio_ns::ip::tcp::endpoint{
+			restinio::asio_ns::ip::make_address_v4( "127.0.0.1" ), port } );
+	socket.set_option( restinio::asio_ns::ip::tcp::no_delay{ true } );
+
+	const std::string request{
+		"GET / HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"\r\n" };
+
+	const restinio::string_view_t content_length{ "Content-Length: " };
+
+	latencies_t latencies;
+	latencies.reserve( 64u * 1024u );
+
+	restinio::asio_ns::streambuf response;
+	for( auto started_at = clock_type_t::now(); started_at < finish_at; )
+	{
+		restinio::asio_ns::write( socket, restinio::asio_ns::buffer( request ) );
+
+		const auto header_size = restinio::asio_ns::read_until(
+				socket, response, "\r\n\r\n" );
+
+		const restinio::string_view_t header{
+				static_cast< const char * >( response.data().data() ),
+				header_size };
+		const auto pos = header.find( content_length );
+		if( restinio::string_view_t::npos == pos )
+			throw std::runtime_error{ "no Content-Length in response" };
+
+		const auto body_size = static_cast< std::size_t >( std::stoul(
+				std::string{ header.substr( pos + content_length.size(), 16u ) } ) );
+
+		if( response.size() < header_size + body_size )
+			restinio::asio_ns::read( socket, response,
+					restinio::asio_ns::transfer_exactly(
+							header_size + body_size - response.size() ) );
+		response.consume( header_size + body_size );
+
+		const auto finished_at = clock_type_t::now();
+		latencies.push_back(
+				std::chrono::duration_cast< std::chrono::nanoseconds >(
+						finished_at - started_at ).count() );
+		started_at = finished_at;
+	}
+
+	return latencies;
+}
+
+std::int64_t
+percentile( const latencies_t & sorted, double p )
+{
+	const auto index = static_cast< std::size_t >(
+			p / 100.0 * static_cast< double >( sorted.size() - 1u ) );
+	return sorted[ index ];
+}
+
+int
+main( int argc, const char * argv[] )
+{
+	try
+	{
+		std::size_t connections = 64u;
+		if( 1 < argc )
+			connections = std::stoul( argv[ 1 ] );
+
+		std::size_t seconds = 10u;
+		if( 2 < argc )
+			seconds = std::stoul( argv[ 2 ] );
+
+		std::size_t threads = 1u;
+		if( 3 < argc )
+			threads = std::stoul( argv[ 3 ] );
+
+		std::uint16_t port = 8080u;
+		if( 4 < argc )
+			port = static_cast< std::uint16_t >( std::stoul( argv[ 4 ] ) );
+
+#if defined(RESTINIO_ASIO_HAS_IO_URING)
+		std::cout << "reactor: io_uring" << std::endl;
+#else
+		std::cout << "reactor: default" << std::endl;
+#endif
+		std::cout << "connections: " << connections
+			<< ", seconds: " << seconds
+			<< ", server threads: " << threads << std::endl;
+
+		auto server = restinio::run_async< traits_t >(
+			restinio::own_io_context(),
+			restinio::server_settings_t< traits_t >{}
+				.address( "127.0.0.1" )
+				.port( port )
+				.buffer_size( 1024u )
+				.max_pipelined_requests( 4u ),
+			threads );
+
+		const auto started_at = clock_type_t::now();
+		const auto finish_at = started_at + std::chrono::seconds{ seconds };
+
+		std::vector< latencies_t > results( connections );
+		std::vector< std::thread > clients;
+		clients.reserve( connections );
+		for( std::size_t i = 0u; i != connections; ++i )
+			clients.emplace_back( [&results, i, port, finish_at] {
+				try
+				{
+					results[ i ] = run_client( port, finish_at );
+				}
+				catch( const std::exception & ex )
+				{
+					std::cerr << "Client error: " << ex.what() << std::endl;
+				}
+			} );
+
+		for( auto & t : clients )
+			t.join();
+
+		const auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+				clock_type_t::now() - started_at ).count();
+
+		latencies_t all;
+		for( const auto & r : results )
+			all.insert( all.end(), r.begin(), r.end() );
+		if( all.empty() )
+			throw std::runtime_error{ "no responses received" };
+
+		std::sort( all.begin(), all.end() );
+
+		std::cout << "requests: " << all.size() << ", "
+			<< ( static_cast< double >( all.size() ) /
+					static_cast< double >( ns ) * 1e9 )
+			<< " req/s" << std::endl;
+		std::cout << "latency (us): p50=" << percentile( all, 50.0 ) / 1000.0
+			<< ", p99=" << percentile( all, 99.0 ) / 1000.0
+			<< ", p99.9=" << percentile( all, 99.9 ) / 1000.0
+			<< ", max=" << all.back() / 1000.0 << std::endl;
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
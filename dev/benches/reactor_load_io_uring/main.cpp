@@ -0,0 +1,10 @@
+/*
+	restinio bench for comparison of asio reactors.
+
+	The same bench as reactor_load but with io_uring backend of asio.
+*/
+
+// RESTINIO_ASIO_USE_IO_URING is defined for the whole target
+// by the build files.
+
+#include "../reactor_load/main.cpp"
@@ -0,0 +1,18 @@
+require 'mxx_ru/cpp'
+require 'restinio/asio_helper.rb'
+
+MxxRu::Cpp::exe_target {
+
+	RestinioAsioHelper.attach_propper_asio( self )
+
+	required_prj 'nodejs/http_parser_mxxru/prj.rb'
+	required_prj 'fmt_mxxru/prj.rb'
+	required_prj 'restinio/platform_specific_libs.rb'
+
+	define 'RESTINIO_ASIO_USE_IO_URING'
+	lib 'uring'
+
+	target( "_bench.restinio.reactor_load_io_uring" )
+
+	cpp_source( "main.cpp" )
+}
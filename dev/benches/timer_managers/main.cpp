@@ -0,0 +1,164 @@
+/*
+	restinio bench for timer managers.
+
+	Simulates a lot of idle keep-alive connections. Every connection
+	holds a timer guard and reschedules it on every timeout check
+	(just like connection_t does while waiting for a next request).
+*/
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <ctime>
+#include <cstdlib>
+#include <string>
+
+#include <restinio/asio_timer_manager.hpp>
+#include <restinio/wheel_timer_manager.hpp>
+
+//
+// idle_connection_t
+//
+
+template< typename Timer_Manager >
+class idle_connection_t final
+	:	public restinio::tcp_connection_ctx_base_t
+{
+	public:
+		idle_connection_t(
+			restinio::connection_id_t id,
+			Timer_Manager & timer_manager,
+			std::size_t & checks_counter )
+			:	restinio::tcp_connection_ctx_base_t{ id }
+			,	m_timer_guard{ timer_manager.create_timer_guard() }
+			,	m_checks_counter{ checks_counter }
+		{}
+
+		void
+		start()
+		{
+			m_weak_self = shared_from_this();
+			m_timer_guard.schedule( m_weak_self );
+		}
+
+		void
+		stop()
+		{
+			m_stopped = true;
+			m_timer_guard.cancel();
+		}
+
+		void
+		check_timeout( restinio::tcp_connection_ctx_handle_t & ) override
+		{
+			// A check can be already queued when the guard is cancelled.
+			if( !m_stopped )
+			{
+				++m_checks_counter;
+				m_timer_guard.schedule( m_weak_self );
+			}
+		}
+
+	private:
+		typename Timer_Manager::timer_guard_t m_timer_guard;
+		restinio::tcp_connection_ctx_weak_handle_t m_weak_self;
+		std::size_t & m_checks_counter;
+		bool m_stopped{ false };
+};
+
+double
+ms_since( std::chrono::steady_clock::time_point started_at )
+{
+	return std::chrono::duration_cast< std::chrono::microseconds >(
+			std::chrono::steady_clock::now() - started_at ).count() / 1000.0;
+}
+
+template< typename Timer_Manager >
+void
+run_bench(
+	const char * tag,
+	std::size_t connections,
+	std::chrono::steady_clock::duration check_period,
+	std::chrono::steady_clock::duration run_time )
+{
+	using connection_t = idle_connection_t< Timer_Manager >;
+
+	restinio::asio_ns::io_context io_context;
+	auto timer_manager =
+		typename Timer_Manager::factory_t{ check_period }.create( io_context );
+	std::size_t checks{ 0u };
+
+	std::vector< std::shared_ptr< connection_t > > conns;
+	conns.reserve( connections );
+
+	const auto setup_started_at = std::chrono::steady_clock::now();
+	for( std::size_t i = 0; i != connections; ++i )
+	{
+		conns.push_back(
+			std::make_shared< connection_t >( i, *timer_manager, checks ) );
+		conns.back()->start();
+	}
+	const double setup_ms = ms_since( setup_started_at );
+
+	timer_manager->start();
+
+	restinio::asio_ns::steady_timer stopper{ io_context };
+	stopper.expires_after( run_time );
+	stopper.async_wait( [&]( const auto & ) {
+			for( auto & c : conns )
+				c->stop();
+			timer_manager->stop();
+		} );
+
+	const auto cpu_started_at = std::clock();
+	const auto run_started_at = std::chrono::steady_clock::now();
+	io_context.run();
+	const double run_ms = ms_since( run_started_at );
+	const double cpu_ms =
+		1000.0 * static_cast< double >( std::clock() - cpu_started_at ) /
+		CLOCKS_PER_SEC;
+
+	std::cout << tag << ", " << connections << " connections: "
+		<< "setup " << setup_ms << " ms ("
+		<< ( setup_ms * 1000000.0 / static_cast< double >( connections ) )
+		<< " ns/conn), "
+		<< "timeout checks: " << checks << ", "
+		<< "run " << run_ms << " ms, cpu " << cpu_ms << " ms ("
+		<< ( checks ? cpu_ms * 1000000.0 / static_cast< double >( checks ) : 0.0 )
+		<< " ns/check)" << std::endl;
+}
+
+int
+main( int argc, const char * argv[] )
+{
+	try
+	{
+		std::vector< std::size_t > counts{ 10000u, 100000u };
+		if( 1 < argc )
+		{
+			counts.clear();
+			for( int i = 1; i < argc; ++i )
+				counts.push_back( std::stoul( argv[ i ] ) );
+		}
+
+		using namespace std::chrono_literals;
+		const auto check_period = 100ms;
+		const auto run_time = 2s;
+
+		for( const auto n : counts )
+		{
+			run_bench< restinio::asio_timer_manager_t >(
+					"asio_timer_manager_t", n, check_period, run_time );
+			run_bench< restinio::single_thread_wheel_timer_manager_t >(
+					"single_thread_wheel_timer_manager_t", n, check_period, run_time );
+			run_bench< restinio::wheel_timer_manager_t >(
+					"wheel_timer_manager_t", n, check_period, run_time );
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,122 @@
+/*
+	restinio bench for validation of UTF-8 text.
+
+	Compares validation byte by byte by utf8_checker_t::process_byte()
+	(the way payloads of websocket text frames were validated before
+	v.0.6.18) with utf8_checker_t::process_bytes() for texts from 64 bytes
+	to 1 MiB:
+
+	- ASCII-only text (a typical JSON);
+	- text with a lot of multibyte sequences (Cyrillic, CJK and emoji
+	  mixed with ASCII).
+*/
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <restinio/utils/utf8_checker.hpp>
+
+std::string
+make_text( const std::string & pattern, std::size_t size )
+{
+	std::string result;
+	while( result.size() < size )
+		result += pattern;
+
+	// The text shouldn't end in the middle of a multibyte sequence.
+	while( result.size() > size )
+	{
+		result.pop_back();
+		while( 0x80u == ( static_cast< unsigned char >( result.back() ) & 0xC0u ) )
+			result.pop_back();
+		result.pop_back();
+	}
+	result.append( size - result.size(), ' ' );
+
+	return result;
+}
+
+bool
+validate_by_bytes( const std::string & text )
+{
+	restinio::utils::utf8_checker_t checker;
+	for( const auto ch : text )
+		if( !checker.process_byte( static_cast< std::uint8_t >( ch ) ) )
+			return false;
+
+	return checker.finalized();
+}
+
+bool
+validate_by_blocks( const std::string & text )
+{
+	restinio::utils::utf8_checker_t checker;
+	return checker.process_bytes( text.data(), text.size() ) &&
+			checker.finalized();
+}
+
+template< typename Validator >
+void
+run_bench(
+	const char * tag,
+	const std::string & text,
+	std::size_t total_bytes,
+	Validator && validator )
+{
+	const std::size_t iterations = total_bytes / text.size();
+
+	std::size_t valid = 0u;
+	const auto started_at = std::chrono::steady_clock::now();
+	for( std::size_t i = 0u; i != iterations; ++i )
+		if( validator( text ) )
+			++valid;
+	const auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+			std::chrono::steady_clock::now() - started_at ).count();
+
+	std::cout << tag << " (" << text.size() << " bytes): "
+		<< ( static_cast< double >( iterations * text.size() ) /
+				static_cast< double >( ns ) )
+		<< " GB/s, "
+		<< ( static_cast< double >( ns ) / static_cast< double >( iterations ) )
+		<< " ns/text (" << ( valid == iterations ? "valid" : "INVALID" ) << ")"
+		<< std::endl;
+}
+
+int
+main( int argc, const char * argv[] )
+{
+	try
+	{
+		std::size_t total_bytes = 256u * 1024u * 1024u;
+		if( 1 < argc )
+			total_bytes = std::stoul( argv[ 1 ] );
+
+		const std::string json_pattern{
+			R"({"id":12345,"name":"John Smith","tags":["a","b"],"active":true},)" };
+		const std::string mixed_pattern{
+			"Hello, \xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82! "
+			"\xE4\xBD\xA0\xE5\xA5\xBD\xE4\xB8\x96\xE7\x95\x8C "
+			"\xF0\x9F\x98\x80\xF0\x9F\x9A\x80 " };
+
+		for( const auto & p : { std::make_pair( "ascii", &json_pattern ),
+				std::make_pair( "mixed", &mixed_pattern ) } )
+		{
+			std::cout << "--- " << p.first << " ---" << std::endl;
+			for( const std::size_t size : { 64u, 256u, 1024u, 4096u,
+					64u * 1024u, 1024u * 1024u } )
+			{
+				const auto text = make_text( *p.second, size );
+				run_bench( "process_byte", text, total_bytes, &validate_by_bytes );
+				run_bench( "process_bytes", text, total_bytes, &validate_by_blocks );
+			}
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
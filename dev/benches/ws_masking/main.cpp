@@ -0,0 +1,103 @@
+/*
+	restinio bench for masking/unmasking of websocket payload.
+
+	Compares masking byte by byte (the way it was done before v.0.6.18)
+	with mask_unmask_bytes() for payloads from 64 bytes to 1 MiB.
+	The data starts at an odd address to include an unaligned head.
+*/
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <restinio/websocket/impl/ws_masking.hpp>
+
+//! Masking as it was done before v.0.6.18.
+void
+legacy_mask_unmask( std::uint32_t masking_key, char * data, std::size_t size )
+{
+	using namespace ::restinio::utils::impl::bitops;
+
+	const std::size_t MASK_SIZE = 4;
+	const std::uint8_t mask[ MASK_SIZE ] = {
+		n_bits_from< std::uint8_t, 24 >(masking_key),
+		n_bits_from< std::uint8_t, 16 >(masking_key),
+		n_bits_from< std::uint8_t, 8 >(masking_key),
+		n_bits_from< std::uint8_t, 0 >(masking_key),
+	};
+
+	for( std::size_t i = 0; i < size; )
+	{
+		for( std::size_t j = 0; j < MASK_SIZE && i < size; ++j, ++i )
+		{
+			data[ i ] ^= mask[ j ];
+		}
+	}
+}
+
+template< typename Masker >
+void
+run_bench(
+	const char * tag,
+	std::size_t size,
+	std::size_t total_bytes,
+	Masker && masker )
+{
+	std::vector< char > buffer( size + 1u, 'x' );
+	char * data = buffer.data() + 1u;
+
+	const std::size_t iterations = total_bytes / size;
+
+	const auto started_at = std::chrono::steady_clock::now();
+	for( std::size_t i = 0u; i != iterations; ++i )
+		masker( 0x37FA213Du, data, size );
+	const auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+			std::chrono::steady_clock::now() - started_at ).count();
+
+	// Use the result to prevent the optimization out.
+	unsigned checksum = 0u;
+	for( const auto ch : buffer )
+		checksum += static_cast< unsigned char >( ch );
+
+	std::cout << tag << " (" << size << " bytes): "
+		<< ( static_cast< double >( iterations * size ) /
+				static_cast< double >( ns ) )
+		<< " GB/s, "
+		<< ( static_cast< double >( ns ) / static_cast< double >( iterations ) )
+		<< " ns/payload (" << checksum % 10u << ")" << std::endl;
+}
+
+int
+main( int argc, const char * argv[] )
+{
+	try
+	{
+		std::size_t total_bytes = 1024u * 1024u * 1024u;
+		if( 1 < argc )
+			total_bytes = std::stoul( argv[ 1 ] );
+
+		std::cout << "block size: "
+			<< restinio::websocket::basic::impl::ws_masking_block_size
+			<< std::endl;
+
+		for( const std::size_t size : { 64u, 256u, 1024u, 4096u,
+				64u * 1024u, 1024u * 1024u } )
+		{
+			run_bench( "byte by byte", size, total_bytes,
+					&legacy_mask_unmask );
+			run_bench( "mask_unmask_bytes", size, total_bytes,
+					[]( std::uint32_t key, char * data, std::size_t n ) {
+						restinio::websocket::basic::impl::mask_unmask_bytes(
+								key, 0u, data, n );
+					} );
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,196 @@
+/*
+	restinio bench for permessage-deflate websocket extension.
+
+	Compresses and decompresses a stream of JSON market data messages
+	(128 bytes, 1 KiB and 16 KiB) the way it is done for a websocket
+	connection and shows:
+
+	- throughput of compression and decompression;
+	- compression ratio;
+	- memory used by zlib streams of one connection (glibc only).
+
+	Every size is checked with context takeover, without context takeover
+	and with small windows.
+*/
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#if defined( __GLIBC__ )
+	#include <malloc.h>
+#endif
+
+#include <restinio/all.hpp>
+#include <restinio/websocket/permessage_deflate.hpp>
+
+namespace rws = restinio::websocket::basic;
+
+std::string
+make_message( std::mt19937 & gen, std::size_t size )
+{
+	static const char * symbols[] = { "AAPL", "MSFT", "GOOG", "AMZN", "NVDA" };
+	std::uniform_int_distribution< int > symbol{ 0, 4 };
+	std::uniform_int_distribution< int > price{ 10000, 99999 };
+	std::uniform_int_distribution< int > qty{ 1, 5000 };
+
+	std::string result{ R"({"type":"book","updates":[)" };
+	do
+	{
+		result += R"({"symbol":")";
+		result += symbols[ symbol( gen ) ];
+		result += R"(","bid":)" + std::to_string( price( gen ) ) +
+			R"(,"ask":)" + std::to_string( price( gen ) ) +
+			R"(,"qty":)" + std::to_string( qty( gen ) ) + "},";
+	}
+	while( result.size() + 2u < size );
+
+	result.resize( size - 2u );
+	result += "]}";
+
+	return result;
+}
+
+struct config_t
+{
+	const char * m_name;
+	rws::permessage_deflate_params_t m_params;
+};
+
+rws::permessage_deflate_agreement_t
+make_agreement( const rws::permessage_deflate_params_t & params )
+{
+	restinio::http_header_fields_t fields;
+	fields.add_field(
+		restinio::http_field::sec_websocket_extensions,
+		"permessage-deflate; client_max_window_bits" );
+
+	return *rws::negotiate_permessage_deflate( fields, params );
+}
+
+std::size_t
+allocated_bytes()
+{
+#if defined( __GLIBC__ ) && \
+		( __GLIBC__ > 2 || ( __GLIBC__ == 2 && __GLIBC_MINOR__ >= 33 ) )
+	return mallinfo2().uordblks;
+#else
+	return 0u;
+#endif
+}
+
+void
+run_bench(
+	const config_t & config,
+	const std::vector< std::string > & messages,
+	std::size_t total_bytes )
+{
+	const auto agreement = make_agreement( config.m_params );
+	rws::impl::permessage_deflate_t server{ agreement };
+	rws::impl::permessage_deflate_t client{ agreement };
+
+	const std::size_t iterations = total_bytes / messages.front().size();
+
+	std::vector< std::string > compressed;
+	compressed.reserve( iterations );
+
+	std::size_t source_size = 0u;
+	std::size_t compressed_size = 0u;
+
+	auto started_at = std::chrono::steady_clock::now();
+	for( std::size_t i = 0u; i != iterations; ++i )
+	{
+		const auto & m = messages[ i % messages.size() ];
+		compressed.push_back( server.compress_frame( m, rws::final_frame ) );
+		source_size += m.size();
+		compressed_size += compressed.back().size();
+	}
+	const auto compress_ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+			std::chrono::steady_clock::now() - started_at ).count();
+
+	std::size_t decompressed_size = 0u;
+	started_at = std::chrono::steady_clock::now();
+	for( const auto & c : compressed )
+		decompressed_size += client.decompress_frame( c, rws::final_frame )->size();
+	const auto decompress_ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+			std::chrono::steady_clock::now() - started_at ).count();
+
+	// Memory of connections that have sent and received one message.
+	constexpr std::size_t connections = 1000u;
+	std::vector< std::unique_ptr< rws::impl::permessage_deflate_t > > conns;
+	conns.reserve( connections );
+
+	const auto allocated_before = allocated_bytes();
+	for( std::size_t i = 0u; i != connections; ++i )
+	{
+		conns.push_back(
+			std::make_unique< rws::impl::permessage_deflate_t >( agreement ) );
+		const auto c = conns.back()->compress_frame(
+				messages[ i % messages.size() ], rws::final_frame );
+		conns.back()->decompress_frame( c, rws::final_frame );
+	}
+	const auto per_connection =
+		( allocated_bytes() - allocated_before ) / connections;
+
+	std::cout << config.m_name << " (" << messages.front().size() << " bytes): "
+		<< "compress "
+		<< ( static_cast< double >( source_size ) /
+				static_cast< double >( compress_ns ) * 1000.0 )
+		<< " MB/s, decompress "
+		<< ( static_cast< double >( decompressed_size ) /
+				static_cast< double >( decompress_ns ) * 1000.0 )
+		<< " MB/s, ratio "
+		<< ( static_cast< double >( compressed_size ) /
+				static_cast< double >( source_size ) )
+		<< ", memory per connection: ";
+	if( 0u != allocated_before )
+		std::cout << per_connection << " bytes";
+	else
+		std::cout << "n/a";
+	std::cout << std::endl;
+}
+
+int
+main( int argc, const char * argv[] )
+{
+	try
+	{
+		std::size_t total_bytes = 64u * 1024u * 1024u;
+		if( 1 < argc )
+			total_bytes = std::stoul( argv[ 1 ] );
+
+		const config_t configs[] = {
+			{ "context takeover", rws::permessage_deflate_params_t{} },
+			{ "no context takeover",
+				rws::permessage_deflate_params_t{}
+					.server_no_context_takeover( true )
+					.client_no_context_takeover( true ) },
+			{ "window bits 10",
+				rws::permessage_deflate_params_t{}
+					.server_max_window_bits( 10 )
+					.client_max_window_bits( 10 )
+					.mem_level( 4 ) },
+		};
+
+		std::mt19937 gen{ 42u };
+		for( const std::size_t size : { 128u, 1024u, 16u * 1024u } )
+		{
+			// Messages shouldn't repeat in the window of compression.
+			std::vector< std::string > messages;
+			for( std::size_t i = 0u; i < 1024u * 1024u; i += size )
+				messages.push_back( make_message( gen, size ) );
+
+			std::cout << "--- " << size << " bytes ---" << std::endl;
+			for( const auto & config : configs )
+				run_bench( config, messages, total_bytes );
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
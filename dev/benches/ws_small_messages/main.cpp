@@ -0,0 +1,161 @@
+/*
+	restinio bench for small websocket messages.
+
+	Starts a server with one websocket connection and sends a stream of
+	small text messages (32, 64, 128 and 256 bytes) from another thread
+	to the client over a loopback socket. Shows the throughput of one
+	connection in messages per second and MB/s.
+
+	Every size is checked without a write delay and with
+	websocket_write_coalescing_delay.
+
+	Usage:
+		_bench.restinio.ws_small_messages [MESSAGES [PORT]]
+*/
+#include <iostream>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <restinio/all.hpp>
+#include <restinio/websocket/websocket.hpp>
+
+namespace rws = restinio::websocket::basic;
+
+using traits_t = restinio::default_single_thread_traits_t;
+
+struct config_t
+{
+	const char * m_name;
+	std::chrono::microseconds m_write_delay;
+};
+
+std::string
+make_upgrade_request()
+{
+	return
+		"GET /bench HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"Upgrade: websocket\r\n"
+		"Connection: Upgrade\r\n"
+		"Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+		"Sec-WebSocket-Version: 13\r\n"
+		"\r\n";
+}
+
+void
+run_bench(
+	const config_t & config,
+	std::size_t messages,
+	std::uint16_t port )
+{
+	std::promise< rws::ws_handle_t > ws_promise;
+
+	auto server = restinio::run_async< traits_t >(
+		restinio::own_io_context(),
+		restinio::server_settings_t< traits_t >{}
+			.address( "127.0.0.1" )
+			.port( port )
+			.websocket_write_coalescing_delay( config.m_write_delay )
+			.request_handler( [&]( auto req ) {
+				if( restinio::http_connection_header_t::upgrade !=
+					req->header().connection() )
+					return restinio::request_rejected();
+
+				ws_promise.set_value(
+					rws::upgrade< traits_t >(
+						*req,
+						rws::activation_t::immediate,
+						[]( rws::ws_handle_t, rws::message_handle_t ){} ) );
+
+				return restinio::request_accepted();
+			} ),
+		1u );
+
+	restinio::asio_ns::io_context io_context;
+	restinio::asio_ns::ip::tcp::socket socket{ io_context };
+	socket.connect( restinio::asio_ns::ip::tcp::endpoint{
+			restinio::asio_ns::ip::make_address_v4( "127.0.0.1" ), port } );
+
+	const auto request = make_upgrade_request();
+	restinio::asio_ns::write( socket, restinio::asio_ns::buffer( request ) );
+
+	restinio::asio_ns::streambuf response;
+	restinio::asio_ns::read_until( socket, response, "\r\n\r\n" );
+
+	auto ws = ws_promise.get_future().get();
+
+	std::vector< char > buffer( 64u * 1024u );
+
+	for( const std::size_t size : { 32u, 64u, 128u, 256u } )
+	{
+		const std::string payload( size, 'x' );
+		const std::size_t header_size = size < 126u ? 2u : 4u;
+		const std::size_t total_bytes = messages * ( header_size + size );
+
+		const auto started_at = std::chrono::steady_clock::now();
+
+		std::thread producer{ [&] {
+			for( std::size_t i = 0u; i != messages; ++i )
+				ws->send_message(
+					rws::final_frame,
+					rws::opcode_t::text_frame,
+					restinio::writable_item_t{ payload } );
+		} };
+
+		// The rest of the upgrade response is counted too,
+		// but it is empty for this server.
+		std::size_t received = response.size();
+		response.consume( response.size() );
+		while( received < total_bytes )
+			received += socket.read_some( restinio::asio_ns::buffer( buffer ) );
+
+		const auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+				std::chrono::steady_clock::now() - started_at ).count();
+
+		producer.join();
+
+		std::cout << config.m_name << " (" << size << " bytes): "
+			<< ( static_cast< double >( messages ) /
+					static_cast< double >( ns ) * 1e9 )
+			<< " msg/s, "
+			<< ( static_cast< double >( received ) /
+					static_cast< double >( ns ) * 1000.0 )
+			<< " MB/s" << std::endl;
+	}
+
+	ws->kill();
+}
+
+int
+main( int argc, const char * argv[] )
+{
+	try
+	{
+		std::size_t messages = 200000u;
+		if( 1 < argc )
+			messages = std::stoul( argv[ 1 ] );
+
+		std::uint16_t port = 8080u;
+		if( 2 < argc )
+			port = static_cast< std::uint16_t >( std::stoul( argv[ 2 ] ) );
+
+		const config_t configs[] = {
+			{ "no delay", std::chrono::microseconds{ 0 } },
+			{ "delay 50us", std::chrono::microseconds{ 50 } },
+			{ "delay 500us", std::chrono::microseconds{ 500 } },
+		};
+
+		for( const auto & config : configs )
+			run_bench( config, messages, port );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
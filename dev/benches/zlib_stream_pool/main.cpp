@@ -0,0 +1,86 @@
+/*
+	restinio bench for the pool of zlib streams.
+
+	Compresses a stream of small JSON responses (512 bytes, 2 KiB and
+	8 KiB) by gzip_compress() the way it is done by a request handler
+	and shows the throughput with the pool of zlib streams and without
+	it (stream_pool_capacity(0)).
+
+	Usage:
+		_bench.restinio.zlib_stream_pool [RESPONSES]
+*/
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <string>
+
+#include <restinio/all.hpp>
+#include <restinio/transforms/zlib.hpp>
+
+namespace rtz = restinio::transforms::zlib;
+
+std::string
+make_json( std::size_t size )
+{
+	std::mt19937 gen{ 42u };
+	std::uniform_int_distribution< int > price{ 1000, 9999 };
+
+	std::string result{ "[" };
+	while( result.size() < size )
+		result += R"({"symbol":"ABC","price":)" + std::to_string( price( gen ) ) +
+			R"(,"qty":)" + std::to_string( price( gen ) % 100 ) + "},";
+	result.back() = ']';
+
+	return result;
+}
+
+void
+run_bench( const char * name, std::size_t responses )
+{
+	for( const std::size_t size : { 512u, 2048u, 8192u } )
+	{
+		const auto json = make_json( size );
+
+		std::size_t compressed_bytes = 0u;
+		const auto started_at = std::chrono::steady_clock::now();
+
+		for( std::size_t i = 0u; i != responses; ++i )
+			compressed_bytes += rtz::gzip_compress( json ).size();
+
+		const auto ns = std::chrono::duration_cast< std::chrono::nanoseconds >(
+				std::chrono::steady_clock::now() - started_at ).count();
+
+		std::cout << name << " (" << json.size() << " bytes): "
+			<< ( static_cast< double >( responses ) /
+					static_cast< double >( ns ) * 1e9 )
+			<< " responses/s, "
+			<< ( static_cast< double >( ns ) /
+					static_cast< double >( responses ) / 1000.0 )
+			<< " us per response (compressed to "
+			<< compressed_bytes / responses << " bytes)" << std::endl;
+	}
+}
+
+int
+main( int argc, const char * argv[] )
+{
+	try
+	{
+		std::size_t responses = 20000u;
+		if( 1 < argc )
+			responses = std::stoul( argv[ 1 ] );
+
+		rtz::stream_pool_capacity( 0u );
+		run_bench( "without pool", responses );
+
+		rtz::stream_pool_capacity( rtz::default_stream_pool_capacity );
+		run_bench( "with pool", responses );
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
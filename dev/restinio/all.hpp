@@ -18,6 +18,7 @@
 #include <restinio/http_server_run.hpp>
 #include <restinio/asio_timer_manager.hpp>
 #include <restinio/null_timer_manager.hpp>
+#include <restinio/wheel_timer_manager.hpp>
 #include <restinio/null_logger.hpp>
 #include <restinio/ostream_logger.hpp>
 #include <restinio/uri_helpers.hpp>
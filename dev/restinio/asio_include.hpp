@@ -8,8 +8,51 @@
 
 #pragma once
 
+/*
+	Since v.0.6.18 RESTinio can ask asio to use io_uring instead of epoll
+	on Linux. To do that RESTINIO_ASIO_USE_IO_URING should be defined
+	(and liburing should be linked). Requires asio 1.21 (or Boost 1.78)
+	or newer.
+
+	The scope of that macro is the whole program, not a server:
+	- it defines ASIO_HAS_IO_URING and ASIO_DISABLE_EPOLL (or their
+	  BOOST_ASIO_ counterparts), so all socket and timer operations of
+	  every io_context are switched to io_uring, including io_contexts
+	  that aren't used by RESTinio;
+	- asio selects its reactor at compile time, so translation units
+	  compiled with and without the macro can't be mixed in one program
+	  (that is an ODR violation). The macro should be passed by the build
+	  system for all translation units, not defined in a source file;
+	- types of asio (and traits of RESTinio) are the same for both
+	  backends, so the backend can't be selected by traits of a server.
+
+	Only that program-wide switch is provided. The following parts of
+	an io_uring backend are not implemented:
+	- selection of the backend by traits of a server (see above);
+	- registered (fixed) buffers for reading: asio doesn't expose
+	  IORING_REGISTER_BUFFERS and IORING_OP_READ_FIXED, connections read
+	  into ordinary buffers by async_read_some;
+	- sendfile by IORING_OP_SPLICE: sendfile operations still use
+	  sendfile() (see sendfile_operation_posix.ipp) and don't go through
+	  the io_uring of io_context.
+	Those would require a submission queue of RESTinio's own beside
+	the one of asio.
+
+	Tests and benches for that backend are built with RESTINIO_ASIO_IO_URING
+	CMake option (or RESTINIO_ASIO_IO_URING environment variable for Mxx_ru).
+	See benches/reactor_load for comparison with the default backend.
+*/
 #if !defined(RESTINIO_USE_BOOST_ASIO)
 
+#if defined(RESTINIO_ASIO_USE_IO_URING)
+	#if !defined(ASIO_HAS_IO_URING)
+		#define ASIO_HAS_IO_URING
+	#endif
+	#if !defined(ASIO_DISABLE_EPOLL)
+		#define ASIO_DISABLE_EPOLL
+	#endif
+#endif
+
 // RESTinio uses stand-alone version of asio.
 #include <asio.hpp>
 
@@ -56,8 +99,22 @@ namespace restinio
 		#define RESTINIO_ASIO_HAS_WINDOWS_OVERLAPPED_PTR
 	#endif
 
+	#if defined(ASIO_HAS_IO_URING)
+		// Define feature macro with the same name for stand-alone and boost asio.
+		#define RESTINIO_ASIO_HAS_IO_URING
+	#endif
+
 #else
 
+#if defined(RESTINIO_ASIO_USE_IO_URING)
+	#if !defined(BOOST_ASIO_HAS_IO_URING)
+		#define BOOST_ASIO_HAS_IO_URING
+	#endif
+	#if !defined(BOOST_ASIO_DISABLE_EPOLL)
+		#define BOOST_ASIO_DISABLE_EPOLL
+	#endif
+#endif
+
 // RESTinio uses boost::asio.
 #include <boost/asio.hpp>
 
@@ -108,6 +165,17 @@ namespace restinio
 		#define RESTINIO_ASIO_HAS_WINDOWS_OVERLAPPED_PTR
 	#endif
 
+	#if defined(BOOST_ASIO_HAS_IO_URING)
+		// Define feature macro with the same name for stand-alone and boost asio.
+		#define RESTINIO_ASIO_HAS_IO_URING
+	#endif
+
+#endif
+
+#if defined(RESTINIO_ASIO_USE_IO_URING)
+	#if RESTINIO_ASIO_VERSION < 102100
+		#error "RESTINIO_ASIO_USE_IO_URING requires asio 1.21 or newer"
+	#endif
 #endif
 
 namespace restinio
@@ -1484,6 +1484,14 @@ public :
 		,	m_consumer{ std::move(consumer) }
 	{}
 
+	//! Get access to the producer of the clause.
+	/*!
+	 * @since v.0.6.18
+	 */
+	RESTINIO_NODISCARD
+	const P &
+	producer() const noexcept { return m_producer; }
+
 	template< typename Target_Type >
 	RESTINIO_NODISCARD
 	optional_t< parse_error_t >
@@ -2018,6 +2026,14 @@ public :
 		:	m_subitems{ std::move(subitems) }
 	{}
 
+	//! Get access to clauses of the producer.
+	/*!
+	 * @since v.0.6.18
+	 */
+	RESTINIO_NODISCARD
+	const Subitems_Tuple &
+	subitems() const noexcept { return m_subitems; }
+
 	RESTINIO_NODISCARD
 	expected_t< Target_Type, parse_error_t >
 	try_parse( source_t & from )
@@ -3366,6 +3382,17 @@ public:
 		std::copy( &f[ 0 ], &f[ m_fragment.size() ], m_fragment.data() );
 	}
 
+	//! Get the fragment to be found.
+	/*!
+	 * @since v.0.6.18
+	 */
+	RESTINIO_NODISCARD
+	string_view_t
+	fragment() const noexcept
+	{
+		return { m_fragment.data(), m_fragment.size() };
+	}
+
 	RESTINIO_NODISCARD
 	expected_t< bool, parse_error_t >
 	try_parse( source_t & from )
@@ -3398,6 +3425,17 @@ public:
 					"can't be empty!" );
 	}
 
+	//! Get the fragment to be found.
+	/*!
+	 * @since v.0.6.18
+	 */
+	RESTINIO_NODISCARD
+	string_view_t
+	fragment() const noexcept
+	{
+		return m_fragment;
+	}
+
 	RESTINIO_NODISCARD
 	expected_t< bool, parse_error_t >
 	try_parse( source_t & from )
@@ -0,0 +1,104 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief Stuff related to value of Sec-WebSocket-Extensions HTTP-field.
+ *
+ * @since v.0.6.18
+ */
+
+#pragma once
+
+#include <restinio/helpers/http_field_parsers/basics.hpp>
+
+#include <tuple>
+
+namespace restinio
+{
+
+namespace http_field_parsers
+{
+
+//
+// sec_websocket_extensions_value_t
+//
+/*!
+ * @brief Tools for working with the value of Sec-WebSocket-Extensions
+ * HTTP-field.
+ *
+ * This struct represents parsed value of HTTP-field Sec-WebSocket-Extensions
+ * (see https://tools.ietf.org/html/rfc6455#section-9.1):
+@verbatim
+Sec-WebSocket-Extensions = extension-list
+extension-list = 1#extension
+extension = extension-token *( ";" extension-param )
+extension-token = registered-token
+registered-token = token
+extension-param = token [ "=" (token | quoted-string) ]
+@endverbatim
+ *
+ * @note
+ * Names of extensions and parameters are converted to lower case.
+ *
+ * @since v.0.6.18
+ */
+struct sec_websocket_extensions_value_t
+{
+	//! Description of an extension.
+	struct extension_t
+	{
+		std::string name;
+		parameter_with_optional_value_container_t params;
+
+		RESTINIO_NODISCARD
+		bool
+		operator==( const extension_t & o ) const noexcept
+		{
+			return std::tie(this->name, this->params) ==
+					std::tie(o.name, o.params);
+		}
+	};
+
+	using extension_container_t = std::vector< extension_t >;
+
+	extension_container_t extensions;
+
+	/*!
+	 * @brief A factory function for a parser of Sec-WebSocket-Extensions value.
+	 *
+	 * @since v.0.6.18
+	 */
+	RESTINIO_NODISCARD
+	static auto
+	make_parser()
+	{
+		return produce< sec_websocket_extensions_value_t >(
+			non_empty_comma_separated_list_p< extension_container_t >(
+				produce< extension_t >(
+					token_p() >> to_lower() >> &extension_t::name,
+					params_with_opt_value_p() >> &extension_t::params
+				)
+			) >> &sec_websocket_extensions_value_t::extensions
+		);
+	}
+
+	/*!
+	 * @brief An attempt to parse Sec-WebSocket-Extensions HTTP-field.
+	 *
+	 * @since v.0.6.18
+	 */
+	RESTINIO_NODISCARD
+	static expected_t<
+		sec_websocket_extensions_value_t,
+		restinio::easy_parser::parse_error_t >
+	try_parse( string_view_t what )
+	{
+		return restinio::easy_parser::try_parse( what, make_parser() );
+	}
+};
+
+} /* namespace http_field_parsers */
+
+} /* namespace restinio */
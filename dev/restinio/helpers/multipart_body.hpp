@@ -57,7 +57,7 @@ namespace multipart_body
  * 		req, "multipart", "form-data" );
  * if( boundary )
  * {
- * 	const auto parts = split_multipart_body( req.body(), *boundary );
+ * 	const auto parts = split_multipart_body( req.body_as_string(), *boundary );
  * 	for( restinio::string_view_t one_part : parts )
  * 	{
  * 		... // Handling of a part.
@@ -296,7 +296,7 @@ make_parser()
  * 		req, "multipart", "form-data" );
  * if( boundary )
  * {
- * 	const auto parts = split_multipart_body( req.body(), *boundary );
+ * 	const auto parts = split_multipart_body( req.body_as_string(), *boundary );
  * 	for( restinio::string_view_t one_part : parts )
  * 	{
  * 		const auto parsed_part = try_parse_part( one_part );
@@ -715,7 +715,7 @@ enumerate_parts(
 			expected_media_subtype );
 	if( boundary )
 	{
-		const auto parts = split_multipart_body( req.body(), *boundary );
+		const auto parts = split_multipart_body( req.body_as_string(), *boundary );
 
 		if( parts.empty() )
 			return make_unexpected(
@@ -20,6 +20,7 @@
 #include <http_parser.h>
 
 #include <iosfwd>
+#include <cstring>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -241,306 +242,333 @@ enum class http_field_t : std::uint8_t //By now 152 + 34 + 1 items fits to uint8
 //! Helper alies to omitt `_t` suffix.
 using http_field = http_field_t;
 
+namespace impl
+{
+
+namespace field_perfect_hash
+{
+
+//! Description of the name of a known field.
+/*!
+ * @since v.0.6.18
+ */
+struct field_name_t
+{
+	const char * m_name;
+	std::size_t m_size;
+};
+
+//! Names of all known fields in the order of http_field_t.
+/*!
+ * It's a template just to have a single definition of the table
+ * in a header-only library.
+ *
+ * @since v.0.6.18
+ */
+template< typename T = void >
+struct known_names_t
+{
+	static constexpr field_name_t items[] = {
+#define RESTINIO_HTTP_FIELD_NAME_GEN( ignored, string_name ) \
+		{ #string_name, sizeof( #string_name ) - 1u },
+		RESTINIO_HTTP_FIELDS_MAP( RESTINIO_HTTP_FIELD_NAME_GEN )
+#undef RESTINIO_HTTP_FIELD_NAME_GEN
+	};
+};
+
+template< typename T >
+constexpr field_name_t known_names_t< T >::items[];
+
+//! The count of known fields.
+constexpr std::size_t fields_count =
+		static_cast< std::size_t >( http_field_t::field_unspecified );
+
+//! The length of the longest name of a known field.
+constexpr std::size_t max_name_size = 32u;
+
+//! The count of buckets for the first level of the hash.
+constexpr std::size_t buckets_count = 64u;
+
+//! The count of slots in the table (every slot holds one field).
+constexpr std::size_t slots_count = 256u;
+
+static_assert( fields_count * 4u <= slots_count * 3u,
+		"the table is too small for the list of known fields" );
+
+//! Load up to 8 bytes of a name as a little-endian word.
+/*!
+ * GCC and clang turn the loop for 8 bytes into a single load.
+ */
+RESTINIO_NODISCARD
+constexpr std::uint64_t
+load_word( const char * from, std::size_t size ) noexcept
+{
+	std::uint64_t result = 0u;
+	for( std::size_t i = 0u; i != size; ++i )
+		result |= static_cast< std::uint64_t >(
+				static_cast< unsigned char >( from[ i ] ) ) << ( 8u * i );
+	return result;
+}
+
+//! Caseless hash of a field name.
+/*!
+ * Only the size of the name and its first and last 8 bytes are
+ * taken into account. That is enough to distinguish all known fields
+ * (it's checked at compile time by make_table()), and any name found
+ * in the table is compared with the original one anyway.
+ *
+ * Bytes are folded by `c | 0x20`. It makes upper and lower case
+ * letters identical and doesn't split case-insensitively equal names.
+ *
+ * It's used for building the table at compile time and for
+ * lookups at run-time.
+ */
+RESTINIO_NODISCARD
+constexpr std::uint64_t
+hash( const char * name, std::size_t size ) noexcept
+{
+	constexpr std::uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+	constexpr std::uint64_t case_mask = 0x2020202020202020ull;
+
+	std::uint64_t first = 0u;
+	std::uint64_t last = 0u;
+	if( size >= 8u )
+	{
+		first = load_word( name, 8u );
+		last = load_word( name + size - 8u, 8u );
+	}
+	else
+		first = load_word( name, size );
+
+	std::uint64_t result = ( size ^ ( first | case_mask ) ) * multiplier;
+	result = ( result ^ ( last | case_mask ) ) * multiplier;
+
+	return result ^ ( result >> 29u );
+}
+
+//! Does a word have a byte less than 0x20?
+RESTINIO_NODISCARD
+constexpr bool
+has_control_byte( std::uint64_t w ) noexcept
+{
+	return 0u != ( ( w - 0x2020202020202020ull ) & ~w & 0x8080808080808080ull );
+}
+
+//! Caseless comparison of a name with the name of a known field.
+/*!
+ * Names of known fields consist only of letters, digits and '-' (it's
+ * checked at compile time by make_table()). For such names folding
+ * of bytes by `c | 0x20` gives the same result as conversion to lower
+ * case, if bytes less than 0x20 are rejected. So the comparison is
+ * performed by 8-byte words.
+ *
+ * @pre The sizes of names are the same.
+ */
+RESTINIO_NODISCARD
+inline bool
+is_equal_to_known_name(
+	const char * name,
+	const field_name_t & known ) noexcept
+{
+	constexpr std::uint64_t case_mask = 0x2020202020202020ull;
+
+	const auto words_equal = []( std::uint64_t a, std::uint64_t b ) {
+		return !has_control_byte( a ) && ( a | case_mask ) == ( b | case_mask );
+	};
+
+	const std::size_t size = known.m_size;
+	if( size < 8u )
+		return words_equal(
+				load_word( name, size ) | ( ~std::uint64_t{} << ( 8u * size ) ),
+				load_word( known.m_name, size ) | ( ~std::uint64_t{} << ( 8u * size ) ) );
+
+	std::uint64_t a{}, b{};
+	for( std::size_t i = 0u; i + 8u < size; i += 8u )
+	{
+		std::memcpy( &a, name + i, 8u );
+		std::memcpy( &b, known.m_name + i, 8u );
+		if( !words_equal( a, b ) )
+			return false;
+	}
+
+	// The last word (it can overlap with the previous one).
+	std::memcpy( &a, name + size - 8u, 8u );
+	std::memcpy( &b, known.m_name + size - 8u, 8u );
+	return words_equal( a, b );
+}
+
+//! Bucket of the first level for a hash value.
+RESTINIO_NODISCARD
+constexpr std::size_t
+bucket_of( std::uint64_t h ) noexcept
+{
+	return static_cast< std::size_t >( h ) & ( buckets_count - 1u );
+}
+
+//! Slot for a hash value with the displacement of its bucket.
+RESTINIO_NODISCARD
+constexpr std::size_t
+slot_of( std::uint64_t h, std::uint8_t displacement ) noexcept
+{
+	return static_cast< std::size_t >(
+			( h >> 32u ) +
+			displacement * ( ( ( h >> 8u ) & 0xFFFFFFu ) | 1u ) ) &
+		( slots_count - 1u );
+}
+
+//! Two-level perfect hash table for known fields.
+/*!
+ * A hash of the name selects a bucket, the displacement of the bucket
+ * selects a slot. Displacements are chosen in a way that every known
+ * field gets its own slot ("hash and displace" scheme).
+ *
+ * @since v.0.6.18
+ */
+struct table_t
+{
+	std::uint8_t m_displacements[ buckets_count ];
+	http_field_t m_slots[ slots_count ];
+};
+
+//! Build the table at compile time.
+/*!
+ * Buckets are processed from the biggest to the smallest. For every
+ * bucket the first displacement that puts all fields of the bucket
+ * into free slots is taken.
+ *
+ * @note
+ * A compilation error is raised if there is no suitable displacement
+ * for a bucket. That can happen only after changes in the list of
+ * known fields, the hash function or the sizes of the table.
+ */
+RESTINIO_NODISCARD
+constexpr table_t
+make_table()
+{
+	table_t result{};
+	for( auto & s : result.m_slots )
+		s = http_field_t::field_unspecified;
+
+	std::uint64_t hashes[ fields_count ]{};
+	std::size_t bucket_sizes[ buckets_count ]{};
+	std::size_t biggest_bucket = 0u;
+	for( std::size_t i = 0u; i != fields_count; ++i )
+	{
+		const auto & n = known_names_t<>::items[ i ];
+		if( n.m_size > max_name_size )
+			throw exception_t{ "max_name_size is less than the size of a name" };
+		for( std::size_t c = 0u; c != n.m_size; ++c )
+		{
+			const char ch = n.m_name[ c ];
+			if( !( ( 'a' <= ch && ch <= 'z' ) || ( 'A' <= ch && ch <= 'Z' ) ||
+					( '0' <= ch && ch <= '9' ) || '-' == ch ) )
+				throw exception_t{ "unexpected char in the name of a field" };
+		}
+		hashes[ i ] = hash( n.m_name, n.m_size );
+
+		const auto s = ++bucket_sizes[ bucket_of( hashes[ i ] ) ];
+		if( s > biggest_bucket )
+			biggest_bucket = s;
+	}
+
+	for( std::size_t size = biggest_bucket; size != 0u; --size )
+		for( std::size_t b = 0u; b != buckets_count; ++b )
+		{
+			if( size != bucket_sizes[ b ] )
+				continue;
+
+			std::size_t members[ fields_count ]{};
+			std::size_t members_count = 0u;
+			for( std::size_t i = 0u; i != fields_count; ++i )
+				if( b == bucket_of( hashes[ i ] ) )
+					members[ members_count++ ] = i;
+
+			bool placed = false;
+			for( unsigned d = 0u; !placed && d != 256u; ++d )
+			{
+				const auto displacement = static_cast< std::uint8_t >( d );
+				std::size_t m = 0u;
+				for( ; m != members_count; ++m )
+				{
+					const auto slot = slot_of( hashes[ members[ m ] ], displacement );
+					if( http_field_t::field_unspecified != result.m_slots[ slot ] )
+						break;
+					result.m_slots[ slot ] = static_cast< http_field_t >( members[ m ] );
+				}
+
+				if( m == members_count )
+				{
+					result.m_displacements[ b ] = displacement;
+					placed = true;
+				}
+				else
+				{
+					// Rollback of partially placed fields.
+					while( m != 0u )
+					{
+						--m;
+						result.m_slots[ slot_of( hashes[ members[ m ] ], displacement ) ] =
+								http_field_t::field_unspecified;
+					}
+				}
+			}
+
+			if( !placed )
+				throw exception_t{ "unable to build perfect hash for known fields" };
+		}
+
+	return result;
+}
+
+//! The table built at compile time.
+template< typename T = void >
+struct table_holder_t
+{
+	static constexpr table_t table = make_table();
+};
+
+template< typename T >
+constexpr table_t table_holder_t< T >::table;
+
+} /* namespace field_perfect_hash */
+
+} /* namespace impl */
+
 //
 // string_to_field()
 //
 
 //! Helper function to get method string name.
-//! \{
+/*!
+ * Since v.0.6.18 the lookup is performed via a perfect hash table
+ * that is built at compile time from RESTINIO_HTTP_FIELDS_MAP. It takes
+ * one hash calculation, one probe and one caseless comparison.
+ */
 inline http_field_t
 string_to_field( string_view_t field ) noexcept
 {
+	namespace ph = impl::field_perfect_hash;
+
 	const char * field_name = field.data();
 	const std::size_t field_name_size = field.size();
 
-#define RESTINIO_HTTP_CHECK_FOR_FIELD( field_id, candidate_field_name ) \
-	if( impl::is_equal_caseless(field_name, #candidate_field_name , field_name_size ) ) \
-		return http_field_t:: field_id;
+	if( field_name_size > ph::max_name_size )
+		return http_field_t::field_unspecified;
 
-	// TODO: make most popular fields to be checked first.
+	const auto h = ph::hash( field_name, field_name_size );
+	const auto & table = ph::table_holder_t<>::table;
+	const auto candidate = table.m_slots[
+			ph::slot_of( h, table.m_displacements[ ph::bucket_of( h ) ] ) ];
 
-	switch( field_name_size )
+	if( http_field_t::field_unspecified != candidate )
 	{
-		case 2:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_,                          If )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( im,                           IM )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( te,                           TE )
-			break;
-
-		case 3:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( age,                          Age )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( dav,                          DAV )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ext,                          Ext )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( man,                          Man )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( opt,                          Opt )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( p3p,                          P3P )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( pep,                          PEP )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( tcn,                          TCN )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ttl,                          TTL )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( uri,                          URI )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( via,                          Via )
-			break;
-
-		case 4:
-			// Known to be more used first:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( host,                         Host )
-
-			RESTINIO_HTTP_CHECK_FOR_FIELD( a_im,                         A-IM )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( alpn,                         ALPN )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( dasl,                         DASL )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( date,                         Date )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( etag,                         ETag )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( from,                         From )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( link,                         Link )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( safe,                         Safe )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( slug,                         SLUG )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( vary,                         Vary )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( cost,                         Cost )
-			break;
-
-		case 5:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( allow,                        Allow )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( c_ext,                        C-Ext )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( c_man,                        C-Man )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( c_opt,                        C-Opt )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( c_pep,                        C-PEP )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( close,                        Close )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( depth,                        Depth )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( label,                        Label )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( meter,                        Meter )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( range,                        Range )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( topic,                        Topic )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( subok,                        SubOK )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( subst,                        Subst )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( title,                        Title )
-			break;
-
-		case 6:
-			// Known to be more used first:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept,                       Accept )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( cookie,                       Cookie )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( server,                       Server )
-
-			RESTINIO_HTTP_CHECK_FOR_FIELD( digest,                       Digest )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( expect,                       Expect )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( origin,                       Origin )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( pragma,                       Pragma )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( prefer,                       Prefer )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( public_,                      Public )
-			break;
-
-		case 7:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( alt_svc,                      Alt-Svc )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( cookie2,                      Cookie2 )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( expires,                      Expires )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( hobareg,                      Hobareg )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( referer,                      Referer )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( timeout,                      Timeout )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( trailer,                      Trailer )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( urgency,                      Urgency )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( upgrade,                      Upgrade )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( warning,                      Warning )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( version,                      Version )
-			break;
-
-		case 8:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( alt_used,                     Alt-Used )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_match,                     If-Match )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_range,                     If-Range )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( location,                     Location )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( pep_info,                     Pep-Info )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( position,                     Position )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( protocol,                     Protocol )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( optional,                     Optional )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_color,                     UA-Color )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_media,                     UA-Media )
-			break;
-
-		case 9:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( forwarded,                    Forwarded )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( negotiate,                    Negotiate )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( overwrite,                    Overwrite )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_pixels,                    UA-Pixels )
-			break;
-
-		case 10:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( alternates,                   Alternates )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( c_pep_info,                   C-PEP-Info )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_id,                   Content-ID )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( delta_base,                   Delta-Base )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( getprofile,                   GetProfile )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( keep_alive,                   Keep-Alive )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( lock_token,                   Lock-Token )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( pics_label,                   PICS-Label )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( set_cookie,                   Set-Cookie )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( setprofile,                   SetProfile )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( soapaction,                   SoapAction )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( status_uri,                   Status-URI )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( user_agent,                   User-Agent )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( compliance,                   Compliance )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( message_id,                   Message-ID )
-			break;
-
-		case 11:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_post,                  Accept-Post )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_md5,                  Content-MD5 )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( destination,                  Destination )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( retry_after,                  Retry-After )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( set_cookie2,                  Set-Cookie2 )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( want_digest,                  Want-Digest )
-			break;
-
-		case 12:
-			// Known to be more used first:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_type,                 Content-Type )
-
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_patch,                 Accept-Patch )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_base,                 Content-Base )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( derived_from,                 Derived-From )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( max_forwards,                 Max-Forwards )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( mime_version,                 MIME-Version )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( schedule_tag,                 Schedule-Tag )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( redirect_ref,                 Redirect-Ref )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( variant_vary,                 Variant-Vary )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( method_check,                 Method-Check )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( referer_root,                 Referer-Root )
-			break;
-
-		case 13:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_ranges,                Accept-Ranges )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( authorization,                Authorization )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( cache_control,                Cache-Control )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_range,                Content-Range )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( default_style,                Default-Style )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_none_match,                If-None-Match )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( last_modified,                Last-Modified )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ordering_type,                Ordering-Type )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( profileobject,                ProfileObject )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( protocol_info,                Protocol-Info )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_resolution,                UA-Resolution )
-			break;
-
-		case 14:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_charset,               Accept-Charset )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( http2_settings,               HTTP2-Settings )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( protocol_query,               Protocol-Query )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_features,               Proxy-Features )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( schedule_reply,               Schedule-Reply )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( non_compliance,               Non-Compliance )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control,               Access-Control )
-			break;
-
-		case 15:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_encoding,              Accept-Encoding )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_features,              Accept-Features )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_language,              Accept-Language )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_datetime,              Accept-Datetime )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_version,              Content-Version )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( differential_id,              Differential-ID )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( public_key_pins,              Public-Key-Pins )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( security_scheme,              Security-Scheme )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( x_frame_options,              X-Frame-Options )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_accept,              X-Device-Accept )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( resolution_hint,              Resolution-Hint )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ediint_features,              EDIINT-Features )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_windowpixels,              UA-Windowpixels )
-			break;
-
-		case 16:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_additions,             Accept-Additions )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( caldav_timezones,             CalDAV-Timezones )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_encoding,             Content-Encoding )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_language,             Content-Language )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_location,             Content-Location )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( memento_datetime,             Memento-Datetime )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( protocol_request,             Protocol-Request )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( www_authenticate,             WWW-Authenticate )
-			break;
-
-		case 17:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_modified_since,            If-Modified-Since )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_instruction,            Proxy-Instruction )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_key,            Sec-WebSocket-Key )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( surrogate_control,            Surrogate-Control )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( transfer_encoding,            Transfer-Encoding )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( resolver_location,            Resolver-Location )
-			break;
-
-		case 18:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_style_type,           Content-Style-Type )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( preference_applied,           Preference-Applied )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_authenticate,           Proxy-Authenticate )
-			break;
-
-		case 19:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( authentication_info,          Authentication-Info )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_disposition,          Content-Disposition )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_script_type,          Content-Script-Type )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_unmodified_since,          If-Unmodified-Since )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_authorization,          Proxy-Authorization )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_user_agent,          X-Device-User-Agent )
-			break;
-
-		case 20:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_accept,         Sec-WebSocket-Accept )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( surrogate_capability,         Surrogate-Capability )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( method_check_expires,         Method-Check-Expires )
-			break;
-
-		case 21:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( apply_to_redirect_ref,        Apply-To-Redirect-Ref )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( if_schedule_tag_match,        If-Schedule-Tag-Match )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_version,        Sec-WebSocket-Version )
-			break;
-
-		case 22:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( authentication_control,       Authentication-Control )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_protocol,       Sec-WebSocket-Protocol )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_max_age,       Access-Control-Max-Age )
-			break;
-
-		case 23:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_accept_charset,      X-Device-Accept-Charset )
-			break;
-
-		case 24:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_extensions,     Sec-WebSocket-Extensions )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_accept_encoding,     X-Device-Accept-Encoding )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_accept_language,     X-Device-Accept-Language )
-			break;
-
-		case 25:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( optional_www_authenticate,    Optional-WWW-Authenticate )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_authentication_info,    Proxy-Authentication-Info )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( strict_transport_security,    Strict-Transport-Security )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( content_transfer_encoding,    Content-Transfer-Encoding )
-			break;
-
-		case 27:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( public_key_pins_report_only,  Public-Key-Pins-Report-Only )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_allow_origin,  Access-Control-Allow-Origin )
-			break;
-
-		case 28:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_allow_headers, Access-Control-Allow-Headers )
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_allow_methods, Access-Control-Allow-Methods )
-			break;
-
-		case 29:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_request_method,    Access-Control-Request-Method )
-			break;
-
-		case 30:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_request_headers,   Access-Control-Request-Headers )
-			break;
-
-		case 32:
-			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_allow_credentials, Access-Control-Allow-Credentials )
-			break;
+		const auto & n = ph::known_names_t<>::items[
+				static_cast< std::size_t >( candidate ) ];
+		if( n.m_size == field_name_size &&
+			ph::is_equal_to_known_name( field_name, n ) )
+			return candidate;
 	}
 
-#undef RESTINIO_HTTP_CHECK_FOR_FIELD
-
 	return http_field_t::field_unspecified;
 }
 
@@ -581,9 +609,12 @@ field_to_string( http_field_t f ) noexcept
 */
 class http_header_field_t
 {
+		friend class http_header_fields_t;
+
 	public:
 		http_header_field_t()
 			:	m_field_id{ http_field_t::field_unspecified }
+			,	m_name_hash{ make_name_hash( m_name ) }
 		{}
 
 		http_header_field_t(
@@ -592,6 +623,7 @@ class http_header_field_t
 			:	m_name{ std::move( name ) }
 			,	m_value{ std::move( value ) }
 			,	m_field_id{ string_to_field( m_name ) }
+			,	m_name_hash{ make_name_hash( m_name ) }
 		{}
 
 		http_header_field_t(
@@ -600,6 +632,7 @@ class http_header_field_t
 			:	m_name{ name.data(), name.size() }
 			,	m_value{ value.data(), value.size() }
 			,	m_field_id{ string_to_field( m_name ) }
+			,	m_name_hash{ make_name_hash( m_name ) }
 		{}
 
 		http_header_field_t(
@@ -608,6 +641,7 @@ class http_header_field_t
 			:	m_name{ field_to_string( field_id ) }
 			,	m_value{ std::move( value ) }
 			,	m_field_id{ field_id }
+			,	m_name_hash{ make_name_hash( m_name ) }
 		{}
 
 		http_header_field_t(
@@ -616,6 +650,7 @@ class http_header_field_t
 			:	m_name{ field_to_string( field_id ) }
 			,	m_value{ std::move( value ) }
 			,	m_field_id{ field_id }
+			,	m_name_hash{ make_name_hash( m_name ) }
 		{}
 
 		const std::string & name() const noexcept { return m_name; }
@@ -627,6 +662,7 @@ class http_header_field_t
 		{
 			m_name = std::move( n );
 			m_field_id = string_to_field( m_name );
+			m_name_hash = make_name_hash( m_name );
 		}
 
 		void
@@ -646,28 +682,317 @@ class http_header_field_t
 		{
 			m_field_id = field_id;
 			m_name = field_to_string( m_field_id );
+			m_name_hash = make_name_hash( m_name );
 		}
 
 	private:
+		//! Make a caseless hash of a name of a field.
+		/*!
+		 * @since v.0.6.18
+		 */
+		static std::uint32_t
+		make_name_hash( const std::string & name ) noexcept
+		{
+			return impl::caseless_hash( string_view_t{ name } );
+		}
+
 		std::string m_name;
 		std::string m_value;
 		http_field_t m_field_id;
+
+		//! Caseless hash of m_name.
+		/*!
+		 * @since v.0.6.18
+		 */
+		std::uint32_t m_name_hash;
 };
 
 // Make neccessary forward declarations.
 class http_header_fields_t;
+struct http_request_header_t;
 namespace impl
 {
 
 void
 append_last_field_accessor( http_header_fields_t &, string_view_t );
 
+void
+add_field_from_spare_accessor(
+	http_header_fields_t &,
+	std::vector< http_header_field_t > &,
+	string_view_t,
+	string_view_t );
+
+void
+recycle_request_header_accessor(
+	http_request_header_t &,
+	std::vector< http_header_field_t > & );
+
 } /* namespace impl */
 
 #if !defined( RESTINIO_HEADER_FIELDS_DEFAULT_RESERVE_COUNT )
 	#define RESTINIO_HEADER_FIELDS_DEFAULT_RESERVE_COUNT 4
 #endif
 
+#if !defined( RESTINIO_HEADER_FIELDS_INDEX_CAPACITY )
+	#define RESTINIO_HEADER_FIELDS_INDEX_CAPACITY 24
+#endif
+
+namespace impl
+{
+
+//
+// header_fields_index_t
+//
+
+//! An index for fields in http_header_fields_t.
+/*!
+ * The index consists of two parts.
+ *
+ * The first one is for fields with known names. It is a bitmap with a bit
+ * for every http_field_t value and a table of positions of the first
+ * occurrences of fields. The table is ordered by field ID, so the position
+ * of a field is found by the count of bits set before the bit of the
+ * field. If there are more than RESTINIO_HEADER_FIELDS_INDEX_CAPACITY
+ * different known fields the table isn't maintained and only the bitmap
+ * is used.
+ *
+ * The second one is an open-addressing hash table for names of fields
+ * (both known and custom). It maps the caseless hash of a name to the
+ * position of the first field with that hash. A lookup by name touches
+ * only that field. If its name is different (that is a collision of
+ * hashes) the search continues from the next field. If there are more
+ * than RESTINIO_HEADER_FIELDS_INDEX_CAPACITY different hashes the table
+ * isn't maintained and fields are searched by a linear scan.
+ *
+ * @since v.0.6.18
+ */
+class header_fields_index_t
+{
+	public:
+		//! The max count of items in tables of the index.
+		static constexpr std::size_t capacity =
+				RESTINIO_HEADER_FIELDS_INDEX_CAPACITY;
+
+		//! Indicator of the absence of a field.
+		static constexpr std::size_t npos = static_cast< std::size_t >( -1 );
+
+		//! Indicator that the position of a field isn't known and
+		//! should be found by a linear search.
+		static constexpr std::size_t unknown_pos = npos - 1u;
+
+		//! Register a field appended to the end of the fields list.
+		void
+		on_field_appended(
+			http_field_t field_id,
+			std::uint32_t name_hash,
+			std::size_t pos ) noexcept
+		{
+			on_name_appended( name_hash, pos );
+
+			if( http_field_t::field_unspecified == field_id || contains( field_id ) )
+				return;
+
+			const auto id = static_cast< std::size_t >( field_id );
+			m_bits[ id / bits_per_word ] |= bit_of( id );
+
+			if( m_overflow )
+				return;
+
+			if( capacity == m_count || pos >= unindexed_pos )
+			{
+				m_overflow = true;
+				return;
+			}
+
+			const std::size_t rank = rank_of( id );
+			for( std::size_t i = m_count; i != rank; --i )
+				m_positions[ i ] = m_positions[ i - 1u ];
+			m_positions[ rank ] = static_cast< std::uint8_t >( pos );
+			++m_count;
+		}
+
+		//! Remove all information from the index.
+		void
+		clear() noexcept
+		{
+			*this = header_fields_index_t{};
+		}
+
+		//! Is there a field with such ID?
+		bool
+		contains( http_field_t field_id ) const noexcept
+		{
+			const auto id = static_cast< std::size_t >( field_id );
+			return 0u != ( m_bits[ id / bits_per_word ] & bit_of( id ) );
+		}
+
+		//! Get the position of the first occurrence of a field.
+		/*!
+		 * @return npos if there is no such field or unknown_pos if
+		 * the field should be found by a linear search.
+		 */
+		std::size_t
+		position_of( http_field_t field_id ) const noexcept
+		{
+			if( http_field_t::field_unspecified == field_id ||
+				!contains( field_id ) )
+				return npos;
+
+			if( m_overflow )
+				return unknown_pos;
+
+			return m_positions[ rank_of( static_cast< std::size_t >( field_id ) ) ];
+		}
+
+		//! Get the position of the first field with such hash of a name.
+		/*!
+		 * @note
+		 * The name of the found field should be checked because different
+		 * names can have the same hash.
+		 *
+		 * @return npos if there is no such field or unknown_pos if
+		 * the field should be found by a linear search.
+		 */
+		std::size_t
+		position_of_name( std::uint32_t name_hash ) const noexcept
+		{
+			if( m_names_overflow )
+				return unknown_pos;
+
+			for( std::size_t i = slot_of( name_hash ); ;
+					i = ( i + 1u ) & ( name_slots_count - 1u ) )
+			{
+				if( 0u == m_name_positions[ i ] )
+					return npos;
+
+				if( name_hash == m_name_hashes[ i ] )
+					return m_name_positions[ i ] - 1u;
+			}
+		}
+
+	private:
+		//! The count of slots in the table of names.
+		/*!
+		 * It's a power of two that is not less than 2*capacity,
+		 * so there are always free slots in the table.
+		 */
+		static constexpr std::size_t name_slots_count =
+				capacity <= 8u ? 16u :
+				capacity <= 16u ? 32u :
+				capacity <= 32u ? 64u :
+				capacity <= 64u ? 128u : 256u;
+
+		static_assert( capacity <= 128u,
+				"RESTINIO_HEADER_FIELDS_INDEX_CAPACITY should not be "
+				"greater than 128" );
+
+		static constexpr std::size_t bits_per_word = 64u;
+		static constexpr std::size_t words_count =
+				( static_cast< std::size_t >( http_field_t::field_unspecified ) +
+					bits_per_word ) / bits_per_word;
+		//! Fields at that and next positions can't be stored in the table.
+		static constexpr std::size_t unindexed_pos = 255u;
+
+		static constexpr std::uint64_t
+		bit_of( std::size_t id ) noexcept
+		{
+			return std::uint64_t{ 1u } << ( id % bits_per_word );
+		}
+
+		static std::size_t
+		popcount( std::uint64_t v ) noexcept
+		{
+#if defined(__POPCNT__)
+			return static_cast< std::size_t >( __builtin_popcountll( v ) );
+#else
+			// NOTE: __builtin_popcountll is a call to a library function
+			// if POPCNT instruction isn't enabled.
+			v = v - ( ( v >> 1 ) & 0x5555555555555555ull );
+			v = ( v & 0x3333333333333333ull ) + ( ( v >> 2 ) & 0x3333333333333333ull );
+			v = ( v + ( v >> 4 ) ) & 0x0F0F0F0F0F0F0F0Full;
+			return static_cast< std::size_t >( ( v * 0x0101010101010101ull ) >> 56 );
+#endif
+		}
+
+		static std::size_t
+		slot_of( std::uint32_t name_hash ) noexcept
+		{
+			return static_cast< std::size_t >( name_hash ^ ( name_hash >> 16 ) ) &
+					( name_slots_count - 1u );
+		}
+
+		//! Register the name of a field appended to the end of the list.
+		void
+		on_name_appended( std::uint32_t name_hash, std::size_t pos ) noexcept
+		{
+			if( m_names_overflow )
+				return;
+
+			std::size_t i = slot_of( name_hash );
+			for( ; 0u != m_name_positions[ i ];
+					i = ( i + 1u ) & ( name_slots_count - 1u ) )
+			{
+				// Only the first field with that hash is stored.
+				if( name_hash == m_name_hashes[ i ] )
+					return;
+			}
+
+			if( capacity == m_names_count || pos >= unindexed_pos )
+			{
+				m_names_overflow = true;
+				return;
+			}
+
+			m_name_hashes[ i ] = name_hash;
+			m_name_positions[ i ] = static_cast< std::uint8_t >( pos + 1u );
+			++m_names_count;
+		}
+
+		//! The count of known fields with IDs less than @a id.
+		std::size_t
+		rank_of( std::size_t id ) const noexcept
+		{
+			const std::size_t word = id / bits_per_word;
+
+			std::size_t result = popcount(
+					m_bits[ word ] & ( bit_of( id ) - 1u ) );
+			for( std::size_t i = 0u; i != word; ++i )
+				result += popcount( m_bits[ i ] );
+
+			return result;
+		}
+
+		//! Bits for present fields.
+		std::uint64_t m_bits[ words_count ] = {};
+
+		//! Positions of first occurrences ordered by field ID.
+		std::uint8_t m_positions[ capacity ] = {};
+
+		//! The count of items in m_positions.
+		std::uint8_t m_count{ 0u };
+
+		//! Is m_positions not maintained anymore?
+		bool m_overflow{ false };
+
+		//! Hashes of names in the table of names.
+		std::uint32_t m_name_hashes[ name_slots_count ] = {};
+
+		//! Positions of first fields with hashes from m_name_hashes.
+		/*!
+		 * Positions are stored plus one, zero means an empty slot.
+		 */
+		std::uint8_t m_name_positions[ name_slots_count ] = {};
+
+		//! The count of items in the table of names.
+		std::uint8_t m_names_count{ 0u };
+
+		//! Is the table of names not maintained anymore?
+		bool m_names_overflow{ false };
+};
+
+} /* namespace impl */
+
 //
 // http_header_fields_t
 //
@@ -704,6 +1029,18 @@ class http_header_fields_t
 		friend void
 		impl::append_last_field_accessor( http_header_fields_t &, string_view_t );
 
+		friend void
+		impl::add_field_from_spare_accessor(
+			http_header_fields_t &,
+			std::vector< http_header_field_t > &,
+			string_view_t,
+			string_view_t );
+
+		friend void
+		impl::recycle_request_header_accessor(
+			http_request_header_t &,
+			std::vector< http_header_field_t > & );
+
 	public:
 		using fields_container_t = std::vector< http_header_field_t >;
 
@@ -747,6 +1084,7 @@ class http_header_fields_t
 		swap_fields( http_header_fields_t & http_header_fields )
 		{
 			std::swap( m_fields, http_header_fields.m_fields );
+			std::swap( m_index, http_header_fields.m_index );
 		}
 
 		//! Check field by name.
@@ -792,7 +1130,7 @@ class http_header_fields_t
 			}
 			else
 			{
-				m_fields.emplace_back( std::move( http_header_field ) );
+				emplace_field( std::move( http_header_field ) );
 			}
 		}
 
@@ -811,7 +1149,7 @@ class http_header_fields_t
 			}
 			else
 			{
-				m_fields.emplace_back(
+				emplace_field(
 					std::move( field_name ),
 					std::move( field_value ) );
 			}
@@ -837,7 +1175,7 @@ class http_header_fields_t
 				}
 				else
 				{
-					m_fields.emplace_back(
+					emplace_field(
 						field_id,
 						std::move( field_value ) );
 				}
@@ -863,7 +1201,7 @@ class http_header_fields_t
 		{
 			if( http_field_t::field_unspecified != field_id )
 			{
-				m_fields.emplace_back(
+				emplace_field(
 					field_id,
 					std::move( field_value ) );
 			}
@@ -883,7 +1221,7 @@ class http_header_fields_t
 			std::string field_name,
 			std::string field_value )
 		{
-			m_fields.emplace_back(
+			emplace_field(
 				std::move( field_name ),
 				std::move( field_value ) );
 		}
@@ -900,7 +1238,7 @@ class http_header_fields_t
 		void
 		add_field( http_header_field_t http_header_field )
 		{
-			m_fields.push_back( std::move(http_header_field) );
+			emplace_field( std::move(http_header_field) );
 		}
 
 		//! Append field with name.
@@ -917,7 +1255,7 @@ class http_header_fields_t
 			}
 			else
 			{
-				m_fields.emplace_back( field_name, field_value );
+				emplace_field( field_name, field_value );
 			}
 		}
 
@@ -941,7 +1279,7 @@ class http_header_fields_t
 				}
 				else
 				{
-					m_fields.emplace_back( field_id, field_value );
+					emplace_field( field_id, field_value );
 				}
 			}
 		}
@@ -1179,6 +1517,7 @@ class http_header_fields_t
 			if( m_fields.end() != it )
 			{
 				m_fields.erase( it );
+				rebuild_index();
 				return true;
 			}
 
@@ -1205,6 +1544,7 @@ class http_header_fields_t
 				if( m_fields.end() != it )
 				{
 					m_fields.erase( it );
+					rebuild_index();
 					return true;
 				}
 			}
@@ -1221,10 +1561,12 @@ class http_header_fields_t
 		std::size_t
 		remove_all_of( string_view_t field_name ) noexcept
 		{
+			const auto hash = impl::caseless_hash( field_name );
+
 			std::size_t count{};
 			for( auto it = m_fields.begin(); it != m_fields.end(); )
 			{
-				if( impl::is_equal_caseless( it->name(), field_name ) )
+				if( is_field_with_name( *it, hash, field_name ) )
 				{
 					it = m_fields.erase( it );
 					++count;
@@ -1233,6 +1575,9 @@ class http_header_fields_t
 					++it;
 			}
 
+			if( count )
+				rebuild_index();
+
 			return count;
 		}
 
@@ -1248,7 +1593,7 @@ class http_header_fields_t
 			std::size_t count{};
 			if( http_field_t::field_unspecified != field_id )
 			{
-				for( auto it = m_fields.begin(); it != m_fields.end(); )
+				for( auto it = find( field_id ); it != m_fields.end(); )
 				{
 					if( it->field_id() == field_id )
 					{
@@ -1258,6 +1603,9 @@ class http_header_fields_t
 					else
 						++it;
 				}
+
+				if( count )
+					rebuild_index();
 			}
 
 			return count;
@@ -1412,11 +1760,11 @@ class http_header_fields_t
 				>::value,
 				"lambda should return restinio::http_header_fields_t::handling_result_t" );
 
-			for( const auto & f : m_fields )
+			for( auto it = cfind( field_id ); it != m_fields.cend(); ++it )
 			{
-				if( field_id == f.field_id() )
+				if( field_id == it->field_id() )
 				{
-					const handling_result_t r = lambda( f.value() );
+					const handling_result_t r = lambda( it->value() );
 					if( stop_enumeration() == r )
 						break;
 				}
@@ -1468,9 +1816,10 @@ class http_header_fields_t
 				>::value,
 				"lambda should return restinio::http_header_fields_t::handling_result_t" );
 
+			const auto hash = impl::caseless_hash( field_name );
 			for( const auto & f : m_fields )
 			{
-				if( impl::is_equal_caseless( f.name(), field_name ) )
+				if( is_field_with_name( f, hash, field_name ) )
 				{
 					const handling_result_t r = lambda( f.value() );
 					if( stop_enumeration() == r )
@@ -1512,51 +1861,164 @@ class http_header_fields_t
 			m_fields.back().append_value( field_value );
 		}
 
+		//! Move all fields to @a spare_fields.
+		/*!
+		 * Memory of names and values of those fields can be reused
+		 * by add_field_from_spare() later.
+		 *
+		 * @since v.0.6.18
+		 */
+		void
+		move_fields_to_spare( fields_container_t & spare_fields )
+		{
+			for( auto & f : m_fields )
+				spare_fields.push_back( std::move( f ) );
+
+			m_fields.clear();
+			m_index.clear();
+		}
+
+		//! Add a new field to the end of the list by using the memory
+		//! of the last item of @a spare_fields.
+		/*!
+		 * @attention
+		 * @a spare_fields shouldn't be empty.
+		 *
+		 * @since v.0.6.18
+		 */
+		void
+		add_field_from_spare(
+			fields_container_t & spare_fields,
+			string_view_t field_name,
+			string_view_t field_value )
+		{
+			auto & f = spare_fields.back();
+			f.m_name.assign( field_name.data(), field_name.size() );
+			f.m_value.assign( field_value.data(), field_value.size() );
+			f.m_field_id = string_to_field( f.m_name );
+			f.m_name_hash = http_header_field_t::make_name_hash( f.m_name );
+
+			emplace_field( std::move( f ) );
+			spare_fields.pop_back();
+		}
+
+		//! Add a new field to the end of the list.
+		/*!
+		 * @since v.0.6.18
+		 */
+		template< typename... Args >
+		void
+		emplace_field( Args && ...args )
+		{
+			m_fields.emplace_back( std::forward< Args >( args )... );
+			m_index.on_field_appended(
+					m_fields.back().field_id(),
+					m_fields.back().m_name_hash,
+					m_fields.size() - 1u );
+		}
+
+		//! Rebuild the index after the removal of fields.
+		/*!
+		 * @since v.0.6.18
+		 */
+		void
+		rebuild_index() noexcept
+		{
+			m_index.clear();
+			for( std::size_t i = 0u; i != m_fields.size(); ++i )
+				m_index.on_field_appended(
+						m_fields[ i ].field_id(),
+						m_fields[ i ].m_name_hash,
+						i );
+		}
+
+		//! Does the field have the specified name?
+		/*!
+		 * Names are compared only if their hashes are equal.
+		 *
+		 * @since v.0.6.18
+		 */
+		static bool
+		is_field_with_name(
+			const http_header_field_t & f,
+			std::uint32_t name_hash,
+			string_view_t field_name ) noexcept
+		{
+			return name_hash == f.m_name_hash &&
+					impl::is_equal_caseless( f.name(), field_name );
+		}
+
 		fields_container_t::iterator
 		find( string_view_t field_name ) noexcept
 		{
-			return std::find_if(
-				m_fields.begin(),
-				m_fields.end(),
-				[&]( const auto & f ){
-					return impl::is_equal_caseless( f.name(), field_name );
-				} );
+			return m_fields.begin() + ( cfind( field_name ) - m_fields.cbegin() );
 		}
 
 		fields_container_t::const_iterator
 		cfind( string_view_t field_name ) const noexcept
 		{
+			const auto hash = impl::caseless_hash( field_name );
+			const auto pos = m_index.position_of_name( hash );
+
+			if( impl::header_fields_index_t::npos == pos )
+				return m_fields.cend();
+
+			std::size_t first_to_scan = 0u;
+			if( impl::header_fields_index_t::unknown_pos != pos )
+			{
+				if( impl::is_equal_caseless( m_fields[ pos ].name(), field_name ) )
+					return m_fields.cbegin() +
+							static_cast< fields_container_t::difference_type >( pos );
+
+				// It's a collision of hashes. There is no field with that
+				// hash before pos.
+				first_to_scan = pos + 1u;
+			}
+
 			return std::find_if(
-				m_fields.cbegin(),
+				m_fields.cbegin() +
+					static_cast< fields_container_t::difference_type >( first_to_scan ),
 				m_fields.cend(),
 				[&]( const auto & f ){
-					return impl::is_equal_caseless( f.name(), field_name );
+					return is_field_with_name( f, hash, field_name );
 				} );
 		}
 
 		fields_container_t::iterator
 		find( http_field_t field_id ) noexcept
 		{
-			return std::find_if(
-				m_fields.begin(),
-				m_fields.end(),
-				[&]( const auto & f ){
-					return f.field_id() == field_id;
-				} );
+			return m_fields.begin() + ( cfind( field_id ) - m_fields.cbegin() );
 		}
 
 		fields_container_t::const_iterator
 		cfind( http_field_t field_id ) const noexcept
 		{
-			return std::find_if(
-				m_fields.cbegin(),
-				m_fields.cend(),
-				[&]( const auto & f ){
-					return f.field_id() == field_id;
-				} );
+			const auto pos = m_index.position_of( field_id );
+
+			if( impl::header_fields_index_t::npos == pos &&
+				http_field_t::field_unspecified != field_id )
+				return m_fields.cend();
+
+			if( impl::header_fields_index_t::npos == pos ||
+				impl::header_fields_index_t::unknown_pos == pos )
+				return std::find_if(
+					m_fields.cbegin(),
+					m_fields.cend(),
+					[&]( const auto & f ){
+						return f.field_id() == field_id;
+					} );
+
+			return m_fields.cbegin() +
+					static_cast< fields_container_t::difference_type >( pos );
 		}
 
 		fields_container_t m_fields;
+
+		//! Index for fields with known names.
+		/*!
+		 * @since v.0.6.18
+		 */
+		impl::header_fields_index_t m_index;
 };
 
 //
@@ -1979,12 +2441,64 @@ struct http_request_header_t final
 		}
 
 	private:
+		friend void
+		impl::recycle_request_header_accessor(
+			http_request_header_t &,
+			std::vector< http_header_field_t > & );
+
 		http_method_id_t m_method{ http_method_get() };
 		std::string m_request_target;
 		std::size_t m_query_separator_pos{ 0 };
 		std::size_t m_fragment_separator_pos{ 0 };
 };
 
+namespace impl
+{
+
+//! Add a field by using the memory of a spare field.
+/*!
+ * @attention
+ * @a spare_fields shouldn't be empty.
+ *
+ * @since v.0.6.18
+ */
+inline void
+add_field_from_spare_accessor(
+	http_header_fields_t & fields,
+	std::vector< http_header_field_t > & spare_fields,
+	string_view_t field_name,
+	string_view_t field_value )
+{
+	fields.add_field_from_spare( spare_fields, field_name, field_value );
+}
+
+//! Bring a request header to the default state but keep the memory
+//! of the request target and of fields for the next request.
+/*!
+ * Fields are moved to @a spare_fields.
+ *
+ * @since v.0.6.18
+ */
+inline void
+recycle_request_header_accessor(
+	http_request_header_t & header,
+	std::vector< http_header_field_t > & spare_fields )
+{
+	header.move_fields_to_spare( spare_fields );
+
+	header.http_major( 1u );
+	header.http_minor( 1u );
+	header.content_length( 0u );
+	header.connection( http_connection_header_t::close );
+
+	header.m_method = http_method_get();
+	header.m_request_target.clear();
+	header.m_query_separator_pos = 0u;
+	header.m_fragment_separator_pos = 0u;
+}
+
+} /* namespace impl */
+
 //
 // http_status_code_t
 //
@@ -2373,8 +2887,36 @@ struct http_response_header_t final
 			m_status_line = std::move( sl );
 		}
 
+		//! Should a cached `Date` field be added to the response?
+		/*!
+		 * If this flag is set and there is no explicitly set `Date` field
+		 * then the pre-formatted value of the current time is written
+		 * during the serialization of the header.
+		 *
+		 * @since v.0.6.18
+		 */
+		//! \{
+		void
+		use_cached_date_field( bool v ) noexcept
+		{
+			m_use_cached_date_field = v;
+		}
+
+		bool
+		use_cached_date_field() const noexcept
+		{
+			return m_use_cached_date_field;
+		}
+		//! \}
+
 	private:
 		http_status_line_t m_status_line;
+
+		//! Should a cached `Date` field be added?
+		/*!
+		 * @since v.0.6.18
+		 */
+		bool m_use_cached_date_field{ false };
 };
 
 } /* namespace restinio */
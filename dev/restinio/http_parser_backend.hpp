@@ -0,0 +1,138 @@
+/*
+	restinio
+*/
+
+/*!
+	Backends for parsing of incoming HTTP requests.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/impl/simd_http_parser.hpp>
+
+#include <http_parser.h>
+
+#include <cstddef>
+
+namespace restinio
+{
+
+//
+// nodejs_http_parser_backend_t
+//
+
+//! A backend that uses nodejs/http_parser for parsing of requests.
+/*!
+ * A backend is created for every connection. It should have
+ * the following methods:
+ * @code
+ * // Prepare for parsing of a new request.
+ * void reset( http_parser & parser );
+ *
+ * // Parse a portion of data, return the count of consumed bytes.
+ * std::size_t execute(
+ * 	http_parser & parser,
+ * 	const http_parser_settings & settings,
+ * 	const char * data,
+ * 	std::size_t length );
+ * @endcode
+ * The results of parsing should be stored into @a parser and reported
+ * via callbacks from @a settings in the same way as
+ * http_parser_execute() does it.
+ *
+ * @since v.0.6.18
+ */
+class nodejs_http_parser_backend_t
+{
+	public:
+		void
+		reset( http_parser & parser ) noexcept
+		{
+			http_parser_init( &parser, HTTP_REQUEST );
+		}
+
+		std::size_t
+		execute(
+			http_parser & parser,
+			const http_parser_settings & settings,
+			const char * data,
+			std::size_t length )
+		{
+			return http_parser_execute( &parser, &settings, data, length );
+		}
+};
+
+//
+// simd_http_parser_backend_t
+//
+
+//! A backend that uses in-tree parser with SIMD scanning of data.
+/*!
+ * The parser scans request targets and values of fields by 32 bytes
+ * if AVX2 is available, then by 16 bytes if SSE2 is available and then
+ * byte by byte.
+ *
+ * `-mavx2` isn't required for AVX2 scanning. If AVX2 isn't enabled at
+ * compile time GCC and clang on x86 compile the AVX2 version with target
+ * options anyway (RESTINIO_SIMD_HTTP_PARSER_RUNTIME_DISPATCH is defined
+ * in that case) and use it only if `__builtin_cpu_supports("avx2")`
+ * says the CPU supports AVX2. The check is made once.
+ * Define RESTINIO_SIMD_HTTP_PARSER_NO_RUNTIME_DISPATCH to use only
+ * instruction sets that are enabled at compile time.
+ * Define RESTINIO_SIMD_HTTP_PARSER_SCALAR_ONLY to disable SIMD at all.
+ *
+ * Usage:
+ * @code
+ * struct my_traits : public restinio::default_traits_t {
+ * 	using http_parser_backend_t = restinio::simd_http_parser_backend_t;
+ * };
+ * @endcode
+ *
+ * See impl::simd_http_parser::parser_t for the differences from
+ * nodejs/http_parser.
+ *
+ * @since v.0.6.18
+ */
+class simd_http_parser_backend_t
+{
+	public:
+		void
+		reset( http_parser & parser ) noexcept
+		{
+			m_parser.reset( parser );
+		}
+
+		std::size_t
+		execute(
+			http_parser & parser,
+			const http_parser_settings & settings,
+			const char * data,
+			std::size_t length )
+		{
+			return m_parser.execute( parser, settings, data, length );
+		}
+
+	private:
+		impl::simd_http_parser::parser_t m_parser;
+};
+
+//
+// default_http_parser_backend_t
+//
+
+//! The backend used by default traits.
+/*!
+ * It's nodejs_http_parser_backend_t, but simd_http_parser_backend_t
+ * is used if RESTINIO_USE_SIMD_HTTP_PARSER_BY_DEFAULT is defined.
+ *
+ * @since v.0.6.18
+ */
+#if defined( RESTINIO_USE_SIMD_HTTP_PARSER_BY_DEFAULT )
+using default_http_parser_backend_t = simd_http_parser_backend_t;
+#else
+using default_http_parser_backend_t = nodejs_http_parser_backend_t;
+#endif
+
+} /* namespace restinio */
@@ -12,6 +12,7 @@
 #include <restinio/impl/ioctx_on_thread_pool.hpp>
 
 #include <restinio/http_server.hpp>
+#include <restinio/sharded_http_server.hpp>
 
 namespace restinio
 {
@@ -686,6 +687,209 @@ initiate_shutdown( http_server_t<Traits> & server )
 		} );
 }
 
+/*!
+ * @brief Helper function for initiation of shutdown of a sharded server.
+ *
+ * @since v.0.6.18
+ */
+template<typename Traits>
+inline void
+initiate_shutdown( sharded_http_server_t<Traits> & server )
+{
+	server.stop();
+}
+
+//
+// run_on_sharded_threads_settings_t
+//
+/*!
+ * @brief Parameters for running HTTP-server in sharded mode.
+ *
+ * @note This class is not intended for direct use. It is used by
+ * RESTinio itself. Use on_sharded_threads() function instead.
+ *
+ * @since v.0.6.18
+ */
+template<typename Traits, typename Configurator>
+class run_on_sharded_threads_settings_t
+{
+	//! Count of shards.
+	std::size_t m_shards_count;
+	//! Should break signal handler be used?
+	break_signal_handling_t m_break_handling;
+	//! Configurator for settings of every shard.
+	Configurator m_configurator;
+	//! An optional hook for threads of shards.
+	sharded_thread_init_hook_t m_thread_init_hook;
+
+public:
+	//! Initializing constructor.
+	run_on_sharded_threads_settings_t(
+		std::size_t shards_count,
+		break_signal_handling_t break_handling,
+		Configurator configurator )
+		:	m_shards_count{ shards_count }
+		,	m_break_handling{ break_handling }
+		,	m_configurator{ std::move(configurator) }
+	{}
+
+	std::size_t
+	shards_count() const noexcept { return m_shards_count; }
+
+	break_signal_handling_t
+	break_handling() const noexcept { return m_break_handling; }
+
+	Configurator &
+	configurator() noexcept { return m_configurator; }
+
+	//! Set a hook for threads of shards.
+	/*!
+	 * Usage example:
+	 * \code
+	 * run( restinio::on_sharded_threads( 4, configurator )
+	 * 	.thread_init_hook( restinio::pin_shard_threads_to_cpus() ) );
+	 * \endcode
+	 *
+	 * @see sharded_http_server_t::thread_init_hook()
+	 */
+	run_on_sharded_threads_settings_t &&
+	thread_init_hook( sharded_thread_init_hook_t hook ) &&
+	{
+		m_thread_init_hook = std::move( hook );
+		return std::move( *this );
+	}
+
+	sharded_thread_init_hook_t &
+	thread_init_hook() noexcept { return m_thread_init_hook; }
+};
+
+//
+// on_sharded_threads
+//
+/*!
+ * @brief A special marker for the case when http_server must be
+ * run in sharded mode.
+ *
+ * In sharded mode there are several independent instances of
+ * HTTP-server. Every instance has own io_context that is run on
+ * a dedicated thread and own acceptor bound with SO_REUSEPORT
+ * (see sharded_http_server_t for more details).
+ *
+ * Usage example:
+ * \code
+ * run( restinio::on_sharded_threads(
+ * 	std::thread::hardware_concurrency(),
+ * 	[]( std::size_t shard_index, auto & settings ) {
+ * 		settings
+ * 			.port(8080)
+ * 			.address("localhost")
+ * 			.request_handler(...);
+ * 	} ) );
+ * \endcode
+ * For a case when some custom traits must be used:
+ * \code
+ * run( restinio::on_sharded_threads<my_server_traits_t>( 16, ... ) );
+ * \endcode
+ *
+ * @note
+ * default_single_thread_traits_t is used by default because
+ * connections in sharded mode never migrate between threads.
+ *
+ * @since v.0.6.18
+ */
+template<
+	typename Traits = default_single_thread_traits_t,
+	typename Configurator >
+run_on_sharded_threads_settings_t< Traits, std::decay_t<Configurator> >
+on_sharded_threads(
+	//! Count of shards.
+	std::size_t shards_count,
+	//! Configurator for settings of every shard.
+	Configurator && configurator )
+{
+	return {
+			shards_count,
+			break_signal_handling_t::used,
+			std::forward<Configurator>(configurator) };
+}
+
+/*!
+ * @brief A special marker for the case when http_server must be
+ * run in sharded mode with explicit specification of break
+ * signals handling.
+ *
+ * Usage example:
+ * \code
+ * run( restinio::on_sharded_threads(
+ * 	std::thread::hardware_concurrency(),
+ * 	restinio::skip_break_signal_handling(),
+ * 	[]( std::size_t shard_index, auto & settings ) {...} ) );
+ * \endcode
+ *
+ * @since v.0.6.18
+ */
+template<
+	typename Traits = default_single_thread_traits_t,
+	typename Configurator >
+run_on_sharded_threads_settings_t< Traits, std::decay_t<Configurator> >
+on_sharded_threads(
+	//! Count of shards.
+	std::size_t shards_count,
+	//! Should break signal handler be used?
+	break_signal_handling_t break_handling,
+	//! Configurator for settings of every shard.
+	Configurator && configurator )
+{
+	return {
+			shards_count,
+			break_handling,
+			std::forward<Configurator>(configurator) };
+}
+
+//! Helper function for running http server in sharded mode
+//! until ctrl+c is hit.
+/*!
+ * Usage example:
+ * \code
+ * restinio::run(
+ * 		restinio::on_sharded_threads<my_traits>(
+ * 			16,
+ * 			[]( std::size_t, auto & settings ) {
+ * 				settings
+ * 					.port(8080)
+ * 					.address("localhost")
+ * 					.request_handler([](auto req) {...});
+ * 			} ) );
+ * \endcode
+ *
+ * @since v.0.6.18
+ */
+template<typename Traits, typename Configurator>
+inline void
+run( run_on_sharded_threads_settings_t<Traits, Configurator> && params )
+{
+	sharded_http_server_t<Traits> server{
+			params.shards_count(),
+			params.configurator() };
+	server.thread_init_hook( std::move( params.thread_init_hook() ) );
+
+	// The signal set is bound to the first shard's io_context.
+	// The handler stops all shards.
+	asio_ns::signal_set break_signals{ server.shard( 0u ).io_context() };
+	if( break_signal_handling_t::used == params.break_handling() )
+	{
+		break_signals.add( SIGINT );
+		break_signals.async_wait(
+			[&server]( const asio_ns::error_code & ec, int ){
+				if( !ec )
+					server.stop();
+			} );
+	}
+
+	server.start();
+	server.wait();
+}
+
 //
 // on_pool_runner_t
 //
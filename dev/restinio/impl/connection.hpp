@@ -23,6 +23,8 @@
 #include <restinio/impl/response_coordinator.hpp>
 #include <restinio/impl/connection_settings.hpp>
 #include <restinio/impl/fixed_buffer.hpp>
+#include <restinio/impl/request_arena.hpp>
+#include <restinio/impl/request_storage_recycler.hpp>
 #include <restinio/impl/write_group_output_ctx.hpp>
 #include <restinio/impl/executor_wrapper.hpp>
 #include <restinio/impl/sendfile_operation.hpp>
@@ -51,8 +53,32 @@ struct http_parser_ctx_t
 	//! \{
 	http_request_header_t m_header;
 	std::string m_body;
+
+	/*!
+	 * @brief Slices of the body if zero-copy body mode is used.
+	 *
+	 * @since v.0.6.18
+	 */
+	request_body_slices_t m_body_slices;
 	//! \}
 
+	/*!
+	 * @brief The slot from that the memory of a destroyed request
+	 * is taken for the next request.
+	 *
+	 * It's present only if traits_t::use_request_arena is true.
+	 *
+	 * @since v.0.6.18
+	 */
+	std::shared_ptr< request_storage_recycler_t > m_storage_recycler;
+
+	/*!
+	 * @brief Fields of a destroyed request whose memory can be reused.
+	 *
+	 * @since v.0.6.18
+	 */
+	std::vector< http_header_field_t > m_spare_fields;
+
 	//! Parser context temp values and flags.
 	//! \{
 	std::string m_current_field_name;
@@ -90,28 +116,156 @@ struct http_parser_ctx_t
 	 */
 	const incoming_http_msg_limits_t m_limits;
 
+	/*!
+	 * @brief Should the body be collected as slices of read buffers?
+	 *
+	 * @since v.0.6.18
+	 */
+	const bool m_zero_copy_body;
+
+	/*!
+	 * @brief The buffer from that the parser takes data.
+	 *
+	 * Slices of the body are pointed into this buffer in zero-copy mode.
+	 *
+	 * @since v.0.6.18
+	 */
+	const fixed_buffer_t * m_read_buffer{ nullptr };
+
+	/*!
+	 * @brief Should the parsing be paused after the header to
+	 * give a chance to create a body stream handler?
+	 *
+	 * @since v.0.6.18
+	 */
+	const bool m_check_body_stream;
+
+	/*!
+	 * @brief The parsing is paused right after the header.
+	 *
+	 * @since v.0.6.18
+	 */
+	bool m_paused_after_headers{ false };
+
+	/*!
+	 * @brief Handler for streamed body.
+	 *
+	 * If it is present the body isn't collected in m_body.
+	 *
+	 * @since v.0.6.18
+	 */
+	request_body_stream_handler_unique_ptr_t m_body_stream_handler;
+
+	/*!
+	 * @brief Total size of parts passed to m_body_stream_handler.
+	 *
+	 * @since v.0.6.18
+	 */
+	std::size_t m_streamed_body_size{ 0u };
+
+	/*!
+	 * @brief The parsing is paused by m_body_stream_handler.
+	 *
+	 * @since v.0.6.18
+	 */
+	bool m_body_reading_paused{ false };
+
 	/*!
 	 * @brief The main constructor.
 	 *
 	 * @since v.0.6.12
 	 */
 	http_parser_ctx_t(
-		incoming_http_msg_limits_t limits )
+		incoming_http_msg_limits_t limits,
+		bool zero_copy_body = false,
+		bool check_body_stream = false )
 		:	m_limits{ limits }
+		,	m_zero_copy_body{ zero_copy_body }
+		,	m_check_body_stream{ check_body_stream }
 	{}
 
+	/*!
+	 * @brief Get the size of the body collected so far.
+	 *
+	 * @since v.0.6.18
+	 */
+	RESTINIO_NODISCARD
+	std::size_t
+	body_size() const noexcept
+	{
+		if( m_body_stream_handler )
+			return m_streamed_body_size;
+
+		return m_zero_copy_body ? m_body_slices.size() : m_body.size();
+	}
+
+	/*!
+	 * @brief Check the size of the body and prepare the storage for it.
+	 *
+	 * @return false if the body is too big.
+	 *
+	 * @since v.0.6.18
+	 */
+	RESTINIO_NODISCARD
+	bool
+	prepare_body_storage( std::uint64_t content_length )
+	{
+		// Maximum body size can be checked right now.
+		if( content_length > m_limits.max_body_size() )
+			return false;
+
+		// There is no need to reserve anything if the body is
+		// collected as slices of read buffers.
+		if( !m_zero_copy_body )
+			m_body.reserve(
+					::restinio::utils::impl::uint64_to_size_t( content_length ) );
+
+		return true;
+	}
+
+	/*!
+	 * @brief Append a part of the body.
+	 *
+	 * In zero-copy mode @a at must point into m_read_buffer.
+	 *
+	 * @since v.0.6.18
+	 */
+	void
+	append_body( const char * at, std::size_t length )
+	{
+		if( m_zero_copy_body )
+			m_body_slices.append( request_body_slice_t{
+					m_read_buffer->share_block(),
+					string_view_t{ at, length } } );
+		else
+			m_body.append( at, length );
+	}
+
 	//! Prepare context to handle new request.
 	void
 	reset()
 	{
-		m_header = http_request_header_t{};
+		if( m_storage_recycler )
+		{
+			// The memory of the previous request is reused if that
+			// request is already destroyed.
+			m_storage_recycler->take( m_header, m_body );
+			recycle_request_header_accessor( m_header, m_spare_fields );
+		}
+		else
+			m_header = http_request_header_t{};
 		m_body.clear();
+		m_body_slices.clear();
 		m_current_field_name.clear();
 		m_last_value_total_size = 0u;
 		m_last_was_value = true;
 		m_leading_headers_completed = false;
 		m_message_complete = false;
 		m_total_field_count = 0u;
+		m_paused_after_headers = false;
+		m_body_stream_handler.reset();
+		m_streamed_body_size = 0u;
+		m_body_reading_paused = false;
 	}
 
 	//! Creates an instance of chunked_input_info if there is an info
@@ -171,7 +325,7 @@ create_parser_settings() noexcept
 
 	parser_settings.on_headers_complete =
 		[]( http_parser * parser ) -> int {
-			return restinio_headers_complete_cb( parser );
+			return restinio_headers_complete_cb< Http_Methods >( parser );
 		};
 
 	parser_settings.on_body =
@@ -222,19 +376,26 @@ enum class connection_upgrade_stage_t : std::uint8_t
 //
 
 //! Data associated with connection read routine.
+template< typename Http_Parser_Backend >
 struct connection_input_t
 {
 	connection_input_t(
 		std::size_t buffer_size,
-		incoming_http_msg_limits_t limits )
-		:	m_parser_ctx{ limits }
-		,	m_buf{ buffer_size }
-	{}
+		incoming_http_msg_limits_t limits,
+		bool zero_copy_body = false,
+		read_buffer_pool_t * read_buffer_pool = nullptr,
+		bool check_body_stream = false )
+		:	m_parser_ctx{ limits, zero_copy_body, check_body_stream }
+		,	m_buf{ buffer_size, read_buffer_pool }
+	{
+		m_parser_ctx.m_read_buffer = &m_buf;
+	}
 
 	//! HTTP-parser.
 	//! \{
 	http_parser m_parser;
 	http_parser_ctx_t m_parser_ctx;
+	Http_Parser_Backend m_parser_backend;
 	//! \}
 
 	//! Input buffer.
@@ -247,12 +408,30 @@ struct connection_input_t
 	//! Flag to track whether read operation is performed now.
 	bool m_read_operation_is_running{ false };
 
+	//! Is the connection waiting for the first bytes of the next request?
+	/*!
+	 * @since v.0.6.18
+	 */
+	bool m_waiting_for_next_message{ false };
+
+	//! Was the connection found idle by the previous timeout check?
+	/*!
+	 * @since v.0.6.18
+	 */
+	bool m_idle_detected{ false };
+
+	//! Was the current read operation cancelled to release the read buffer?
+	/*!
+	 * @since v.0.6.18
+	 */
+	bool m_read_cancelled_for_idle{ false };
+
 	//! Prepare parser for reading new http-message.
 	void
 	reset_parser()
 	{
 		// Reinit parser.
-		http_parser_init( &m_parser, HTTP_REQUEST);
+		m_parser_backend.reset( m_parser );
 
 		// Reset context and attach it to parser.
 		m_parser_ctx.reset();
@@ -328,21 +507,29 @@ class connection_t final
 			endpoint_t remote_endpoint,
 			//! Lifetime monitor to be used for handling connection count.
 			lifetime_monitor_t lifetime_monitor )
-			:	connection_base_t{ conn_id }
+			:	connection_base_t{ conn_id, settings->m_add_date_field }
 			,	executor_wrapper_base_t{ socket.get_executor() }
 			,	m_socket{ std::move( socket ) }
 			,	m_settings{ std::move( settings ) }
 			,	m_remote_endpoint{ std::move( remote_endpoint ) }
 			,	m_input{
 					m_settings->m_buffer_size,
-					m_settings->m_incoming_http_msg_limits
+					m_settings->m_incoming_http_msg_limits,
+					Traits::use_zero_copy_request_body,
+					m_settings->m_read_buffer_pool.get(),
+					static_cast< bool >(
+							m_settings->m_request_body_stream_handler_factory )
 				}
+			,	m_write_output_ctx{ m_settings->m_max_coalesced_write_size }
 			,	m_response_coordinator{ m_settings->m_max_pipelined_requests }
 			,	m_timer_guard{ m_settings->create_timer_guard() }
 			,	m_request_handler{ *( m_settings->m_request_handler ) }
 			,	m_logger{ *( m_settings->m_logger ) }
 			,	m_lifetime_monitor{ std::move(lifetime_monitor) }
 		{
+			m_input.m_parser_ctx.m_storage_recycler = make_storage_recycler(
+					std::integral_constant< bool, Traits::use_request_arena >{} );
+
 			// Notify of a new connection instance.
 			m_logger.trace( [&]{
 					return fmt::format(
@@ -436,6 +623,18 @@ class connection_t final
 			}
 			else
 			{
+				// If pooling is used and the socket allows to wait for
+				// incoming data the read buffer is returned to the pool
+				// here and is taken back only when some data arrives
+				// (see consume_message()). Otherwise it is released only
+				// if the connection stays without incoming data for a while
+				// (see release_idle_read_buffer()).
+				m_input.m_waiting_for_next_message = true;
+				m_input.m_idle_detected = false;
+				if( can_wait_for_incoming_data_t::value &&
+					!m_input.m_read_operation_is_running )
+					m_input.m_buf.release_block();
+
 				// Next request (if any) must be obtained from socket.
 				consume_message();
 			}
@@ -488,17 +687,12 @@ class connection_t final
 
 
 				m_input.m_read_operation_is_running = true;
-				m_socket.async_read_some(
-					m_input.m_buf.make_asio_buffer(),
-					asio_ns::bind_executor(
-						this->get_executor(),
-						[this, ctx = shared_from_this()]
-						// NOTE: this lambda is noexcept since v.0.6.0.
-						( const asio_ns::error_code & ec,
-							std::size_t length ) noexcept {
-							m_input.m_read_operation_is_running = false;
-							RESTINIO_ENSURE_NOEXCEPT_CALL( after_read( ec, length ) );
-						} ) );
+
+				if( can_wait_for_incoming_data_t::value &&
+					m_input.m_buf.block_released() )
+					start_wait_for_incoming_data( can_wait_for_incoming_data_t{} );
+				else
+					start_read();
 			}
 			else
 			{
@@ -511,6 +705,124 @@ class connection_t final
 			}
 		}
 
+		//! Start a read operation.
+		/*!
+		 * @since v.0.6.18
+		 */
+		void
+		start_read()
+		{
+			auto buffer = m_input.m_buf.make_asio_buffer();
+
+			if( m_input.m_buf.is_peek_read() )
+				m_logger.trace( [&]{
+					return fmt::format(
+							RESTINIO_FMT_FORMAT_STRING(
+								"[connection:{}] read into peek area" ),
+							connection_id() );
+				} );
+
+			m_socket.async_read_some(
+				buffer,
+				asio_ns::bind_executor(
+					this->get_executor(),
+					[this, ctx = shared_from_this()]
+					// NOTE: this lambda is noexcept since v.0.6.0.
+					( const asio_ns::error_code & ec,
+						std::size_t length ) noexcept {
+						m_input.m_read_operation_is_running = false;
+						RESTINIO_ENSURE_NOEXCEPT_CALL( after_read( ec, length ) );
+					} ) );
+		}
+
+		//! Can the connection wait for incoming data without reading it?
+		/*!
+		 * It's possible only for plain TCP sockets. A TLS stream can
+		 * already hold decrypted data of the next request while there is
+		 * nothing to read from the underlying socket.
+		 *
+		 * @since v.0.6.18
+		 */
+		using can_wait_for_incoming_data_t = std::integral_constant< bool,
+				std::is_same< stream_socket_t, asio_ns::ip::tcp::socket >::value >;
+
+		//! Wait for incoming data without a read buffer.
+		/*!
+		 * The read is started when the socket becomes readable.
+		 * So a connection that waits for the next request doesn't hold
+		 * a block from the pool.
+		 *
+		 * @since v.0.6.18
+		 */
+		void
+		start_wait_for_incoming_data( std::true_type )
+		{
+			m_logger.trace( [&]{
+				return fmt::format(
+						RESTINIO_FMT_FORMAT_STRING(
+							"[connection:{}] wait for incoming data" ),
+						connection_id() );
+			} );
+
+			m_socket.async_wait(
+				asio_ns::socket_base::wait_read,
+				asio_ns::bind_executor(
+					this->get_executor(),
+					[this, ctx = shared_from_this()]
+					( const asio_ns::error_code & ec ) noexcept {
+						RESTINIO_ENSURE_NOEXCEPT_CALL(
+								after_wait_for_incoming_data( ec ) );
+					} ) );
+		}
+
+		void
+		start_wait_for_incoming_data( std::false_type )
+		{
+			start_read();
+		}
+
+		//! Handle the result of waiting for incoming data.
+		/*!
+		 * A block is taken from the pool only if there is some data
+		 * to read. If the socket is readable but there is no data
+		 * then the peer has closed the connection (or there is an error).
+		 * It is detected by a read into the peek area, so the block
+		 * isn't taken.
+		 *
+		 * @since v.0.6.18
+		 */
+		void
+		after_wait_for_incoming_data( const asio_ns::error_code & ec ) noexcept
+		{
+			if( ec )
+			{
+				m_input.m_read_operation_is_running = false;
+				after_read( ec, 0u );
+				return;
+			}
+
+			try
+			{
+				asio_ns::error_code available_ec;
+				if( 0u != m_socket.available( available_ec ) )
+					m_input.m_buf.acquire_released_block();
+
+				start_read();
+			}
+			catch( const std::exception & x )
+			{
+				m_input.m_read_operation_is_running = false;
+				trigger_error_and_close( [&] {
+						return fmt::format(
+								RESTINIO_FMT_FORMAT_STRING(
+									"[connection:{}] unable to start read "
+									"operation: {}" ),
+								connection_id(),
+								x.what() );
+					} );
+			}
+		}
+
 		//! Handle read operation result.
 		inline void
 		after_read( const asio_ns::error_code & ec, std::size_t length ) noexcept
@@ -530,6 +842,9 @@ class connection_t final
 								length );
 					} );
 
+					m_input.m_waiting_for_next_message = false;
+					m_input.m_read_cancelled_for_idle = false;
+
 					m_input.m_buf.obtained_bytes( length );
 
 					consume_data( m_input.m_buf.bytes(), length );
@@ -580,10 +895,97 @@ class connection_t final
 						RESTINIO_ENSURE_NOEXCEPT_CALL( close() );
 					}
 				}
+				else if( m_input.m_read_cancelled_for_idle )
+				{
+					// The read was cancelled by release_idle_read_buffer().
+					m_input.m_read_cancelled_for_idle = false;
+					if( m_socket.is_open() )
+						restart_read_without_block();
+				}
 				// else: read operation was cancelled.
 			}
 		}
 
+		//! Release the read buffer and start the read into the peek area.
+		/*!
+		 * @since v.0.6.18
+		 */
+		void
+		restart_read_without_block() noexcept
+		{
+			try
+			{
+				m_input.m_buf.release_block();
+				consume_message();
+			}
+			catch( const std::exception & x )
+			{
+				trigger_error_and_close( [&] {
+						return fmt::format(
+								RESTINIO_FMT_FORMAT_STRING(
+									"[connection:{}] unable to restart read "
+									"operation: {}" ),
+								connection_id(),
+								x.what() );
+					} );
+			}
+		}
+
+		//! Release the read buffer if the connection is idle.
+		/*!
+		 * The connection is treated as idle if it is waiting for
+		 * the next request and no data has arrived since the previous
+		 * timeout check. The pending read operation is cancelled because
+		 * it is writing to the block. The read is restarted
+		 * into the peek area when the cancellation is completed.
+		 *
+		 * This work is done only on timeout checks, so a keep-alive
+		 * connection that receives requests one by one keeps its block.
+		 *
+		 * It's necessary only for sockets that can't wait for incoming
+		 * data without reading it (see can_wait_for_incoming_data_t).
+		 * Other connections don't hold a block while waiting for the
+		 * next request.
+		 *
+		 * @since v.0.6.18
+		 */
+		void
+		release_idle_read_buffer()
+		{
+			auto & input = m_input;
+			if( !input.m_buf.has_pool() ||
+				!input.m_buf.has_block() ||
+				!input.m_read_operation_is_running ||
+				!input.m_waiting_for_next_message ||
+				input.m_read_cancelled_for_idle ||
+				!m_response_coordinator.empty() ||
+				m_write_output_ctx.transmitting() )
+			{
+				input.m_idle_detected = false;
+				return;
+			}
+
+			if( !input.m_idle_detected )
+			{
+				// Give the connection one more check period.
+				input.m_idle_detected = true;
+				return;
+			}
+
+			m_logger.trace( [&]{
+				return fmt::format(
+						RESTINIO_FMT_FORMAT_STRING(
+							"[connection:{}] release idle read buffer" ),
+						connection_id() );
+			} );
+
+			input.m_idle_detected = false;
+			input.m_read_cancelled_for_idle = true;
+
+			asio_ns::error_code ignored_ec;
+			m_socket.cancel( ignored_ec );
+		}
+
 		//! Parse some data.
 		void
 		consume_data( const char * data, std::size_t length )
@@ -591,9 +993,9 @@ class connection_t final
 			auto & parser = m_input.m_parser;
 
 			const auto nparsed =
-				http_parser_execute(
-					&parser,
-					&( m_settings->m_parser_settings ),
+				m_input.m_parser_backend.execute(
+					parser,
+					m_settings->m_parser_settings,
 					data,
 					length );
 
@@ -628,8 +1030,156 @@ class connection_t final
 			{
 				on_request_message_complete();
 			}
+			else if( m_input.m_parser_ctx.m_paused_after_headers )
+			{
+				on_request_headers_complete();
+			}
+			else if( m_input.m_parser_ctx.m_body_reading_paused )
+			{
+				m_logger.trace( [&]{
+					return fmt::format(
+							RESTINIO_FMT_FORMAT_STRING(
+								"[connection:{}] reading of request body is paused" ),
+							connection_id() );
+				} );
+
+				// The body stream handler has control now.
+				guard_request_handling_operation();
+			}
 			else
+			{
+				// The time limit for a streamed body is applied to
+				// every read operation, not to the whole message.
+				if( m_input.m_parser_ctx.m_body_stream_handler )
+					guard_read_operation();
+
 				consume_message();
+			}
+		}
+
+		//! Continue parsing of data after a pause.
+		/*!
+		 * @since v.0.6.18
+		 */
+		void
+		continue_paused_parsing()
+		{
+			http_parser_pause( &m_input.m_parser, 0 );
+
+			if( 0 != m_input.m_buf.length() )
+				consume_data( m_input.m_buf.bytes(), m_input.m_buf.length() );
+			else
+				consume_message();
+		}
+
+		//! Handle the parsed header of a request.
+		/*!
+		 * Is called only if a factory of body stream handlers is set.
+		 *
+		 * @since v.0.6.18
+		 */
+		void
+		on_request_headers_complete()
+		{
+			auto & parser_ctx = m_input.m_parser_ctx;
+			parser_ctx.m_paused_after_headers = false;
+
+			parser_ctx.m_body_stream_handler =
+				m_settings->m_request_body_stream_handler_factory(
+					parser_ctx.m_header,
+					request_body_stream_control_t{
+						shared_from_concrete< connection_base_t >() } );
+
+			if( parser_ctx.m_body_stream_handler )
+			{
+				m_logger.trace( [&]{
+					return fmt::format(
+							RESTINIO_FMT_FORMAT_STRING(
+								"[connection:{}] request body will be streamed: {} {}" ),
+							connection_id(),
+							http_method_str(
+								static_cast<http_method>( m_input.m_parser.method ) ),
+							parser_ctx.m_header.request_target() );
+				} );
+			}
+			else
+			{
+				// The body will be collected in memory.
+				const auto content_length = m_input.m_parser.content_length;
+				if( ULLONG_MAX != content_length &&
+					0 < content_length &&
+					!parser_ctx.prepare_body_storage( content_length ) )
+				{
+					trigger_error_and_close( [&]{
+						return fmt::format(
+								RESTINIO_FMT_FORMAT_STRING(
+									"[connection:{}] request body is too big: {}" ),
+								connection_id(),
+								content_length );
+					} );
+
+					return;
+				}
+			}
+
+			continue_paused_parsing();
+		}
+
+		//! Resume reading of a streamed body.
+		/*!
+		 * @since v.0.6.18
+		 */
+		void
+		resume_request_body_reading() override
+		{
+			asio_ns::post(
+				this->get_executor(),
+				[ this, ctx = shared_from_this() ]
+				() noexcept
+				{
+					try
+					{
+						resume_request_body_reading_impl();
+					}
+					catch( const std::exception & ex )
+					{
+						trigger_error_and_close( [&]{
+							return fmt::format(
+								RESTINIO_FMT_FORMAT_STRING(
+									"[connection:{}] unable to resume reading of "
+									"request body: {}" ),
+								connection_id(),
+								ex.what() );
+						} );
+					}
+				} );
+		}
+
+		//! Resume reading of a streamed body on the context of the connection.
+		/*!
+		 * @since v.0.6.18
+		 */
+		void
+		resume_request_body_reading_impl()
+		{
+			auto & parser_ctx = m_input.m_parser_ctx;
+
+			// The connection can already be closed or the resume
+			// can be called twice.
+			if( !parser_ctx.m_body_reading_paused )
+				return;
+
+			parser_ctx.m_body_reading_paused = false;
+
+			m_logger.trace( [&]{
+				return fmt::format(
+						RESTINIO_FMT_FORMAT_STRING(
+							"[connection:{}] reading of request body is resumed" ),
+						connection_id() );
+			} );
+
+			guard_read_operation();
+			continue_paused_parsing();
 		}
 
 		//! Handle a given request message.
@@ -676,15 +1226,7 @@ class connection_t final
 					guard_request_handling_operation();
 
 					const auto handling_result =
-						m_request_handler(
-							std::make_shared< generic_request_t >(
-								request_id,
-								std::move( parser_ctx.m_header ),
-								std::move( parser_ctx.m_body ),
-								parser_ctx.make_chunked_input_info_if_necessary(),
-								shared_from_concrete< connection_base_t >(),
-								m_remote_endpoint,
-								m_settings->extra_data_factory() ) );
+						m_request_handler( make_request_object( request_id ) );
 
 					switch( handling_result )
 					{
@@ -766,6 +1308,96 @@ class connection_t final
 			}
 		}
 
+		//! Create a request object from the data in input context.
+		/*!
+		 * @since v.0.6.18
+		 */
+		std::shared_ptr< generic_request_t >
+		make_request_object( request_id_t request_id )
+		{
+			auto & parser_ctx = m_input.m_parser_ctx;
+
+			std::shared_ptr< generic_request_t > result;
+
+			if( parser_ctx.m_zero_copy_body )
+				result = make_request_shared(
+						request_id,
+						std::move( parser_ctx.m_header ),
+						std::move( parser_ctx.m_body_slices ),
+						parser_ctx.make_chunked_input_info_if_necessary(),
+						shared_from_concrete< connection_base_t >(),
+						m_remote_endpoint,
+						m_settings->extra_data_factory() );
+			else
+				result = make_request_shared(
+						request_id,
+						std::move( parser_ctx.m_header ),
+						std::move( parser_ctx.m_body ),
+						parser_ctx.make_chunked_input_info_if_necessary(),
+						shared_from_concrete< connection_base_t >(),
+						m_remote_endpoint,
+						m_settings->extra_data_factory() );
+
+			if( parser_ctx.m_body_stream_handler )
+				attach_body_stream_handler(
+						*result,
+						std::move( parser_ctx.m_body_stream_handler ) );
+
+			if( parser_ctx.m_storage_recycler )
+				attach_storage_recycler( *result, parser_ctx.m_storage_recycler );
+
+			return result;
+		}
+
+		//! Create a request object by std::make_shared or in the arena.
+		/*!
+		 * @since v.0.6.18
+		 */
+		template< typename... Args >
+		std::shared_ptr< generic_request_t >
+		make_request_shared( Args && ...args )
+		{
+			return make_request_shared_impl(
+					std::integral_constant< bool, Traits::use_request_arena >{},
+					std::forward< Args >( args )... );
+		}
+
+		template< typename... Args >
+		std::shared_ptr< generic_request_t >
+		make_request_shared_impl( std::false_type, Args && ...args )
+		{
+			return std::make_shared< generic_request_t >(
+					std::forward< Args >( args )... );
+		}
+
+		template< typename... Args >
+		std::shared_ptr< generic_request_t >
+		make_request_shared_impl( std::true_type, Args && ...args )
+		{
+			return std::allocate_shared< generic_request_t >(
+					request_arena_allocator_t< generic_request_t >{
+							m_request_arena },
+					std::forward< Args >( args )... );
+		}
+
+		//! Create the slot for reusing the memory of requests.
+		/*!
+		 * It's created only if the arena for request objects is used.
+		 *
+		 * @since v.0.6.18
+		 */
+		static std::shared_ptr< request_storage_recycler_t >
+		make_storage_recycler( std::false_type )
+		{
+			return {};
+		}
+
+		static std::shared_ptr< request_storage_recycler_t >
+		make_storage_recycler( std::true_type )
+		{
+			return std::make_shared< request_storage_recycler_t >();
+		}
+
 		//! Calls handler for upgrade request.
 		/*!
 			Request data must be in input context (m_input).
@@ -802,14 +1434,7 @@ class connection_t final
 				connection_upgrade_stage_t::wait_for_upgrade_handling_result_or_nothing;
 
 			const auto handling_result = m_request_handler(
-				std::make_shared< generic_request_t >(
-					request_id,
-					std::move( parser_ctx.m_header ),
-					std::move( parser_ctx.m_body ),
-					parser_ctx.make_chunked_input_info_if_necessary(),
-					shared_from_concrete< connection_base_t >(),
-					m_remote_endpoint,
-					m_settings->extra_data_factory() ) );
+					make_request_object( request_id ) );
 			switch( handling_result )
 			{
 				case request_handling_status_t::not_handled:
@@ -1034,15 +1659,6 @@ class connection_t final
 						next_write_group->first.items_count() );
 				} );
 
-				// Check if all response cells busy:
-				const bool response_coordinator_full_after =
-					m_response_coordinator.is_full();
-
-				// Whether we need to resume read after this group is written?
-				m_init_read_after_this_write =
-					response_coordinator_full_before &&
-					!response_coordinator_full_after;
-
 				if( 0 < next_write_group->first.status_line_size() )
 				{
 					// We need to extract status line out of the first buffer
@@ -1070,6 +1686,21 @@ class connection_t final
 				m_write_output_ctx.start_next_write_group(
 					std::move( next_write_group->first ) );
 
+				// Ready write groups of the next responses (it is the case
+				// of pipelined requests) are written together with the
+				// current one if they fit into the limits of a single
+				// gather write operation.
+				coalesce_ready_write_groups();
+
+				// Check if all response cells busy:
+				const bool response_coordinator_full_after =
+					m_response_coordinator.is_full();
+
+				// Whether we need to resume read after this group is written?
+				m_init_read_after_this_write =
+					response_coordinator_full_before &&
+					!response_coordinator_full_after;
+
 				// Start the loop of sending data from current write group.
 				handle_current_write_ctx();
 			}
@@ -1079,6 +1710,35 @@ class connection_t final
 			}
 		}
 
+		//! Append ready write groups to the current write operation.
+		/*!
+		 * @since v.0.6.18
+		 */
+		void
+		coalesce_ready_write_groups()
+		{
+			const auto can_coalesce = [this]( const write_group_t & wg ) {
+					return m_write_output_ctx.can_coalesce( wg );
+				};
+
+			while( auto next_write_group =
+					m_response_coordinator.pop_ready_buffers_if( can_coalesce ) )
+			{
+				m_logger.trace( [&]{
+					return fmt::format(
+						RESTINIO_FMT_FORMAT_STRING(
+							"[connection:{}] append write group for response (#{}), "
+							"size: {}" ),
+						this->connection_id(),
+						next_write_group->second,
+						next_write_group->first.items_count() );
+				} );
+
+				m_write_output_ctx.append_write_group(
+					std::move( next_write_group->first ) );
+			}
+		}
+
 		// Use aliases for shorter names.
 		using none_write_operation_t = write_group_output_ctx_t::none_write_operation_t;
 		using trivial_write_operation_t = write_group_output_ctx_t::trivial_write_operation_t;
@@ -1483,6 +2143,11 @@ class connection_t final
 
 			RESTINIO_ENSURE_NOEXCEPT_CALL( m_response_coordinator.reset() );
 
+			// A handler of streamed body is destroyed without
+			// the call to request handler.
+			m_input.m_parser_ctx.m_body_stream_handler.reset();
+			m_input.m_parser_ctx.m_body_reading_paused = false;
+
 			restinio::utils::log_trace_noexcept( m_logger,
 				[&]{
 					return fmt::format(
@@ -1530,7 +2195,7 @@ class connection_t final
 		const endpoint_t m_remote_endpoint;
 
 		//! Input routine.
-		connection_input_t m_input;
+		connection_input_t< typename Traits::http_parser_backend_t > m_input;
 
 		//! Write to socket operation context.
 		write_group_output_ctx_t m_write_output_ctx;
@@ -1541,6 +2206,14 @@ class connection_t final
 		//! Response coordinator.
 		response_coordinator_t m_response_coordinator;
 
+		//! Arena for request objects.
+		/*!
+		 * Is used only if Traits::use_request_arena is true.
+		 *
+		 * @since v.0.6.18
+		 */
+		request_arena_t m_request_arena;
+
 		//! Timer to controll operations.
 		//! \{
 
@@ -1606,6 +2279,7 @@ class connection_t final
 			}
 			else
 			{
+				release_idle_read_buffer();
 				init_next_timeout_checking();
 			}
 		}
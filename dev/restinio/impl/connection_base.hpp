@@ -13,6 +13,8 @@
 #include <restinio/tcp_connection_ctx_base.hpp>
 #include <restinio/buffers.hpp>
 
+#include <restinio/impl/response_header_buffer.hpp>
+
 namespace restinio
 {
 
@@ -32,6 +34,14 @@ class connection_base_t
 			:	tcp_connection_ctx_base_t{ id }
 		{}
 
+		/*!
+		 * @since v.0.6.18
+		 */
+		connection_base_t( connection_id_t id, bool add_date_field )
+			:	tcp_connection_ctx_base_t{ id }
+			,	m_add_date_field{ add_date_field }
+		{}
+
 		//! Write parts for specified request.
 		virtual void
 		write_response_parts(
@@ -41,6 +51,35 @@ class connection_base_t
 			response_output_flags_t response_output_flags,
 			//! Part of the response data.
 			write_group_t wg ) = 0;
+
+		//! Resume reading of a request body that was paused by
+		//! a body stream handler.
+		/*!
+		 * Can be called from any thread.
+		 *
+		 * @since v.0.6.18
+		 */
+		virtual void
+		resume_request_body_reading() {}
+
+		//! Should `Date` field be added to every response?
+		/*!
+		 * @since v.0.6.18
+		 */
+		bool
+		add_date_field() const noexcept { return m_add_date_field; }
+
+		//! A buffer for serializing headers of responses.
+		/*!
+		 * @since v.0.6.18
+		 */
+		response_header_buffer_slot_t &
+		response_header_buffer() noexcept { return m_response_header_buffer; }
+
+	private:
+		const bool m_add_date_field{ false };
+
+		response_header_buffer_slot_t m_response_header_buffer;
 };
 
 //! Alias for http connection handle.
@@ -13,6 +13,8 @@
 #include <restinio/connection_state_listener.hpp>
 #include <restinio/incoming_http_msg_limits.hpp>
 
+#include <restinio/impl/read_buffer_pool.hpp>
+
 #include <restinio/utils/suppress_exceptions.hpp>
 
 #include <memory>
@@ -145,6 +147,7 @@ struct connection_settings_t final
 		,	m_request_handler{ settings.request_handler() }
 		,	m_parser_settings{ parser_settings }
 		,	m_buffer_size{ settings.buffer_size() }
+		,	m_read_buffer_pool{ make_read_buffer_pool( settings ) }
 		,	m_incoming_http_msg_limits{ settings.incoming_http_msg_limits() }
 		,	m_read_next_http_message_timelimit{
 				settings.read_next_http_message_timelimit() }
@@ -153,6 +156,12 @@ struct connection_settings_t final
 		,	m_handle_request_timeout{
 				settings.handle_request_timeout() }
 		,	m_max_pipelined_requests{ settings.max_pipelined_requests() }
+		,	m_add_date_field{ settings.add_date_field() }
+		,	m_request_body_stream_handler_factory{
+				settings.request_body_stream_handler_factory() }
+		,	m_websocket_write_coalescing_delay{
+				settings.websocket_write_coalescing_delay() }
+		,	m_max_coalesced_write_size{ settings.max_coalesced_write_size() }
 		,	m_logger{ settings.logger() }
 		,	m_timer_manager{ std::move( timer_manager ) }
 		,	m_extra_data_factory{ settings.giveaway_extra_data_factory() }
@@ -177,6 +186,15 @@ struct connection_settings_t final
 	//! \{
 	std::size_t m_buffer_size;
 
+	/*!
+	 * @brief A pool for read buffers.
+	 *
+	 * Is nullptr if release_idle_read_buffers is disabled.
+	 *
+	 * @since v.0.6.18
+	 */
+	const std::unique_ptr< read_buffer_pool_t > m_read_buffer_pool;
+
 	/*!
 	 * @since v.0.6.12
 	 */
@@ -193,6 +211,27 @@ struct connection_settings_t final
 
 	std::size_t m_max_pipelined_requests;
 
+	/*!
+	 * @since v.0.6.18
+	 */
+	const bool m_add_date_field;
+
+	/*!
+	 * @since v.0.6.18
+	 */
+	const request_body_stream_handler_factory_t
+		m_request_body_stream_handler_factory;
+
+	/*!
+	 * @since v.0.6.18
+	 */
+	const std::chrono::microseconds m_websocket_write_coalescing_delay;
+
+	/*!
+	 * @since v.0.6.18
+	 */
+	const std::size_t m_max_coalesced_write_size;
+
 	const std::unique_ptr< logger_t > m_logger;
 	//! \}
 
@@ -216,6 +255,19 @@ struct connection_settings_t final
 	}
 
 private:
+	template< typename Settings >
+	static std::unique_ptr< read_buffer_pool_t >
+	make_read_buffer_pool( const Settings & settings )
+	{
+		std::unique_ptr< read_buffer_pool_t > result;
+		if( settings.release_idle_read_buffers() )
+			result = std::make_unique< read_buffer_pool_t >(
+					settings.buffer_size(),
+					settings.read_buffer_pool_capacity() );
+
+		return result;
+	}
+
 	//! Timer factory for timout guards.
 	timer_manager_handle_t m_timer_manager;
 
@@ -0,0 +1,143 @@
+/*
+	restinio
+*/
+
+/*!
+	A cache for pre-formatted value of `Date` header field.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/os.hpp>
+#include <restinio/string_view.hpp>
+
+#include <array>
+#include <cstdint>
+#include <ctime>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+//! The length of a value like "Sun, 06 Nov 1994 08:49:37 GMT".
+/*!
+ * @since v.0.6.18
+ */
+constexpr std::size_t date_field_value_size = 29u;
+
+//
+// format_date_field_value
+//
+/*!
+ * @brief Format a time in IMF-fixdate format (RFC 7231).
+ *
+ * Unlike strftime() this function doesn't depend on the current locale.
+ *
+ * IMF-fixdate has exactly four digits for a year, so @a t is clamped
+ * to the range from 0000-01-01 00:00:00 till 9999-12-31 23:59:59.
+ *
+ * @attention
+ * @a to must point to a buffer of at least date_field_value_size bytes.
+ *
+ * @since v.0.6.18
+ */
+inline void
+format_date_field_value( std::time_t t, char * to )
+{
+	static constexpr char days[ 7 ][ 4 ] = {
+		"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"
+	};
+	static constexpr char months[ 12 ][ 4 ] = {
+		"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+		"Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+	};
+
+	constexpr std::int64_t min_time = -62167219200; // 0000-01-01 00:00:00
+	constexpr std::int64_t max_time = 253402300799; // 9999-12-31 23:59:59
+	if( static_cast< std::int64_t >( t ) < min_time )
+		t = static_cast< std::time_t >( min_time );
+	else if( static_cast< std::int64_t >( t ) > max_time )
+		t = static_cast< std::time_t >( max_time );
+
+	const auto tpoint = make_gmtime( t );
+
+	const auto put2 = [&to]( int v ) noexcept {
+		*to++ = static_cast< char >( '0' + v / 10 );
+		*to++ = static_cast< char >( '0' + v % 10 );
+	};
+	const auto put3 = [&to]( const char (&s)[ 4 ] ) noexcept {
+		*to++ = s[ 0 ]; *to++ = s[ 1 ]; *to++ = s[ 2 ];
+	};
+
+	put3( days[ tpoint.tm_wday ] );
+	*to++ = ','; *to++ = ' ';
+	put2( tpoint.tm_mday );
+	*to++ = ' ';
+	put3( months[ tpoint.tm_mon ] );
+	*to++ = ' ';
+	const int year = tpoint.tm_year + 1900;
+	put2( year / 100 );
+	put2( year % 100 );
+	*to++ = ' ';
+	put2( tpoint.tm_hour );
+	*to++ = ':';
+	put2( tpoint.tm_min );
+	*to++ = ':';
+	put2( tpoint.tm_sec );
+	*to++ = ' '; *to++ = 'G'; *to++ = 'M'; *to++ = 'T';
+}
+
+//
+// date_field_cache_t
+//
+/*!
+ * @brief A holder of pre-formatted value of `Date` header field.
+ *
+ * The value is reformatted only when the current second changes.
+ * Every thread has own instance of the cache (see current()), so
+ * no synchronization is needed.
+ *
+ * @since v.0.6.18
+ */
+class date_field_cache_t
+{
+	public:
+		//! Get the value for the specified time.
+		string_view_t
+		get( std::time_t now )
+		{
+			if( now != m_time )
+			{
+				format_date_field_value( now, m_value.data() );
+				m_time = now;
+			}
+
+			return { m_value.data(), m_value.size() };
+		}
+
+		//! Get the value for the current time from the cache of
+		//! the current thread.
+		/*!
+		 * @note
+		 * The returned view remains valid until the next call to
+		 * current() on the same thread.
+		 */
+		static string_view_t
+		current()
+		{
+			static thread_local date_field_cache_t cache;
+			return cache.get( std::time( nullptr ) );
+		}
+
+	private:
+		std::time_t m_time{ -1 };
+		std::array< char, date_field_value_size > m_value;
+};
+
+} /* namespace impl */
+
+} /* namespace restinio */
@@ -8,10 +8,15 @@
 
 #pragma once
 
-#include <vector>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
 
 #include <restinio/asio_include.hpp>
 
+#include <restinio/impl/read_buffer_pool.hpp>
+
 namespace restinio
 {
 
@@ -23,30 +28,103 @@ namespace impl
 //
 
 //! Helper class for reading bytes and feeding them to parser.
+/*!
+ * Since v.0.6.18 the buffer can be bound to a read_buffer_pool_t.
+ * In that case the block is taken from the pool by the first read
+ * and the buffer can release it while the connection is idle
+ * (see release_block()). After such a release the block can be taken
+ * back by acquire_released_block() when the connection knows that
+ * there is some data to read. Otherwise the next read is performed
+ * into a small embedded "peek" area and a block is taken from the pool
+ * only when some data arrives.
+ */
 class fixed_buffer_t
 {
 	public:
+		//! The size of the area for a read without a block.
+		/*!
+		 * @since v.0.6.18
+		 */
+		static constexpr std::size_t peek_size = 64u;
+
 		fixed_buffer_t( const fixed_buffer_t & ) = delete;
 		fixed_buffer_t & operator = ( const fixed_buffer_t & ) = delete;
 		fixed_buffer_t( fixed_buffer_t && ) = delete;
 		fixed_buffer_t & operator = ( fixed_buffer_t && ) = delete;
 
 		explicit fixed_buffer_t( std::size_t size )
+			:	m_buf{ read_buffer_pool_t::make_block( size ) }
+			,	m_size{ size }
+		{}
+
+		//! Create a buffer bound to a pool.
+		/*!
+		 * If @a pool is nullptr the buffer behaves just like a buffer
+		 * created by the constructor without a pool.
+		 *
+		 * @attention
+		 * The pool must outlive the buffer.
+		 *
+		 * @since v.0.6.18
+		 */
+		fixed_buffer_t( std::size_t size, read_buffer_pool_t * pool )
+			:	m_buf{ pool ? nullptr : read_buffer_pool_t::make_block( size ) }
+			,	m_size{ size }
+			,	m_pool{ pool }
+		{}
+
+		~fixed_buffer_t()
 		{
-			m_buf.resize( size );
+			if( m_pool )
+				m_pool->release( std::move( m_buf ) );
 		}
 
 		//! Make asio buffer for reading bytes from socket.
+		/*!
+		 * If the current block is still referenced by someone else
+		 * (see share_block()) a new block is allocated. Such
+		 * a reallocation is possible only because the whole buffer is
+		 * overwritten by every read operation.
+		 *
+		 * If the block was released by release_block() then
+		 * a buffer for the small embedded peek area is returned.
+		 */
 		auto
-		make_asio_buffer() noexcept
+		make_asio_buffer()
 		{
-			return asio_ns::buffer( m_buf.data(), m_buf.size() );
+			if( m_block_released )
+			{
+				m_peek_read = true;
+				return asio_ns::buffer(
+						m_peek_area.data(),
+						(std::min)( m_peek_area.size(), m_size ) );
+			}
+
+			m_peek_read = false;
+			if( 1 != m_buf.use_count() )
+				m_buf = acquire_block();
+
+			return asio_ns::buffer( m_buf.get(), m_size );
 		}
 
 		//! Mark how many bytes were obtained.
+		/*!
+		 * @note
+		 * If the data was read into the peek area then a block is
+		 * acquired and the data is copied into it. Because of that
+		 * this method isn't noexcept since v.0.6.18.
+		 */
 		void
-		obtained_bytes( std::size_t length ) noexcept
+		obtained_bytes( std::size_t length )
 		{
+			if( m_peek_read )
+			{
+				m_peek_read = false;
+				m_block_released = false;
+				m_buf = acquire_block();
+				std::memcpy( m_buf.get(), m_peek_area.data(), length );
+			}
+
 			m_ready_length = length; // Current bytes in buffer.
 			m_ready_pos = 0; // Reset current pos.
 		}
@@ -66,11 +144,124 @@ class fixed_buffer_t
 		/*!
 			\note To check that buffer has unconsumed bytes use length().
 		*/
-		const char * bytes() const noexcept { return m_buf.data() + m_ready_pos; }
+		const char * bytes() const noexcept { return m_buf.get() + m_ready_pos; }
+
+		//! Get a shared reference to the current block.
+		/*!
+		 * The content of the block remains untouched while the returned
+		 * reference is alive. The buffer will use a new block for
+		 * the next read operation.
+		 *
+		 * @since v.0.6.18
+		 */
+		std::shared_ptr< const void >
+		share_block() const noexcept { return m_buf; }
+
+		//! Does the buffer have a block?
+		/*!
+		 * @since v.0.6.18
+		 */
+		bool
+		has_block() const noexcept { return static_cast< bool >( m_buf ); }
+
+		//! Is the buffer bound to a pool?
+		/*!
+		 * @since v.0.6.18
+		 */
+		bool
+		has_pool() const noexcept { return nullptr != m_pool; }
+
+		//! Is the current read operation performed into the peek area?
+		/*!
+		 * @since v.0.6.18
+		 */
+		bool
+		is_peek_read() const noexcept { return m_peek_read; }
+
+		//! Return the current block to the pool.
+		/*!
+		 * Does nothing if the buffer isn't bound to a pool or if there
+		 * are unconsumed bytes in the buffer.
+		 *
+		 * @attention
+		 * Must not be called while a read operation into the block
+		 * is in progress.
+		 *
+		 * @since v.0.6.18
+		 */
+		void
+		release_block() noexcept
+		{
+			if( m_pool && 0u == m_ready_length )
+			{
+				m_pool->release( std::move( m_buf ) );
+				m_buf.reset();
+				m_ready_pos = 0u;
+				m_block_released = true;
+			}
+		}
+
+		//! Was the block released by release_block()?
+		/*!
+		 * @since v.0.6.18
+		 */
+		bool
+		block_released() const noexcept { return m_block_released; }
+
+		//! Take a block from the pool after release_block().
+		/*!
+		 * The next read is performed directly into the block.
+		 *
+		 * @since v.0.6.18
+		 */
+		void
+		acquire_released_block()
+		{
+			m_buf = acquire_block();
+			m_block_released = false;
+		}
 
 	private:
+		std::shared_ptr< char >
+		acquire_block()
+		{
+			return m_pool ?
+					m_pool->acquire() : read_buffer_pool_t::make_block( m_size );
+		}
+
 		//! Buffer for io operation.
-		std::vector< char > m_buf;
+		/*!
+		 * @note
+		 * It is a shared block since v.0.6.18.
+		 */
+		std::shared_ptr< char > m_buf;
+
+		//! The size of the buffer.
+		std::size_t m_size;
+
+		//! Optional pool for blocks.
+		/*!
+		 * @since v.0.6.18
+		 */
+		read_buffer_pool_t * m_pool{ nullptr };
+
+		//! Area for a read operation when there is no block.
+		/*!
+		 * @since v.0.6.18
+		 */
+		std::array< char, peek_size > m_peek_area;
+
+		//! Is the current read operation performed into the peek area?
+		/*!
+		 * @since v.0.6.18
+		 */
+		bool m_peek_read{ false };
+
+		//! Was the block released by release_block()?
+		/*!
+		 * @since v.0.6.18
+		 */
+		bool m_block_released{ false };
 
 		//! unconsumed data left in buffer:
 		//! \{
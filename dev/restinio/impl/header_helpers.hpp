@@ -12,6 +12,10 @@
 #include <numeric>
 
 #include <restinio/buffers.hpp>
+#include <restinio/http_headers.hpp>
+
+#include <restinio/impl/header_serializer.hpp>
+#include <restinio/impl/response_header_buffer.hpp>
 
 namespace restinio
 {
@@ -30,12 +34,6 @@ inline constexpr std::size_t ct_string_len( const char (&)[N] ) noexcept
 	return N-1;
 }
 
-enum class content_length_field_presence_t : std::uint8_t
-{
-	add_content_length,
-	skip_content_length
-};
-
 //
 // calculate_approx_buffer_size_for_header()
 //
@@ -52,6 +50,9 @@ calculate_approx_buffer_size_for_header(
 
 	result += 2; // Final "\r\n\r\n".
 
+	if( h.use_cached_date_field() )
+		result += 6 + date_field_value_size + 2; // "Date: <value>\r\n".
+
 	h.for_each_field( [&result](const auto & f) noexcept {
 			result += f.name().size() + 2 + f.value().size() + 2;
 		} );
@@ -71,87 +72,49 @@ create_header_string(
 		content_length_field_presence_t::add_content_length,
 	std::size_t buffer_size = 0 )
 {
-	std::string result;
+	const response_header_serializer_t serializer{
+			h, content_length_field_presence };
 
-	if( 0 != buffer_size )
+	std::string result;
+	if( buffer_size > serializer.size() )
 		result.reserve( buffer_size );
-	else
-		result.reserve( calculate_approx_buffer_size_for_header( h ) );
-
-	constexpr const char header_part1[] = "HTTP/";
-	result.append( header_part1, ct_string_len( header_part1 ) );
-
-	result += static_cast<char>( '0' + h.http_major() );
-	result += '.';
-	result += static_cast<char>( '0' + h.http_minor() );
-	result += ' ';
-
-	const auto sc = h.status_code().raw_code();
-
-//FIXME: there should be a check for status_code in range 100..999.
-//May be a special type like bounded_value_t<100,999> must be used in
-//http_response_header_t.
-	result += '0' + ( sc / 100 ) % 10;
-	result += '0' + ( sc / 10 ) % 10;
-	result += '0' + ( sc ) % 10;
-
-	result += ' ';
-	result += h.reason_phrase();
-
-	constexpr const char header_rn[] = "\r\n";
-	result.append( header_rn, ct_string_len( header_rn ) );
-
-	switch( h.connection() )
-	{
-		case http_connection_header_t::keep_alive:
-		{
-			constexpr const char header_part2_1[] = "Connection: keep-alive\r\n";
-			result.append( header_part2_1, ct_string_len( header_part2_1 ) );
-			break;
-		}
-
-		case http_connection_header_t::close:
-		{
-			constexpr const char header_part2_2[] = "Connection: close\r\n";
-			result.append( header_part2_2, ct_string_len( header_part2_2 ) );
-			break;
-		}
-
-		case http_connection_header_t::upgrade:
-		{
-			constexpr const char header_part2_3[] = "Connection: Upgrade\r\n";
-			result.append( header_part2_3, ct_string_len( header_part2_3 ) );
-			break;
-		}
-	}
-
-	if( content_length_field_presence_t::add_content_length ==
-		content_length_field_presence )
-	{
-		std::array< char, 64 > buf;
-		const auto n =
-			std::snprintf(
-				buf.data(),
-				buf.size(),
-				"Content-Length: %llu\r\n",
-				static_cast< unsigned long long >( h.content_length() ) );
-
-		result.append( buf.data(), static_cast<std::string::size_type>(n) );
-	}
-
-	constexpr const char header_field_sep[] = ": ";
-	h.for_each_field( [&result, header_field_sep, header_rn](const auto & f) {
-		result += f.name();
-		result.append( header_field_sep, ct_string_len( header_field_sep ) );
-		result += f.value();
-		result.append( header_rn, ct_string_len( header_rn ) );
-	} );
-
-	result.append( header_rn, ct_string_len( header_rn ) );
+
+	// The string is allocated only once and the header is written
+	// directly into it.
+	result.resize( serializer.size() );
+	serializer.write( &result[ 0 ] );
 
 	return result;
 }
 
+//
+// create_header_buffer()
+//
+
+//! Creates a writable item with http response header.
+/*!
+ * The header is serialized into a string taken from @a slot,
+ * so the memory of a header of the previous response can be reused.
+ *
+ * @since v.0.6.18
+ */
+inline writable_item_t
+create_header_buffer(
+	const http_response_header_t & h,
+	response_header_buffer_slot_t & slot,
+	content_length_field_presence_t content_length_field_presence =
+		content_length_field_presence_t::add_content_length )
+{
+	const response_header_serializer_t serializer{
+			h, content_length_field_presence };
+
+	auto buffer = slot.take();
+	buffer->resize( serializer.size() );
+	serializer.write( &( *buffer )[ 0 ] );
+
+	return writable_item_t{ std::move( buffer ) };
+}
+
 inline auto
 create_not_implemented_resp()
 {
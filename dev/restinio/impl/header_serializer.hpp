@@ -0,0 +1,449 @@
+/*
+	restinio
+*/
+
+/*!
+	Serializer of HTTP response header into a preallocated buffer.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/http_headers.hpp>
+
+#include <restinio/impl/date_field_cache.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+//
+// content_length_field_presence_t
+//
+
+//! Should Content-Length field be added to serialized header.
+enum class content_length_field_presence_t : std::uint8_t
+{
+	add_content_length,
+	skip_content_length
+};
+
+//
+// static_fragment_t
+//
+
+//! A pointer to a static string with its length.
+/*!
+ * @since v.0.6.18
+ */
+struct static_fragment_t
+{
+	const char * m_data;
+	std::size_t m_size;
+
+	constexpr bool
+	empty() const noexcept { return 0u == m_size; }
+};
+
+//! Make static_fragment_t from a string literal.
+/*!
+ * @since v.0.6.18
+ */
+template< std::size_t N >
+constexpr static_fragment_t
+make_static_fragment( const char (&s)[N] ) noexcept
+{
+	return static_fragment_t{ s, N - 1u };
+}
+
+//
+// uint64_decimal_digits_count
+//
+
+//! Get the count of decimal digits in a number.
+/*!
+ * Comparisons are summed up instead of being checked in a loop,
+ * so the compiler produces code without conditional jumps.
+ *
+ * @since v.0.6.18
+ */
+inline std::size_t
+uint64_decimal_digits_count( std::uint64_t v ) noexcept
+{
+	return 1u
+		+ (v >= 10ull)
+		+ (v >= 100ull)
+		+ (v >= 1000ull)
+		+ (v >= 10000ull)
+		+ (v >= 100000ull)
+		+ (v >= 1000000ull)
+		+ (v >= 10000000ull)
+		+ (v >= 100000000ull)
+		+ (v >= 1000000000ull)
+		+ (v >= 10000000000ull)
+		+ (v >= 100000000000ull)
+		+ (v >= 1000000000000ull)
+		+ (v >= 10000000000000ull)
+		+ (v >= 100000000000000ull)
+		+ (v >= 1000000000000000ull)
+		+ (v >= 10000000000000000ull)
+		+ (v >= 100000000000000000ull)
+		+ (v >= 1000000000000000000ull)
+		+ (v >= 10000000000000000000ull);
+}
+
+//
+// uint64_to_chars
+//
+
+//! Write decimal representation of a number.
+/*!
+ * Digits are produced by pairs with the help of a table of
+ * all two-digit numbers.
+ *
+ * @attention
+ * @a to must point to a buffer of at least
+ * uint64_decimal_digits_count(v) bytes.
+ *
+ * @return pointer to the byte right after the last written digit.
+ *
+ * @since v.0.6.18
+ */
+inline char *
+uint64_to_chars( std::uint64_t v, char * to ) noexcept
+{
+	static constexpr char digit_pairs[] =
+		"00010203040506070809"
+		"10111213141516171819"
+		"20212223242526272829"
+		"30313233343536373839"
+		"40414243444546474849"
+		"50515253545556575859"
+		"60616263646566676869"
+		"70717273747576777879"
+		"80818283848586878889"
+		"90919293949596979899";
+
+	char * const end = to + uint64_decimal_digits_count( v );
+	char * p = end;
+
+	while( v >= 100u )
+	{
+		const auto i = static_cast< std::size_t >( v % 100u ) * 2u;
+		v /= 100u;
+		*--p = digit_pairs[ i + 1u ];
+		*--p = digit_pairs[ i ];
+	}
+
+	if( v >= 10u )
+	{
+		const auto i = static_cast< std::size_t >( v ) * 2u;
+		*--p = digit_pairs[ i + 1u ];
+		*--p = digit_pairs[ i ];
+	}
+	else
+		*--p = static_cast< char >( '0' + v );
+
+	return end;
+}
+
+//
+// precomputed_status_line
+//
+
+//! Get a precomputed HTTP/1.1 status line for a status code.
+/*!
+ * There are lines like "HTTP/1.1 200 OK\r\n" for all status codes
+ * from restinio::status_code namespace. The reason phrases are the same
+ * as used by restinio::status_ok() and similar functions.
+ *
+ * @return an empty fragment if there is no line for @a code.
+ *
+ * @since v.0.6.18
+ */
+inline static_fragment_t
+precomputed_status_line( http_status_code_t code ) noexcept
+{
+#define RESTINIO_STATUS_LINE( code, reason ) \
+	case code: return make_static_fragment( "HTTP/1.1 " #code " " reason "\r\n" );
+
+	switch( code.raw_code() )
+	{
+		RESTINIO_STATUS_LINE( 100, "Continue" )
+		RESTINIO_STATUS_LINE( 101, "Switching Protocols" )
+		RESTINIO_STATUS_LINE( 102, "Processing" )
+		RESTINIO_STATUS_LINE( 200, "OK" )
+		RESTINIO_STATUS_LINE( 201, "Created" )
+		RESTINIO_STATUS_LINE( 202, "Accepted" )
+		RESTINIO_STATUS_LINE( 203, "Non-Authoritative Information" )
+		RESTINIO_STATUS_LINE( 204, "No Content" )
+		RESTINIO_STATUS_LINE( 205, "Reset Content" )
+		RESTINIO_STATUS_LINE( 206, "Partial Content" )
+		RESTINIO_STATUS_LINE( 207, "Multi-Status" )
+		RESTINIO_STATUS_LINE( 300, "Multiple Choices" )
+		RESTINIO_STATUS_LINE( 301, "Moved Permanently" )
+		RESTINIO_STATUS_LINE( 302, "Found" )
+		RESTINIO_STATUS_LINE( 303, "See Other" )
+		RESTINIO_STATUS_LINE( 304, "Not Modified" )
+		RESTINIO_STATUS_LINE( 305, "Use Proxy" )
+		RESTINIO_STATUS_LINE( 307, "Temporary Redirect" )
+		RESTINIO_STATUS_LINE( 308, "Permanent Redirect" )
+		RESTINIO_STATUS_LINE( 400, "Bad Request" )
+		RESTINIO_STATUS_LINE( 401, "Unauthorized" )
+		RESTINIO_STATUS_LINE( 402, "Payment Required" )
+		RESTINIO_STATUS_LINE( 403, "Forbidden" )
+		RESTINIO_STATUS_LINE( 404, "Not Found" )
+		RESTINIO_STATUS_LINE( 405, "Method Not Allowed" )
+		RESTINIO_STATUS_LINE( 406, "Not Acceptable" )
+		RESTINIO_STATUS_LINE( 407, "Proxy Authentication Required" )
+		RESTINIO_STATUS_LINE( 408, "Request Timeout" )
+		RESTINIO_STATUS_LINE( 409, "Conflict" )
+		RESTINIO_STATUS_LINE( 410, "Gone" )
+		RESTINIO_STATUS_LINE( 411, "Length Required" )
+		RESTINIO_STATUS_LINE( 412, "Precondition Failed" )
+		RESTINIO_STATUS_LINE( 413, "Payload Too Large" )
+		RESTINIO_STATUS_LINE( 414, "URI Too Long" )
+		RESTINIO_STATUS_LINE( 415, "Unsupported Media Type" )
+		RESTINIO_STATUS_LINE( 416, "Requested Range Not Satisfiable" )
+		RESTINIO_STATUS_LINE( 417, "Expectation Failed" )
+		RESTINIO_STATUS_LINE( 422, "Unprocessable Entity" )
+		RESTINIO_STATUS_LINE( 423, "Locked" )
+		RESTINIO_STATUS_LINE( 424, "Failed Dependency" )
+		RESTINIO_STATUS_LINE( 428, "Precondition Required" )
+		RESTINIO_STATUS_LINE( 429, "Too Many Requests" )
+		RESTINIO_STATUS_LINE( 431, "Request Header Fields Too Large" )
+		RESTINIO_STATUS_LINE( 500, "Internal Server Error" )
+		RESTINIO_STATUS_LINE( 501, "Not Implemented" )
+		RESTINIO_STATUS_LINE( 502, "Bad Gateway" )
+		RESTINIO_STATUS_LINE( 503, "Service Unavailable" )
+		RESTINIO_STATUS_LINE( 504, "Gateway Timeout" )
+		RESTINIO_STATUS_LINE( 505, "HTTP Version not supported" )
+		RESTINIO_STATUS_LINE( 507, "Insufficient Storage" )
+		RESTINIO_STATUS_LINE( 511, "Network Authentication Required" )
+	}
+
+#undef RESTINIO_STATUS_LINE
+
+	return static_fragment_t{ nullptr, 0u };
+}
+
+//
+// response_header_serializer_t
+//
+
+//! Serializer of HTTP response header.
+/*!
+ * The exact size of the serialized header is calculated by
+ * the constructor, so the header can be written into a buffer
+ * allocated only once (or into a buffer taken from some pool)
+ * by write() method:
+ * @code
+ * response_header_serializer_t serializer{ header, presence };
+ * std::string buf( serializer.size(), '\0' );
+ * serializer.write( &buf[ 0 ] );
+ * @endcode
+ *
+ * Static parts of the header (status line for HTTP/1.1 with the
+ * standard reason phrase and Connection field) are copied from
+ * precomputed strings.
+ *
+ * @note
+ * Names of fields are written exactly as they were set by
+ * the application (e.g. "content-type" stays "content-type").
+ *
+ * @attention
+ * The serializer holds references to @a h and to the cached value of
+ * Date field, so write() should be called right after the construction.
+ *
+ * @since v.0.6.18
+ */
+class response_header_serializer_t
+{
+	public:
+		response_header_serializer_t(
+			const http_response_header_t & h,
+			content_length_field_presence_t content_length_field_presence )
+			:	m_header{ h }
+			,	m_add_content_length{
+					content_length_field_presence_t::add_content_length ==
+						content_length_field_presence }
+		{
+			// Status line can be precomputed only for HTTP/1.1 and
+			// the standard reason phrase.
+			if( 1 == h.http_major() && 1 == h.http_minor() )
+			{
+				const auto line = precomputed_status_line( h.status_code() );
+				if( !line.empty() &&
+					line.m_size == status_line_size( h.reason_phrase() ) &&
+					0 == std::memcmp(
+						line.m_data + 13u,
+						h.reason_phrase().data(),
+						h.reason_phrase().size() ) )
+				{
+					m_status_line = line;
+				}
+			}
+
+			m_size = m_status_line.empty() ?
+					status_line_size( h.reason_phrase() ) : m_status_line.m_size;
+
+			m_size += connection_line( h.connection() ).m_size;
+
+			if( m_add_content_length )
+				m_size += content_length_name().m_size +
+						uint64_decimal_digits_count( h.content_length() ) + 2u;
+
+			if( h.use_cached_date_field() && !h.has_field( http_field_t::date ) )
+			{
+				m_date = date_field_cache_t::current();
+				m_size += 6u + m_date.size() + 2u; // "Date: <value>\r\n".
+			}
+
+			h.for_each_field( [this]( const http_header_field_t & f ) noexcept {
+					m_size += f.name().size() + 2u + f.value().size() + 2u;
+				} );
+
+			m_size += 2u; // Final "\r\n".
+		}
+
+		//! Get the exact size of the serialized header.
+		RESTINIO_NODISCARD
+		std::size_t
+		size() const noexcept { return m_size; }
+
+		//! Write the header.
+		/*!
+		 * @attention
+		 * @a to must point to a buffer of at least size() bytes.
+		 *
+		 * @return pointer to the byte right after the written header.
+		 */
+		char *
+		write( char * to ) const noexcept
+		{
+			const auto & h = m_header;
+
+			if( !m_status_line.empty() )
+				to = put( to, m_status_line );
+			else
+			{
+				to = put( to, make_static_fragment( "HTTP/" ) );
+				*to++ = static_cast< char >( '0' + h.http_major() );
+				*to++ = '.';
+				*to++ = static_cast< char >( '0' + h.http_minor() );
+				*to++ = ' ';
+
+				const auto sc = h.status_code().raw_code();
+
+//FIXME: there should be a check for status_code in range 100..999.
+//May be a special type like bounded_value_t<100,999> must be used in
+//http_response_header_t.
+				*to++ = static_cast< char >( '0' + ( sc / 100 ) % 10 );
+				*to++ = static_cast< char >( '0' + ( sc / 10 ) % 10 );
+				*to++ = static_cast< char >( '0' + ( sc ) % 10 );
+				*to++ = ' ';
+
+				to = put( to, h.reason_phrase() );
+				to = put( to, make_static_fragment( "\r\n" ) );
+			}
+
+			to = put( to, connection_line( h.connection() ) );
+
+			if( m_add_content_length )
+			{
+				to = put( to, content_length_name() );
+				to = uint64_to_chars( h.content_length(), to );
+				to = put( to, make_static_fragment( "\r\n" ) );
+			}
+
+			if( !m_date.empty() )
+			{
+				to = put( to, make_static_fragment( "Date: " ) );
+				to = put( to, m_date );
+				to = put( to, make_static_fragment( "\r\n" ) );
+			}
+
+			h.for_each_field( [&to]( const http_header_field_t & f ) noexcept {
+					to = put( to, f.name() );
+					to = put( to, make_static_fragment( ": " ) );
+					to = put( to, f.value() );
+					to = put( to, make_static_fragment( "\r\n" ) );
+				} );
+
+			return put( to, make_static_fragment( "\r\n" ) );
+		}
+
+	private:
+		const http_response_header_t & m_header;
+		const bool m_add_content_length;
+
+		//! Precomputed status line (if it can be used).
+		static_fragment_t m_status_line{ nullptr, 0u };
+
+		//! The value for Date field (if it should be added).
+		string_view_t m_date;
+
+		std::size_t m_size;
+
+		static std::size_t
+		status_line_size( string_view_t reason_phrase ) noexcept
+		{
+			// "HTTP/1.1 xxx " + reason + "\r\n".
+			return 13u + reason_phrase.size() + 2u;
+		}
+
+		static static_fragment_t
+		connection_line( http_connection_header_t c ) noexcept
+		{
+			switch( c )
+			{
+				case http_connection_header_t::keep_alive:
+					return make_static_fragment( "Connection: keep-alive\r\n" );
+
+				case http_connection_header_t::close:
+					return make_static_fragment( "Connection: close\r\n" );
+
+				case http_connection_header_t::upgrade:
+					return make_static_fragment( "Connection: Upgrade\r\n" );
+			}
+
+			return static_fragment_t{ nullptr, 0u };
+		}
+
+		static constexpr static_fragment_t
+		content_length_name() noexcept
+		{
+			return make_static_fragment( "Content-Length: " );
+		}
+
+		static char *
+		put( char * to, static_fragment_t what ) noexcept
+		{
+			std::memcpy( to, what.m_data, what.m_size );
+			return to + what.m_size;
+		}
+
+		static char *
+		put( char * to, string_view_t what ) noexcept
+		{
+			std::memcpy( to, what.data(), what.size() );
+			return to + what.size();
+		}
+
+		static char *
+		put( char * to, const std::string & what ) noexcept
+		{
+			std::memcpy( to, what.data(), what.size() );
+			return to + what.size();
+		}
+};
+
+} /* namespace impl */
+
+} /* namespace restinio */
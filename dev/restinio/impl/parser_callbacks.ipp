@@ -90,9 +90,16 @@ restinio_header_value_cb( http_parser * parser, const char *at, size_t length )
 
 		if( !ctx->m_last_was_value )
 		{
-			fields.add_field(
-				std::move( ctx->m_current_field_name ),
-				std::string{ at, length } );
+			if( ctx->m_spare_fields.empty() )
+				fields.add_field(
+					std::move( ctx->m_current_field_name ),
+					std::string{ at, length } );
+			else
+				add_field_from_spare_accessor(
+					fields,
+					ctx->m_spare_fields,
+					ctx->m_current_field_name,
+					string_view_t{ at, length } );
 
 			ctx->m_last_value_total_size = length;
 			ctx->m_last_was_value = true;
@@ -102,7 +109,7 @@ restinio_header_value_cb( http_parser * parser, const char *at, size_t length )
 		}
 		else
 		{
-			append_last_field_accessor( fields, std::string{ at, length } );
+			append_last_field_accessor( fields, string_view_t{ at, length } );
 			ctx->m_last_value_total_size += length;
 		}
 
@@ -120,7 +127,8 @@ restinio_header_value_cb( http_parser * parser, const char *at, size_t length )
 	return 0;
 }
 
-inline int
+template< typename Http_Methods >
+int
 restinio_headers_complete_cb( http_parser * parser )
 {
 	auto * ctx =
@@ -130,20 +138,27 @@ restinio_headers_complete_cb( http_parser * parser )
 	// values of trailing fields.
 	ctx->m_leading_headers_completed = true;
 
+	if( ctx->m_check_body_stream )
+	{
+		// The method should be available for the factory of
+		// body stream handlers.
+		ctx->m_header.method( Http_Methods::from_nodejs( parser->method ) );
+
+		// The connection will decide how to handle the body.
+		// The size of the body will be checked there.
+		ctx->m_paused_after_headers = true;
+		http_parser_pause( parser, 1 );
+
+		return 0;
+	}
+
 	if( ULLONG_MAX != parser->content_length &&
 		0 < parser->content_length )
 	{
-		// Maximum body size can be checked right now.
-		if( parser->content_length > ctx->m_limits.max_body_size() )
-		{
-			return -1;
-		}
-
 		try
 		{
-			ctx->m_body.reserve(
-					::restinio::utils::impl::uint64_to_size_t(
-							parser->content_length) );
+			if( !ctx->prepare_body_storage( parser->content_length ) )
+				return -1;
 		}
 		catch( const std::exception & )
 		{
@@ -164,15 +179,38 @@ restinio_body_cb( http_parser * parser, const char *at, size_t length )
 			reinterpret_cast< restinio::impl::http_parser_ctx_t * >(
 				parser->data );
 
+		if( ctx->m_body_stream_handler )
+		{
+			// The body isn't collected, so its size isn't limited.
+			ctx->m_streamed_body_size += length;
+
+			switch( ctx->m_body_stream_handler->on_body_part(
+					restinio::string_view_t{ at, length } ) )
+			{
+				case restinio::body_stream_action_t::continue_reading:
+				break;
+
+				case restinio::body_stream_action_t::pause_reading:
+					ctx->m_body_reading_paused = true;
+					http_parser_pause( parser, 1 );
+				break;
+
+				case restinio::body_stream_action_t::abort:
+					return -1;
+			}
+
+			return 0;
+		}
+
 		// The total size of the body should be checked.
 		const auto total_length = static_cast<std::uint64_t>(
-				ctx->m_body.size() ) + length;
+				ctx->body_size() ) + length;
 		if( total_length > ctx->m_limits.max_body_size() )
 		{
 			return -1;
 		}
 
-		ctx->m_body.append( at, length );
+		ctx->append_body( at, length );
 	}
 	catch( const std::exception & )
 	{
@@ -202,8 +240,12 @@ restinio_chunk_header_cb( http_parser * parser )
 			// the incoming request the whole request's data will be dropped.
 			// So there is no need to care about that new item in m_chunks.
 			ctx->m_chunked_info_block.m_chunks.emplace_back(
-				ctx->m_body.size(),
+				ctx->body_size(),
 				::restinio::utils::impl::uint64_to_size_t(parser->content_length) );
+
+			if( ctx->m_body_stream_handler )
+				ctx->m_body_stream_handler->on_chunk_started(
+						ctx->m_chunked_info_block.m_chunks.back() );
 		}
 	}
 	catch( const std::exception & )
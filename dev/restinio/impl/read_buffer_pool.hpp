@@ -0,0 +1,135 @@
+/*
+	restinio
+*/
+
+/*!
+	A pool of blocks for connection read buffers.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+//
+// read_buffer_pool_t
+//
+
+//! A pool of memory blocks for connection read buffers.
+/*!
+ * A connection that releases its read buffer while being idle
+ * returns the block to the pool and takes a block from the pool
+ * when new data arrives. That allows to have memory for read buffers
+ * only for connections that are actually reading something.
+ *
+ * The pool keeps at most `capacity` free blocks. Extra blocks are
+ * deallocated.
+ *
+ * The pool is shared by all connections of a server and
+ * can be used from several threads.
+ *
+ * @since v.0.6.18
+ */
+class read_buffer_pool_t
+{
+	public:
+		read_buffer_pool_t( const read_buffer_pool_t & ) = delete;
+		read_buffer_pool_t & operator = ( const read_buffer_pool_t & ) = delete;
+		read_buffer_pool_t( read_buffer_pool_t && ) = delete;
+		read_buffer_pool_t & operator = ( read_buffer_pool_t && ) = delete;
+
+		read_buffer_pool_t(
+			//! The size of every block.
+			std::size_t block_size,
+			//! Max count of free blocks to be kept in the pool.
+			std::size_t capacity )
+			:	m_block_size{ block_size }
+			,	m_capacity{ capacity }
+		{
+			// Memory for the free list is reserved beforehand
+			// to make release() noexcept.
+			m_free_blocks.reserve( m_capacity );
+		}
+
+		//! Make a new block that is not bound to any pool.
+		RESTINIO_NODISCARD
+		static std::shared_ptr< char >
+		make_block( std::size_t size )
+		{
+			return std::shared_ptr< char >{
+					new char[ size ], std::default_delete< char[] >{} };
+		}
+
+		//! Get a block from the pool or allocate a new one.
+		RESTINIO_NODISCARD
+		std::shared_ptr< char >
+		acquire()
+		{
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				if( !m_free_blocks.empty() )
+				{
+					auto block = std::move( m_free_blocks.back() );
+					m_free_blocks.pop_back();
+					return block;
+				}
+			}
+
+			return make_block( m_block_size );
+		}
+
+		//! Return a block to the pool.
+		/*!
+		 * If the block is still referenced by someone else (for example
+		 * by a request body slice) or if the pool is full then the block
+		 * isn't stored in the pool.
+		 */
+		void
+		release( std::shared_ptr< char > block ) noexcept
+		{
+			if( block && 1 == block.use_count() )
+			{
+				std::lock_guard< std::mutex > lock{ m_lock };
+				if( m_free_blocks.size() < m_capacity )
+					m_free_blocks.push_back( std::move( block ) );
+			}
+		}
+
+		//! Get the size of blocks.
+		RESTINIO_NODISCARD
+		std::size_t
+		block_size() const noexcept { return m_block_size; }
+
+		//! Get the count of free blocks in the pool.
+		RESTINIO_NODISCARD
+		std::size_t
+		free_blocks() const
+		{
+			std::lock_guard< std::mutex > lock{ m_lock };
+			return m_free_blocks.size();
+		}
+
+	private:
+		const std::size_t m_block_size;
+		const std::size_t m_capacity;
+
+		mutable std::mutex m_lock;
+
+		//! Free blocks.
+		std::vector< std::shared_ptr< char > > m_free_blocks;
+};
+
+} /* namespace impl */
+
+} /* namespace restinio */
@@ -0,0 +1,246 @@
+/*
+	restinio
+*/
+
+/*!
+	A per-connection monotonic arena for request objects.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+//
+// request_arena_t
+//
+
+//! A monotonic arena for objects created for every incoming request.
+/*!
+ * The arena allocates memory from a block by simply moving a pointer.
+ * Memory isn't returned to the block on deallocation. Instead every
+ * block counts the allocations that are alive. When all of them are
+ * released the block is reused by the arena (if it is still the current
+ * block of the arena) or deallocated.
+ *
+ * So if requests of a connection are handled one by one then all of
+ * them are placed into the same block and there are no allocations
+ * for them at all.
+ *
+ * If an allocation doesn't fit into the free space of the current block
+ * a new block is allocated. An allocation that is bigger than a block
+ * is performed by the ordinary operator new.
+ *
+ * The arena itself should be used only on the context of the connection,
+ * but memory from the arena can be released on any thread and even after
+ * the destruction of the arena.
+ *
+ * @since v.0.6.18
+ */
+class request_arena_t
+{
+	//! Header of a block. The block's data follows it.
+	struct block_t
+	{
+		//! The number of alive allocations plus one for the arena.
+		std::atomic< std::size_t > m_references{ 1u };
+		//! How many bytes of the block's data are used.
+		std::size_t m_used{ 0u };
+	};
+
+	//! Header of every allocation.
+	/*!
+	 * It is padded to keep the alignment of the allocated object.
+	 */
+	union allocation_header_t
+	{
+		//! The block for the allocation (nullptr if the allocation
+		//! was performed by the ordinary operator new).
+		block_t * m_block;
+		std::max_align_t m_alignment;
+	};
+
+	static constexpr std::size_t header_size =
+			sizeof( allocation_header_t );
+
+	static constexpr std::size_t block_header_size =
+			( sizeof( block_t ) + header_size - 1u ) / header_size * header_size;
+
+	public:
+		//! The default size of the data of a block.
+		static constexpr std::size_t default_block_size = 4u * 1024u;
+
+		request_arena_t( const request_arena_t & ) = delete;
+		request_arena_t & operator = ( const request_arena_t & ) = delete;
+		request_arena_t( request_arena_t && ) = delete;
+		request_arena_t & operator = ( request_arena_t && ) = delete;
+
+		explicit request_arena_t(
+			std::size_t block_size = default_block_size ) noexcept
+			:	m_block_size{ block_size }
+		{}
+
+		~request_arena_t()
+		{
+			if( m_block )
+				release_block( m_block );
+		}
+
+		//! Allocate memory for @a size bytes.
+		RESTINIO_NODISCARD
+		void *
+		allocate( std::size_t size )
+		{
+			const std::size_t required =
+					( size + header_size - 1u ) / header_size * header_size +
+					header_size;
+
+			if( required > m_block_size )
+			{
+				// That allocation won't fit into any block.
+				auto * header = static_cast< allocation_header_t * >(
+						::operator new( required ) );
+				header->m_block = nullptr;
+
+				return header + 1;
+			}
+
+			if( m_block &&
+				1u == m_block->m_references.load( std::memory_order_acquire ) )
+			{
+				// Nobody uses the current block, it can be reused.
+				m_block->m_used = 0u;
+			}
+
+			if( !m_block || m_block_size - m_block->m_used < required )
+			{
+				block_t * fresh_block = new( ::operator new(
+						block_header_size + m_block_size ) ) block_t{};
+
+				if( m_block )
+					release_block( m_block );
+				m_block = fresh_block;
+			}
+
+			auto * header = reinterpret_cast< allocation_header_t * >(
+					reinterpret_cast< char * >( m_block ) +
+					block_header_size + m_block->m_used );
+			header->m_block = m_block;
+
+			m_block->m_used += required;
+			m_block->m_references.fetch_add( 1u, std::memory_order_relaxed );
+
+			return header + 1;
+		}
+
+		//! Release memory allocated by allocate().
+		/*!
+		 * Can be called on any thread.
+		 */
+		static void
+		deallocate( void * p ) noexcept
+		{
+			auto * header = static_cast< allocation_header_t * >( p ) - 1;
+
+			if( header->m_block )
+				release_block( header->m_block );
+			else
+				::operator delete( header );
+		}
+
+	private:
+		static void
+		release_block( block_t * block ) noexcept
+		{
+			if( 1u == block->m_references.fetch_sub(
+					1u, std::memory_order_acq_rel ) )
+			{
+				block->~block_t();
+				::operator delete( block );
+			}
+		}
+
+		//! The size of the data of every block.
+		const std::size_t m_block_size;
+
+		//! The current block.
+		block_t * m_block{ nullptr };
+};
+
+//
+// request_arena_allocator_t
+//
+
+//! An allocator that takes memory from request_arena_t.
+/*!
+ * It is intended to be used with std::allocate_shared.
+ *
+ * @attention
+ * The arena must be alive while allocate() is called. But deallocate()
+ * can be called after the destruction of the arena.
+ *
+ * @since v.0.6.18
+ */
+template< typename T >
+class request_arena_allocator_t
+{
+	template< typename U > friend class request_arena_allocator_t;
+
+	public:
+		using value_type = T;
+
+		explicit request_arena_allocator_t( request_arena_t & arena ) noexcept
+			:	m_arena{ &arena }
+		{}
+
+		template< typename U >
+		request_arena_allocator_t(
+			const request_arena_allocator_t< U > & other ) noexcept
+			:	m_arena{ other.m_arena }
+		{}
+
+		RESTINIO_NODISCARD
+		T *
+		allocate( std::size_t n )
+		{
+			return static_cast< T * >( m_arena->allocate( n * sizeof( T ) ) );
+		}
+
+		void
+		deallocate( T * p, std::size_t ) noexcept
+		{
+			request_arena_t::deallocate( p );
+		}
+
+		template< typename U >
+		bool
+		operator==( const request_arena_allocator_t< U > & other ) const noexcept
+		{
+			return m_arena == other.m_arena;
+		}
+
+		template< typename U >
+		bool
+		operator!=( const request_arena_allocator_t< U > & other ) const noexcept
+		{
+			return m_arena != other.m_arena;
+		}
+
+	private:
+		request_arena_t * m_arena;
+};
+
+} /* namespace impl */
+
+} /* namespace restinio */
@@ -0,0 +1,102 @@
+/*
+	restinio
+*/
+
+/*!
+	A per-connection slot for reusing memory of destroyed requests.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/http_headers.hpp>
+
+#include <atomic>
+#include <string>
+#include <utility>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+//
+// request_storage_recycler_t
+//
+
+//! A slot for the header and the body of a destroyed request.
+/*!
+ * The request target, names and values of fields and the body are
+ * kept in std::string objects. When a request object is destroyed
+ * they are returned to the connection via that slot and the connection
+ * parses the next request into them. So if requests of a connection
+ * are handled one by one there are no allocations for those strings
+ * while their capacity is enough.
+ *
+ * There is only one slot. If it is occupied (for example, several
+ * pipelined requests are alive at the same time) the data of a request
+ * is simply destroyed.
+ *
+ * put() can be called on any thread, take() should be called only on
+ * the context of the connection.
+ *
+ * @since v.0.6.18
+ */
+class request_storage_recycler_t
+{
+	public:
+		//! Try to keep the data of a destroyed request.
+		void
+		put( http_request_header_t & header, std::string & body ) noexcept
+		{
+			int expected = empty;
+			if( m_state.compare_exchange_strong(
+					expected, busy, std::memory_order_acquire ) )
+			{
+				std::swap( m_header, header );
+				std::swap( m_body, body );
+
+				m_state.store( full, std::memory_order_release );
+			}
+		}
+
+		//! Try to get the data of a destroyed request.
+		/*!
+		 * @return false if there is no data in the slot. @a header and
+		 * @a body are not changed in that case.
+		 */
+		bool
+		take( http_request_header_t & header, std::string & body ) noexcept
+		{
+			int expected = full;
+			if( !m_state.compare_exchange_strong(
+					expected, busy, std::memory_order_acquire ) )
+				return false;
+
+			std::swap( m_header, header );
+			std::swap( m_body, body );
+
+			m_state.store( empty, std::memory_order_release );
+
+			return true;
+		}
+
+	private:
+		//! States of the slot.
+		//! \{
+		static constexpr int empty = 0;
+		static constexpr int busy = 1;
+		static constexpr int full = 2;
+		//! \}
+
+		std::atomic< int > m_state{ empty };
+
+		http_request_header_t m_header;
+		std::string m_body;
+};
+
+} /* namespace impl */
+
+} /* namespace restinio */
@@ -79,6 +79,18 @@ class response_context_t
 		//! Is context empty.
 		bool empty() const noexcept { return m_write_groups.empty(); }
 
+		//! Get access to the first write group in data queue.
+		/*!
+		 * @since v.0.6.18
+		 */
+		const write_group_t &
+		front_group() const noexcept
+		{
+			assert( !m_write_groups.empty() );
+
+			return m_write_groups.front();
+		}
+
 		//! Extract write group from data queue.
 		write_group_t
 		dequeue_group() noexcept
@@ -406,6 +418,36 @@ class response_coordinator_t
 			return result;
 		}
 
+		//! Extract a portion of data available for write if it is
+		//! accepted by a predicate.
+		/*!
+		 * Works like pop_ready_buffers() but the write group is extracted
+		 * only if @a predicate returns true for it. Nothing is extracted
+		 * if the coordinator is closed.
+		 *
+		 * It allows to gather ready write groups of several consecutive
+		 * responses (e.g. responses to pipelined requests) in order to
+		 * send them by a single write operation.
+		 *
+		 * @since v.0.6.18
+		 */
+		template< typename Predicate >
+		optional_t< std::pair< write_group_t, request_id_t > >
+		pop_ready_buffers_if( Predicate && predicate )
+		{
+			optional_t< std::pair< write_group_t, request_id_t > > result;
+
+			if( !closed() && !m_context_table.empty() )
+			{
+				const auto & current_ctx = m_context_table.front();
+
+				if( !current_ctx.empty() && predicate( current_ctx.front_group() ) )
+					result = pop_ready_buffers();
+			}
+
+			return result;
+		}
+
 		//! Remove all contexts.
 		/*!
 			Invoke write groups after-write callbacks with error status.
@@ -0,0 +1,94 @@
+/*
+	restinio
+*/
+
+/*!
+	A per-connection buffer for serialized response headers.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace restinio
+{
+
+namespace impl
+{
+
+//
+// response_header_buffer_slot_t
+//
+
+//! A slot with a buffer for a serialized response header.
+/*!
+ * A header of a response is serialized into a std::string that is
+ * shared between the slot and a writable item of the response.
+ * When the response is written and its write group is destroyed the
+ * slot becomes the only owner of the string and the header of the next
+ * response of the connection is serialized into the same string.
+ * So there are no allocations for headers while responses are written
+ * one by one and the capacity of the string is enough.
+ *
+ * If the string is still in use (or the slot is being used by another
+ * thread at the same moment) a new string is created.
+ *
+ * take() can be called on any thread.
+ *
+ * @since v.0.6.18
+ */
+class response_header_buffer_slot_t
+{
+	public:
+		//! Get a string for serializing a header into.
+		/*!
+		 * The content of the returned string is unspecified.
+		 */
+		std::shared_ptr< std::string >
+		take()
+		{
+			if( m_busy.test_and_set( std::memory_order_acquire ) )
+				return std::make_shared< std::string >();
+
+			std::shared_ptr< std::string > result;
+			try
+			{
+				if( m_buffer && 1 == m_buffer.use_count() )
+				{
+					// Previous users of the string have released it and
+					// nobody else can get it while m_busy is set.
+					// The fence is synchronized with the release of
+					// the reference count by the last user.
+					std::atomic_thread_fence( std::memory_order_acquire );
+					result = m_buffer;
+				}
+				else
+				{
+					result = std::make_shared< std::string >();
+					m_buffer = result;
+				}
+			}
+			catch( ... )
+			{
+				m_busy.clear( std::memory_order_release );
+				throw;
+			}
+
+			m_busy.clear( std::memory_order_release );
+
+			return result;
+		}
+
+	private:
+		std::atomic_flag m_busy = ATOMIC_FLAG_INIT;
+
+		std::shared_ptr< std::string > m_buffer;
+};
+
+} /* namespace impl */
+
+} /* namespace restinio */
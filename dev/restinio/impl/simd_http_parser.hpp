@@ -0,0 +1,1613 @@
+/*
+	restinio
+*/
+
+/*!
+	An in-tree parser of HTTP/1.x requests that scans data by SIMD.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+
+#include <restinio/utils/impl/cpu_features.hpp>
+
+#include <http_parser.h>
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if !defined( RESTINIO_SIMD_HTTP_PARSER_SCALAR_ONLY )
+	#if defined( __SSE2__ ) || defined( _M_X64 ) || \
+			( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+		#define RESTINIO_SIMD_HTTP_PARSER_USE_SSE2
+		#include <emmintrin.h>
+	#endif
+
+	#if defined( __AVX2__ )
+		#define RESTINIO_SIMD_HTTP_PARSER_USE_AVX2
+		#include <immintrin.h>
+	#endif
+
+	// If AVX2 isn't enabled at compile time then the AVX2 version of
+	// scanning is compiled with target options and is selected at run time.
+	#if !defined( RESTINIO_SIMD_HTTP_PARSER_USE_AVX2 ) && \
+			!defined( RESTINIO_SIMD_HTTP_PARSER_NO_RUNTIME_DISPATCH ) && \
+			defined( RESTINIO_HAS_X86_CPU_FEATURES )
+		#define RESTINIO_SIMD_HTTP_PARSER_RUNTIME_DISPATCH
+		#include <immintrin.h>
+	#endif
+#endif
+
+#define RESTINIO_SIMD_HTTP_PARSER_PRAGMA( x ) _Pragma( #x )
+
+#if !defined( RESTINIO_SIMD_HTTP_PARSER_RUNTIME_DISPATCH )
+	#define RESTINIO_SIMD_HTTP_PARSER_TARGET_BEGIN( isa )
+	#define RESTINIO_SIMD_HTTP_PARSER_TARGET_END
+#elif defined( __clang__ )
+	#define RESTINIO_SIMD_HTTP_PARSER_TARGET_BEGIN( isa ) \
+		RESTINIO_SIMD_HTTP_PARSER_PRAGMA( clang attribute push( \
+				__attribute__(( target( isa ) )), apply_to = function ) )
+	#define RESTINIO_SIMD_HTTP_PARSER_TARGET_END \
+		RESTINIO_SIMD_HTTP_PARSER_PRAGMA( clang attribute pop )
+#else
+	#define RESTINIO_SIMD_HTTP_PARSER_TARGET_BEGIN( isa ) \
+		RESTINIO_SIMD_HTTP_PARSER_PRAGMA( GCC push_options ) \
+		RESTINIO_SIMD_HTTP_PARSER_PRAGMA( GCC target( isa ) )
+	#define RESTINIO_SIMD_HTTP_PARSER_TARGET_END \
+		RESTINIO_SIMD_HTTP_PARSER_PRAGMA( GCC pop_options )
+#endif
+
+#if defined( _MSC_VER )
+	#include <intrin.h>
+#endif
+
+namespace restinio
+{
+
+namespace impl
+{
+
+namespace simd_http_parser
+{
+
+//
+// Classes of chars.
+//
+
+//! A char that stops scanning of a request target (SP or CTL).
+constexpr std::uint8_t url_end_char = 1u;
+//! A char that stops scanning of a header value (CTL except HTAB).
+constexpr std::uint8_t value_end_char = 2u;
+//! A char that can be used in a token (RFC 7230, 3.2.6).
+constexpr std::uint8_t token_char = 4u;
+//! A char that can be used in the authority of a request target
+//! (userinfo chars, '[' and ']' as in nodejs/http_parser).
+constexpr std::uint8_t authority_char = 8u;
+
+//! A table with classes of all chars.
+struct char_table_t
+{
+	std::uint8_t m_classes[ 256 ];
+};
+
+RESTINIO_NODISCARD
+constexpr char_table_t
+make_char_table() noexcept
+{
+	char_table_t result{};
+
+	for( unsigned c = 0u; c != 256u; ++c )
+	{
+		std::uint8_t classes = 0u;
+
+		if( c <= 0x20u || 0x7Fu == c )
+			classes |= url_end_char;
+
+		if( ( c < 0x20u && '\t' != c ) || 0x7Fu == c )
+			classes |= value_end_char;
+
+		if( ( '0' <= c && c <= '9' ) || ( 'a' <= c && c <= 'z' ) ||
+			( 'A' <= c && c <= 'Z' ) )
+			classes |= token_char;
+
+		result.m_classes[ c ] = classes;
+	}
+
+	for( const char c : "!#$%&'*+-.^_`|~" )
+		if( c )
+			result.m_classes[ static_cast< unsigned char >( c ) ] |= token_char;
+
+	for( unsigned c = 0u; c != 256u; ++c )
+		if( ( '0' <= c && c <= '9' ) || ( 'a' <= c && c <= 'z' ) ||
+			( 'A' <= c && c <= 'Z' ) )
+			result.m_classes[ c ] |= authority_char;
+
+	for( const char c : "-_.!~*'()%;:&=+$,[]" )
+		if( c )
+			result.m_classes[ static_cast< unsigned char >( c ) ] |= authority_char;
+
+	return result;
+}
+
+//! The table built at compile time.
+template< typename T = void >
+struct char_table_holder_t
+{
+	static constexpr char_table_t table = make_char_table();
+};
+
+template< typename T >
+constexpr char_table_t char_table_holder_t< T >::table;
+
+RESTINIO_NODISCARD
+inline bool
+is_char_of( char ch, std::uint8_t char_class ) noexcept
+{
+	return 0u != ( char_table_holder_t<>::table.m_classes[
+			static_cast< unsigned char >( ch ) ] & char_class );
+}
+
+RESTINIO_NODISCARD
+inline unsigned
+count_trailing_zeros( std::uint32_t mask ) noexcept
+{
+#if defined( _MSC_VER ) && !defined( __clang__ )
+	unsigned long index;
+	_BitScanForward( &index, mask );
+	return static_cast< unsigned >( index );
+#else
+	return static_cast< unsigned >( __builtin_ctz( mask ) );
+#endif
+}
+
+//
+// url_end_scanner_t
+//
+
+//! Scanner for the end of a request target.
+struct url_end_scanner_t
+{
+	static constexpr std::uint8_t char_class = url_end_char;
+
+#if defined( RESTINIO_SIMD_HTTP_PARSER_USE_SSE2 )
+	static __m128i
+	stop_chars( __m128i v ) noexcept
+	{
+		// Unsigned `v <= 0x20` is `min(v, 0x20) == v`.
+		return _mm_or_si128(
+				_mm_cmpeq_epi8( _mm_min_epu8( v, _mm_set1_epi8( 0x20 ) ), v ),
+				_mm_cmpeq_epi8( v, _mm_set1_epi8( 0x7F ) ) );
+	}
+#endif
+};
+
+//
+// value_end_scanner_t
+//
+
+//! Scanner for the end of a header value.
+struct value_end_scanner_t
+{
+	static constexpr std::uint8_t char_class = value_end_char;
+
+#if defined( RESTINIO_SIMD_HTTP_PARSER_USE_SSE2 )
+	static __m128i
+	stop_chars( __m128i v ) noexcept
+	{
+		// Unsigned `v < 0x20` is `min(v, 0x1F) == v`.
+		const __m128i ctl = _mm_cmpeq_epi8(
+				_mm_min_epu8( v, _mm_set1_epi8( 0x1F ) ), v );
+		return _mm_or_si128(
+				_mm_andnot_si128( _mm_cmpeq_epi8( v, _mm_set1_epi8( '\t' ) ), ctl ),
+				_mm_cmpeq_epi8( v, _mm_set1_epi8( 0x7F ) ) );
+	}
+#endif
+};
+
+#if defined( RESTINIO_SIMD_HTTP_PARSER_USE_AVX2 ) || \
+		defined( RESTINIO_SIMD_HTTP_PARSER_RUNTIME_DISPATCH )
+RESTINIO_SIMD_HTTP_PARSER_TARGET_BEGIN( "avx2" )
+
+namespace avx2
+{
+
+inline __m256i
+stop_chars( url_end_scanner_t, __m256i v ) noexcept
+{
+	return _mm256_or_si256(
+			_mm256_cmpeq_epi8( _mm256_min_epu8( v, _mm256_set1_epi8( 0x20 ) ), v ),
+			_mm256_cmpeq_epi8( v, _mm256_set1_epi8( 0x7F ) ) );
+}
+
+inline __m256i
+stop_chars( value_end_scanner_t, __m256i v ) noexcept
+{
+	const __m256i ctl = _mm256_cmpeq_epi8(
+			_mm256_min_epu8( v, _mm256_set1_epi8( 0x1F ) ), v );
+	return _mm256_or_si256(
+			_mm256_andnot_si256(
+					_mm256_cmpeq_epi8( v, _mm256_set1_epi8( '\t' ) ), ctl ),
+			_mm256_cmpeq_epi8( v, _mm256_set1_epi8( 0x7F ) ) );
+}
+
+//! Find a char that stops the scanning in 32-byte blocks.
+/*!
+ * If there is no such char then @a from is moved to the beginning of
+ * the tail that is less than 32 bytes.
+ *
+ * @return nullptr if there is no such char.
+ */
+template< typename Scanner >
+RESTINIO_NODISCARD
+const char *
+find_in_blocks( const char * & from, const char * to ) noexcept
+{
+	for( ; to - from >= 32; from += 32 )
+	{
+		const auto mask = static_cast< std::uint32_t >(
+				_mm256_movemask_epi8( stop_chars( Scanner{},
+						_mm256_loadu_si256(
+								reinterpret_cast< const __m256i * >( from ) ) ) ) );
+		if( mask )
+			return from + count_trailing_zeros( mask );
+	}
+
+	return nullptr;
+}
+
+} /* namespace avx2 */
+
+RESTINIO_SIMD_HTTP_PARSER_TARGET_END
+#endif
+
+//! Find the first char that stops the scanning.
+/*!
+ * Data is processed by 32 bytes (if AVX2 is available), then by
+ * 16 bytes (if SSE2 is available) and then byte by byte.
+ *
+ * If AVX2 isn't enabled at compile time, GCC and clang on x86 compile
+ * the AVX2 version anyway and use it if the CPU supports AVX2.
+ * Define RESTINIO_SIMD_HTTP_PARSER_NO_RUNTIME_DISPATCH to disable that.
+ *
+ * @return @a to if there is no such char.
+ */
+template< typename Scanner >
+RESTINIO_NODISCARD
+const char *
+find_first( const char * from, const char * to ) noexcept
+{
+#if defined( RESTINIO_SIMD_HTTP_PARSER_USE_AVX2 )
+	if( const char * found = avx2::find_in_blocks< Scanner >( from, to ) )
+		return found;
+#elif defined( RESTINIO_SIMD_HTTP_PARSER_RUNTIME_DISPATCH )
+	if( restinio::utils::impl::x86_features().m_avx2 )
+		if( const char * found = avx2::find_in_blocks< Scanner >( from, to ) )
+			return found;
+#endif
+
+#if defined( RESTINIO_SIMD_HTTP_PARSER_USE_SSE2 )
+	for( ; to - from >= 16; from += 16 )
+	{
+		const auto mask = static_cast< std::uint32_t >(
+				_mm_movemask_epi8( Scanner::stop_chars(
+						_mm_loadu_si128(
+								reinterpret_cast< const __m128i * >( from ) ) ) ) );
+		if( mask )
+			return from + count_trailing_zeros( mask );
+	}
+#endif
+
+	for( ; from != to; ++from )
+		if( is_char_of( *from, Scanner::char_class ) )
+			break;
+
+	return from;
+}
+
+//! The max size of the head of a request (the same as in nodejs/http_parser).
+constexpr std::uint32_t max_head_size = 80u * 1024u;
+
+//
+// parser_t
+//
+
+//! A parser of HTTP/1.x requests.
+/*!
+ * The parser is a replacement for http_parser_execute() of
+ * nodejs/http_parser for requests. It uses the same http_parser
+ * object for the results (method, version, content_length, flags,
+ * upgrade, http_errno) and calls the same callbacks from
+ * http_parser_settings, including the pause via http_parser_pause().
+ * So http_should_keep_alive() and http_errno_name() can be used as usual.
+ *
+ * Like nodejs/http_parser the parser is incremental: a request can be
+ * split into any parts and URL, names and values of fields and parts
+ * of the body are reported by fragments.
+ *
+ * The difference from nodejs/http_parser is in the scanning:
+ * URL and values of fields are scanned by 16/32 bytes with SSE2/AVX2,
+ * names of fields and other short tokens are checked by a table of
+ * char classes. Only the scheme and the authority of a request target
+ * are checked char by char, a path, a query and a fragment are checked
+ * by SIMD scanning only.
+ *
+ * @since v.0.6.18
+ */
+class parser_t
+{
+	public:
+		//! Prepare the parser for a new request.
+		/*!
+		 * It's an analog of http_parser_init( &parser, HTTP_REQUEST ).
+		 */
+		void
+		reset( http_parser & parser ) noexcept
+		{
+			void * data = parser.data;
+			std::memset( &parser, 0, sizeof( parser ) );
+			parser.data = data;
+			parser.type = HTTP_REQUEST;
+			parser.http_errno = HPE_OK;
+
+			m_state = state_t::start;
+		}
+
+		//! Parse a portion of data.
+		/*!
+		 * @return the count of consumed bytes.
+		 */
+		std::size_t
+		execute(
+			http_parser & parser,
+			const http_parser_settings & settings,
+			const char * data,
+			std::size_t length )
+		{
+			if( HPE_OK != parser.http_errno )
+				return 0u;
+
+			m_parser = &parser;
+			m_settings = &settings;
+
+			if( 0u == length )
+			{
+				// The end of the input.
+				if( state_t::start != m_state )
+					set_error( HPE_INVALID_EOF_STATE );
+				return 0u;
+			}
+
+			const char * p = data;
+			const char * const end = data + length;
+			while( p != end )
+			{
+				const char * const before = p;
+				const bool head = in_head();
+
+				p = step( p, end );
+
+				if( head )
+				{
+					parser.nread += static_cast< std::uint32_t >( p - before );
+					if( parser.nread > max_head_size &&
+						HPE_OK == parser.http_errno )
+					{
+						// Like nodejs/http_parser the byte that exceeds
+						// the limit isn't treated as consumed.
+						set_error( HPE_HEADER_OVERFLOW );
+						if( p != before )
+							--p;
+					}
+				}
+
+				if( HPE_OK != parser.http_errno || m_stop )
+				{
+					m_stop = false;
+					break;
+				}
+			}
+
+			return static_cast< std::size_t >( p - data );
+		}
+
+	private:
+		//! States of the parser.
+		enum class state_t : std::uint8_t
+		{
+			start,
+			method,
+			url,
+			version,
+			request_line_lf,
+			field_start,
+			field_name,
+			value_ws,
+			value,
+			value_lf,
+			headers_lf,
+			headers_done,
+			body_identity,
+			message_done,
+			chunk_size_start,
+			chunk_size,
+			chunk_ext,
+			chunk_size_lf,
+			chunk_data,
+			chunk_data_cr,
+			chunk_data_lf
+		};
+
+		//! States of the check of a request target.
+		/*!
+		 * States before `server` mean an incomplete target.
+		 * The `path` state is used for a query and a fragment too.
+		 */
+		enum class url_state_t : std::uint8_t
+		{
+			start,
+			schema,
+			schema_slash,
+			schema_slash_slash,
+			server_start,
+			server,
+			server_with_at,
+			path,
+			invalid
+		};
+
+		//! Fields that affect the parsing.
+		enum class special_field_t : std::uint8_t
+		{
+			none,
+			content_length,
+			transfer_encoding,
+			connection,
+			upgrade
+		};
+
+		//! The max size of a value of a special field to be handled.
+		static constexpr std::size_t max_special_value_size = 1024u;
+
+		//! The max size of a method name.
+		static constexpr std::size_t max_method_size = 16u;
+
+		//! The size of a buffer for names of special fields.
+		static constexpr std::size_t max_special_name_size = 17u;
+
+		RESTINIO_NODISCARD
+		bool
+		in_head() const noexcept
+		{
+			return state_t::start != m_state && m_state <= state_t::headers_lf;
+		}
+
+		void
+		set_error( http_errno error ) noexcept
+		{
+			m_parser->http_errno = error;
+		}
+
+		//! Call a notification callback.
+		void
+		notify( http_cb cb, http_errno error )
+		{
+			if( cb && 0 != cb( m_parser ) )
+				set_error( error );
+		}
+
+		//! Call a data callback.
+		void
+		notify_data(
+			http_data_cb cb,
+			const char * at,
+			std::size_t length,
+			http_errno error )
+		{
+			if( cb && 0 != cb( m_parser, at, length ) )
+				set_error( error );
+		}
+
+		//! Handle data according to the current state.
+		/*!
+		 * Every handler consumes some data or changes the state.
+		 */
+		const char *
+		step( const char * p, const char * end )
+		{
+			switch( m_state )
+			{
+				case state_t::start: return on_start( p );
+				case state_t::method: return on_method( p, end );
+				case state_t::url: return on_url( p, end );
+				case state_t::version: return on_version( p );
+				case state_t::request_line_lf: return expect_lf( p, state_t::field_start );
+				case state_t::field_start: return on_field_start( p );
+				case state_t::field_name: return on_field_name( p, end );
+				case state_t::value_ws: return on_value_ws( p, end );
+				case state_t::value: return on_value( p, end );
+				case state_t::value_lf: return expect_lf( p, state_t::field_start );
+				case state_t::headers_lf: return on_headers_lf( p );
+				case state_t::headers_done: return on_headers_done( p );
+				case state_t::body_identity: return on_body_identity( p, end );
+				case state_t::message_done: complete_message(); return p + 1;
+				case state_t::chunk_size_start: return on_chunk_size_start( p );
+				case state_t::chunk_size: return on_chunk_size( p );
+				case state_t::chunk_ext: return on_chunk_ext( p, end );
+				case state_t::chunk_size_lf: return on_chunk_size_lf( p );
+				case state_t::chunk_data: return on_chunk_data( p, end );
+				case state_t::chunk_data_cr: return on_chunk_data_cr( p );
+				case state_t::chunk_data_lf: return on_chunk_data_lf( p );
+			}
+
+			set_error( HPE_INVALID_INTERNAL_STATE );
+			return p;
+		}
+
+		const char *
+		expect_lf( const char * p, state_t next )
+		{
+			if( '\n' != *p )
+			{
+				set_error( HPE_LF_EXPECTED );
+				return p;
+			}
+
+			m_state = next;
+			return p + 1;
+		}
+
+		const char *
+		on_start( const char * p )
+		{
+			// Empty lines before a request are ignored.
+			if( '\r' == *p || '\n' == *p )
+				return p + 1;
+
+			// Like nodejs/http_parser the beginning of a message isn't
+			// reported if there is no method starting with the char.
+			if( !is_method_first_char( *p ) )
+			{
+				set_error( HPE_INVALID_METHOD );
+				return p;
+			}
+
+			m_parser->flags = 0u;
+			m_parser->content_length = ULLONG_MAX;
+			m_parser->nread = 0u;
+			// Like nodejs/http_parser the upgrade flag isn't reset here,
+			// it is set when the head of the message is parsed.
+			m_parser->http_major = 0u;
+			m_parser->http_minor = 0u;
+
+			m_method_size = 0u;
+			m_url_started = false;
+			m_url_state = url_state_t::start;
+			m_version_index = 0u;
+			m_ice_protocol = false;
+			m_has_field = false;
+			m_trailing = false;
+			m_has_transfer_encoding = false;
+
+			m_state = state_t::method;
+			notify( m_settings->on_message_begin, HPE_CB_message_begin );
+
+			return p;
+		}
+
+		const char *
+		on_method( const char * p, const char * end )
+		{
+			for( ; p != end; ++p )
+			{
+				const char ch = *p;
+				if( ' ' == ch )
+				{
+					if( !resolve_method() )
+					{
+						set_error( HPE_INVALID_METHOD );
+						return p;
+					}
+
+					m_state = state_t::url;
+					return p + 1;
+				}
+
+				if( max_method_size == m_method_size )
+				{
+					set_error( HPE_INVALID_METHOD );
+					return p;
+				}
+
+				m_method[ m_method_size++ ] = ch;
+
+				// An error is detected at the first char that doesn't
+				// match any method (as in nodejs/http_parser).
+				if( !is_method_prefix() )
+				{
+					set_error( HPE_INVALID_METHOD );
+					return p;
+				}
+			}
+
+			return p;
+		}
+
+		RESTINIO_NODISCARD
+		static bool
+		is_method_first_char( char ch ) noexcept
+		{
+#define RESTINIO_SIMD_HTTP_PARSER_METHOD_GEN( num, name, string ) \
+			if( #string[ 0 ] == ch ) \
+				return true;
+
+			HTTP_METHOD_MAP( RESTINIO_SIMD_HTTP_PARSER_METHOD_GEN )
+
+#undef RESTINIO_SIMD_HTTP_PARSER_METHOD_GEN
+
+			return false;
+		}
+
+		RESTINIO_NODISCARD
+		bool
+		is_method_prefix() const noexcept
+		{
+			const std::size_t size = m_method_size;
+
+#define RESTINIO_SIMD_HTTP_PARSER_METHOD_GEN( num, name, string ) \
+			if( sizeof( #string ) - 1u >= size && \
+				0 == std::memcmp( #string, m_method, size ) ) \
+				return true;
+
+			HTTP_METHOD_MAP( RESTINIO_SIMD_HTTP_PARSER_METHOD_GEN )
+
+#undef RESTINIO_SIMD_HTTP_PARSER_METHOD_GEN
+
+			return false;
+		}
+
+		RESTINIO_NODISCARD
+		bool
+		resolve_method() noexcept
+		{
+			const std::size_t size = m_method_size;
+
+#define RESTINIO_SIMD_HTTP_PARSER_METHOD_GEN( num, name, string ) \
+			if( sizeof( #string ) - 1u == size && \
+				0 == std::memcmp( #string, m_method, size ) ) \
+			{ \
+				m_parser->method = num; \
+				return true; \
+			}
+
+			HTTP_METHOD_MAP( RESTINIO_SIMD_HTTP_PARSER_METHOD_GEN )
+
+#undef RESTINIO_SIMD_HTTP_PARSER_METHOD_GEN
+
+			return false;
+		}
+
+		const char *
+		on_url( const char * p, const char * end )
+		{
+			if( !m_url_started )
+			{
+				// Spaces before a request target are skipped
+				// (as in nodejs/http_parser).
+				while( p != end && ' ' == *p )
+					++p;
+				if( p == end )
+					return p;
+
+				// CONNECT has a target in authority-form.
+				m_url_state = HTTP_CONNECT == m_parser->method ?
+						url_state_t::server_start : url_state_t::start;
+			}
+
+			const char * const stop = find_first< url_end_scanner_t >( p, end );
+
+			// Like nodejs/http_parser the part of the target from
+			// the current data isn't reported if it's invalid.
+			const char * const invalid = check_url( p, stop );
+			if( invalid != stop )
+			{
+				set_error( HPE_INVALID_URL );
+				return invalid;
+			}
+
+			if( stop != end &&
+				( !( ' ' == *stop || '\r' == *stop || '\n' == *stop ) ||
+					m_url_state < url_state_t::server ) )
+			{
+				set_error( HPE_INVALID_URL );
+				return stop;
+			}
+
+			if( stop != p )
+			{
+				m_url_started = true;
+				notify_data(
+						m_settings->on_url,
+						p,
+						static_cast< std::size_t >( stop - p ),
+						HPE_CB_url );
+				if( HPE_OK != m_parser->http_errno || stop == end )
+					return stop;
+			}
+
+			if( ' ' == *stop )
+				m_state = state_t::version;
+			else
+			{
+				// HTTP/0.9 request.
+				m_parser->http_major = 0u;
+				m_parser->http_minor = 9u;
+				m_state = '\r' == *stop ?
+						state_t::request_line_lf : state_t::field_start;
+			}
+
+			return stop + 1;
+		}
+
+		//! Check the structure of a request target.
+		/*!
+		 * Only a scheme and an authority are checked char by char.
+		 * All chars of a path, a query and a fragment are already
+		 * checked by url_end_scanner_t.
+		 *
+		 * @return a pointer to the first invalid char or @a end.
+		 */
+		RESTINIO_NODISCARD
+		const char *
+		check_url( const char * p, const char * end ) noexcept
+		{
+			for( ; p != end && url_state_t::path != m_url_state; ++p )
+			{
+				const auto next = next_url_state( m_url_state, *p );
+				if( url_state_t::invalid == next )
+					return p;
+				m_url_state = next;
+			}
+
+			return end;
+		}
+
+		//! The same transitions as parse_url_char() from nodejs/http_parser.
+		RESTINIO_NODISCARD
+		static url_state_t
+		next_url_state( url_state_t state, char ch ) noexcept
+		{
+			const bool alpha =
+					( 'a' <= ch && ch <= 'z' ) || ( 'A' <= ch && ch <= 'Z' );
+
+			switch( state )
+			{
+				case url_state_t::start:
+					if( '/' == ch || '*' == ch )
+						return url_state_t::path;
+					if( alpha )
+						return url_state_t::schema;
+				break;
+
+				case url_state_t::schema:
+					if( alpha )
+						return state;
+					if( ':' == ch )
+						return url_state_t::schema_slash;
+				break;
+
+				case url_state_t::schema_slash:
+					if( '/' == ch )
+						return url_state_t::schema_slash_slash;
+				break;
+
+				case url_state_t::schema_slash_slash:
+					if( '/' == ch )
+						return url_state_t::server_start;
+				break;
+
+				case url_state_t::server_with_at:
+					if( '@' == ch )
+						break;
+					RESTINIO_FALLTHROUGH;
+				case url_state_t::server_start:
+				case url_state_t::server:
+					if( '/' == ch || '?' == ch )
+						return url_state_t::path;
+					if( '@' == ch )
+						return url_state_t::server_with_at;
+					if( is_char_of( ch, authority_char ) )
+						return url_state_t::server;
+				break;
+
+				case url_state_t::path:
+					return state;
+
+				case url_state_t::invalid:
+				break;
+			}
+
+			return url_state_t::invalid;
+		}
+
+		const char *
+		on_version( const char * p )
+		{
+			const char ch = *p;
+			const auto index = m_version_index++;
+
+			if( 0u == index )
+			{
+				// Spaces before a version are skipped (as in nodejs/http_parser).
+				if( ' ' == ch )
+				{
+					m_version_index = 0u;
+					return p + 1;
+				}
+
+				// ICE/x.y is also accepted for SOURCE requests
+				// (as in nodejs/http_parser). "ICE/" is aligned
+				// to the end of "HTTP/".
+				if( 'I' == ch && HTTP_SOURCE == m_parser->method )
+				{
+					m_ice_protocol = true;
+					m_version_index = 2u;
+					return p + 1;
+				}
+			}
+
+			if( index < 5u )
+			{
+				if( ( m_ice_protocol ? " ICE/" : "HTTP/" )[ index ] != ch )
+					set_error( HPE_INVALID_CONSTANT );
+			}
+			else if( 5u == index || 7u == index )
+			{
+				if( '0' <= ch && ch <= '9' )
+					( 5u == index ? m_parser->http_major : m_parser->http_minor ) =
+							static_cast< unsigned short >( ch - '0' );
+				else
+					set_error( HPE_INVALID_VERSION );
+			}
+			else if( 6u == index )
+			{
+				if( '.' != ch )
+					set_error( HPE_INVALID_VERSION );
+			}
+			else if( '\r' == ch )
+				m_state = state_t::request_line_lf;
+			else if( '\n' == ch )
+				m_state = state_t::field_start;
+			else
+				set_error( HPE_INVALID_VERSION );
+
+			return HPE_OK == m_parser->http_errno ? p + 1 : p;
+		}
+
+		const char *
+		on_field_start( const char * p )
+		{
+			const char ch = *p;
+
+			if( ( ' ' == ch || '\t' == ch ) && m_has_field )
+			{
+				// obs-fold: the value continues on the next line.
+				// Like nodejs/http_parser the whitespace of the fold
+				// is a part of the value, but leading whitespace of
+				// an empty value is still skipped.
+				m_state = m_value_has_chars ?
+						state_t::value : state_t::value_ws;
+				return p;
+			}
+
+			if( m_has_field )
+			{
+				m_has_field = false;
+				if( !handle_special_field() )
+					return p;
+			}
+
+			if( '\r' == ch )
+			{
+				m_state = state_t::headers_lf;
+				return p + 1;
+			}
+
+			if( '\n' == ch )
+			{
+				// The LF will be handled by the next state.
+				m_state = state_t::headers_lf;
+				return p;
+			}
+
+			m_name_size = 0u;
+			m_value_reported = false;
+			m_value_has_chars = false;
+			m_special_value.clear();
+			m_state = state_t::field_name;
+
+			return p;
+		}
+
+		const char *
+		on_field_name( const char * p, const char * end )
+		{
+			const char * const from = p;
+			for( ; p != end && is_char_of( *p, token_char ); ++p )
+			{
+				if( m_name_size < max_special_name_size )
+					m_name[ m_name_size ] = static_cast< char >( *p | 0x20 );
+				++m_name_size;
+			}
+
+			// Like nodejs/http_parser a name that is ended by an invalid
+			// char isn't reported.
+			if( p != end && ( ':' != *p || 0u == m_name_size ) )
+			{
+				set_error( HPE_INVALID_HEADER_TOKEN );
+				return p;
+			}
+
+			if( p != from )
+			{
+				notify_data(
+						m_settings->on_header_field,
+						from,
+						static_cast< std::size_t >( p - from ),
+						HPE_CB_header_field );
+				if( HPE_OK != m_parser->http_errno || p == end )
+					return p;
+			}
+
+			m_special_field = m_trailing ? special_field_t::none : detect_special_field();
+			m_has_field = true;
+			m_state = state_t::value_ws;
+
+			return p + 1;
+		}
+
+		RESTINIO_NODISCARD
+		special_field_t
+		detect_special_field() const noexcept
+		{
+			const auto is = [this]( const char * name, std::size_t size ) {
+				return size == m_name_size && 0 == std::memcmp( name, m_name, size );
+			};
+
+			if( is( "content-length", 14u ) )
+				return special_field_t::content_length;
+			if( is( "transfer-encoding", 17u ) )
+				return special_field_t::transfer_encoding;
+			if( is( "connection", 10u ) )
+				return special_field_t::connection;
+			if( is( "upgrade", 7u ) )
+				return special_field_t::upgrade;
+
+			return special_field_t::none;
+		}
+
+		const char *
+		on_value_ws( const char * p, const char * end )
+		{
+			while( p != end && ( ' ' == *p || '\t' == *p ) )
+				++p;
+
+			if( p != end )
+				m_state = state_t::value;
+
+			return p;
+		}
+
+		const char *
+		on_value( const char * p, const char * end )
+		{
+			const char * const stop = find_first< value_end_scanner_t >( p, end );
+
+			// Like nodejs/http_parser a part of a value that is ended by
+			// an invalid char isn't reported.
+			if( stop != end && '\r' != *stop && '\n' != *stop )
+			{
+				set_error( HPE_INVALID_HEADER_TOKEN );
+				return stop;
+			}
+
+			// The same for a part of a value that isn't terminated in
+			// this portion of data and exceeds the limit for the head.
+			// A terminated value is reported and the limit is checked
+			// by execute().
+			if( m_parser->nread >= max_head_size || ( stop == end &&
+					m_parser->nread + static_cast< std::size_t >( stop - p ) >
+						max_head_size ) )
+			{
+				set_error( HPE_HEADER_OVERFLOW );
+				return m_parser->nread >= max_head_size ? p : stop - 1;
+			}
+
+			if( special_field_t::content_length == m_special_field )
+			{
+				const char * const invalid =
+						find_invalid_content_length_char( p, stop );
+				if( invalid != stop )
+					return invalid;
+			}
+
+			if( stop != p || ( stop != end && !m_value_reported ) )
+			{
+				// An empty value is reported too, otherwise the field
+				// won't be stored.
+				on_value_part( p, static_cast< std::size_t >( stop - p ) );
+				if( HPE_OK != m_parser->http_errno || stop == end )
+					return stop;
+			}
+
+			switch( *stop )
+			{
+				case '\r':
+					m_state = state_t::value_lf;
+				break;
+
+				default:
+					m_state = state_t::field_start;
+				break;
+			}
+
+			return stop + 1;
+		}
+
+		//! Find the char that makes the value of Content-Length invalid.
+		/*!
+		 * Like nodejs/http_parser the value is checked char by char, so
+		 * the error is reported at the invalid char and the part of the
+		 * value before it isn't reported.
+		 *
+		 * @return @a to if all chars are valid.
+		 */
+		RESTINIO_NODISCARD
+		const char *
+		find_invalid_content_length_char( const char * from, const char * to )
+		{
+			std::uint64_t value = 0u;
+			bool ws = false;
+			const auto handle = [&]( char ch ) noexcept {
+				if( ' ' == ch )
+				{
+					ws = true;
+					return true;
+				}
+				if( ws || ch < '0' || ch > '9' ||
+					value > ( ULLONG_MAX - 10u ) / 10u )
+					return false;
+				value = value * 10u + static_cast< unsigned >( ch - '0' );
+				return true;
+			};
+
+			// The already reported part of the value is valid.
+			for( const char ch : m_special_value )
+				(void)handle( ch );
+
+			for( const char * p = from; p != to; ++p )
+			{
+				if( !handle( *p ) )
+				{
+					set_error( HPE_INVALID_CONTENT_LENGTH );
+					return p;
+				}
+
+				if( m_special_value.empty() && p == from &&
+					0u != ( m_parser->flags & F_CONTENTLENGTH ) )
+				{
+					set_error( HPE_UNEXPECTED_CONTENT_LENGTH );
+					return p;
+				}
+			}
+
+			return to;
+		}
+
+		void
+		on_value_part( const char * at, std::size_t length )
+		{
+			m_value_reported = true;
+			if( length )
+				m_value_has_chars = true;
+
+			if( special_field_t::none != m_special_field )
+			{
+				if( m_special_value.size() + length > max_special_value_size )
+				{
+					set_error( HPE_HEADER_OVERFLOW );
+					return;
+				}
+				m_special_value.append( at, length );
+			}
+
+			notify_data(
+					m_settings->on_header_value,
+					at,
+					length,
+					HPE_CB_header_value );
+		}
+
+		//! Handle the value of a field that affects the parsing.
+		/*!
+		 * @return false in the case of an error.
+		 */
+		RESTINIO_NODISCARD
+		bool
+		handle_special_field()
+		{
+			switch( m_special_field )
+			{
+				case special_field_t::none:
+				break;
+
+				case special_field_t::content_length:
+				{
+					std::uint64_t value = 0u;
+					const auto & v = m_special_value;
+					std::size_t size = v.size();
+					while( size && ( ' ' == v[ size - 1u ] || '\t' == v[ size - 1u ] ) )
+						--size;
+
+					if( 0u == size )
+					{
+						set_error( HPE_INVALID_CONTENT_LENGTH );
+						return false;
+					}
+
+					for( std::size_t i = 0u; i != size; ++i )
+					{
+						const char ch = v[ i ];
+						if( ch < '0' || ch > '9' ||
+							value > ( ULLONG_MAX - 10u ) / 10u )
+						{
+							set_error( HPE_INVALID_CONTENT_LENGTH );
+							return false;
+						}
+						value = value * 10u + static_cast< unsigned >( ch - '0' );
+					}
+
+					if( 0u != ( m_parser->flags & F_CONTENTLENGTH ) )
+					{
+						set_error( HPE_UNEXPECTED_CONTENT_LENGTH );
+						return false;
+					}
+
+					m_parser->flags |= F_CONTENTLENGTH;
+					m_parser->content_length = value;
+				}
+				break;
+
+				case special_field_t::transfer_encoding:
+					m_has_transfer_encoding = true;
+					// The message is chunked only if "chunked" is
+					// the last coding.
+					m_parser->flags &= ~static_cast< unsigned >( F_CHUNKED );
+					for_each_token( [this]( const char * token, std::size_t size ) {
+						if( is_token( token, size, "chunked", 7u ) )
+							m_parser->flags |= F_CHUNKED;
+						else
+							m_parser->flags &= ~static_cast< unsigned >( F_CHUNKED );
+					} );
+				break;
+
+				case special_field_t::connection:
+					for_each_token( [this]( const char * token, std::size_t size ) {
+						if( is_token( token, size, "keep-alive", 10u ) )
+							m_parser->flags |= F_CONNECTION_KEEP_ALIVE;
+						else if( is_token( token, size, "close", 5u ) )
+							m_parser->flags |= F_CONNECTION_CLOSE;
+						else if( is_token( token, size, "upgrade", 7u ) )
+							m_parser->flags |= F_CONNECTION_UPGRADE;
+					} );
+				break;
+
+				case special_field_t::upgrade:
+					m_parser->flags |= F_UPGRADE;
+				break;
+			}
+
+			return true;
+		}
+
+		//! Call a lambda for every comma-separated item of a special field.
+		template< typename Lambda >
+		void
+		for_each_token( Lambda && lambda ) const
+		{
+			const char * p = m_special_value.data();
+			const char * const end = p + m_special_value.size();
+			while( p != end )
+			{
+				while( p != end && ( ' ' == *p || '\t' == *p || ',' == *p ) )
+					++p;
+
+				const char * const token = p;
+				while( p != end && ',' != *p )
+					++p;
+
+				const char * token_end = p;
+				while( token_end != token &&
+					( ' ' == token_end[ -1 ] || '\t' == token_end[ -1 ] ) )
+					--token_end;
+
+				if( token_end != token )
+					lambda( token, static_cast< std::size_t >( token_end - token ) );
+			}
+		}
+
+		RESTINIO_NODISCARD
+		static bool
+		is_token(
+			const char * token,
+			std::size_t size,
+			const char * lower_case_expected,
+			std::size_t expected_size ) noexcept
+		{
+			if( size != expected_size )
+				return false;
+
+			for( std::size_t i = 0u; i != size; ++i )
+				if( ( token[ i ] | 0x20 ) != lower_case_expected[ i ] )
+					return false;
+
+			return true;
+		}
+
+		const char *
+		on_headers_lf( const char * p )
+		{
+			if( '\n' != *p )
+			{
+				set_error( HPE_LF_EXPECTED );
+				return p;
+			}
+
+			if( m_trailing )
+			{
+				// The end of a chunked message.
+				notify( m_settings->on_chunk_complete, HPE_CB_chunk_complete );
+				if( HPE_OK == m_parser->http_errno )
+					complete_message();
+				return p + 1;
+			}
+
+			const unsigned flags = m_parser->flags;
+			if( m_has_transfer_encoding && 0u != ( flags & F_CONTENTLENGTH ) )
+			{
+				// RFC 7230, 3.3.3: Transfer-Encoding and Content-Length
+				// can't be used together.
+				set_error( HPE_UNEXPECTED_CONTENT_LENGTH );
+				return p;
+			}
+
+			m_parser->upgrade =
+					( 0u != ( flags & F_UPGRADE ) &&
+						0u != ( flags & F_CONNECTION_UPGRADE ) ) ||
+					HTTP_CONNECT == m_parser->method;
+
+			// The LF is consumed in headers_done state. So if the parser
+			// is paused by the callback there will be data for the next
+			// call of execute().
+			m_state = state_t::headers_done;
+
+			if( m_settings->on_headers_complete )
+			{
+				switch( m_settings->on_headers_complete( m_parser ) )
+				{
+					case 0: break;
+
+					case 2:
+						m_parser->upgrade = 1u;
+						m_parser->flags |= F_SKIPBODY;
+					break;
+
+					case 1:
+						m_parser->flags |= F_SKIPBODY;
+					break;
+
+					default:
+						set_error( HPE_CB_headers_complete );
+				}
+			}
+
+			return p;
+		}
+
+		const char *
+		on_headers_done( const char * p )
+		{
+			m_parser->nread = 0u;
+
+			const auto flags = m_parser->flags;
+			const auto content_length = m_parser->content_length;
+			const bool has_body = 0u != ( flags & F_CHUNKED ) ||
+					( 0u != content_length && ULLONG_MAX != content_length );
+
+			// The body of CONNECT belongs to a different protocol.
+			if( ( m_parser->upgrade && HTTP_CONNECT == m_parser->method ) ||
+				0u != ( flags & F_SKIPBODY ) )
+				complete_message();
+			else if( 0u != ( flags & F_CHUNKED ) )
+				m_state = state_t::chunk_size_start;
+			else if( m_has_transfer_encoding && !m_parser->upgrade )
+			{
+				// RFC 7230, 3.3.3: the length of a request body
+				// can't be determined. Like nodejs/http_parser it's
+				// detected after on_headers_complete.
+				set_error( HPE_INVALID_TRANSFER_ENCODING );
+				return p;
+			}
+			else if( !has_body )
+				complete_message();
+			else
+				m_state = state_t::body_identity;
+
+			return p + 1;
+		}
+
+		const char *
+		on_body_identity( const char * p, const char * end )
+		{
+			const auto size = take_body_part( p, end );
+			p += size;
+
+			if( 0u == m_parser->content_length )
+			{
+				if( HPE_OK == m_parser->http_errno )
+					complete_message();
+				else
+				{
+					// The last byte is left for the next call of execute()
+					// (it is consumed by message_done state).
+					m_state = state_t::message_done;
+					--p;
+				}
+			}
+
+			return p;
+		}
+
+		//! Pass the next part of the body to the callback.
+		std::size_t
+		take_body_part( const char * p, const char * end )
+		{
+			const auto available = static_cast< std::uint64_t >( end - p );
+			const auto size = static_cast< std::size_t >(
+					m_parser->content_length < available ?
+							m_parser->content_length : available );
+
+			m_parser->content_length -= size;
+			notify_data( m_settings->on_body, p, size, HPE_CB_body );
+
+			return size;
+		}
+
+		void
+		complete_message()
+		{
+			m_state = state_t::start;
+			notify( m_settings->on_message_complete, HPE_CB_message_complete );
+
+			// The rest of data belongs to a different protocol
+			// (even if the upgrade request has a body).
+			if( m_parser->upgrade )
+				m_stop = true;
+		}
+
+		RESTINIO_NODISCARD
+		static int
+		hex_digit( char ch ) noexcept
+		{
+			if( '0' <= ch && ch <= '9' )
+				return ch - '0';
+
+			const char lower = static_cast< char >( ch | 0x20 );
+			if( 'a' <= lower && lower <= 'f' )
+				return lower - 'a' + 10;
+
+			return -1;
+		}
+
+		const char *
+		on_chunk_size_start( const char * p )
+		{
+			const auto digit = hex_digit( *p );
+			if( digit < 0 )
+			{
+				set_error( HPE_INVALID_CHUNK_SIZE );
+				return p;
+			}
+
+			m_chunk_size = static_cast< std::uint64_t >( digit );
+			m_state = state_t::chunk_size;
+
+			return p + 1;
+		}
+
+		const char *
+		on_chunk_size( const char * p )
+		{
+			const char ch = *p;
+			const auto digit = hex_digit( ch );
+			if( digit >= 0 )
+			{
+				// The same limit as in nodejs/http_parser.
+				if( m_chunk_size > ( ULLONG_MAX - 16u ) / 16u )
+				{
+					set_error( HPE_INVALID_CONTENT_LENGTH );
+					return p;
+				}
+
+				m_chunk_size = ( m_chunk_size << 4u ) |
+						static_cast< std::uint64_t >( digit );
+				return p + 1;
+			}
+
+			switch( ch )
+			{
+				case ';':
+				case ' ':
+					m_state = state_t::chunk_ext;
+					return p + 1;
+
+				case '\r':
+					m_state = state_t::chunk_size_lf;
+					return p + 1;
+			}
+
+			set_error( HPE_INVALID_CHUNK_SIZE );
+			return p;
+		}
+
+		const char *
+		on_chunk_ext( const char * p, const char * end )
+		{
+			// Chunk extensions are ignored.
+			while( p != end && '\r' != *p && '\n' != *p )
+				++p;
+
+			if( p != end )
+			{
+				m_state = state_t::chunk_size_lf;
+				if( '\r' == *p )
+					++p;
+			}
+
+			return p;
+		}
+
+		const char *
+		on_chunk_size_lf( const char * p )
+		{
+			if( '\n' != *p )
+			{
+				set_error( HPE_LF_EXPECTED );
+				return p;
+			}
+
+			m_parser->content_length = m_chunk_size;
+			if( 0u == m_chunk_size )
+			{
+				// The last chunk, trailing fields can follow.
+				m_parser->flags |= F_TRAILING;
+				m_trailing = true;
+				m_has_field = false;
+				m_state = state_t::field_start;
+			}
+			else
+				m_state = state_t::chunk_data;
+
+			notify( m_settings->on_chunk_header, HPE_CB_chunk_header );
+
+			return p + 1;
+		}
+
+		const char *
+		on_chunk_data( const char * p, const char * end )
+		{
+			p += take_body_part( p, end );
+
+			if( 0u == m_parser->content_length )
+				m_state = state_t::chunk_data_cr;
+
+			return p;
+		}
+
+		const char *
+		on_chunk_data_cr( const char * p )
+		{
+			switch( *p )
+			{
+				case '\r':
+					m_state = state_t::chunk_data_lf;
+					return p + 1;
+
+				case '\n':
+					m_state = state_t::chunk_data_lf;
+					return p;
+			}
+
+			set_error( HPE_INVALID_CHUNK_SIZE );
+			return p;
+		}
+
+		const char *
+		on_chunk_data_lf( const char * p )
+		{
+			if( '\n' != *p )
+			{
+				set_error( HPE_LF_EXPECTED );
+				return p;
+			}
+
+			m_state = state_t::chunk_size_start;
+			notify( m_settings->on_chunk_complete, HPE_CB_chunk_complete );
+
+			return p + 1;
+		}
+
+		//! The current state.
+		state_t m_state{ state_t::start };
+
+		//! Parser and settings for the current call of execute().
+		//! \{
+		http_parser * m_parser{ nullptr };
+		const http_parser_settings * m_settings{ nullptr };
+		//! \}
+
+		//! Should the parsing be stopped after the current step?
+		bool m_stop{ false };
+
+		//! The name of the method.
+		char m_method[ max_method_size ];
+		std::size_t m_method_size{ 0u };
+
+		//! Has a part of the request target been found?
+		bool m_url_started{ false };
+		//! The state of the check of the request target.
+		url_state_t m_url_state{ url_state_t::start };
+
+		//! The index of the next char in "HTTP/x.y".
+		unsigned m_version_index{ 0u };
+		//! Is ICE/x.y used instead of HTTP/x.y?
+		bool m_ice_protocol{ false };
+
+		//! Lowercase prefix of the name of the current field.
+		char m_name[ max_special_name_size ];
+		//! The whole size of the name of the current field.
+		std::size_t m_name_size{ 0u };
+
+		//! The kind of the current field.
+		special_field_t m_special_field{ special_field_t::none };
+		//! The value of the current field if it's a special one.
+		std::string m_special_value;
+
+		//! Has the name of a field been parsed (and its value not handled yet)?
+		bool m_has_field{ false };
+		//! Has a part of the value of the current field been reported?
+		bool m_value_reported{ false };
+		//! Has a non-empty part of the value been reported?
+		bool m_value_has_chars{ false };
+		//! Are trailing fields of a chunked message parsed?
+		bool m_trailing{ false };
+		//! Has Transfer-Encoding field been found?
+		bool m_has_transfer_encoding{ false };
+
+		//! The size of the current chunk.
+		std::uint64_t m_chunk_size{ 0u };
+};
+
+} /* namespace simd_http_parser */
+
+} /* namespace impl */
+
+} /* namespace restinio */
+
+#undef RESTINIO_SIMD_HTTP_PARSER_TARGET_END
+#undef RESTINIO_SIMD_HTTP_PARSER_TARGET_BEGIN
+#undef RESTINIO_SIMD_HTTP_PARSER_PRAGMA
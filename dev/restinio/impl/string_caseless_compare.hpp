@@ -14,6 +14,9 @@
 #include <restinio/impl/to_lower_lut.hpp>
 #include <restinio/string_view.hpp>
 
+#include <cstdint>
+#include <cstring>
+
 namespace restinio
 {
 
@@ -84,6 +87,47 @@ is_equal_caseless( string_view_t a, string_view_t b ) noexcept
 	return is_equal_caseless( a.data(), a.size(), b.data(), b.size() );
 }
 
+//
+// caseless_hash()
+//
+
+//! A hash of a string that doesn't depend on the case of letters.
+/*!
+ * It is a variant of FNV-1a hash that takes 4 characters at a step.
+ * Characters are converted to lower case by setting of 0x20 bit.
+ * It also maps some non-letter characters to each other but it is
+ * acceptable for a hash because the equality of strings is checked by
+ * is_equal_caseless().
+ *
+ * @since v.0.6.18
+ */
+inline std::uint32_t
+caseless_hash( string_view_t s ) noexcept
+{
+	constexpr std::uint32_t fnv_prime = 16777619u;
+
+	const char * p = s.data();
+	std::size_t size = s.size();
+
+	std::uint32_t result = 2166136261u;
+	for( ; size >= 4u; p += 4, size -= 4u )
+	{
+		std::uint32_t word;
+		std::memcpy( &word, p, sizeof( word ) );
+
+		result = ( result ^ ( word | 0x20202020u ) ) * fnv_prime;
+		// High bits of a word should affect low bits of the hash.
+		result ^= result >> 15;
+	}
+
+	for( ; size; ++p, --size )
+		result = ( result ^
+				( static_cast< std::uint32_t >(
+						static_cast< unsigned char >( *p ) ) | 0x20u ) ) * fnv_prime;
+
+	return result;
+}
+
 } /* namespace impl */
 
 } /* namespace restinio */
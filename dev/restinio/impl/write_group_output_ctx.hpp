@@ -89,13 +89,35 @@ class write_group_output_ctx_t
 	}
 
 	public:
+		//! Get the default maximum size of data of write groups that
+		//! can be appended to the current one.
+		/*!
+		 * @since v.0.6.18
+		 */
+		static constexpr std::size_t
+		default_max_coalesced_bytes() noexcept
+		{
+			return 64u * 1024u;
+		}
+
 		//! Contruct an object.
 		/*
 			Space for m_asio_bufs is reserved to be ready to store max_iov_len() asio bufs.
+
+			Since v.0.6.18 space for one write group is reserved too.
+			Space for write groups that are appended to the current one
+			is allocated only when they are appended.
+
+			Since v.0.6.18 the limit for the size of data of appended
+			write groups is passed to the constructor. Zero disables
+			appending of groups with data.
 		*/
-		write_group_output_ctx_t()
+		explicit write_group_output_ctx_t(
+			std::size_t max_coalesced_bytes = default_max_coalesced_bytes() )
+			:	m_max_coalesced_bytes{ max_coalesced_bytes }
 		{
 			m_asio_bufs.reserve( max_iov_len() );
+			m_write_groups.reserve( 1u );
 		}
 
 		//! Trivial write operaton.
@@ -232,15 +254,103 @@ class write_group_output_ctx_t
 		struct none_write_operation_t {};
 
 		//! Check if data is trunsmitting now
-		bool transmitting() const noexcept { return static_cast< bool >( m_current_wg ); }
+		bool transmitting() const noexcept { return !m_write_groups.empty(); }
 
 		//! Start handlong next write group.
+		/*!
+		 * @note
+		 * Since v.0.6.18 the write group is stored in a container with
+		 * space for at least one item (it is reserved in the constructor
+		 * and isn't released by clear()), so emplace_back never
+		 * reallocates here.
+		 */
 		void
 		start_next_write_group( optional_t< write_group_t > next_wg ) noexcept
 		{
-			m_current_wg = std::move( next_wg );
+			reset_write_group();
+			if( next_wg )
+			{
+				m_items_count = next_wg->items_count();
+				m_write_groups.emplace_back( std::move( *next_wg ) );
+			}
+		}
+
+		//! Get the maximum size of data of write groups that can be
+		//! appended to the current one.
+		/*!
+		 * @since v.0.6.18
+		 */
+		RESTINIO_NODISCARD
+		std::size_t
+		max_coalesced_bytes() const noexcept { return m_max_coalesced_bytes; }
+
+		//! Can a write group be written together with the current ones?
+		/*!
+		 * A group can be coalesced if it contains only trivial buffers and
+		 * the total count of buffers (and the count of groups) doesn't
+		 * exceed max_iov_len() and the total size of appended groups
+		 * doesn't exceed max_coalesced_bytes().
+		 *
+		 * @since v.0.6.18
+		 */
+		RESTINIO_NODISCARD
+		bool
+		can_coalesce( const write_group_t & wg ) const
+		{
+			if( !transmitting() ||
+				m_write_groups.size() == max_iov_len() ||
+				m_items_count + wg.items_count() > max_iov_len() )
+				return false;
+
+			std::size_t bytes = m_coalesced_bytes;
+			for( const auto & item : wg.items() )
+			{
+				if( writable_item_type_t::trivial_write_operation !=
+						item.write_type() )
+					return false;
+
+				bytes += item.size();
+			}
+
+			return bytes <= m_max_coalesced_bytes;
+		}
+
+		//! Append a write group that will be written together with
+		//! the current ones.
+		/*!
+		 * Buffers of the appended group are written by the same
+		 * gather write operation as the previous ones (if it is possible).
+		 * After-write notificators of all groups are invoked in the order
+		 * groups were added.
+		 *
+		 * Space for the group is allocated on demand, it is kept for
+		 * the next write groups.
+		 *
+		 * @pre can_coalesce(wg) is true.
+		 *
+		 * @since v.0.6.18
+		 */
+		void
+		append_write_group( write_group_t wg )
+		{
+			assert( can_coalesce( wg ) );
+
+			m_write_groups.emplace_back( std::move( wg ) );
+
+			const auto & appended = m_write_groups.back();
+			m_items_count += appended.items_count();
+			for( const auto & item : appended.items() )
+				m_coalesced_bytes += item.size();
 		}
 
+		//! Get the count of write groups that are being written.
+		/*!
+		 * @since v.0.6.18
+		 */
+		RESTINIO_NODISCARD
+		std::size_t
+		write_groups_count() const noexcept { return m_write_groups.size(); }
+
 		//! An alias for variant holding write operation specifics.
 		using solid_write_operation_variant_t =
 			variant_t<
@@ -252,15 +362,18 @@ class write_group_output_ctx_t
 		solid_write_operation_variant_t
 		extract_next_write_operation()
 		{
-			assert( m_current_wg );
+			assert( transmitting() );
 
 			solid_write_operation_variant_t result{ none_write_operation_t{} };
 
-			if( m_next_writable_item_index < m_current_wg->items_count() )
+			skip_finished_write_groups();
+
+			if( m_current_wg_index < m_write_groups.size() )
 			{
 				// Has writable items.
 				const auto next_wi_type =
-					m_current_wg->items()[ m_next_writable_item_index ].write_type();
+					current_write_group().items()[ m_next_writable_item_index ]
+						.write_type();
 
 				if( writable_item_type_t::trivial_write_operation == next_wi_type )
 				{
@@ -282,53 +395,83 @@ class write_group_output_ctx_t
 		void
 		fail_write_group( const asio_ns::error_code & ec )
 		{
-			assert( m_current_wg );
+			assert( transmitting() );
 
-			invoke_after_write_notificator_if_necessary( ec );
-			m_current_wg.reset();
 			m_sendfile_operation.reset();
+			invoke_after_write_notificator_if_necessary( ec );
 		}
 
 		//! Finish writing group normally.
 		void
 		finish_write_group()
 		{
-			assert( m_current_wg );
+			assert( transmitting() );
 
 			invoke_after_write_notificator_if_necessary( asio_ns::error_code{} );
-			reset_write_group();
 		}
 
 	private:
 		//! Reset the write group and associated context.
 		void
-		reset_write_group()
+		reset_write_group() noexcept
 		{
-			m_current_wg.reset();
+			m_write_groups.clear();
+			m_current_wg_index = 0;
 			m_next_writable_item_index = 0;
+			m_items_count = 0;
+			m_coalesced_bytes = 0;
+		}
+
+		//! Get the write group whose items are being written.
+		write_group_t &
+		current_write_group() noexcept
+		{
+			return m_write_groups[ m_current_wg_index ];
 		}
 
-		//! Execute notification callback if necessary.
+		//! Move to the first write group that still has unwritten items.
 		void
-		invoke_after_write_notificator_if_necessary( const asio_ns::error_code & ec )
+		skip_finished_write_groups() noexcept
 		{
-			try
+			while( m_current_wg_index < m_write_groups.size() &&
+				m_next_writable_item_index >= current_write_group().items_count() )
 			{
-				m_current_wg->invoke_after_write_notificator_if_exists( ec );
+				++m_current_wg_index;
+				m_next_writable_item_index = 0;
 			}
-			catch( const std::exception & ex )
+		}
+
+		//! Execute notification callbacks if necessary.
+		/*!
+		 * Notificators of all write groups are invoked in the order
+		 * the groups were added even if some of them throws.
+		 * Then write groups are reset and the first error is reported.
+		 */
+		void
+		invoke_after_write_notificator_if_necessary( const asio_ns::error_code & ec )
+		{
+			optional_t< std::string > first_error_what;
+
+			for( auto & wg : m_write_groups )
 			{
-				// Actualy no need to reset m_current_wg as a thrown exception
-				// will break working circle of connection.
-				// But as it is used as flag for transmitting()
-				// we reset the object.
-				reset_write_group();
+				try
+				{
+					wg.invoke_after_write_notificator_if_exists( ec );
+				}
+				catch( const std::exception & ex )
+				{
+					if( !first_error_what )
+						first_error_what = std::string{ ex.what() };
+				}
+			}
+
+			reset_write_group();
 
+			if( first_error_what )
 				throw exception_t{
 					fmt::format(
 						RESTINIO_FMT_FORMAT_STRING( "after write callback failed: {}" ),
-						ex.what() ) };
-			}
+						*first_error_what ) };
 		}
 
 		//! Prepare write operation for trivial buffers.
@@ -337,18 +480,22 @@ class write_group_output_ctx_t
 		{
 			m_asio_bufs.clear();
 
-			const auto & items = m_current_wg->items();
 			std::size_t total_size{ 0 };
 
-			for( ;m_next_writable_item_index < items.size() &&
-				writable_item_type_t::trivial_write_operation ==
-					items[ m_next_writable_item_index ].write_type() &&
+			// Buffers can be taken from several consecutive write groups.
+			for( ; m_current_wg_index < m_write_groups.size() &&
 				max_iov_len() > m_asio_bufs.size();
-				++m_next_writable_item_index )
+				skip_finished_write_groups() )
 			{
-				const auto & item = items[ m_next_writable_item_index ];
+				const auto & item =
+					current_write_group().items()[ m_next_writable_item_index ];
+				if( writable_item_type_t::trivial_write_operation !=
+						item.write_type() )
+					break;
+
 				m_asio_bufs.emplace_back( item.buf() );
 				total_size += item.size();
+				++m_next_writable_item_index;
 			}
 
 			assert( !m_asio_bufs.empty() );
@@ -360,21 +507,51 @@ class write_group_output_ctx_t
 		prepare_sendfile_wo()
 		{
 			auto & sf =
-				m_current_wg->items()[ m_next_writable_item_index++ ].sendfile_operation();
+				current_write_group().items()[ m_next_writable_item_index++ ]
+					.sendfile_operation();
 
 			return file_write_operation_t{ sf, m_sendfile_operation };
 		}
 
 		//! Real buffers with data.
-		optional_t< write_group_t > m_current_wg;
+		/*!
+		 * @since v.0.6.18 there can be several write groups that
+		 * are written by the same gather write operations.
+		 */
+		std::vector< write_group_t > m_write_groups;
 
-		//! Keeps track of the next writable item stored in m_current_wg.
+		//! Index of the write group whose items are being written.
+		/*!
+		 * @since v.0.6.18
+		 */
+		std::size_t m_current_wg_index{ 0 };
+
+		//! Keeps track of the next writable item stored in the current
+		//! write group.
 		/*!
 			When emitting next solid write operation
 			we need to know where the next starting item is.
 		*/
 		std::size_t m_next_writable_item_index{ 0 };
 
+		//! Total count of items in all write groups.
+		/*!
+		 * @since v.0.6.18
+		 */
+		std::size_t m_items_count{ 0 };
+
+		//! Limit for the total size of data in appended write groups.
+		/*!
+		 * @since v.0.6.18
+		 */
+		const std::size_t m_max_coalesced_bytes;
+
+		//! Total size of data in appended write groups.
+		/*!
+		 * @since v.0.6.18
+		 */
+		std::size_t m_coalesced_bytes{ 0 };
+
 		//! Asio buffers storage.
 		asio_bufs_container_t m_asio_bufs;
 
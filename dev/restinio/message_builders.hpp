@@ -20,6 +20,7 @@
 #include <restinio/impl/connection_base.hpp>
 
 #include <restinio/impl/header_helpers.hpp>
+#include <restinio/impl/date_field_cache.hpp>
 
 namespace restinio
 {
@@ -29,20 +30,17 @@ namespace restinio
 //
 
 //! Format a timepoint to a string of a propper format.
+/*!
+ * @note
+ * Since v.0.6.18 strftime() isn't used anymore.
+ */
 inline std::string
 make_date_field_value( std::time_t t )
 {
-	const auto tpoint = make_gmtime( t );
-
-	std::array< char, 64 > buf;
-	// TODO: is there a faster way to get time string?
-	strftime(
-		buf.data(),
-		buf.size(),
-		"%a, %d %b %Y %H:%M:%S GMT",
-		&tpoint );
+	std::string result( impl::date_field_value_size, ' ' );
+	impl::format_date_field_value( t, &result[ 0 ] );
 
-	return std::string{ buf.data() };
+	return result;
 }
 
 inline std::string
@@ -77,6 +75,9 @@ class base_response_builder_t
 			,	m_request_id{ request_id }
 		{
 			m_header.should_keep_alive( should_keep_alive );
+
+			if( m_connection && m_connection->add_date_field() )
+				m_header.use_cached_date_field( true );
 		}
 
 		//! Accessors for header.
@@ -315,7 +316,8 @@ class response_builder_t< restinio_controlled_output_t > final
 				if_neccessary_reserve_first_element_for_header();
 
 				m_response_parts[ 0 ] =
-					writable_item_t{ impl::create_header_string( m_header ) };
+					impl::create_header_buffer(
+						m_header, m_connection->response_header_buffer() );
 
 				write_group_t wg{ std::move( m_response_parts ) };
 				wg.status_line_size( calculate_status_line_size() );
@@ -527,7 +529,8 @@ class response_builder_t< user_controlled_output_t > final
 				if_neccessary_reserve_first_element_for_header();
 
 				m_response_parts[ 0 ] =
-					writable_item_t{ impl::create_header_string( m_header ) };
+					impl::create_header_buffer(
+						m_header, conn->response_header_buffer() );
 
 				m_header_was_sent = true;
 				status_line_size = calculate_status_line_size();
@@ -733,7 +736,9 @@ class response_builder_t< chunked_output_t > final
 				prepare_header_for_sending();
 			}
 
-			auto bufs = create_bufs( response_parts_attr_t::final_parts == response_parts_attr );
+			auto bufs = create_bufs(
+					*conn,
+					response_parts_attr_t::final_parts == response_parts_attr );
 			m_header_was_sent = true;
 
 			const response_output_flags_t
@@ -789,7 +794,7 @@ class response_builder_t< chunked_output_t > final
 		}
 
 		writable_items_container_t
-		create_bufs( bool add_zero_chunk )
+		create_bufs( impl::connection_base_t & conn, bool add_zero_chunk )
 		{
 			writable_items_container_t bufs;
 
@@ -809,8 +814,9 @@ class response_builder_t< chunked_output_t > final
 			if( !m_header_was_sent )
 			{
 				bufs.emplace_back(
-					impl::create_header_string(
+					impl::create_header_buffer(
 						m_header,
+						conn.response_header_buffer(),
 						impl::content_length_field_presence_t::skip_content_length ) );
 			}
 
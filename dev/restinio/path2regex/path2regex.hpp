@@ -21,6 +21,9 @@
 
 #include <restinio/exception.hpp>
 #include <restinio/string_view.hpp>
+#include <restinio/optional.hpp>
+
+#include <restinio/impl/to_lower_lut.hpp>
 
 namespace restinio
 {
@@ -362,6 +365,44 @@ enum class token_type_t : std::uint8_t
 	capturing_token
 };
 
+//
+// token_info_t
+//
+
+//! Description of a token of a route.
+/*!
+	Allows to match simple routes without regexes.
+
+	@since v.0.6.18
+*/
+struct token_info_t
+{
+	token_type_t m_type{ token_type_t::plain_string };
+
+	//! Plain string or the prefix of a parameter (not escaped).
+	std::string m_text;
+
+	//! Properties of a parameter (used only for capturing_token).
+	//! \{
+	std::string m_delimiter;
+	bool m_optional{ false };
+	bool m_repeat{ false };
+	//! The default pattern (any chars except the delimiter) is used.
+	bool m_default_pattern{ false };
+	//! \}
+};
+
+//
+// make_default_pattern()
+//
+
+//! Pattern for a parameter without a custom pattern.
+inline std::string
+make_default_pattern( const std::string & delimiter )
+{
+	return "[^" + escape_string( delimiter ) + "]+?";
+}
+
 //
 // token_t
 //
@@ -387,6 +428,11 @@ class token_t
 		{
 			return false;
 		}
+
+		//! Get the description of the token.
+		//! @since v.0.6.18
+		virtual token_info_t
+		info() const = 0;
 };
 
 template < typename Route_Param_Appender >
@@ -405,7 +451,8 @@ class plain_string_token_t final : public token_t< Route_Param_Appender >
 {
 	public:
 		plain_string_token_t( const std::string & path )
-			:	m_escaped_path{ escape_string( path ) }
+			:	m_path{ path }
+			,	m_escaped_path{ escape_string( path ) }
 			,	m_last_char{ path.back() }
 		{}
 
@@ -426,7 +473,20 @@ class plain_string_token_t final : public token_t< Route_Param_Appender >
 			return std::string::npos != delimiters.find( m_last_char );
 		}
 
+		virtual token_info_t
+		info() const override
+		{
+			token_info_t result;
+			result.m_type = token_type_t::plain_string;
+			result.m_text = m_path;
+
+			return result;
+		}
+
 	private:
+		//! Piece of the route as is.
+		//! @since v.0.6.18
+		const std::string m_path;
 		//! Already escaped piece of the route.
 		const std::string m_escaped_path;
 		const char m_last_char;
@@ -461,6 +521,7 @@ class parameter_token_t final : public token_t< Route_Param_Appender >
 			bool partial,
 			std::string pattern )
 			:	m_name{ std::move( name ) }
+			,	m_prefix{ prefix }
 			,	m_escaped_prefix{ escape_string( prefix ) }
 			,	m_delimiter{ std::move( delimiter ) }
 			,	m_optional{ optional }
@@ -511,8 +572,25 @@ class parameter_token_t final : public token_t< Route_Param_Appender >
 			return token_type_t::capturing_token;
 		}
 
+		virtual token_info_t
+		info() const override
+		{
+			token_info_t result;
+			result.m_type = token_type_t::capturing_token;
+			result.m_text = m_prefix;
+			result.m_delimiter = m_delimiter;
+			result.m_optional = m_optional;
+			result.m_repeat = m_repeat;
+			result.m_default_pattern =
+				make_default_pattern( m_delimiter ) == m_pattern;
+
+			return result;
+		}
+
 	private:
 		const Name m_name;
+		//! @since v.0.6.18
+		const std::string m_prefix;
 		const std::string m_escaped_prefix;
 		const std::string m_delimiter;
 		const bool m_optional;
@@ -635,7 +713,7 @@ handle_param_token(
 		}
 		else
 		{
-			pattern = "[^" + escape_string( delimiter ) + "]+?";
+			pattern = make_default_pattern( delimiter );
 		}
 		return pattern;
 	};
@@ -742,6 +820,163 @@ parse( string_view_t route_sv, const options_t & options )
 	return result;
 }
 
+//
+// is_simple_route()
+//
+
+//! Check that a route can be matched without a regex.
+/*!
+	It's possible if the route has default options and every parameter
+	is mandatory, has the default pattern and is followed by '/' or
+	by the end of the route. In that case a parameter takes all chars
+	up to the next '/' exactly as the regex does.
+
+	@since v.0.6.18
+*/
+inline bool
+is_simple_route(
+	const options_t & options,
+	const std::vector< token_info_t > & tokens )
+{
+	if( !options.ending() || "/" != options.delimiter() ||
+		"$" != options.make_ends_with() )
+		return false;
+
+	for( std::size_t i = 0; i < tokens.size(); ++i )
+	{
+		const auto & t = tokens[ i ];
+		if( token_type_t::capturing_token != t.m_type )
+			continue;
+
+		if( t.m_optional || t.m_repeat || !t.m_default_pattern ||
+			"/" != t.m_delimiter )
+			return false;
+
+		if( i + 1 < tokens.size() )
+		{
+			const auto & next = tokens[ i + 1 ].m_text;
+			if( next.empty() || '/' != next.front() )
+				return false;
+		}
+	}
+
+	return true;
+}
+
+//
+// simple_route_matcher_t
+//
+
+//! Matcher for simple routes that doesn't use regexes.
+/*!
+	A route should be checked by is_simple_route().
+
+	The route is represented as a sequence of literals each of them
+	can be followed by a parameter. A parameter takes all chars
+	up to the next '/' (or up to the end of a path).
+
+	@since v.0.6.18
+*/
+class simple_route_matcher_t
+{
+	public:
+		simple_route_matcher_t(
+			const options_t & options,
+			const std::vector< token_info_t > & tokens )
+			:	m_sensitive{ options.sensitive() }
+			,	m_strict{ options.strict() }
+		{
+			item_t item;
+			for( const auto & t : tokens )
+			{
+				item.m_literal += t.m_text;
+				if( token_type_t::capturing_token == t.m_type )
+				{
+					item.m_param = true;
+					m_items.push_back( std::move( item ) );
+					item = item_t{};
+				}
+			}
+
+			if( !item.m_literal.empty() )
+				m_items.push_back( std::move( item ) );
+
+			if( !m_sensitive )
+				for( auto & i : m_items )
+					for( auto & ch : i.m_literal )
+						ch = restinio::impl::to_lower_case( ch );
+		}
+
+		//! Try to match a path.
+		/*!
+			Positions of values of parameters are added to @a values
+			(`{begin, size}` for every parameter).
+
+			@return true if the whole path is matched.
+		*/
+		template< typename Value_Positions >
+		bool
+		match( string_view_t path, Value_Positions & values ) const
+		{
+			std::size_t pos = 0;
+			for( const auto & item : m_items )
+			{
+				if( !starts_with( path, pos, item.m_literal ) )
+					return false;
+
+				pos += item.m_literal.size();
+
+				if( item.m_param )
+				{
+					auto end = path.find( '/', pos );
+					if( string_view_t::npos == end )
+						end = path.size();
+
+					if( end == pos )
+						return false;
+
+					values.push_back( { pos, end - pos } );
+					pos = end;
+				}
+			}
+
+			// The trailing delimiter is optional if the route isn't strict.
+			return path.size() == pos ||
+					( !m_strict && path.size() == pos + 1 && '/' == path[ pos ] );
+		}
+
+	private:
+		//! A literal followed by a parameter.
+		struct item_t
+		{
+			std::string m_literal;
+			bool m_param{ false };
+		};
+
+		bool
+		starts_with(
+			string_view_t path,
+			std::size_t pos,
+			const std::string & literal ) const noexcept
+		{
+			if( path.size() - pos < literal.size() )
+				return false;
+
+			if( m_sensitive )
+				return 0 == path.compare( pos, literal.size(), literal.data(), literal.size() );
+
+			for( std::size_t i = 0; i < literal.size(); ++i )
+				if( restinio::impl::to_lower_case( path[ pos + i ] ) != literal[ i ] )
+					return false;
+
+			return true;
+		}
+
+		std::vector< item_t > m_items;
+		bool m_sensitive;
+		bool m_strict;
+};
+
 //
 // route_regex_matcher_data_t
 //
@@ -770,6 +1005,14 @@ struct route_regex_matcher_data_t
 
 	//! Appenders for captured values (names/indexed groups).
 	param_appender_sequence_t< Route_Param_Appender > m_param_appender_sequence;
+
+	//! Descriptions of tokens of the route.
+	//! @since v.0.6.18
+	std::vector< token_info_t > m_tokens;
+
+	//! Matcher that can be used instead of the regex (only for simple routes).
+	//! @since v.0.6.18
+	optional_t< simple_route_matcher_t > m_simple_matcher;
 };
 
 //
@@ -805,6 +1048,8 @@ tokens2regexp(
 
 			if( token_type_t::capturing_token == appended_token_type )
 				++captured_groups_count;
+
+			result.m_tokens.push_back( t->info() );
 		}
 
 		if( Regex_Engine::max_capture_groups() < captured_groups_count )
@@ -845,6 +1090,9 @@ tokens2regexp(
 		}
 
 		result.m_regex = Regex_Engine::compile_regex( "^" + route, options.sensitive() );
+
+		if( is_simple_route( options, result.m_tokens ) )
+			result.m_simple_matcher = simple_route_matcher_t{ options, result.m_tokens };
 	}
 	catch( const std::exception & ex )
 	{
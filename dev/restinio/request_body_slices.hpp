@@ -0,0 +1,167 @@
+/*
+	restinio
+*/
+
+/*!
+ * @file
+ * @brief A body of incoming request as a chain of read-buffer slices.
+ * @since v.0.6.18
+ */
+
+#pragma once
+
+#include <restinio/string_view.hpp>
+#include <restinio/compiler_features.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace restinio
+{
+
+//
+// request_body_slice_t
+//
+/*!
+ * @brief A fragment of an incoming request body.
+ *
+ * A slice points directly into a buffer that was used for reading
+ * data from a socket. The slice holds a reference to that buffer, so the
+ * buffer won't be reused by the connection until all slices pointing
+ * into it are destroyed.
+ *
+ * @since v.0.6.18
+ */
+class request_body_slice_t
+{
+	//! A holder of the underlying buffer.
+	/*!
+	 * Can be empty if the slice points into a buffer that is owned
+	 * by someone else (for example into a std::string of a request object).
+	 */
+	std::shared_ptr< const void > m_keeper;
+
+	//! The data of the slice.
+	string_view_t m_data;
+
+public:
+	//! Initializing constructor.
+	request_body_slice_t(
+		std::shared_ptr< const void > keeper,
+		string_view_t data ) noexcept
+		:	m_keeper{ std::move( keeper ) }
+		,	m_data{ data }
+	{}
+
+	//! Get a pointer to the data.
+	RESTINIO_NODISCARD
+	const char *
+	data() const noexcept { return m_data.data(); }
+
+	//! Get the size of the data.
+	RESTINIO_NODISCARD
+	std::size_t
+	size() const noexcept { return m_data.size(); }
+
+	//! Get the data as string_view.
+	RESTINIO_NODISCARD
+	string_view_t
+	view() const noexcept { return m_data; }
+};
+
+//
+// request_body_slices_t
+//
+/*!
+ * @brief A body of an incoming request as a sequence of slices.
+ *
+ * Usage example:
+ * @code
+ * auto handler = [](const restinio::request_handle_t & req) {
+ * 	for( const auto & slice : req->body_slices() )
+ * 		output_file.write( slice.data(), slice.size() );
+ * 	...
+ * };
+ * @endcode
+ *
+ * @since v.0.6.18
+ */
+class request_body_slices_t
+{
+	using container_t = std::vector< request_body_slice_t >;
+
+	//! All slices of the body.
+	container_t m_slices;
+
+	//! Total size of all slices.
+	std::size_t m_total_size{ 0u };
+
+public:
+	using const_iterator = container_t::const_iterator;
+
+	request_body_slices_t() = default;
+
+	//! Append another slice to the body.
+	void
+	append( request_body_slice_t slice )
+	{
+		if( slice.size() )
+		{
+			m_total_size += slice.size();
+			m_slices.push_back( std::move( slice ) );
+		}
+	}
+
+	//! Remove all slices.
+	void
+	clear() noexcept
+	{
+		m_slices.clear();
+		m_total_size = 0u;
+	}
+
+	//! Get the total size of the body.
+	RESTINIO_NODISCARD
+	std::size_t
+	size() const noexcept { return m_total_size; }
+
+	//! Is the body empty?
+	RESTINIO_NODISCARD
+	bool
+	empty() const noexcept { return 0u == m_total_size; }
+
+	//! Get the number of slices.
+	RESTINIO_NODISCARD
+	std::size_t
+	slices_count() const noexcept { return m_slices.size(); }
+
+	RESTINIO_NODISCARD
+	const_iterator
+	begin() const noexcept { return m_slices.begin(); }
+
+	RESTINIO_NODISCARD
+	const_iterator
+	end() const noexcept { return m_slices.end(); }
+
+	//! Append the content of the body to a string.
+	void
+	append_to( std::string & to ) const
+	{
+		to.reserve( to.size() + m_total_size );
+		for( const auto & s : m_slices )
+			to.append( s.data(), s.size() );
+	}
+
+	//! Make a copy of the body as a single string.
+	RESTINIO_NODISCARD
+	std::string
+	to_string() const
+	{
+		std::string result;
+		append_to( result );
+		return result;
+	}
+};
+
+} /* namespace restinio */
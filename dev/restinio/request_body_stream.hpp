@@ -0,0 +1,162 @@
+/*
+	restinio
+*/
+
+/*!
+	Handling of request body as a stream of parts.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+#include <restinio/string_view.hpp>
+#include <restinio/http_headers.hpp>
+#include <restinio/chunked_input_info.hpp>
+#include <restinio/impl/connection_base.hpp>
+
+#include <functional>
+#include <memory>
+
+namespace restinio
+{
+
+//
+// body_stream_action_t
+//
+
+//! What should be done after handling of a part of a streamed body.
+/*!
+ * @since v.0.6.18
+ */
+enum class body_stream_action_t
+{
+	//! Parts of the body should be read further.
+	continue_reading,
+	//! Reading of the body should be suspended until
+	//! request_body_stream_control_t::resume_reading() is called.
+	pause_reading,
+	//! The request should be rejected and the connection closed.
+	abort
+};
+
+//
+// request_body_stream_handler_t
+//
+
+//! Interface of a receiver of parts of a request body.
+/*!
+ * If a handler is created for an incoming request then the body of
+ * the request isn't collected in memory. Every part of the body is
+ * passed to on_body_part() right after it is parsed. When the whole
+ * request is received the ordinary request handler is called with
+ * a request object that has an empty body. The stream handler can be
+ * accessed via generic_request_t::body_stream_handler().
+ *
+ * All methods are called on the context of the connection.
+ *
+ * @note
+ * If the connection is closed before the whole body is received
+ * the handler is destroyed without the call of the request handler.
+ *
+ * @since v.0.6.18
+ */
+class request_body_stream_handler_t
+{
+	public:
+		virtual ~request_body_stream_handler_t() = default;
+
+		//! A new chunk of chunked-encoded body is started.
+		/*!
+		 * The offset of the chunk is counted from the beginning of
+		 * the whole body. Data of the chunk will be passed to
+		 * on_body_part() (maybe by several parts).
+		 *
+		 * The same description of chunks will be available via
+		 * generic_request_t::chunked_input_info().
+		 */
+		virtual void
+		on_chunk_started( const chunk_info_t & /*chunk*/ ) {}
+
+		//! A new part of the body is received.
+		/*!
+		 * @attention
+		 * @a data is valid only during the call.
+		 */
+		RESTINIO_NODISCARD
+		virtual body_stream_action_t
+		on_body_part( string_view_t data ) = 0;
+};
+
+//! An alias for unique_ptr to request_body_stream_handler_t.
+/*!
+ * @since v.0.6.18
+ */
+using request_body_stream_handler_unique_ptr_t =
+		std::unique_ptr< request_body_stream_handler_t >;
+
+//
+// request_body_stream_control_t
+//
+
+//! A handle for resuming of reading of a streamed body.
+/*!
+ * An instance of that type is passed to the factory of body stream
+ * handlers. It can be copied and used from any thread.
+ *
+ * @note
+ * The control object holds the connection (like request_handle_t does).
+ * There is no pending I/O operation while reading is paused, so an
+ * instance of the control should be kept until resume_reading() is called.
+ *
+ * @since v.0.6.18
+ */
+class request_body_stream_control_t
+{
+	public:
+		explicit request_body_stream_control_t(
+			impl::connection_handle_t connection ) noexcept
+			:	m_connection{ std::move( connection ) }
+		{}
+
+		//! Resume reading of a body after body_stream_action_t::pause_reading.
+		/*!
+		 * Does nothing if the connection is already closed or
+		 * the reading isn't paused.
+		 */
+		void
+		resume_reading() const
+		{
+			m_connection->resume_request_body_reading();
+		}
+
+	private:
+		impl::connection_handle_t m_connection;
+};
+
+//
+// request_body_stream_handler_factory_t
+//
+
+//! Type of factory for body stream handlers.
+/*!
+ * The factory is called when the header of a request is parsed.
+ * The method and all leading header fields are available at that moment.
+ *
+ * If the factory returns nullptr then the body is collected in
+ * memory as usual.
+ *
+ * @note
+ * If a handler is created then the body isn't limited by
+ * incoming_http_msg_limits_t::max_body_size().
+ *
+ * @since v.0.6.18
+ */
+using request_body_stream_handler_factory_t =
+		std::function<
+				request_body_stream_handler_unique_ptr_t(
+						const http_request_header_t &,
+						request_body_stream_control_t ) >;
+
+} /* namespace restinio */
@@ -14,11 +14,15 @@
 #include <restinio/http_headers.hpp>
 #include <restinio/message_builders.hpp>
 #include <restinio/chunked_input_info.hpp>
+#include <restinio/request_body_slices.hpp>
+#include <restinio/request_body_stream.hpp>
 #include <restinio/impl/connection_base.hpp>
+#include <restinio/impl/request_storage_recycler.hpp>
 
 #include <array>
 #include <functional>
 #include <iosfwd>
+#include <mutex>
 
 namespace restinio
 {
@@ -259,6 +263,40 @@ class generic_request_t final
 			,	m_extra_data_holder{ extra_data_factory }
 		{}
 
+		//! Initializing constructor for the case of zero-copy body.
+		/*!
+		 * The body is kept as a sequence of slices of read buffers.
+		 * A std::string with the whole body is created only if
+		 * body_as_string() is called.
+		 *
+		 * @since v.0.6.18
+		 */
+		template< typename Extra_Data_Factory >
+		generic_request_t(
+			request_id_t request_id,
+			http_request_header_t header,
+			request_body_slices_t body_slices,
+			chunked_input_info_unique_ptr_t chunked_input_info,
+			impl::connection_handle_t connection,
+			endpoint_t remote_endpoint,
+			Extra_Data_Factory & extra_data_factory )
+			:	m_request_id{ request_id }
+			,	m_header{ std::move( header ) }
+			,	m_body_slices{ std::move( body_slices ) }
+			,	m_body_is_sliced{ true }
+			,	m_chunked_input_info{ std::move( chunked_input_info ) }
+			,	m_connection{ std::move( connection ) }
+			,	m_connection_id{ m_connection->connection_id() }
+			,	m_remote_endpoint{ std::move( remote_endpoint ) }
+			,	m_extra_data_holder{ extra_data_factory }
+		{}
+
+		~generic_request_t()
+		{
+			if( m_storage_recycler )
+				m_storage_recycler->put( m_header, m_body );
+		}
+
 		//! Get request header.
 		const http_request_header_t &
 		header() const noexcept
@@ -267,12 +305,87 @@ class generic_request_t final
 		}
 
 		//! Get request body.
+		/*!
+		 * If the body is kept as slices of read buffers (see
+		 * traits_t::use_zero_copy_request_body) the body is copied
+		 * into a std::string on the first call of that method, just
+		 * like body_as_string() does. body_slices() can be used to
+		 * access the body without the copy.
+		 *
+		 * @note
+		 * Since v.0.6.18 this method isn't noexcept.
+		 *
+		 * @throw std::bad_alloc if the copy of the body can't be made.
+		 */
 		const std::string &
-		body() const noexcept
+		body() const
 		{
+			return body_as_string();
+		}
+
+		//! Get request body as a single string.
+		/*!
+		 * If the body is kept as slices of read buffers (see
+		 * traits_t::use_zero_copy_request_body) the body is copied
+		 * into a std::string on the first call of that method.
+		 * Otherwise the body is returned as is.
+		 *
+		 * @throw std::bad_alloc if the copy of the body can't be made.
+		 *
+		 * @since v.0.6.18
+		 */
+		const std::string &
+		body_as_string() const
+		{
+			if( m_body_is_sliced )
+			{
+				std::call_once( m_body_converted, [this] {
+						m_body_slices.append_to( m_body );
+					} );
+			}
+
 			return m_body;
 		}
 
+		//! Get request body as a sequence of slices.
+		/*!
+		 * This method never copies the body. If the body was passed
+		 * as std::string a single slice that points into it is made
+		 * on the first call.
+		 *
+		 * Usage example:
+		 * @code
+		 * for( const auto & slice : req->body_slices() )
+		 * 	output_file.write( slice.data(), slice.size() );
+		 * @endcode
+		 *
+		 * @since v.0.6.18
+		 */
+		const request_body_slices_t &
+		body_slices() const
+		{
+			if( !m_body_is_sliced )
+			{
+				std::call_once( m_body_converted, [this] {
+						m_body_slices.append( request_body_slice_t{ {}, m_body } );
+					} );
+			}
+
+			return m_body_slices;
+		}
+
+		//! Get the size of request body.
+		/*!
+		 * This method never copies the body.
+		 *
+		 * @since v.0.6.18
+		 */
+		std::size_t
+		body_size() const noexcept
+		{
+			return m_body_is_sliced ? m_body_slices.size() : m_body.size();
+		}
+
 		template < typename Output = restinio_controlled_output_t >
 		auto
 		create_response( http_status_line_t status_line = status_ok() )
@@ -309,6 +422,51 @@ class generic_request_t final
 			return m_chunked_input_info.get();
 		}
 
+		//! Get the handler that received the body of the request.
+		/*!
+		 * @note
+		 * nullptr will be returned if the body wasn't streamed
+		 * (see server_settings_t::request_body_stream_handler_factory()).
+		 *
+		 * @since v.0.6.18
+		 */
+		nullable_pointer_t< request_body_stream_handler_t >
+		body_stream_handler() const noexcept
+		{
+			return m_body_stream_handler.get();
+		}
+
+		//! Attach the handler that received the body of the request.
+		/*!
+		 * @note
+		 * It's intended to be used by RESTinio's internals.
+		 *
+		 * @since v.0.6.18
+		 */
+		friend void
+		attach_body_stream_handler(
+			generic_request_t & req,
+			request_body_stream_handler_unique_ptr_t handler ) noexcept
+		{
+			req.m_body_stream_handler = std::move( handler );
+		}
+
+		//! Attach the slot to that the memory of the header and
+		//! the body is returned on the destruction of the request.
+		/*!
+		 * @note
+		 * It's intended to be used by RESTinio's internals.
+		 *
+		 * @since v.0.6.18
+		 */
+		friend void
+		attach_storage_recycler(
+			generic_request_t & req,
+			std::shared_ptr< impl::request_storage_recycler_t > recycler ) noexcept
+		{
+			req.m_storage_recycler = std::move( recycler );
+		}
+
 		/*!
 		 * @brief Get writeable access to extra-data object incorporated
 		 * into a request object.
@@ -408,8 +566,45 @@ class generic_request_t final
 		}
 
 		const request_id_t m_request_id;
-		const http_request_header_t m_header;
-		const std::string m_body;
+
+		//! The header of the request.
+		/*!
+		 * @note
+		 * It isn't const since v.0.6.18 because its memory can be
+		 * returned to m_storage_recycler in the destructor.
+		 */
+		http_request_header_t m_header;
+
+		//! The body as a single string.
+		/*!
+		 * @note
+		 * It's mutable since v.0.6.18 because it can be created from
+		 * m_body_slices in const body_as_string() method.
+		 */
+		mutable std::string m_body;
+
+		//! The body as a sequence of slices.
+		/*!
+		 * If the body was passed as std::string it's empty until
+		 * the first call of body_slices(). Then there is just one
+		 * slice that points into m_body.
+		 *
+		 * @since v.0.6.18
+		 */
+		mutable request_body_slices_t m_body_slices;
+
+		//! Is the body passed as a sequence of slices?
+		/*!
+		 * @since v.0.6.18
+		 */
+		const bool m_body_is_sliced{ false };
+
+		//! Flag for creation of m_body from m_body_slices or
+		//! m_body_slices from m_body.
+		/*!
+		 * @since v.0.6.18
+		 */
+		mutable std::once_flag m_body_converted;
 
 		//! Optional description for chunked-encoding.
 		/*!
@@ -420,6 +615,20 @@ class generic_request_t final
 		 */
 		const chunked_input_info_unique_ptr_t m_chunked_input_info;
 
+		//! Handler of the streamed body.
+		/*!
+		 * @since v.0.6.18
+		 */
+		request_body_stream_handler_unique_ptr_t m_body_stream_handler;
+
+		//! The slot for reusing the memory of the header and the body.
+		/*!
+		 * It's present only if traits_t::use_request_arena is true.
+		 *
+		 * @since v.0.6.18
+		 */
+		std::shared_ptr< impl::request_storage_recycler_t > m_storage_recycler;
+
 		impl::connection_handle_t m_connection;
 		const connection_id_t m_connection_id;
 
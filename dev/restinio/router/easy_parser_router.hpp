@@ -14,9 +14,15 @@
 #include <restinio/router/impl/target_path_holder.hpp>
 #include <restinio/router/non_matched_request_handler.hpp>
 #include <restinio/router/method_matcher.hpp>
+#include <restinio/router/route_hits.hpp>
 
 #include <restinio/helpers/easy_parser.hpp>
 
+#include <restinio/optional.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace restinio
@@ -153,6 +159,138 @@ public:
 	}
 };
 
+//
+// literal_index_t
+//
+/*!
+ * @brief An index of routes by their leading literals.
+ *
+ * A route that starts with literals (like `"/api/v1/users/"` in
+ * `path_to_params("/api/v1/users/", id_p)`) can match only a path that
+ * starts with the same literals. Such routes are placed into a compressed
+ * prefix tree by their leading literals. A route without a leading literal
+ * is placed into the root of the tree.
+ *
+ * Every node of the tree holds numbers of all routes whose leading
+ * literal is a prefix of the node's path (in order of registration). So a
+ * lookup is just a walk from the root to the deepest node that matches
+ * a request path.
+ *
+ * @since v.0.6.18
+ */
+class literal_index_t
+{
+public:
+	//! Numbers of routes in order of registration.
+	using entry_numbers_t = std::vector< std::size_t >;
+
+	//! Add a route.
+	/*!
+	 * @attention
+	 * Routes should be added in order of registration (every new
+	 * @a entry should be greater than all previously added).
+	 */
+	void
+	add( string_view_t leading_literal, std::size_t entry )
+	{
+		node_t * current = &m_root;
+		string_view_t rest = leading_literal;
+		while( !rest.empty() )
+		{
+			const auto index = current->m_children_first_chars.find( rest[ 0 ] );
+			if( std::string::npos == index )
+			{
+				auto child = std::make_unique< node_t >();
+				child->m_label.assign( rest.data(), rest.size() );
+				child->m_entries = current->m_entries;
+
+				current->m_children_first_chars += rest[ 0 ];
+				current->m_children.push_back( std::move( child ) );
+				current = current->m_children.back().get();
+				break;
+			}
+
+			auto & child = current->m_children[ index ];
+			const string_view_t label{ child->m_label };
+
+			std::size_t common = 1u;
+			while( common < label.size() && common < rest.size() &&
+					label[ common ] == rest[ common ] )
+				++common;
+
+			if( common < label.size() )
+			{
+				// The child should be split.
+				auto middle = std::make_unique< node_t >();
+				middle->m_label.assign( label.data(), common );
+				middle->m_entries = current->m_entries;
+				child->m_label.erase( 0u, common );
+
+				middle->m_children_first_chars += child->m_label[ 0 ];
+				middle->m_children.push_back( std::move( child ) );
+				child = std::move( middle );
+			}
+
+			current = child.get();
+			rest.remove_prefix( common );
+		}
+
+		append_entry( *current, entry );
+	}
+
+	//! Get routes that can match @a path.
+	RESTINIO_NODISCARD
+	const entry_numbers_t &
+	candidates( string_view_t path ) const noexcept
+	{
+		const node_t * current = &m_root;
+		std::size_t pos = 0u;
+		while( pos < path.size() )
+		{
+			const auto index = current->m_children_first_chars.find( path[ pos ] );
+			if( std::string::npos == index )
+				break;
+
+			const node_t & child = *( current->m_children[ index ] );
+			const string_view_t label{ child.m_label };
+			if( path.size() - pos < label.size() ||
+					path.substr( pos, label.size() ) != label )
+				break;
+
+			current = &child;
+			pos += label.size();
+		}
+
+		return current->m_entries;
+	}
+
+private:
+	//! A node of the tree.
+	struct node_t
+	{
+		//! The literal that should be matched to enter the node.
+		std::string m_label;
+
+		//! The first chars of literals of children (for fast lookup).
+		std::string m_children_first_chars;
+		std::vector< std::unique_ptr< node_t > > m_children;
+
+		//! Routes that can match a path that starts with the node's path.
+		entry_numbers_t m_entries;
+	};
+
+	//! Add a route to the node and to all its descendants.
+	static void
+	append_entry( node_t & node, std::size_t entry )
+	{
+		node.m_entries.push_back( entry );
+		for( auto & child : node.m_children )
+			append_entry( *child, entry );
+	}
+
+	node_t m_root;
+};
+
 //
 // unescape_transformer_t
 //
@@ -522,6 +660,135 @@ struct dsl_processor
 	using clauses_tuple = dsl_details::make_clauses_types_t< arg_types >;
 };
 
+namespace leading_literal_details
+{
+
+// A clause that can't be handled as a literal stops the leading literal.
+template< typename T >
+bool
+append_literal( const T &, std::string & )
+{
+	return false;
+}
+
+template< std::size_t Size >
+bool
+append_literal(
+	const ep::impl::exact_fixed_size_fragment_producer_t< Size > & producer,
+	std::string & to )
+{
+	const auto fragment = producer.fragment();
+	to.append( fragment.data(), fragment.size() );
+	return true;
+}
+
+inline bool
+append_literal(
+	const ep::impl::exact_fragment_producer_t & producer,
+	std::string & to )
+{
+	const auto fragment = producer.fragment();
+	to.append( fragment.data(), fragment.size() );
+	return true;
+}
+
+// Handles cases like exact("/api") or exact_p("/api") >> skip().
+template< typename P, typename C >
+bool
+append_literal(
+	const ep::impl::consume_value_clause_t< P, C > & clause,
+	std::string & to )
+{
+	return append_literal( clause.producer(), to );
+}
+
+// Special clauses are created for string literals, std::string and
+// string_view_t values and for producers (like exact_p("/api")).
+template< std::size_t Size >
+bool
+append_literal(
+	const special_exact_fixed_size_fragment_clause_t< Size > & clause,
+	std::string & to )
+{
+	return append_literal( clause.producer(), to );
+}
+
+inline bool
+append_literal(
+	const special_exact_fragment_clause_t & clause,
+	std::string & to )
+{
+	return append_literal( clause.producer(), to );
+}
+
+template< typename Producer, std::size_t Index >
+bool
+append_literal(
+	const special_produce_tuple_item_clause_t< Producer, Index > & clause,
+	std::string & to )
+{
+	return append_literal( clause.producer(), to );
+}
+
+//
+// make_leading_literal
+//
+/*!
+ * @brief A helper function that concatenates all leading literals
+ * of a route.
+ *
+ * Literals are string literals, std::string and string_view_t values,
+ * exact() and exact_p() clauses. The first clause of another type stops
+ * the leading literal.
+ *
+ * @since v.0.6.18
+ */
+template< typename Subitems_Tuple >
+RESTINIO_NODISCARD
+std::string
+make_leading_literal( const Subitems_Tuple & subitems )
+{
+	std::string result;
+	(void)restinio::utils::tuple_algorithms::all_of(
+			subitems,
+			[&result]( const auto & clause ) {
+				return append_literal( clause, result );
+			} );
+
+	return result;
+}
+
+//
+// leading_literal_of
+//
+/*!
+ * @brief A helper function that returns the leading literal of
+ * a route producer.
+ *
+ * An empty string is returned if the producer doesn't know its
+ * leading literal.
+ *
+ * @since v.0.6.18
+ */
+template< typename Producer >
+RESTINIO_NODISCARD
+auto
+leading_literal_of( const Producer & producer, int )
+	-> decltype( std::string{ producer.leading_literal() } )
+{
+	return producer.leading_literal();
+}
+
+template< typename Producer >
+RESTINIO_NODISCARD
+std::string
+leading_literal_of( const Producer &, long )
+{
+	return {};
+}
+
+} /* namespace leading_literal_details */
+
 //
 // path_to_tuple_producer_t
 //
@@ -544,6 +811,28 @@ class path_to_tuple_producer_t
 public:
 	using base_type_t::base_type_t;
 
+	//! Get the leading literal of the route.
+	/*!
+	 * It's a concatenation of all literals at the beginning of the route.
+	 * For example, it's "/api/v1/books/" for
+	 * `path_to_tuple("/api/v1/books/", book_id_p, "/versions/", version_p)`.
+	 *
+	 * A path that doesn't start with that literal can't be matched.
+	 *
+	 * @note
+	 * The value is not stored inside the producer because the producer is
+	 * copied on every parsing attempt.
+	 *
+	 * @since v.0.6.18
+	 */
+	RESTINIO_NODISCARD
+	std::string
+	leading_literal() const
+	{
+		return leading_literal_details::make_leading_literal(
+				this->subitems() );
+	}
+
 	template< typename Extra_Data, typename Handler >
 	RESTINIO_NODISCARD
 	static auto
@@ -627,6 +916,28 @@ class path_to_params_producer_t
 public:
 	using base_type_t::base_type_t;
 
+	//! Get the leading literal of the route.
+	/*!
+	 * It's a concatenation of all literals at the beginning of the route.
+	 * For example, it's "/api/v1/books/" for
+	 * `path_to_params("/api/v1/books/", book_id_p, "/versions/", version_p)`.
+	 *
+	 * A path that doesn't start with that literal can't be matched.
+	 *
+	 * @note
+	 * The value is not stored inside the producer because the producer is
+	 * copied on every parsing attempt.
+	 *
+	 * @since v.0.6.18
+	 */
+	RESTINIO_NODISCARD
+	std::string
+	leading_literal() const
+	{
+		return leading_literal_details::make_leading_literal(
+				this->subitems() );
+	}
+
 	template< typename User_Type, typename Handler >
 	RESTINIO_NODISCARD
 	static auto
@@ -937,6 +1248,14 @@ unescape()
  * );
  * @endcode
  *
+ * @note
+ * Since v.0.6.18 routes aren't tried one by one. The router extracts
+ * leading literals of routes (string literals, exact() and exact_p()
+ * at the beginning of a route) and tries only routes whose leading
+ * literals are found at the beginning of a request path. Routes with
+ * a single HTTP method are indexed separately for every method.
+ * The order in which routes are tried is still the order of registration.
+ *
  * @tparam Extra_Data_Factory The type of user-type-factory. This type should
  * be the same as the `traits::user_type_factory_t` type for the server.
  *
@@ -973,11 +1292,33 @@ public:
 			path_to_inspect.remove_suffix( 1u );
 
 		target_path_holder_t target_path{ path_to_inspect };
-		for( const auto & entry : m_entries )
+
+		// Only routes whose leading literals are found in the path
+		// are checked. Routes for the request's method and routes with
+		// other method matchers are merged in order of registration.
+		static const literal_index_t::entry_numbers_t no_entries;
+
+		const auto & any_method_entries =
+				m_any_method_index.candidates( target_path.view() );
+
+		const auto * method_index = find_method_index( req->header().method() );
+		const auto & method_entries = method_index ?
+				method_index->candidates( target_path.view() ) : no_entries;
+
+		auto any_it = any_method_entries.begin();
+		auto method_it = method_entries.begin();
+		while( any_it != any_method_entries.end() ||
+				method_it != method_entries.end() )
 		{
-			const auto r = entry->try_handle( req, target_path );
+			const bool take_any = method_it == method_entries.end() ||
+					( any_it != any_method_entries.end() && *any_it < *method_it );
+			const auto number = take_any ? *(any_it++) : *(method_it++);
+
+			const auto r = m_entries[ number ]->try_handle( req, target_path );
 			if( r )
 			{
+				if( m_count_route_hits )
+					m_route_hits.hit( number );
 				return *r;
 			}
 		}
@@ -1011,12 +1352,22 @@ public:
 		using actual_entry_type = actual_router_entry_t<
 				extra_data_t, producer_type, handler_type >;
 
+		// NOTE: this info should be extracted before args are moved.
+		const auto leading_literal =
+				leading_literal_details::leading_literal_of( route, 0 );
+		auto & index = index_for(
+				restinio::router::impl::single_method_of( method_matcher ) );
+
 		auto entry = std::make_unique< actual_entry_type >(
 				std::forward<Method_Matcher>(method_matcher),
 				std::forward<Route_Producer>(route),
 				std::forward<Handler>(handler) );
 
 		m_entries.push_back( std::move(entry) );
+		index.add( leading_literal, m_entries.size() - 1u );
+
+		if( m_count_route_hits )
+			m_route_hits.add_route();
 	}
 
 	//! Set handler for HTTP GET request.
@@ -1092,16 +1443,126 @@ public:
 		m_non_matched_request_handler= std::move( nmrh );
 	}
 
+	//! Turn on counting of requests handled by every route.
+	/*!
+	 * Can be called before or after adding routes, but not during
+	 * the handling of requests.
+	 *
+	 * @note
+	 * There is no adaptive order of routes for this router (unlike
+	 * generic_express_router_t::enable_adaptive_route_order()): only
+	 * routes with leading literals found at the beginning of a request
+	 * path are tried, and such routes can always match the same request,
+	 * so their order can't be changed.
+	 *
+	 * @since v.0.6.18
+	 */
+	void
+	enable_route_hits_counting()
+	{
+		while( m_route_hits.size() < m_entries.size() )
+			m_route_hits.add_route();
+
+		m_count_route_hits = true;
+	}
+
+	//! Get the number of requests handled by every route.
+	/*!
+	 * Routes are numbered in order of registration. An empty vector
+	 * is returned if counting isn't enabled.
+	 *
+	 * Can be called while requests are handled, e.g. for exporting
+	 * the values as metrics.
+	 *
+	 * @since v.0.6.18
+	 */
+	RESTINIO_NODISCARD
+	std::vector< route_hits_t >
+	route_hits() const
+	{
+		return m_route_hits.hits();
+	}
+
+	//! Reset the numbers of handled requests to zero.
+	/*!
+	 * @since v.0.6.18
+	 */
+	void
+	reset_route_hits() noexcept
+	{
+		m_route_hits.reset();
+	}
+
 private:
 	using entries_container_t = std::vector<
 			easy_parser_router::impl::router_entry_unique_ptr_t< extra_data_t >
 	>;
 
+	using literal_index_t = easy_parser_router::impl::literal_index_t;
+
+	//! An index for routes with a single HTTP method.
+	/*!
+	 * @since v.0.6.18
+	 */
+	struct method_index_t
+	{
+		http_method_id_t m_method;
+		literal_index_t m_index;
+	};
+
+	RESTINIO_NODISCARD
+	const literal_index_t *
+	find_method_index( http_method_id_t method ) const noexcept
+	{
+		for( const auto & i : m_method_indexes )
+			if( method == i.m_method )
+				return &i.m_index;
+
+		return nullptr;
+	}
+
+	RESTINIO_NODISCARD
+	literal_index_t &
+	index_for( const optional_t< http_method_id_t > & method )
+	{
+		if( !method )
+			return m_any_method_index;
+
+		for( auto & i : m_method_indexes )
+			if( *method == i.m_method )
+				return i.m_index;
+
+		m_method_indexes.push_back( method_index_t{ *method, literal_index_t{} } );
+		return m_method_indexes.back().m_index;
+	}
+
 	entries_container_t m_entries;
 
+	//! Indexes of routes by their leading literals.
+	/*!
+	 * Routes with a single HTTP method are placed into separate
+	 * indexes for every method. Routes with other method matchers
+	 * (like any_of_methods()) are placed into m_any_method_index.
+	 *
+	 * @since v.0.6.18
+	 */
+	//! \{
+	std::vector< method_index_t > m_method_indexes;
+	literal_index_t m_any_method_index;
+	//! \}
+
 	//! Handler that is called for requests that don't match any route.
 	generic_non_matched_request_handler_t< extra_data_t >
 			m_non_matched_request_handler;
+
+	//! Counters of requests handled by routes.
+	/*!
+	 * @since v.0.6.18
+	 */
+	//! \{
+	bool m_count_route_hits{ false };
+	mutable restinio::router::impl::route_hits_counters_t m_route_hits;
+	//! \}
 };
 
 //
@@ -17,11 +17,13 @@
 
 #include <restinio/router/std_regex_engine.hpp>
 #include <restinio/router/method_matcher.hpp>
+#include <restinio/router/route_hits.hpp>
 
 #include <restinio/utils/from_string.hpp>
 #include <restinio/utils/percent_encoding.hpp>
 
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace restinio
@@ -276,6 +278,20 @@ class route_params_appender_t
 using param_appender_sequence_t =
 	path2regex::param_appender_sequence_t< route_params_appender_t >;
 
+//
+// param_value_position_t
+//
+
+//! Position of a parameter's value in a request target.
+//! @since v.0.6.18
+struct param_value_position_t
+{
+	std::size_t m_begin;
+	std::size_t m_size;
+};
+
+using param_value_positions_t = std::vector< param_value_position_t >;
+
 //
 // route_matcher_t
 //
@@ -289,14 +305,20 @@ class route_matcher_t
 		using match_results_t = typename Regex_Engine::match_results_t;
 
 		//! Creates matcher with a given parameters.
+		/*!
+		 * If @a simple_matcher is specified (since v.0.6.18) it's used
+		 * instead of @a route_regex.
+		 */
 		route_matcher_t(
 			http_method_id_t method,
 			regex_t route_regex,
 			std::shared_ptr< std::string > named_params_buffer,
-			param_appender_sequence_t param_appender_sequence )
+			param_appender_sequence_t param_appender_sequence,
+			optional_t< path2regex::impl::simple_route_matcher_t > simple_matcher = nullopt )
 			:	m_route_regex{ std::move( route_regex ) }
 			,	m_named_params_buffer{ std::move( named_params_buffer ) }
 			,	m_param_appender_sequence{ std::move( param_appender_sequence ) }
+			,	m_simple_matcher{ std::move( simple_matcher ) }
 		{
 			assign( m_method_matcher, std::move(method) );
 		}
@@ -314,10 +336,12 @@ class route_matcher_t
 			Method_Matcher && method_matcher,
 			regex_t route_regex,
 			std::shared_ptr< std::string > named_params_buffer,
-			param_appender_sequence_t param_appender_sequence )
+			param_appender_sequence_t param_appender_sequence,
+			optional_t< path2regex::impl::simple_route_matcher_t > simple_matcher = nullopt )
 			:	m_route_regex{ std::move( route_regex ) }
 			,	m_named_params_buffer{ std::move( named_params_buffer ) }
 			,	m_param_appender_sequence{ std::move( param_appender_sequence ) }
+			,	m_simple_matcher{ std::move( simple_matcher ) }
 		{
 			assign(
 					m_method_matcher,
@@ -333,6 +357,9 @@ class route_matcher_t
 			target_path_holder_t & target_path,
 			route_params_t & parameters ) const
 		{
+			if( m_simple_matcher )
+				return match_simple_route( target_path, parameters );
+
 			match_results_t matches;
 			if( Regex_Engine::try_match(
 					target_path.view(),
@@ -394,17 +421,88 @@ class route_matcher_t
 			return false;
 		}
 
+		/*!
+		 * @brief Set route parameters from values that are found
+		 * without the regex.
+		 *
+		 * @a values should contain a value for every parameter of the route.
+		 *
+		 * @since v.0.6.18
+		 */
+		void
+		set_route_params(
+			target_path_holder_t & target_path,
+			std::size_t match_size,
+			const param_value_positions_t & values,
+			route_params_t & parameters ) const
+		{
+			assert( m_param_appender_sequence.size() == values.size() );
+
+			auto captured_params = target_path.giveout_data();
+
+			route_params_t::named_parameters_container_t named_parameters;
+			route_params_t::indexed_parameters_container_t indexed_parameters;
+
+			route_params_appender_t param_appender{ named_parameters, indexed_parameters };
+
+			for( std::size_t i = 0; i < values.size(); ++i )
+			{
+				m_param_appender_sequence[ i ](
+					param_appender,
+					string_view_t{
+						captured_params.get() + values[ i ].m_begin,
+						values[ i ].m_size } );
+			}
+
+			const string_view_t match{ captured_params.get(), match_size };
+
+			route_params_accessor_t::match(
+					parameters,
+					std::move( captured_params ),
+					m_named_params_buffer,
+					match,
+					std::move( named_parameters ),
+					std::move( indexed_parameters ) );
+		}
+
+		//! Check the method of a request.
+		//! @since v.0.6.18
+		RESTINIO_NODISCARD
+		bool
+		match_method( const http_request_header_t & h ) const
+		{
+			return m_method_matcher->match( h.method() );
+		}
+
 		inline bool
 		operator () (
 			const http_request_header_t & h,
 			target_path_holder_t & target_path,
 			route_params_t & parameters ) const
 		{
-			return m_method_matcher->match( h.method() ) &&
+			return match_method( h ) &&
 					match_route( target_path, parameters );
 		}
 
 	private:
+		//! Try to match a route without the regex.
+		//! @since v.0.6.18
+		bool
+		match_simple_route(
+			target_path_holder_t & target_path,
+			route_params_t & parameters ) const
+		{
+			const auto path = target_path.view();
+
+			param_value_positions_t values;
+			if( !m_simple_matcher->match( path, values ) )
+				return false;
+
+			set_route_params( target_path, path.size(), values, parameters );
+
+			return true;
+		}
+
 		//! HTTP method to match.
 		buffered_matcher_holder_t m_method_matcher;
 
@@ -416,8 +514,49 @@ class route_matcher_t
 
 		//! Parameters values.
 		param_appender_sequence_t m_param_appender_sequence;
+
+		//! Matcher that is used instead of the regex for simple routes.
+		//! @since v.0.6.18
+		optional_t< path2regex::impl::simple_route_matcher_t > m_simple_matcher;
 };
 
+//
+// leading_literal_of_route
+//
+
+//! Get a literal that a path should start with to match a route.
+/*!
+	The literal consists of plain strings at the beginning of the route
+	and the prefix of the first parameter if that parameter isn't optional.
+
+	@since v.0.6.18
+*/
+RESTINIO_NODISCARD
+inline std::string
+leading_literal_of_route(
+	string_view_t route_path,
+	const path2regex::options_t & options )
+{
+	std::string result;
+
+	const auto tokens = path2regex::impl::parse< route_params_appender_t >(
+			route_path, options );
+	for( const auto & t : tokens )
+	{
+		const auto info = t->info();
+		if( path2regex::impl::token_type_t::plain_string != info.m_type )
+		{
+			if( !info.m_optional )
+				result += info.m_text;
+			break;
+		}
+
+		result += info.m_text;
+	}
+
+	return result;
+}
+
 } /* namespace impl */
 
 //
@@ -498,7 +637,8 @@ class generic_express_route_entry_t
 					std::forward<Method_Matcher>( method_matcher ),
 					std::move( matcher_data.m_regex ),
 					std::move( matcher_data.m_named_params_buffer ),
-					std::move( matcher_data.m_param_appender_sequence ) }
+					std::move( matcher_data.m_param_appender_sequence ),
+					std::move( matcher_data.m_simple_matcher ) }
 			,	m_handler{ std::move( handler ) }
 		{}
 
@@ -636,11 +776,32 @@ class generic_express_router_t
 		{
 			impl::target_path_holder_t target_path{ req->header().path() };
 			route_params_t params;
-			for( const auto & entry : m_handlers )
+			if( m_adaptive_order )
+			{
+				m_adaptive_order->on_request( m_route_hits );
+
+				const auto & order = m_adaptive_order->current();
+				for( const auto route : order )
+				{
+					const auto & entry = m_handlers[ route ];
+					if( entry.match( req->header(), target_path, params ) )
+					{
+						m_route_hits.hit( route );
+						return entry.handle( std::move( req ), std::move( params ) );
+					}
+				}
+			}
+			else
 			{
-				if( entry.match( req->header(), target_path, params ) )
+				for( std::size_t route = 0u; route != m_handlers.size(); ++route )
 				{
-					return entry.handle( std::move( req ), std::move( params ) );
+					const auto & entry = m_handlers[ route ];
+					if( entry.match( req->header(), target_path, params ) )
+					{
+						if( m_count_route_hits )
+							m_route_hits.hit( route );
+						return entry.handle( std::move( req ), std::move( params ) );
+					}
 				}
 			}
 
@@ -680,11 +841,22 @@ class generic_express_router_t
 			const path2regex::options_t & options,
 			actual_request_handler_t handler )
 		{
+			// NOTE: this info should be extracted before method_matcher is moved.
+			const auto method = impl::single_method_of( method_matcher );
+
 			m_handlers.emplace_back(
 					std::forward<Method_Matcher>(method_matcher),
 					route_path,
 					options,
 					std::move( handler ) );
+
+			if( m_count_route_hits )
+				m_route_hits.add_route();
+
+			if( m_adaptive_order )
+				m_adaptive_order->add_route( impl::route_conflict_info_t{
+						method,
+						impl::leading_literal_of_route( route_path, options ) } );
 		}
 
 		void
@@ -815,6 +987,89 @@ class generic_express_router_t
 			m_non_matched_request_handler = std::move( nmrh );
 		}
 
+		//! Turn on counting of requests handled by every route.
+		/*!
+			Can be called before or after adding routes, but not during
+			the handling of requests.
+
+			@since v.0.6.18
+		*/
+		void
+		enable_route_hits_counting()
+		{
+			while( m_route_hits.size() < m_handlers.size() )
+				m_route_hits.add_route();
+
+			m_count_route_hits = true;
+		}
+
+		//! Turn on the adaptive order of routes.
+		/*!
+			Routes that handle more requests are checked first. The order
+			is recalculated after every @a reorder_period requests.
+			Routes that can match the same request (that have the same
+			HTTP method or method matchers other than a single method, and
+			leading literals one of which is a prefix of another) are always
+			checked in order of registration. So a request is handled by the
+			same route as without the adaptive order.
+
+			This mode also turns on counting of route hits.
+
+			@attention
+			Should be called before adding routes.
+
+			@throw exception_t if there are routes already.
+
+			@since v.0.6.18
+		*/
+		void
+		enable_adaptive_route_order( std::uint64_t reorder_period )
+		{
+			if( !m_handlers.empty() )
+				throw exception_t{
+					fmt::format(
+						RESTINIO_FMT_FORMAT_STRING(
+							"adaptive route order should be enabled before "
+							"adding routes, routes added: {}" ),
+						m_handlers.size() )
+				};
+
+			enable_route_hits_counting();
+			m_adaptive_order =
+					std::make_unique< impl::adaptive_route_order_t >( reorder_period );
+		}
+
+		//! Get the number of requests handled by every route.
+		/*!
+			Routes are numbered in order of registration. An empty vector
+			is returned if counting isn't enabled.
+
+			Can be called while requests are handled, e.g. for exporting
+			the values as metrics.
+
+			@since v.0.6.18
+		*/
+		RESTINIO_NODISCARD
+		std::vector< route_hits_t >
+		route_hits() const
+		{
+			return m_route_hits.hits();
+		}
+
+		//! Reset the numbers of handled requests to zero.
+		/*!
+			@note
+			The adaptive order of routes is based on these numbers,
+			so it will be changed after the next recalculation.
+
+			@since v.0.6.18
+		*/
+		void
+		reset_route_hits() noexcept
+		{
+			m_route_hits.reset();
+		}
+
 	private:
 		using route_entry_t = generic_express_route_entry_t<
 				Regex_Engine,
@@ -826,6 +1081,17 @@ class generic_express_router_t
 
 		//! Handler that is called for requests that don't match any route.
 		non_matched_handler_t m_non_matched_request_handler;
+
+		//! Counters of requests handled by routes.
+		//! @since v.0.6.18
+		//! \{
+		bool m_count_route_hits{ false };
+		mutable impl::route_hits_counters_t m_route_hits;
+		//! \}
+
+		//! The adaptive order of routes (if enabled).
+		//! @since v.0.6.18
+		std::unique_ptr< impl::adaptive_route_order_t > m_adaptive_order;
 };
 
 //
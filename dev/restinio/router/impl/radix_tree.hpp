@@ -0,0 +1,373 @@
+/*
+ * RESTinio
+ */
+
+/**
+ * @file
+ * @brief Radix tree for dispatching of express routes.
+ *
+ * @since v.0.6.18
+ */
+
+#pragma once
+
+#include <restinio/router/express.hpp>
+
+#include <restinio/impl/to_lower_lut.hpp>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace restinio
+{
+
+namespace router
+{
+
+namespace impl
+{
+
+//
+// radix_tree_node_t
+//
+
+//! A node of radix_tree_t.
+/*!
+ * @since v.0.6.18
+ */
+struct radix_tree_node_t
+{
+	//! A route that is fully matched by the tree.
+	struct matched_route_t
+	{
+		std::size_t m_route;
+		//! The trailing delimiter isn't allowed for the route.
+		bool m_strict;
+	};
+
+	//! The literal that should be matched to enter the node.
+	/*!
+	 * It's empty for the root node and for parameter nodes.
+	 */
+	std::string m_label;
+
+	//! Children with literals.
+	//! \{
+	//! The first chars of literals of children (for fast lookup).
+	std::string m_children_first_chars;
+	std::vector< std::unique_ptr< radix_tree_node_t > > m_children;
+	//! \}
+
+	//! A child that takes a value of a parameter.
+	std::unique_ptr< radix_tree_node_t > m_param;
+
+	//! Routes that end at this node (in order of registration).
+	std::vector< matched_route_t > m_matched_routes;
+
+	//! Routes that have a leading literal that ends at this node
+	//! and should be checked by regex.
+	std::vector< std::size_t > m_regex_routes;
+};
+
+//
+// radix_tree_t
+//
+
+/*!
+ * @brief Compressed radix tree of literals and parameters of routes.
+ *
+ * There are two kinds of routes in the tree:
+ *
+ * - routes that are fully matched by the tree. A route of that kind
+ *   is a sequence of literals and parameters, where every parameter
+ *   takes all chars up to the next '/' (or up to the end).
+ *   Such a route is stored in the node where its last element ends;
+ * - routes that should be checked by regex. Such a route is stored
+ *   in the node where its leading literal ends.
+ *
+ * A lookup of a request target returns the first (in the order of
+ * registration) route that is matched by the tree and all routes
+ * that should be checked by regex.
+ *
+ * If the tree is caseless literals are compared without respect to case.
+ *
+ * @since v.0.6.18
+ */
+class radix_tree_t
+{
+	public:
+		using node_t = radix_tree_node_t;
+
+		//! A value that means that there is no route.
+		static constexpr std::size_t no_route =
+				std::numeric_limits< std::size_t >::max();
+
+		//! The result of a lookup.
+		struct lookup_result_t
+		{
+			//! The first route fully matched by the tree.
+			std::size_t m_route{ no_route };
+
+			//! Values of parameters of m_route.
+			param_value_positions_t m_values;
+
+			//! Routes that should be checked by regex.
+			std::vector< std::size_t > m_regex_routes;
+		};
+
+		explicit radix_tree_t( bool caseless )
+			:	m_caseless{ caseless }
+		{}
+
+		RESTINIO_NODISCARD
+		node_t &
+		root() noexcept
+		{
+			return m_root;
+		}
+
+		//! Add a literal after the node.
+		/*!
+		 * @return The node where the literal ends.
+		 */
+		node_t &
+		add_literal( node_t & from, string_view_t literal )
+		{
+			std::string text{ literal.data(), literal.size() };
+			if( m_caseless )
+				for( auto & ch : text )
+					ch = restinio::impl::to_lower_case( ch );
+
+			node_t * current = &from;
+			string_view_t rest{ text };
+			while( !rest.empty() )
+			{
+				const auto index = current->m_children_first_chars.find( rest[ 0 ] );
+				if( std::string::npos == index )
+				{
+					auto child = std::make_unique< node_t >();
+					child->m_label.assign( rest.data(), rest.size() );
+
+					current->m_children_first_chars += rest[ 0 ];
+					current->m_children.push_back( std::move( child ) );
+
+					return *( current->m_children.back() );
+				}
+
+				auto & child = current->m_children[ index ];
+				const string_view_t label{ child->m_label };
+
+				std::size_t common = 1u;
+				while( common < label.size() && common < rest.size() &&
+						label[ common ] == rest[ common ] )
+					++common;
+
+				if( common < label.size() )
+				{
+					// The child should be split.
+					auto middle = std::make_unique< node_t >();
+					middle->m_label.assign( label.data(), common );
+					child->m_label.erase( 0u, common );
+
+					middle->m_children_first_chars += child->m_label[ 0 ];
+					middle->m_children.push_back( std::move( child ) );
+					child = std::move( middle );
+				}
+
+				current = child.get();
+				rest.remove_prefix( common );
+			}
+
+			return *current;
+		}
+
+		//! Add a parameter after the node.
+		/*!
+		 * @return The node of the parameter.
+		 */
+		node_t &
+		add_param( node_t & from )
+		{
+			if( !from.m_param )
+				from.m_param = std::make_unique< node_t >();
+
+			return *from.m_param;
+		}
+
+		//! Add a route that is fully matched by the tree.
+		void
+		add_matched_route( node_t & where, std::size_t route, bool strict )
+		{
+			where.m_matched_routes.push_back( node_t::matched_route_t{ route, strict } );
+		}
+
+		//! Add a route that should be checked by regex.
+		void
+		add_regex_route( node_t & where, std::size_t route )
+		{
+			where.m_regex_routes.push_back( route );
+		}
+
+		//! Find routes for a request target.
+		/*!
+		 * Only routes accepted by @a filter are taken into account.
+		 *
+		 * A route from @a result is replaced only by a route with
+		 * the lower number, so several trees can be looked up
+		 * with the same @a result.
+		 */
+		template< typename Route_Filter >
+		void
+		lookup(
+			string_view_t path,
+			Route_Filter && filter,
+			lookup_result_t & result ) const
+		{
+			param_value_positions_t values;
+			lookup_in( m_root, path, 0u, filter, values, result );
+		}
+
+	private:
+		template< typename Route_Filter >
+		void
+		lookup_in(
+			const node_t & node,
+			string_view_t path,
+			std::size_t pos,
+			Route_Filter & filter,
+			param_value_positions_t & values,
+			lookup_result_t & result ) const
+		{
+			for( const auto & r : node.m_matched_routes )
+			{
+				if( r.m_route >= result.m_route )
+					break;
+
+				const bool at_end = path.size() == pos ||
+						( !r.m_strict && path.size() == pos + 1u &&
+							'/' == path[ pos ] );
+
+				if( at_end && filter( r.m_route ) )
+				{
+					result.m_route = r.m_route;
+					result.m_values = values;
+					break;
+				}
+			}
+
+			for( const auto route : node.m_regex_routes )
+				if( route < result.m_route && filter( route ) )
+					result.m_regex_routes.push_back( route );
+
+			if( path.size() == pos )
+				return;
+
+			const auto index = node.m_children_first_chars.find( lookup_char( path[ pos ] ) );
+			if( std::string::npos != index )
+			{
+				const auto & child = *( node.m_children[ index ] );
+				if( starts_with( path, pos, child.m_label ) )
+					lookup_in(
+							child, path, pos + child.m_label.size(),
+							filter, values, result );
+			}
+
+			if( node.m_param && '/' != path[ pos ] )
+			{
+				auto end = path.find( '/', pos );
+				if( string_view_t::npos == end )
+					end = path.size();
+
+				values.push_back( param_value_position_t{ pos, end - pos } );
+				lookup_in( *node.m_param, path, end, filter, values, result );
+				values.pop_back();
+			}
+		}
+
+		RESTINIO_NODISCARD
+		char
+		lookup_char( char ch ) const noexcept
+		{
+			return m_caseless ? restinio::impl::to_lower_case( ch ) : ch;
+		}
+
+		RESTINIO_NODISCARD
+		bool
+		starts_with(
+			string_view_t path,
+			std::size_t pos,
+			const std::string & label ) const noexcept
+		{
+			if( path.size() - pos < label.size() )
+				return false;
+
+			// The first char is already checked.
+			for( std::size_t i = 1u; i < label.size(); ++i )
+				if( lookup_char( path[ pos + i ] ) != label[ i ] )
+					return false;
+
+			return true;
+		}
+
+		const bool m_caseless;
+
+		node_t m_root;
+};
+
+//
+// add_route_to_radix_tree()
+//
+
+//! Add a route to the tree.
+/*!
+ * @since v.0.6.18
+ */
+inline void
+add_route_to_radix_tree(
+	radix_tree_t & tree,
+	std::size_t route,
+	const path2regex::options_t & options,
+	const std::vector< path2regex::impl::token_info_t > & tokens )
+{
+	using path2regex::impl::token_type_t;
+
+	radix_tree_t::node_t * node = &tree.root();
+
+	if( path2regex::impl::is_simple_route( options, tokens ) )
+	{
+		for( const auto & t : tokens )
+		{
+			node = &tree.add_literal( *node, t.m_text );
+			if( token_type_t::capturing_token == t.m_type )
+				node = &tree.add_param( *node );
+		}
+
+		tree.add_matched_route( *node, route, options.strict() );
+	}
+	else
+	{
+		// Only the leading literal can be placed into the tree.
+		// The prefix of a mandatory parameter is the part of it.
+		for( const auto & t : tokens )
+		{
+			if( token_type_t::capturing_token == t.m_type )
+			{
+				if( !t.m_optional )
+					node = &tree.add_literal( *node, t.m_text );
+				break;
+			}
+
+			node = &tree.add_literal( *node, t.m_text );
+		}
+
+		tree.add_regex_route( *node, route );
+	}
+}
+
+} /* namespace impl */
+
+} /* namespace router */
+
+} /* namespace restinio */
@@ -0,0 +1,342 @@
+/*
+	restinio
+*/
+
+/*!
+	Express.js style router with dispatching by radix tree.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/router/express.hpp>
+#include <restinio/router/impl/radix_tree.hpp>
+
+#include <algorithm>
+
+namespace restinio
+{
+
+namespace router
+{
+
+//
+// generic_radix_express_router_t
+//
+
+//! Generic Express.js style router that uses radix tree for dispatching.
+/*!
+	This router has the same interface and the same semantics as
+	generic_express_router_t: the first route (in order of registration)
+	that matches the request handles it, parameters are passed to
+	a handler via route_params_t.
+
+	But routes aren't checked one by one. Routes are placed into a radix
+	tree of literals and parameters. Routes that consist only of literals
+	and parameters with default patterns (like `/api/v1/users/:id/orders`)
+	are matched by the tree without regexes at all. Other routes (with
+	custom patterns, optional or repeated parameters, non-default options)
+	are checked by regex, but only if the request target starts with
+	the leading literal of the route.
+
+	Usage:
+	@code
+	auto router = std::make_unique< restinio::router::radix_express_router_t<> >();
+	router->http_get( "/api/v1/users/:id", handler );
+	@endcode
+
+	@tparam Regex_Engine Type of regex-engine to be used.
+
+	@tparam Extra_Data_Factory Type of extra-data-factory specified in
+	server's traits.
+
+	@since v.0.6.18
+*/
+template<
+	typename Regex_Engine,
+	typename Extra_Data_Factory >
+class generic_radix_express_router_t
+{
+	public:
+		using actual_request_handle_t =
+				generic_request_handle_t< typename Extra_Data_Factory::data_t >;
+		using actual_request_handler_t =
+				generic_express_request_handler_t<
+						typename Extra_Data_Factory::data_t
+					>;
+		using non_matched_handler_t =
+				generic_non_matched_request_handler_t<
+						typename Extra_Data_Factory::data_t
+				>;
+
+		generic_radix_express_router_t() = default;
+		generic_radix_express_router_t( generic_radix_express_router_t && ) = default;
+
+		RESTINIO_NODISCARD
+		request_handling_status_t
+		operator()( actual_request_handle_t req ) const
+		{
+			impl::target_path_holder_t target_path{ req->header().path() };
+			const auto path = target_path.view();
+
+			const auto route_filter = [&]( std::size_t route ) {
+				return m_routes[ route ].m_matcher.match_method( req->header() );
+			};
+
+			impl::radix_tree_t::lookup_result_t found;
+			m_caseless_tree.lookup( path, route_filter, found );
+			m_sensitive_tree.lookup( path, route_filter, found );
+
+			route_params_t params;
+
+			// Routes that require regexes are checked in order of registration
+			// and only if they are registered before the route found by trees.
+			std::sort( found.m_regex_routes.begin(), found.m_regex_routes.end() );
+			for( const auto route : found.m_regex_routes )
+			{
+				if( route > found.m_route )
+					break;
+
+				const auto & entry = m_routes[ route ];
+				if( entry.m_matcher.match_route( target_path, params ) )
+				{
+					return entry.m_handler( std::move( req ), std::move( params ) );
+				}
+			}
+
+			if( impl::radix_tree_t::no_route != found.m_route )
+			{
+				const auto & entry = m_routes[ found.m_route ];
+				entry.m_matcher.set_route_params(
+						target_path, path.size(), found.m_values, params );
+
+				return entry.m_handler( std::move( req ), std::move( params ) );
+			}
+
+			// Here: none of the routes matches this handler.
+
+			if( m_non_matched_request_handler )
+			{
+				// If non matched request handler is set
+				// then call it.
+				return m_non_matched_request_handler( std::move( req ) );
+			}
+
+			return request_not_handled();
+		}
+
+		//! Add handlers.
+		//! \{
+		template< typename Method_Matcher >
+		void
+		add_handler(
+			Method_Matcher && method_matcher,
+			string_view_t route_path,
+			actual_request_handler_t handler )
+		{
+			add_handler(
+				std::forward<Method_Matcher>(method_matcher),
+				route_path,
+				path2regex::options_t{},
+				std::move( handler ) );
+		}
+
+		template< typename Method_Matcher >
+		void
+		add_handler(
+			Method_Matcher && method_matcher,
+			string_view_t route_path,
+			const path2regex::options_t & options,
+			actual_request_handler_t handler )
+		{
+			auto matcher_data =
+				path2regex::path2regex< impl::route_params_appender_t, Regex_Engine >(
+					route_path,
+					options );
+
+			const auto route = m_routes.size();
+			m_routes.push_back( route_entry_t{
+					impl::route_matcher_t< Regex_Engine >{
+						std::forward<Method_Matcher>(method_matcher),
+						std::move( matcher_data.m_regex ),
+						std::move( matcher_data.m_named_params_buffer ),
+						std::move( matcher_data.m_param_appender_sequence ) },
+					std::move( handler ) } );
+
+			impl::add_route_to_radix_tree(
+					options.sensitive() ? m_sensitive_tree : m_caseless_tree,
+					route,
+					options,
+					matcher_data.m_tokens );
+		}
+
+		void
+		http_delete(
+			string_view_t route_path,
+			actual_request_handler_t handler )
+		{
+			add_handler(
+				http_method_delete(),
+				route_path,
+				std::move( handler ) );
+		}
+
+		void
+		http_delete(
+			string_view_t route_path,
+			const path2regex::options_t & options,
+			actual_request_handler_t handler )
+		{
+			add_handler(
+				http_method_delete(),
+				route_path,
+				options,
+				std::move( handler ) );
+		}
+
+		void
+		http_get(
+			string_view_t route_path,
+			actual_request_handler_t handler )
+		{
+			add_handler(
+				http_method_get(),
+				route_path,
+				std::move( handler ) );
+		}
+
+		void
+		http_get(
+			string_view_t route_path,
+			const path2regex::options_t & options,
+			actual_request_handler_t handler )
+		{
+			add_handler(
+				http_method_get(),
+				route_path,
+				options,
+				std::move( handler ) );
+		}
+
+		void
+		http_head(
+			string_view_t route_path,
+			actual_request_handler_t handler )
+		{
+			add_handler(
+				http_method_head(),
+				route_path,
+				std::move( handler ) );
+		}
+
+		void
+		http_head(
+			string_view_t route_path,
+			const path2regex::options_t & options,
+			actual_request_handler_t handler )
+		{
+			add_handler(
+				http_method_head(),
+				route_path,
+				options,
+				std::move( handler ) );
+		}
+
+		void
+		http_post(
+			string_view_t route_path,
+			actual_request_handler_t handler )
+		{
+			add_handler(
+				http_method_post(),
+				route_path,
+				std::move( handler ) );
+		}
+
+		void
+		http_post(
+			string_view_t route_path,
+			const path2regex::options_t & options,
+			actual_request_handler_t handler )
+		{
+			add_handler(
+				http_method_post(),
+				route_path,
+				options,
+				std::move( handler ) );
+		}
+
+		void
+		http_put(
+			string_view_t route_path,
+			actual_request_handler_t handler )
+		{
+			add_handler(
+				http_method_put(),
+				route_path,
+				std::move( handler ) );
+		}
+
+		void
+		http_put(
+			string_view_t route_path,
+			const path2regex::options_t & options,
+			actual_request_handler_t handler )
+		{
+			add_handler(
+				http_method_put(),
+				route_path,
+				options,
+				std::move( handler ) );
+		}
+		//! \}
+
+		//! Set handler for requests that don't match any route.
+		void
+		non_matched_request_handler( non_matched_handler_t nmrh )
+		{
+			m_non_matched_request_handler = std::move( nmrh );
+		}
+
+	private:
+		//! A single route.
+		struct route_entry_t
+		{
+			impl::route_matcher_t< Regex_Engine > m_matcher;
+			actual_request_handler_t m_handler;
+		};
+
+		//! A list of existing routes in order of registration.
+		std::vector< route_entry_t > m_routes;
+
+		//! Trees for case insensitive and case sensitive routes.
+		//! \{
+		impl::radix_tree_t m_caseless_tree{ true };
+		impl::radix_tree_t m_sensitive_tree{ false };
+		//! \}
+
+		//! Handler that is called for requests that don't match any route.
+		non_matched_handler_t m_non_matched_request_handler;
+};
+
+//
+// radix_express_router_t
+//
+/*!
+ * @brief A type of express-like router with radix tree for the case when
+ * the default extra-data-factory is specified in the server's traits.
+ *
+ * @tparam Regex_Engine Type of regex-engine to be used.
+ *
+ * @since v.0.6.18
+ */
+template<
+	typename Regex_Engine = std_regex_engine_t >
+using radix_express_router_t = generic_radix_express_router_t<
+		Regex_Engine,
+		no_extra_data_factory_t >;
+
+} /* namespace router */
+
+} /* namespace restinio */
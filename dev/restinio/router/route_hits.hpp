@@ -0,0 +1,414 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief Statistics of route hits and adaptive order of routes.
+ *
+ * @since v.0.6.18
+ */
+
+#pragma once
+
+#include <restinio/http_headers.hpp>
+#include <restinio/optional.hpp>
+#include <restinio/string_view.hpp>
+
+#include <restinio/impl/to_lower_lut.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace restinio
+{
+
+namespace router
+{
+
+//
+// route_hits_t
+//
+/*!
+ * @brief The number of requests handled by a route.
+ *
+ * @since v.0.6.18
+ */
+struct route_hits_t
+{
+	//! The number of the route (in order of registration, starting from 0).
+	std::size_t m_route;
+
+	//! The number of requests handled by the route.
+	std::uint64_t m_hits;
+};
+
+namespace impl
+{
+
+//
+// route_hits_counters_t
+//
+/*!
+ * @brief Counters of requests handled by routes.
+ *
+ * Counters are incremented with relaxed atomic operations, so they can
+ * be incremented from several threads and read at the same time.
+ *
+ * @since v.0.6.18
+ */
+class route_hits_counters_t
+{
+public:
+	//! Add a counter for a new route.
+	void
+	add_route()
+	{
+		m_counters.emplace_back( 0u );
+	}
+
+	RESTINIO_NODISCARD
+	std::size_t
+	size() const noexcept { return m_counters.size(); }
+
+	//! Count a request handled by the route.
+	void
+	hit( std::size_t route ) noexcept
+	{
+		m_counters[ route ].fetch_add( 1u, std::memory_order_relaxed );
+	}
+
+	//! Get the current values of counters.
+	RESTINIO_NODISCARD
+	std::vector< route_hits_t >
+	hits() const
+	{
+		std::vector< route_hits_t > result;
+		result.reserve( m_counters.size() );
+		for( const auto & c : m_counters )
+			result.push_back( route_hits_t{
+					result.size(), c.load( std::memory_order_relaxed ) } );
+
+		return result;
+	}
+
+	//! Set all counters to zero.
+	void
+	reset() noexcept
+	{
+		for( auto & c : m_counters )
+			c.store( 0u, std::memory_order_relaxed );
+	}
+
+private:
+	//! NOTE: std::deque is used because std::atomic can't be moved.
+	std::deque< std::atomic< std::uint64_t > > m_counters;
+};
+
+//
+// single_method_of
+//
+/*!
+ * @brief A helper for detection of routes with a single HTTP method.
+ *
+ * @since v.0.6.18
+ */
+template< typename Method_Matcher >
+RESTINIO_NODISCARD
+optional_t< http_method_id_t >
+single_method_of( const Method_Matcher & ) noexcept
+{
+	return nullopt;
+}
+
+RESTINIO_NODISCARD
+inline optional_t< http_method_id_t >
+single_method_of( http_method_id_t method ) noexcept
+{
+	return method;
+}
+
+//
+// route_conflict_info_t
+//
+/*!
+ * @brief A description of a route for detection of routes that can
+ * match the same request.
+ *
+ * @since v.0.6.18
+ */
+struct route_conflict_info_t
+{
+	//! The method of the route if the route accepts just one method.
+	optional_t< http_method_id_t > m_method;
+
+	//! The leading literal of the route in lower case.
+	/*!
+	 * A request path should start with this literal (without respect
+	 * to case) to be matched by the route.
+	 */
+	std::string m_leading_literal;
+
+	route_conflict_info_t(
+		optional_t< http_method_id_t > method,
+		string_view_t leading_literal )
+		:	m_method{ method }
+		,	m_leading_literal{ leading_literal.data(), leading_literal.size() }
+	{
+		for( auto & ch : m_leading_literal )
+			ch = restinio::impl::to_lower_case( ch );
+	}
+};
+
+//! Can two routes match the same request?
+/*!
+ * The answer is conservative: `true` is returned if it's not known
+ * for sure that routes can't match the same request.
+ *
+ * @since v.0.6.18
+ */
+RESTINIO_NODISCARD
+inline bool
+may_conflict(
+	const route_conflict_info_t & a,
+	const route_conflict_info_t & b ) noexcept
+{
+	if( a.m_method && b.m_method && *a.m_method != *b.m_method )
+		return false;
+
+	const auto & shorter = a.m_leading_literal.size() < b.m_leading_literal.size() ?
+			a.m_leading_literal : b.m_leading_literal;
+	const auto & longer = &shorter == &a.m_leading_literal ?
+			b.m_leading_literal : a.m_leading_literal;
+
+	return 0 == longer.compare( 0u, shorter.size(), shorter );
+}
+
+//
+// adaptive_route_order_t
+//
+/*!
+ * @brief An order of checking of routes that depends on route hits.
+ *
+ * Routes that are hit more often are checked first. But the relative
+ * order of routes that can match the same request (see may_conflict())
+ * is always the order of registration. So the first route in the order
+ * of registration that matches a request is still selected.
+ *
+ * The order is recalculated after every `reorder_period` requests by
+ * the thread that handles the request. If another thread is recalculating
+ * the order at that time the recalculation is skipped, so requests never
+ * wait for it. The current order is an immutable object that is published
+ * with an epoch counter. Every thread keeps a copy of the pointer to the
+ * order it used last time and takes the pointer under a mutex only when
+ * the epoch is changed, so threads don't contend on the mutex between
+ * recalculations.
+ *
+ * @since v.0.6.18
+ */
+class adaptive_route_order_t
+{
+public:
+	//! Type of the order: numbers of routes in order of checking.
+	using order_t = std::vector< std::size_t >;
+	using order_shptr_t = std::shared_ptr< const order_t >;
+
+	explicit adaptive_route_order_t( std::uint64_t reorder_period )
+		:	m_id{ next_id() }
+		,	m_reorder_period{ 0u == reorder_period ? 1u : reorder_period }
+		,	m_order{ std::make_shared< const order_t >() }
+	{}
+
+	//! Add a new route.
+	/*!
+	 * The new route is checked after all existing routes until
+	 * the next reordering.
+	 *
+	 * @attention
+	 * It's not thread safe and can't be called when requests are handled.
+	 */
+	void
+	add_route( route_conflict_info_t info )
+	{
+		const auto route = m_infos.size();
+
+		m_predecessors.emplace_back();
+		m_successors.emplace_back();
+		for( std::size_t i = 0u; i != route; ++i )
+			if( may_conflict( m_infos[ i ], info ) )
+			{
+				m_predecessors.back().push_back( i );
+				m_successors[ i ].push_back( route );
+			}
+
+		m_infos.push_back( std::move( info ) );
+
+		auto order = std::make_shared< order_t >( *m_order );
+		order->push_back( route );
+
+		publish( std::move( order ) );
+	}
+
+	//! Get the current order.
+	/*!
+	 * The lock is acquired only if the order was changed since the
+	 * previous call of that method in the current thread.
+	 *
+	 * @attention
+	 * The reference is valid until the next call of that method
+	 * in the current thread.
+	 */
+	RESTINIO_NODISCARD
+	const order_t &
+	current() const
+	{
+		//! The order used by the current thread last time.
+		struct cached_order_t
+		{
+			std::uint64_t m_owner_id{ 0u };
+			std::uint64_t m_epoch{ 0u };
+			order_shptr_t m_order;
+		};
+		static thread_local cached_order_t cache;
+
+		const auto epoch = m_epoch.load( std::memory_order_acquire );
+		if( cache.m_owner_id != m_id || cache.m_epoch != epoch )
+		{
+			std::lock_guard< std::mutex > lock{ m_order_lock };
+			cache.m_owner_id = m_id;
+			cache.m_epoch = m_epoch.load( std::memory_order_relaxed );
+			cache.m_order = m_order;
+		}
+
+		return *cache.m_order;
+	}
+
+	//! Count a request and recalculate the order if it's time to do it.
+	void
+	on_request( const route_hits_counters_t & counters ) const
+	{
+		const auto requests =
+				m_requests.fetch_add( 1u, std::memory_order_relaxed ) + 1u;
+		if( 0u == requests % m_reorder_period )
+		{
+			// Only one thread recalculates the order at a time.
+			std::unique_lock< std::mutex > reorder_lock{
+					m_reorder_lock, std::try_to_lock };
+			if( !reorder_lock )
+				return;
+
+			publish( make_order( counters ) );
+		}
+	}
+
+private:
+	//! Get a unique identifier for a new object.
+	/*!
+	 * Identifiers are used instead of addresses of objects because
+	 * a new object can be created at the address of a destroyed one.
+	 */
+	static std::uint64_t
+	next_id() noexcept
+	{
+		static std::atomic< std::uint64_t > last_id{ 0u };
+		return last_id.fetch_add( 1u, std::memory_order_relaxed ) + 1u;
+	}
+
+	//! Replace the current order and start a new epoch.
+	void
+	publish( order_shptr_t order ) const
+	{
+		std::lock_guard< std::mutex > lock{ m_order_lock };
+		m_order = std::move( order );
+		m_epoch.fetch_add( 1u, std::memory_order_release );
+	}
+
+	//! Make a new order: a topological sort of the graph of conflicts
+	//! where routes with more hits are taken first.
+	RESTINIO_NODISCARD
+	order_shptr_t
+	make_order( const route_hits_counters_t & counters ) const
+	{
+		const auto hits = counters.hits();
+
+		const auto less_priority = [&hits]( std::size_t a, std::size_t b ) {
+			if( hits[ a ].m_hits != hits[ b ].m_hits )
+				return hits[ a ].m_hits < hits[ b ].m_hits;
+			return a > b;
+		};
+
+		std::priority_queue<
+				std::size_t, std::vector< std::size_t >, decltype(less_priority) >
+			ready{ less_priority };
+
+		std::vector< std::size_t > not_placed_predecessors;
+		not_placed_predecessors.reserve( m_predecessors.size() );
+		for( std::size_t i = 0u; i != m_predecessors.size(); ++i )
+		{
+			not_placed_predecessors.push_back( m_predecessors[ i ].size() );
+			if( m_predecessors[ i ].empty() )
+				ready.push( i );
+		}
+
+		auto order = std::make_shared< order_t >();
+		order->reserve( m_predecessors.size() );
+		while( !ready.empty() )
+		{
+			const auto route = ready.top();
+			ready.pop();
+			order->push_back( route );
+
+			for( const auto s : m_successors[ route ] )
+				if( 0u == --not_placed_predecessors[ s ] )
+					ready.push( s );
+		}
+
+		return order;
+	}
+
+	//! The unique identifier of the object.
+	const std::uint64_t m_id;
+
+	const std::uint64_t m_reorder_period;
+
+	//! Descriptions of routes in order of registration.
+	std::vector< route_conflict_info_t > m_infos;
+
+	//! Graph of conflicts between routes.
+	//! \{
+	//! Routes registered before that can match the same request.
+	std::vector< std::vector< std::size_t > > m_predecessors;
+	//! Routes registered after that can match the same request.
+	std::vector< std::vector< std::size_t > > m_successors;
+	//! \}
+
+	//! The number of requests since the start.
+	mutable std::atomic< std::uint64_t > m_requests{ 0u };
+
+	//! The lock for recalculation of the order.
+	mutable std::mutex m_reorder_lock;
+
+	//! The lock for m_order.
+	mutable std::mutex m_order_lock;
+
+	//! The current order.
+	mutable order_shptr_t m_order;
+
+	//! The number of changes of the current order.
+	/*!
+	 * It's changed under m_order_lock, but it's read without the lock.
+	 */
+	mutable std::atomic< std::uint64_t > m_epoch{ 1u };
+};
+
+} /* namespace impl */
+
+} /* namespace router */
+
+} /* namespace restinio */
@@ -0,0 +1,355 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief A router with a compile-time table of easy_parser-based routes.
+ *
+ * @since v.0.6.18
+ */
+
+#pragma once
+
+#include <restinio/router/easy_parser_router.hpp>
+
+#include <restinio/utils/tuple_algorithms.hpp>
+
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace restinio
+{
+
+namespace router
+{
+
+namespace easy_parser_router
+{
+
+namespace impl
+{
+
+//
+// match_method
+//
+/*!
+ * @brief A helper for matching a method without virtual calls.
+ *
+ * @since v.0.6.18
+ */
+RESTINIO_NODISCARD
+inline bool
+match_method(
+	const http_method_id_t & expected,
+	const http_method_id_t & actual ) noexcept
+{
+	return expected == actual;
+}
+
+template< typename Method_Matcher >
+RESTINIO_NODISCARD
+bool
+match_method(
+	const Method_Matcher & matcher,
+	const http_method_id_t & actual ) noexcept
+{
+	static_assert( std::is_base_of<
+			method_matcher_t, Method_Matcher >::value,
+			"Method_Matcher should be derived from method_matcher_t" );
+
+	// NOTE: the call is qualified to avoid a virtual call.
+	return matcher.Method_Matcher::match( actual );
+}
+
+//
+// static_route_t
+//
+/*!
+ * @brief A route for generic_static_easy_parser_router_t.
+ *
+ * Unlike actual_router_entry_t all types are known at the compile time:
+ * the method matcher and the request handler are stored as is and
+ * are called directly.
+ *
+ * @tparam Method_Matcher A type of method matcher. It's http_method_id_t
+ * or a type derived from method_matcher_t.
+ *
+ * @tparam Producer A type of producer that parses a route and produces
+ * a value to be used as argument(s) for request handler.
+ *
+ * @tparam Handler A type of request handler.
+ *
+ * @since v.0.6.18
+ */
+template< typename Method_Matcher, typename Producer, typename Handler >
+class static_route_t
+{
+	//! HTTP method to match.
+	Method_Matcher m_method_matcher;
+
+	//! Parser of a route and producer of argument(s) for request handler.
+	Producer m_producer;
+
+	//! Request handler to be used.
+	Handler m_handler;
+
+	//! The leading literal of the route.
+	/*!
+	 * A path that doesn't start with that literal isn't parsed at all.
+	 */
+	std::string m_leading_literal;
+
+public:
+	template<
+		typename Method_Matcher_Arg,
+		typename Producer_Arg,
+		typename Handler_Arg >
+	static_route_t(
+		Method_Matcher_Arg && method_matcher,
+		Producer_Arg && producer,
+		Handler_Arg && handler )
+		:	m_method_matcher{ std::forward<Method_Matcher_Arg>(method_matcher) }
+		,	m_producer{ std::forward<Producer_Arg>(producer) }
+		,	m_handler{ std::forward<Handler_Arg>(handler) }
+		,	m_leading_literal{
+				leading_literal_details::leading_literal_of( m_producer, 0 ) }
+	{}
+
+	//! An attempt to match a request against the route.
+	template< typename Extra_Data >
+	RESTINIO_NODISCARD
+	expected_t< request_handling_status_t, no_match_t >
+	try_handle(
+		const generic_request_handle_t< Extra_Data > & req,
+		string_view_t path ) const
+	{
+		if( match_method( m_method_matcher, req->header().method() ) &&
+				path.substr( 0u, m_leading_literal.size() ) == m_leading_literal )
+		{
+			auto parse_result = easy_parser::try_parse( path, m_producer );
+			if( parse_result )
+			{
+				return Producer::invoke_handler( req, m_handler, *parse_result );
+			}
+		}
+
+		return make_unexpected( no_match_t{} );
+	}
+};
+
+} /* namespace impl */
+
+//
+// route
+//
+/*!
+ * @brief A factory for a route of generic_static_easy_parser_router_t.
+ *
+ * Usage example:
+ * @code
+ * namespace epr = restinio::router::easy_parser_router;
+ *
+ * epr::route(restinio::http_method_get(),
+ * 	epr::path_to_params("/api/v1/users/", epr::non_negative_decimal_number_p<int>()),
+ * 	[](const auto & req, int user_id) {...});
+ * @endcode
+ *
+ * @since v.0.6.18
+ */
+template< typename Method_Matcher, typename Route_Producer, typename Handler >
+RESTINIO_NODISCARD
+auto
+route(
+	Method_Matcher && method_matcher,
+	Route_Producer && producer,
+	Handler && handler )
+{
+	using route_type = impl::static_route_t<
+			std::decay_t< Method_Matcher >,
+			std::decay_t< Route_Producer >,
+			std::decay_t< Handler > >;
+
+	return route_type{
+			std::forward<Method_Matcher>(method_matcher),
+			std::forward<Route_Producer>(producer),
+			std::forward<Handler>(handler) };
+}
+
+} /* namespace easy_parser_router */
+
+//
+// generic_static_easy_parser_router_t
+//
+/*!
+ * @brief A request router with a table of routes that is known at the
+ * compile time.
+ *
+ * Routes are described by the same DSL as for easy_parser_router_t, but
+ * they are passed to the router all at once and are stored in a tuple.
+ * There is no type erasure: there are no std::function objects and virtual
+ * calls, handlers are called directly and can be inlined. The checks
+ * of routes are unrolled at the compile time. A route is parsed only if
+ * the request path starts with the leading literal of the route.
+ *
+ * The handling of a request doesn't allocate memory if the request path
+ * doesn't require normalization (and if route producers don't allocate
+ * memory during parsing).
+ *
+ * Routes are checked in the order they are passed to the router.
+ * If there is no matching route then request_not_handled() is returned.
+ *
+ * Usage example:
+ * @code
+ * namespace epr = restinio::router::easy_parser_router;
+ *
+ * auto make_router() {
+ * 	return restinio::router::make_static_easy_parser_router(
+ * 		epr::route(restinio::http_method_get(),
+ * 			epr::path_to_params("/api/v1/users"),
+ * 			[](const auto & req) {...}),
+ * 		epr::route(restinio::http_method_get(),
+ * 			epr::path_to_params("/api/v1/users/", epr::non_negative_decimal_number_p<int>()),
+ * 			[](const auto & req, int user_id) {...}),
+ * 		epr::route(
+ * 			restinio::router::any_of_methods(
+ * 				restinio::http_method_post(), restinio::http_method_put()),
+ * 			epr::path_to_params("/api/v1/users/", epr::non_negative_decimal_number_p<int>()),
+ * 			[](const auto & req, int user_id) {...}) );
+ * }
+ * ...
+ * struct traits_t : public restinio::default_traits_t {
+ * 	using request_handler_t = decltype(make_router());
+ * };
+ * ...
+ * restinio::run(
+ * 	restinio::on_this_thread<traits_t>()
+ * 		.request_handler(make_router())
+ * 		...
+ * );
+ * @endcode
+ *
+ * @tparam Extra_Data_Factory The type of user-type-factory. This type should
+ * be the same as the `traits::user_type_factory_t` type for the server.
+ *
+ * @tparam Routes Types of routes (created by easy_parser_router::route()).
+ *
+ * @since v.0.6.18
+ */
+template< typename Extra_Data_Factory, typename... Routes >
+class generic_static_easy_parser_router_t
+{
+	using extra_data_t = typename Extra_Data_Factory::data_t;
+
+public:
+	using actual_request_handle_t = generic_request_handle_t< extra_data_t >;
+
+	explicit generic_static_easy_parser_router_t( Routes ...routes )
+		:	m_routes{ std::move(routes)... }
+	{}
+
+	RESTINIO_NODISCARD
+	request_handling_status_t
+	operator()( actual_request_handle_t req ) const
+	{
+		// Take care of an optional trailing slash.
+		string_view_t path_to_inspect{ req->header().path() };
+		if( path_to_inspect.size() > 1u && '/' == path_to_inspect.back() )
+			path_to_inspect.remove_suffix( 1u );
+
+		namespace normalization =
+				restinio::utils::uri_normalization::unreserved_chars;
+
+		if( normalization::estimate_required_capacity( path_to_inspect ) ==
+				path_to_inspect.size() )
+		{
+			// There is nothing to normalize, so the path can be used as is.
+			return handle( req, path_to_inspect );
+		}
+
+		impl::target_path_holder_t target_path{ path_to_inspect };
+		return handle( req, target_path.view() );
+	}
+
+private:
+	RESTINIO_NODISCARD
+	request_handling_status_t
+	handle( const actual_request_handle_t & req, string_view_t path ) const
+	{
+		request_handling_status_t result = request_not_handled();
+
+		(void)restinio::utils::tuple_algorithms::any_of(
+				m_routes,
+				[&]( const auto & route ) {
+					const auto r = route.try_handle( req, path );
+					if( r )
+						result = *r;
+					return static_cast< bool >( r );
+				} );
+
+		return result;
+	}
+
+	std::tuple< Routes... > m_routes;
+};
+
+//
+// static_easy_parser_router_t
+//
+/*!
+ * @brief A type of static router for the case when the default
+ * extra-data-factory is specified in the server's traits.
+ *
+ * @since v.0.6.18
+ */
+template< typename... Routes >
+using static_easy_parser_router_t =
+		generic_static_easy_parser_router_t< no_extra_data_factory_t, Routes... >;
+
+//
+// make_static_easy_parser_router
+//
+/*!
+ * @brief A factory for generic_static_easy_parser_router_t.
+ *
+ * Usage example:
+ * @code
+ * namespace epr = restinio::router::easy_parser_router;
+ *
+ * auto router = restinio::router::make_static_easy_parser_router(
+ * 	epr::route(restinio::http_method_get(),
+ * 		epr::path_to_params("/"),
+ * 		[](const auto & req) {...}),
+ * 	epr::route(restinio::http_method_get(),
+ * 		epr::path_to_params("/", epr::non_negative_decimal_number_p<int>()),
+ * 		[](const auto & req, int id) {...}) );
+ *
+ * // The same with non-default extra-data-factory.
+ * auto router2 = restinio::router::make_static_easy_parser_router<
+ * 		my_extra_data_factory >(
+ * 	epr::route(...),
+ * 	...);
+ * @endcode
+ *
+ * @since v.0.6.18
+ */
+template<
+	typename Extra_Data_Factory = no_extra_data_factory_t,
+	typename... Routes >
+RESTINIO_NODISCARD
+auto
+make_static_easy_parser_router( Routes && ...routes )
+{
+	static_assert( 0u != sizeof...(Routes), "Routes can't be an empty list" );
+
+	using router_type = generic_static_easy_parser_router_t<
+			Extra_Data_Factory,
+			std::decay_t< Routes >... >;
+
+	return router_type{ std::forward<Routes>(routes)... };
+}
+
+} /* namespace router */
+
+} /* namespace restinio */
@@ -746,6 +746,80 @@ class basic_server_settings_t
 		}
 		//! }
 
+		//! Release read buffers of idle connections.
+		/*!
+			If this option is enabled then a connection doesn't hold
+			a read buffer while it is idle. The buffer is returned to a pool
+			shared by all connections of the server when the connection
+			starts waiting for a new request. The connection waits until
+			the socket becomes readable and takes a buffer from the pool
+			only if there is some data to read. If the peer closes
+			the connection no buffer is taken at all.
+
+			A TLS stream can't be waited for that way. So a TLS connection
+			returns its buffer only if no data arrives during two
+			consecutive timeout checks (see timer_manager()), and a small
+			read is used to detect the arrival of new data.
+
+			In both cases data is read directly into the connection's
+			buffer while requests follow each other.
+
+			It allows to reduce memory consumption for servers
+			with a lot of mostly idle keep-alive connections.
+
+			@note
+			It is disabled by default.
+
+			@since v.0.6.18
+		*/
+		//! \{
+		Derived &
+		release_idle_read_buffers( bool v ) &
+		{
+			m_release_idle_read_buffers = v;
+			return reference_to_derived();
+		}
+
+		Derived &&
+		release_idle_read_buffers( bool v ) &&
+		{
+			return std::move( this->release_idle_read_buffers( v ) );
+		}
+
+		bool
+		release_idle_read_buffers() const
+		{
+			return m_release_idle_read_buffers;
+		}
+		//! \}
+
+		//! Max count of free read buffers kept for reuse.
+		/*!
+			Is used only if release_idle_read_buffers() is enabled.
+
+			@since v.0.6.18
+		*/
+		//! \{
+		Derived &
+		read_buffer_pool_capacity( std::size_t v ) &
+		{
+			m_read_buffer_pool_capacity = v;
+			return reference_to_derived();
+		}
+
+		Derived &&
+		read_buffer_pool_capacity( std::size_t v ) &&
+		{
+			return std::move( this->read_buffer_pool_capacity( v ) );
+		}
+
+		std::size_t
+		read_buffer_pool_capacity() const
+		{
+			return m_read_buffer_pool_capacity;
+		}
+		//! \}
+
 		//! A period for holding connection before completely receiving
 		//! new http-request. Starts counting since connection is establised
 		//! or a previous request was responsed.
@@ -839,6 +913,153 @@ class basic_server_settings_t
 		}
 		//! \}
 
+		//! Add `Date` field to every response.
+		/*!
+			If enabled then every response created by a response builder
+			gets `Date` field with the current time. The value is formatted
+			only once per second and is written directly into the serialized
+			header, so the field isn't visible via header() of a response
+			builder. If `Date` field is set for a response explicitly
+			(e.g. by append_header_date_field()) that field is used instead.
+
+			@note
+			It is disabled by default.
+
+			@since v.0.6.18
+		*/
+		//! \{
+		Derived &
+		add_date_field( bool v ) &
+		{
+			m_add_date_field = v;
+			return reference_to_derived();
+		}
+
+		Derived &&
+		add_date_field( bool v ) &&
+		{
+			return std::move( this->add_date_field( v ) );
+		}
+
+		bool
+		add_date_field() const
+		{
+			return m_add_date_field;
+		}
+		//! \}
+
+		//! Factory of handlers for streamed request bodies.
+		/*!
+			If the factory is set then it is called for every incoming
+			request right after the header is parsed. If it returns
+			a handler then the body of the request is passed to that
+			handler part by part instead of being collected in memory.
+			The handler can pause reading of the body from the socket
+			(see body_stream_action_t).
+
+			@since v.0.6.18
+		*/
+		//! \{
+		Derived &
+		request_body_stream_handler_factory(
+			request_body_stream_handler_factory_t factory ) &
+		{
+			m_request_body_stream_handler_factory = std::move( factory );
+			return reference_to_derived();
+		}
+
+		Derived &&
+		request_body_stream_handler_factory(
+			request_body_stream_handler_factory_t factory ) &&
+		{
+			return std::move( this->request_body_stream_handler_factory(
+					std::move( factory ) ) );
+		}
+
+		const request_body_stream_handler_factory_t &
+		request_body_stream_handler_factory() const
+		{
+			return m_request_body_stream_handler_factory;
+		}
+		//! \}
+
+		//! A delay before writing outgoing websocket frames.
+		/*!
+			If the delay isn't zero then a websocket connection that has
+			nothing to write waits for the specified time before writing
+			a new frame. Frames sent during that time are written together
+			with the first one by a single gather write operation.
+
+			It is similar to Nagle's algorithm and trades latency for
+			throughput when a lot of small messages are sent.
+
+			Frames that are sent while the previous write operation is in
+			progress are always written together (without the delay).
+
+			@note
+			The delay is zero (disabled) by default.
+
+			@since v.0.6.18
+		*/
+		//! \{
+		Derived &
+		websocket_write_coalescing_delay( std::chrono::microseconds d ) &
+		{
+			m_websocket_write_coalescing_delay = d;
+			return reference_to_derived();
+		}
+
+		Derived &&
+		websocket_write_coalescing_delay( std::chrono::microseconds d ) &&
+		{
+			return std::move( this->websocket_write_coalescing_delay( d ) );
+		}
+
+		std::chrono::microseconds
+		websocket_write_coalescing_delay() const
+		{
+			return m_websocket_write_coalescing_delay;
+		}
+		//! \}
+
+		//! A limit for the size of data written together with
+		//! the current write operation.
+		/*!
+			Responses (or websocket frames) that are ready while a write
+			operation of a connection is in progress are written by the
+			next gather write operation together. Data of those responses
+			is added to that operation only while its total size doesn't
+			exceed the limit. The rest is written by next operations.
+
+			Zero value disables writing of several responses with data
+			by one operation.
+
+			@note
+			The default value is 64 KiB.
+
+			@since v.0.6.18
+		*/
+		//! \{
+		Derived &
+		max_coalesced_write_size( std::size_t s ) &
+		{
+			m_max_coalesced_write_size = s;
+			return reference_to_derived();
+		}
+
+		Derived &&
+		max_coalesced_write_size( std::size_t s ) &&
+		{
+			return std::move( this->max_coalesced_write_size( s ) );
+		}
+
+		std::size_t
+		max_coalesced_write_size() const
+		{
+			return m_max_coalesced_write_size;
+		}
+		//! \}
+
 
 		//! Request handler.
 		//! \{
@@ -1695,6 +1916,15 @@ class basic_server_settings_t
 		//! Size of buffer for io operations.
 		std::size_t m_buffer_size{ 4 * 1024 };
 
+		//! Read buffers pooling.
+		/*!
+		 * @since v.0.6.18
+		 */
+		//! \{
+		bool m_release_idle_read_buffers{ false };
+		std::size_t m_read_buffer_pool_capacity{ 256 };
+		//! \}
+
 		//! Operations timeouts.
 		//! \{
 		std::chrono::steady_clock::duration
@@ -1710,6 +1940,31 @@ class basic_server_settings_t
 		//! Max pipelined requests to receive on single connection.
 		std::size_t m_max_pipelined_requests{ 1 };
 
+		//! Add `Date` field to every response.
+		/*!
+		 * @since v.0.6.18
+		 */
+		bool m_add_date_field{ false };
+
+		//! Factory of handlers for streamed request bodies.
+		/*!
+		 * @since v.0.6.18
+		 */
+		request_body_stream_handler_factory_t m_request_body_stream_handler_factory;
+
+		//! A delay before writing outgoing websocket frames.
+		/*!
+		 * @since v.0.6.18
+		 */
+		std::chrono::microseconds m_websocket_write_coalescing_delay{ 0 };
+
+		//! A limit for the size of data written together with
+		//! the current write operation.
+		/*!
+		 * @since v.0.6.18
+		 */
+		std::size_t m_max_coalesced_write_size{ 64 * 1024 };
+
 		//! Request handler.
 		std::unique_ptr< request_handler_t > m_request_handler;
 
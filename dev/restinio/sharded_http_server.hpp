@@ -0,0 +1,415 @@
+/*
+	restinio
+*/
+
+/*!
+	A set of independent HTTP-servers sharing one port via SO_REUSEPORT.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/http_server.hpp>
+
+#include <restinio/utils/suppress_exceptions.hpp>
+
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+namespace restinio
+{
+
+namespace impl
+{
+
+#if defined(SO_REUSEPORT)
+//! Socket option for enabling SO_REUSEPORT on an acceptor.
+/*!
+ * @since v.0.6.18
+ */
+using reuse_port_option_t =
+		asio_ns::detail::socket_option::boolean< SOL_SOCKET, SO_REUSEPORT >;
+#endif
+
+} /* namespace impl */
+
+//
+// sharded_thread_init_hook_t
+//
+/*!
+ * @brief A hook that is called for the thread of every shard.
+ *
+ * Gets the index of the shard and the native handle of the thread.
+ * Can be used for setting CPU affinity, priority or name of the thread.
+ *
+ * @since v.0.6.18
+ */
+using sharded_thread_init_hook_t =
+		std::function< void( std::size_t, std::thread::native_handle_type ) >;
+
+#if defined(__linux__)
+//
+// pin_shard_threads_to_cpus
+//
+/*!
+ * @brief Make a thread init hook that pins the thread of every shard
+ * to its own CPU.
+ *
+ * The shard with index `i` is pinned to the `i`-th CPU available to
+ * the process (CPUs are reused if there are more shards than CPUs).
+ *
+ * Usage example:
+ * @code
+ * restinio::sharded_http_server_t<> server{ shards_count, configurator };
+ * server.thread_init_hook( restinio::pin_shard_threads_to_cpus() );
+ * server.start();
+ * @endcode
+ *
+ * @note
+ * Available on Linux only.
+ *
+ * @since v.0.6.18
+ */
+RESTINIO_NODISCARD
+inline sharded_thread_init_hook_t
+pin_shard_threads_to_cpus()
+{
+	cpu_set_t available;
+	CPU_ZERO( &available );
+	if( 0 != sched_getaffinity( 0, sizeof( available ), &available ) )
+		throw exception_t{ "unable to get CPUs available to the process" };
+
+	std::vector< int > cpus;
+	for( int cpu = 0; cpu != CPU_SETSIZE; ++cpu )
+		if( CPU_ISSET( cpu, &available ) )
+			cpus.push_back( cpu );
+
+	return [cpus = std::move( cpus )](
+			std::size_t shard_index,
+			std::thread::native_handle_type handle )
+		{
+			const int cpu = cpus[ shard_index % cpus.size() ];
+
+			cpu_set_t set;
+			CPU_ZERO( &set );
+			CPU_SET( cpu, &set );
+
+			const int rc = pthread_setaffinity_np( handle, sizeof( set ), &set );
+			if( 0 != rc )
+				throw exception_t{
+					fmt::format(
+						RESTINIO_FMT_FORMAT_STRING(
+							"unable to pin the thread of shard {} to CPU {}: {}" ),
+						shard_index,
+						cpu,
+						rc ) };
+		};
+}
+#endif
+
+//
+// sharded_http_server_t
+//
+/*!
+ * @brief A set of HTTP-server instances where every instance has its
+ * own io_context and its own worker thread.
+ *
+ * Every shard is a separate http_server_t object with own io_context,
+ * acceptor, connection factory and timer manager. The io_context of
+ * a shard is run only on the shard's thread. All acceptors are bound to
+ * the same address and port with SO_REUSEPORT option, so the OS
+ * distributes new connections between shards.
+ *
+ * Connections never migrate between threads, so traits with
+ * noop_strand_t (like default_single_thread_traits_t) can safely be used.
+ *
+ * Settings for every shard are created by a configurator that is
+ * called for every shard:
+ * @code
+ * restinio::sharded_http_server_t<> server{
+ * 	std::thread::hardware_concurrency(),
+ * 	[]( std::size_t shard_index, auto & settings ) {
+ * 		settings
+ * 			.port( 8080 )
+ * 			.address( "localhost" )
+ * 			.request_handler( ... );
+ * 	} };
+ * server.start();
+ * ...
+ * server.stop();
+ * server.wait();
+ * @endcode
+ *
+ * @note
+ * The configurator shouldn't use zero as port number because in that
+ * case every shard will get its own port.
+ *
+ * @attention
+ * SO_REUSEPORT is required. An exception is thrown by the constructor
+ * if the platform doesn't support it.
+ *
+ * Threads of shards aren't pinned to CPUs by default. A thread init hook
+ * can be set for that (see thread_init_hook() and
+ * pin_shard_threads_to_cpus()).
+ *
+ * @note
+ * This class is not thread-safe (except stop() method). Expected usage
+ * scenario is to start and wait it on the same thread.
+ *
+ * @since v.0.6.18
+ */
+template< typename Traits = default_single_thread_traits_t >
+class sharded_http_server_t
+{
+	public:
+		using traits_t = Traits;
+		using http_server_type_t = http_server_t< Traits >;
+
+		sharded_http_server_t( const sharded_http_server_t & ) = delete;
+		sharded_http_server_t( sharded_http_server_t && ) = delete;
+
+		template< typename Configurator >
+		sharded_http_server_t(
+			//! Count of shards.
+			std::size_t shards_count,
+			//! Function for making settings of a shard.
+			/*!
+			 * It should have the format:
+			 * @code
+			 * void(std::size_t shard_index, server_settings_t<Traits> & settings);
+			 * @endcode
+			 */
+			Configurator && configurator )
+		{
+#if defined(SO_REUSEPORT)
+			if( 0u == shards_count )
+				throw exception_t{ "shards_count can't be zero" };
+
+			m_shards.reserve( shards_count );
+			for( std::size_t i = 0u; i != shards_count; ++i )
+			{
+				m_shards.emplace_back(
+						std::make_unique< http_server_type_t >(
+								// The io_context will be used on one thread only.
+								io_context_holder_t{
+										std::make_shared< asio_ns::io_context >( 1 ) },
+								make_shard_settings( i, configurator ) ) );
+			}
+#else
+			(void)shards_count;
+			(void)configurator;
+
+			throw exception_t{
+					"sharded_http_server_t requires SO_REUSEPORT support" };
+#endif
+		}
+
+		~sharded_http_server_t()
+		{
+			if( started() )
+			{
+				stop();
+				wait();
+			}
+		}
+
+		//! Get the count of shards.
+		RESTINIO_NODISCARD
+		std::size_t
+		shards_count() const noexcept { return m_shards.size(); }
+
+		//! Get access to a shard.
+		RESTINIO_NODISCARD
+		http_server_type_t &
+		shard( std::size_t index ) noexcept
+		{
+			return *(m_shards[ index ].m_server);
+		}
+
+		//! Set a hook to be called for the thread of every shard.
+		/*!
+		 * The hook is called by start() on the calling thread right after
+		 * the creation of a shard's thread and before opening of shards,
+		 * so no connection is accepted before the hook is completed
+		 * for every shard.
+		 *
+		 * If the hook throws then all shards are stopped and the
+		 * exception is rethrown from start().
+		 */
+		void
+		thread_init_hook( sharded_thread_init_hook_t hook )
+		{
+			if( started() )
+				throw exception_t{ "sharded_http_server is already started" };
+
+			m_thread_init_hook = std::move( hook );
+		}
+
+		//! Open all shards and start their threads.
+		/*!
+		 * Returns when all shards are opened. If some shard can't be
+		 * opened all shards are stopped and the exception is rethrown.
+		 */
+		void
+		start()
+		{
+			if( started() )
+				throw exception_t{ "sharded_http_server is already started" };
+
+			// Promises are shared with open_async handlers because those
+			// handlers can outlive this call if a failure is detected.
+			auto open_results = std::make_shared<
+					std::vector< std::promise< void > > >( m_shards.size() );
+
+			try
+			{
+				for( std::size_t i = 0u; i != m_shards.size(); ++i )
+				{
+					auto & shard = m_shards[ i ];
+					shard.m_thread = std::thread{ [&ctx = shard.m_server->io_context()] {
+							auto work{ asio_ns::make_work_guard( ctx ) };
+							ctx.run();
+						} };
+
+					if( m_thread_init_hook )
+						m_thread_init_hook( i, shard.m_thread.native_handle() );
+				}
+
+				for( std::size_t i = 0u; i != m_shards.size(); ++i )
+				{
+					m_shards[ i ].m_server->open_async(
+						[open_results, i]{ (*open_results)[ i ].set_value(); },
+						[open_results, i]( std::exception_ptr ex ){
+							(*open_results)[ i ].set_exception( std::move( ex ) );
+						} );
+				}
+			}
+			catch( ... )
+			{
+				for( auto & shard : m_shards )
+					shard.m_server->io_context().stop();
+				join_threads();
+
+				throw;
+			}
+
+			m_started = true;
+
+			std::exception_ptr first_error;
+			for( auto & r : *open_results )
+			{
+				try
+				{
+					r.get_future().get();
+				}
+				catch( ... )
+				{
+					if( !first_error )
+						first_error = std::current_exception();
+				}
+			}
+
+			if( first_error )
+			{
+				stop();
+				wait();
+				std::rethrow_exception( first_error );
+			}
+		}
+
+		//! Is server started?
+		RESTINIO_NODISCARD
+		bool
+		started() const noexcept { return m_started; }
+
+		//! Initiate the shutdown of all shards.
+		/*!
+		 * Every shard is closed on its own thread and then the io_context
+		 * of the shard is stopped.
+		 *
+		 * Can be called from any thread, including threads of shards.
+		 */
+		void
+		stop() noexcept
+		{
+			for( auto & shard : m_shards )
+			{
+				auto & ctx = shard.m_server->io_context();
+				restinio::utils::suppress_exceptions_quietly( [&] {
+						shard.m_server->close_async(
+							[&ctx]{ ctx.stop(); },
+							[&ctx]( std::exception_ptr ){ ctx.stop(); } );
+					} );
+			}
+		}
+
+		//! Wait for the completion of all shard threads.
+		void
+		wait() noexcept
+		{
+			if( started() )
+			{
+				join_threads();
+				m_started = false;
+			}
+		}
+
+	private:
+		struct shard_t
+		{
+			shard_t( std::unique_ptr< http_server_type_t > server )
+				:	m_server{ std::move( server ) }
+			{}
+
+			std::unique_ptr< http_server_type_t > m_server;
+			std::thread m_thread;
+		};
+
+		std::vector< shard_t > m_shards;
+
+		//! An optional hook for threads of shards.
+		sharded_thread_init_hook_t m_thread_init_hook;
+
+		bool m_started{ false };
+
+		template< typename Configurator >
+		static server_settings_t< Traits >
+		make_shard_settings(
+			std::size_t shard_index,
+			Configurator & configurator )
+		{
+			server_settings_t< Traits > settings;
+			configurator( shard_index, settings );
+
+#if defined(SO_REUSEPORT)
+			// SO_REUSEPORT is set after user's acceptor options.
+			std::shared_ptr< acceptor_options_setter_t > user_setter{
+					settings.acceptor_options_setter() };
+			settings.acceptor_options_setter(
+				[user_setter]( acceptor_options_t & options ) {
+					(*user_setter)( options );
+					options.set_option( impl::reuse_port_option_t{ true } );
+				} );
+#endif
+
+			return settings;
+		}
+
+		void
+		join_threads() noexcept
+		{
+			for( auto & shard : m_shards )
+				if( shard.m_thread.joinable() )
+					shard.m_thread.join();
+		}
+};
+
+} /* namespace restinio */
@@ -15,6 +15,7 @@
 #include <restinio/ip_blocker.hpp>
 #include <restinio/default_strands.hpp>
 #include <restinio/connection_count_limiter.hpp>
+#include <restinio/http_parser_backend.hpp>
 
 #include <restinio/utils/metaprogramming.hpp>
 
@@ -355,6 +356,85 @@ struct traits_t
 	 * @since v.0.6.13
 	 */
 	using extra_data_factory_t = no_extra_data_factory_t;
+
+	/*!
+	 * @brief A flag that enables collecting of request body as
+	 * slices of read buffers.
+	 *
+	 * By default the whole body of an incoming request is copied into
+	 * a std::string. For big bodies this means a copy of every byte
+	 * and several reallocations of the string.
+	 *
+	 * If this flag is set to `true` then the body is kept as a sequence
+	 * of slices that point directly into buffers used for reading data
+	 * from a socket. A connection allocates a new read buffer if the
+	 * previous one is still referenced by a request object. The slices
+	 * are available via generic_request_t::body_slices() method:
+	 * @code
+	 * struct my_traits : public restinio::default_traits_t {
+	 * 	static constexpr bool use_zero_copy_request_body = true;
+	 * };
+	 * ...
+	 * [](const restinio::request_handle_t & req) {
+	 * 	for( const auto & slice : req->body_slices() )
+	 * 		store( slice.view() );
+	 * 	...
+	 * }
+	 * @endcode
+	 * generic_request_t::body() (and generic_request_t::body_as_string())
+	 * is still available but it copies the body into a std::string on
+	 * the first call.
+	 *
+	 * @since v.0.6.18
+	 */
+	static constexpr bool use_zero_copy_request_body = false;
+
+	/*!
+	 * @brief A flag that enables placement of request objects into
+	 * a per-connection arena.
+	 *
+	 * By default every request object (with its extra-data) is created
+	 * by std::make_shared and that means a separate allocation for
+	 * every request.
+	 *
+	 * If this flag is set to `true` then a connection places request
+	 * objects into a monotonic block that is reused when all requests
+	 * from it are destroyed. For a connection that handles requests
+	 * one by one there are no allocations for request objects at all:
+	 * @code
+	 * struct my_traits : public restinio::default_traits_t {
+	 * 	static constexpr bool use_request_arena = true;
+	 * };
+	 * @endcode
+	 *
+	 * In that mode the memory of the request target, of header fields
+	 * and of the body of a destroyed request is also reused by the
+	 * connection for the next request. So if the next request isn't
+	 * bigger than the previous one there are no allocations while it
+	 * is parsed and passed to the request handler.
+	 *
+	 * @note
+	 * A request object that is held by a user for a long time
+	 * pins the whole block (4KiB).
+	 *
+	 * @since v.0.6.18
+	 */
+	static constexpr bool use_request_arena = false;
+
+	/*!
+	 * @brief The type of backend for parsing of incoming requests.
+	 *
+	 * By default nodejs/http_parser is used. An in-tree parser that
+	 * scans data by SIMD instructions can be used instead:
+	 * @code
+	 * struct my_traits : public restinio::default_traits_t {
+	 * 	using http_parser_backend_t = restinio::simd_http_parser_backend_t;
+	 * };
+	 * @endcode
+	 *
+	 * @since v.0.6.18
+	 */
+	using http_parser_backend_t = default_http_parser_backend_t;
 };
 
 //
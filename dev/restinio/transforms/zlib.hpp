@@ -23,6 +23,9 @@
 
 #include <string>
 #include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
 
 namespace restinio
 {
@@ -79,6 +82,14 @@ class params_t
 			deflate,
 			//! gzip format
 			gzip,
+			//! Raw deflate data without zlib header and trailer (RFC 1951).
+			/*!
+				This format is not an HTTP content-coding. It is intended for
+				WebSocket permessage-deflate extension (RFC 7692).
+
+				@since v.0.6.18
+			*/
+			raw_deflate,
 			//! Identity. With semantics descrobed here: https://developer.mozilla.org/en-US/docs/Web/HTTP/Headers/Accept-Encoding
 			/*
 				Means that no compression will be used and no header/trailer will be applied.
@@ -414,6 +425,25 @@ make_gzip_decompress_params()
 			params_t::format_t::gzip };
 }
 
+//! @since v.0.6.18
+inline params_t
+make_raw_deflate_compress_params( int compression_level = -1 )
+{
+	return params_t{
+			params_t::operation_t::compress,
+			params_t::format_t::raw_deflate,
+			compression_level };
+}
+
+//! @since v.0.6.18
+inline params_t
+make_raw_deflate_decompress_params()
+{
+	return params_t{
+			params_t::operation_t::decompress,
+			params_t::format_t::raw_deflate };
+}
+
 inline params_t
 make_identity_params()
 {
@@ -421,6 +451,269 @@ make_identity_params()
 }
 ///@}
 
+//! Default max count of idle zlib streams kept by a thread for reuse.
+//! @since v.0.6.18
+constexpr std::size_t default_stream_pool_capacity = 8u;
+
+namespace impl
+{
+
+//
+// zlib_stream_key_t
+//
+
+//! Parameters of initialization of a zlib stream.
+/*!
+	Streams with the same key can be reused one by another after
+	deflateReset()/inflateReset().
+
+	@since v.0.6.18
+*/
+struct zlib_stream_key_t
+{
+	explicit zlib_stream_key_t( const params_t & params ) noexcept
+		:	m_operation{ params.operation() }
+		,	m_format{ params.format() }
+		,	m_window_bits{ params.window_bits() }
+	{
+		// Other params are used only by deflateInit2().
+		if( params_t::operation_t::compress == m_operation )
+		{
+			m_level = params.level();
+			m_mem_level = params.mem_level();
+			m_strategy = params.strategy();
+		}
+	}
+
+	bool
+	operator==( const zlib_stream_key_t & o ) const noexcept
+	{
+		return m_operation == o.m_operation &&
+			m_format == o.m_format &&
+			m_window_bits == o.m_window_bits &&
+			m_level == o.m_level &&
+			m_mem_level == o.m_mem_level &&
+			m_strategy == o.m_strategy;
+	}
+
+	params_t::operation_t m_operation;
+	params_t::format_t m_format;
+	int m_window_bits;
+	int m_level{ 0 };
+	int m_mem_level{ 0 };
+	int m_strategy{ 0 };
+};
+
+//! Alias for unique pointer to zlib stream.
+/*!
+	A stream can't be moved after initialization because zlib
+	keeps a pointer to it.
+
+	@since v.0.6.18
+*/
+using zlib_stream_unique_ptr_t = std::unique_ptr< z_stream >;
+
+//
+// zlib_stream_pool_t
+//
+
+//! A pool of initialized zlib streams of the current thread.
+/*!
+	Initialization of a zlib stream allocates about 256 KiB for
+	compression (and about 40 KiB for decompression). Streams are
+	returned to the pool by zlib_t and are reused after
+	deflateReset()/inflateReset() by the next zlib_t with the same
+	parameters on the same thread.
+
+	Every thread has its own pool, so no locks are needed.
+
+	@since v.0.6.18
+*/
+class zlib_stream_pool_t
+{
+	public:
+		zlib_stream_pool_t() = default;
+
+		zlib_stream_pool_t( const zlib_stream_pool_t & ) = delete;
+		zlib_stream_pool_t & operator=( const zlib_stream_pool_t & ) = delete;
+
+		~zlib_stream_pool_t()
+		{
+			capacity( 0u );
+
+			// Streams released after this point (e.g. by zlib_t objects
+			// destroyed after the pool on the same thread) are ended
+			// without the pool, see release_for_current_thread().
+			destroyed_flag() = true;
+		}
+
+		//! Get the pool of the current thread.
+		/*!
+			\return nullptr if the pool of the current thread is already
+			destroyed (it happens at the exit of the thread).
+		*/
+		static zlib_stream_pool_t *
+		for_current_thread() noexcept
+		{
+			if( destroyed_flag() )
+				return nullptr;
+
+			static thread_local zlib_stream_pool_t pool;
+			return &pool;
+		}
+
+		//! Get an idle stream from the pool of the current thread.
+		/*!
+			\return nullptr if there is no such stream.
+		*/
+		static zlib_stream_unique_ptr_t
+		acquire_for_current_thread( const zlib_stream_key_t & key ) noexcept
+		{
+			auto * pool = for_current_thread();
+			return pool ? pool->acquire( key ) : zlib_stream_unique_ptr_t{};
+		}
+
+		//! Return a stream to the pool of the current thread.
+		/*!
+			The stream is ended if the pool is already destroyed.
+		*/
+		static void
+		release_for_current_thread(
+			const zlib_stream_key_t & key,
+			zlib_stream_unique_ptr_t stream ) noexcept
+		{
+			if( auto * pool = for_current_thread() )
+				pool->release( key, std::move( stream ) );
+			else
+				end_stream( key, *stream );
+		}
+
+		//! Get an idle stream with the specified parameters.
+		/*!
+			\return nullptr if there is no such stream.
+		*/
+		zlib_stream_unique_ptr_t
+		acquire( const zlib_stream_key_t & key ) noexcept
+		{
+			zlib_stream_unique_ptr_t result;
+
+			// The most recently released stream is taken first.
+			for( auto it = m_streams.rbegin(); it != m_streams.rend(); ++it )
+				if( it->first == key )
+				{
+					result = std::move( it->second );
+					m_streams.erase( std::next( it ).base() );
+					break;
+				}
+
+			return result;
+		}
+
+		//! Return a stream to the pool.
+		/*!
+			The stream is reset. It is destroyed if it can't be reset
+			or if the pool is full.
+		*/
+		void
+		release(
+			const zlib_stream_key_t & key,
+			zlib_stream_unique_ptr_t stream ) noexcept
+		{
+			if( m_streams.size() < m_capacity && reset_stream( key, *stream ) )
+			{
+				try
+				{
+					m_streams.emplace_back( key, std::move( stream ) );
+					return;
+				}
+				catch( ... )
+				{}
+			}
+
+			end_stream( key, *stream );
+		}
+
+		//! Set the max count of idle streams.
+		void
+		capacity( std::size_t v ) noexcept
+		{
+			m_capacity = v;
+			while( m_streams.size() > m_capacity )
+			{
+				end_stream( m_streams.front().first, *m_streams.front().second );
+				m_streams.erase( m_streams.begin() );
+			}
+		}
+
+		std::size_t capacity() const noexcept { return m_capacity; }
+
+		//! Get the count of idle streams.
+		std::size_t size() const noexcept { return m_streams.size(); }
+
+	private:
+		//! Flag: the pool of the current thread is destroyed.
+		/*!
+			It is a trivially destructible thread_local object,
+			so it can be checked after the destruction of the pool.
+		*/
+		static bool &
+		destroyed_flag() noexcept
+		{
+			static thread_local bool destroyed{ false };
+			return destroyed;
+		}
+
+		static bool
+		reset_stream( const zlib_stream_key_t & key, z_stream & stream ) noexcept
+		{
+			const int r = params_t::operation_t::compress == key.m_operation ?
+					deflateReset( &stream ) : inflateReset( &stream );
+
+			return Z_OK == r;
+		}
+
+		static void
+		end_stream( const zlib_stream_key_t & key, z_stream & stream ) noexcept
+		{
+			if( params_t::operation_t::compress == key.m_operation )
+				deflateEnd( &stream );
+			else
+				inflateEnd( &stream );
+		}
+
+		std::size_t m_capacity{ default_stream_pool_capacity };
+
+		std::vector< std::pair< zlib_stream_key_t, zlib_stream_unique_ptr_t > >
+			m_streams;
+};
+
+} /* namespace impl */
+
+//! Set the max count of idle zlib streams kept by the current thread
+//! for reuse.
+/*!
+	Zero disables reuse of streams on the current thread.
+
+	@since v.0.6.18
+*/
+inline void
+stream_pool_capacity( std::size_t capacity ) noexcept
+{
+	if( auto * pool = impl::zlib_stream_pool_t::for_current_thread() )
+		pool->capacity( capacity );
+}
+
+//! Get the count of idle zlib streams kept by the current thread.
+/*!
+	@since v.0.6.18
+*/
+inline std::size_t
+idle_streams_count() noexcept
+{
+	const auto * pool = impl::zlib_stream_pool_t::for_current_thread();
+	return pool ? pool->size() : 0u;
+}
+
 //
 // zlib_t
 //
@@ -483,54 +776,16 @@ class zlib_t
 		{
 			if( !is_identity() )
 			{
-				// Setting allocator stuff before initializing
-				// TODO: allocation can be done with user defined allocator.
-				m_zlib_stream.zalloc = Z_NULL;
-				m_zlib_stream.zfree = Z_NULL;
-				m_zlib_stream.opaque = Z_NULL;
-
-				// Track initialization result.
-				int init_result;
-
-				// Compression.
-				auto current_window_bits = m_params.window_bits();
-
-				if( params_t::format_t::gzip == m_params.format() )
-				{
-					current_window_bits += 16;
-				}
-
-				if( params_t::operation_t::compress == m_params.operation() )
-				{
-					// zlib format.
-					init_result =
-						deflateInit2(
-							&m_zlib_stream,
-							m_params.level(),
-							Z_DEFLATED,
-							current_window_bits,
-							m_params.mem_level(),
-							m_params.strategy() );
-				}
+				// Since v.0.6.18 a stream initialized by a previous zlib_t
+				// with the same params is reused if it is possible.
+				m_zlib_stream =
+					impl::zlib_stream_pool_t::acquire_for_current_thread(
+						impl::zlib_stream_key_t{ m_params } );
+
+				if( m_zlib_stream )
+					m_zlib_stream_initialized = true;
 				else
-				{
-					init_result =
-						inflateInit2(
-							&m_zlib_stream,
-							current_window_bits );
-				}
-
-				if( Z_OK != init_result )
-				{
-					throw exception_t{
-						fmt::format(
-							RESTINIO_FMT_FORMAT_STRING(
-								"Failed to initialize zlib stream: {}, {}" ),
-							init_result,
-							get_error_msg() ) };
-				}
-
-				m_zlib_stream_initialized = true;
+					init_stream();
 
 				// Reserve initial buffer.
 				inc_buffer();
@@ -547,14 +802,10 @@ class zlib_t
 		{
 			if( m_zlib_stream_initialized )
 			{
-				if( params_t::operation_t::compress == m_params.operation() )
-				{
-					deflateEnd( &m_zlib_stream );
-				}
-				else
-				{
-					inflateEnd( &m_zlib_stream );
-				}
+				// The stream is reset and kept for reuse (or destroyed).
+				impl::zlib_stream_pool_t::release_for_current_thread(
+					impl::zlib_stream_key_t{ m_params },
+					std::move( m_zlib_stream ) );
 			}
 		}
 
@@ -578,23 +829,14 @@ class zlib_t
 			}
 			else
 			{
-				if( std::numeric_limits< decltype( m_zlib_stream.avail_in ) >::max() < input.size() )
-				{
-					throw exception_t{
-						fmt::format(
-							RESTINIO_FMT_FORMAT_STRING(
-								"input data is too large: {} (max possible: {}), "
-								"try to break large data into pieces" ),
-							input.size(),
-							std::numeric_limits< decltype( m_zlib_stream.avail_in ) >::max() ) };
-				}
+				ensure_input_size_is_acceptable( input );
 
 				if( 0 < input.size() )
 				{
-					m_zlib_stream.next_in =
+					m_zlib_stream->next_in =
 						reinterpret_cast< Bytef* >( const_cast< char* >( input.data() ) );
 
-					m_zlib_stream.avail_in = static_cast< uInt >( input.size() );
+					m_zlib_stream->avail_in = static_cast< uInt >( input.size() );
 
 					if( params_t::operation_t::compress == m_params.operation() )
 					{
@@ -608,6 +850,117 @@ class zlib_t
 			}
 		}
 
+		//! Decompress input data and pass the output by portions.
+		/*!
+			Unlike write() the output isn't collected in the internal
+			buffer. As soon as @a portion_size bytes are decompressed they
+			are passed to @a handler as std::string. The rest of the output
+			(it is less than @a portion_size) remains in the internal buffer
+			and can be taken by giveaway_output(). So a single call doesn't
+			keep more than @a portion_size bytes of output in memory
+			regardless of the compression ratio of @a input.
+
+			max_output_size() isn't applied here.
+
+			Handler must have the following format:
+			\code
+			void handler( std::string portion );
+			\endcode
+
+			\attention
+			It can be used only for decompression.
+
+			@since v.0.6.18
+		*/
+		template< typename Portion_Handler >
+		void
+		write_by_portions(
+			string_view_t input,
+			std::size_t portion_size,
+			Portion_Handler && handler )
+		{
+			ensure_operation_in_not_completed();
+
+			if( params_t::operation_t::decompress != m_params.operation() )
+				throw exception_t{
+					"write_by_portions() can be used only for decompression" };
+
+			if( 0u == portion_size )
+				throw exception_t{ "portion size can't be zero" };
+
+			if( is_identity() )
+			{
+				while( !input.empty() )
+				{
+					const auto size = (std::min)(
+							input.size(), portion_size - m_write_pos );
+					m_out_buffer.resize( m_write_pos );
+					m_out_buffer.append( input.data(), size );
+					m_write_pos += size;
+					input.remove_prefix( size );
+
+					if( portion_size == m_write_pos )
+						handler( giveaway_output() );
+				}
+				return;
+			}
+
+			ensure_input_size_is_acceptable( input );
+
+			m_zlib_stream->next_in =
+				reinterpret_cast< Bytef* >( const_cast< char* >( input.data() ) );
+			m_zlib_stream->avail_in = static_cast< uInt >( input.size() );
+
+			while( !m_stream_end_reached )
+			{
+				if( m_out_buffer.size() < portion_size )
+					m_out_buffer.resize( portion_size );
+
+				const auto provided_out_buffer_size = (std::min)(
+						portion_size - m_write_pos,
+						static_cast< std::size_t >(
+							std::numeric_limits< uInt >::max() ) );
+
+				m_zlib_stream->next_out =
+					reinterpret_cast< Bytef* >( &m_out_buffer[ m_write_pos ] );
+				m_zlib_stream->avail_out =
+					static_cast< uInt >( provided_out_buffer_size );
+
+				int operation_result = inflate( m_zlib_stream.get(), Z_NO_FLUSH );
+				if( !( Z_OK == operation_result ||
+						Z_BUF_ERROR == operation_result ||
+						Z_STREAM_END == operation_result ) )
+				{
+					throw exception_t{
+						fmt::format(
+							RESTINIO_FMT_FORMAT_STRING(
+								"unexpected result of inflate() (zlib): {}, {}" ),
+							operation_result,
+							get_error_msg() ) };
+				}
+
+				m_write_pos += provided_out_buffer_size - m_zlib_stream->avail_out;
+
+				if( Z_STREAM_END == operation_result )
+					m_stream_end_reached = true;
+
+				if( portion_size == m_write_pos )
+				{
+					// There can be more output even if all the input
+					// is consumed.
+					handler( giveaway_output() );
+					continue;
+				}
+
+				if( 0 == m_zlib_stream->avail_in ||
+					Z_BUF_ERROR == operation_result )
+				{
+					// All the input was consumed or no progress is possible.
+					break;
+				}
+			}
+		}
+
 		//! Flush the zlib stream.
 		/*!
 			Flushes underlying zlib stream.
@@ -620,8 +973,8 @@ class zlib_t
 
 			if( !is_identity() )
 			{
-				m_zlib_stream.next_in = nullptr;
-				m_zlib_stream.avail_in = static_cast< uInt >( 0 );
+				m_zlib_stream->next_in = nullptr;
+				m_zlib_stream->avail_in = static_cast< uInt >( 0 );
 
 				if( params_t::operation_t::compress == m_params.operation() )
 				{
@@ -642,8 +995,8 @@ class zlib_t
 
 			if( !is_identity() )
 			{
-				m_zlib_stream.next_in = nullptr;
-				m_zlib_stream.avail_in = static_cast< uInt >( 0 );
+				m_zlib_stream->next_in = nullptr;
+				m_zlib_stream->avail_in = static_cast< uInt >( 0 );
 
 				if( params_t::operation_t::compress == m_params.operation() )
 				{
@@ -697,7 +1050,101 @@ class zlib_t
 		//! Is operation complete?
 		bool is_completed() const { return m_operation_is_complete; }
 
+		//! Was the end of compressed stream found by decompression?
+		/*!
+			Data after the end of compressed stream is ignored.
+
+			@since v.0.6.18
+		*/
+		bool is_stream_end_reached() const { return m_stream_end_reached; }
+
+		//! Set the max size of decompressed output.
+		/*!
+			Decompression is stopped as soon as the current output
+			(see output_size()) becomes bigger than @a size. Only a few
+			bytes more than @a size are decompressed in that case, the rest
+			of input is ignored and is_output_limit_exceeded() returns true.
+
+			It has no effect for compression.
+
+			@since v.0.6.18
+		*/
+		void
+		max_output_size( std::size_t size ) noexcept
+		{
+			m_max_output_size = size;
+		}
+
+		//! Was decompression stopped because of max_output_size()?
+		/*!
+			@since v.0.6.18
+		*/
+		bool is_output_limit_exceeded() const { return m_output_limit_exceeded; }
+
 	private:
+		//! Initialize a new zlib stream.
+		/*!
+			@since v.0.6.18
+		*/
+		void
+		init_stream()
+		{
+			m_zlib_stream = std::make_unique< z_stream >();
+
+			// Setting allocator stuff before initializing
+			// TODO: allocation can be done with user defined allocator.
+			m_zlib_stream->zalloc = Z_NULL;
+			m_zlib_stream->zfree = Z_NULL;
+			m_zlib_stream->opaque = Z_NULL;
+
+			// Track initialization result.
+			int init_result;
+
+			// Compression.
+			auto current_window_bits = m_params.window_bits();
+
+			if( params_t::format_t::gzip == m_params.format() )
+			{
+				current_window_bits += 16;
+			}
+			else if( params_t::format_t::raw_deflate == m_params.format() )
+			{
+				current_window_bits = -current_window_bits;
+			}
+
+			if( params_t::operation_t::compress == m_params.operation() )
+			{
+				// zlib format.
+				init_result =
+					deflateInit2(
+						m_zlib_stream.get(),
+						m_params.level(),
+						Z_DEFLATED,
+						current_window_bits,
+						m_params.mem_level(),
+						m_params.strategy() );
+			}
+			else
+			{
+				init_result =
+					inflateInit2(
+						m_zlib_stream.get(),
+						current_window_bits );
+			}
+
+			if( Z_OK != init_result )
+			{
+				throw exception_t{
+					fmt::format(
+						RESTINIO_FMT_FORMAT_STRING(
+							"Failed to initialize zlib stream: {}, {}" ),
+						init_result,
+						get_error_msg() ) };
+			}
+
+			m_zlib_stream_initialized = true;
+		}
+
 		bool is_identity() const
 		{
 			return params_t::format_t::identity == m_params.format();
@@ -708,12 +1155,31 @@ class zlib_t
 		get_error_msg() const
 		{
 			const char * err_msg = "<no zlib error description>";
-			if( m_zlib_stream.msg )
-				err_msg = m_zlib_stream.msg;
+			if( m_zlib_stream->msg )
+				err_msg = m_zlib_stream->msg;
 
 			return err_msg;
 		}
 
+		//! Throws if the input can't be passed to zlib by a single call.
+		/*!
+			@since v.0.6.18
+		*/
+		void
+		ensure_input_size_is_acceptable( string_view_t input ) const
+		{
+			if( std::numeric_limits< decltype( m_zlib_stream->avail_in ) >::max() < input.size() )
+			{
+				throw exception_t{
+					fmt::format(
+						RESTINIO_FMT_FORMAT_STRING(
+							"input data is too large: {} (max possible: {}), "
+							"try to break large data into pieces" ),
+						input.size(),
+						std::numeric_limits< decltype( m_zlib_stream->avail_in ) >::max() ) };
+			}
+		}
+
 		//! Checks completion flag and throws if operation is is already completed.
 		void
 		ensure_operation_in_not_completed() const
@@ -734,13 +1200,22 @@ class zlib_t
 		auto
 		prepare_out_buffer()
 		{
-			m_zlib_stream.next_out =
+			m_zlib_stream->next_out =
 				reinterpret_cast< Bytef* >(
 					const_cast< char* >( m_out_buffer.data() + m_write_pos ) );
 
-			const auto provided_out_buffer_size =
+			auto provided_out_buffer_size =
 				m_out_buffer.size() - m_write_pos;
-			m_zlib_stream.avail_out =
+
+			// Decompression shouldn't produce more than one byte above
+			// the limit. That byte shows that the limit is exceeded.
+			if( params_t::operation_t::decompress == m_params.operation() &&
+				m_max_output_size - m_write_pos < provided_out_buffer_size )
+			{
+				provided_out_buffer_size = m_max_output_size - m_write_pos + 1u;
+			}
+
+			m_zlib_stream->avail_out =
 				static_cast<uInt>( provided_out_buffer_size );
 
 			return provided_out_buffer_size;
@@ -749,7 +1224,7 @@ class zlib_t
 		//! Handle incoming data for compression operation.
 		/*
 			Data and its size must be already in
-			`m_zlib_stream.next_in`, `m_zlib_stream.avail_in`.
+			`m_zlib_stream->next_in`, `m_zlib_stream->avail_in`.
 		*/
 		void
 		write_compress_impl( int flush )
@@ -758,15 +1233,15 @@ class zlib_t
 			{
 				const auto provided_out_buffer_size = prepare_out_buffer();
 
-				int operation_result = deflate( &m_zlib_stream, flush );
+				int operation_result = deflate( m_zlib_stream.get(), flush );
 
 				if( !( Z_OK == operation_result ||
 						Z_BUF_ERROR == operation_result ||
 						( Z_STREAM_END == operation_result && Z_FINISH == flush ) ) )
 				{
 					const char * err_msg = "<no error desc>";
-					if( m_zlib_stream.msg )
-						err_msg = m_zlib_stream.msg;
+					if( m_zlib_stream->msg )
+						err_msg = m_zlib_stream->msg;
 
 					throw exception_t{
 						fmt::format(
@@ -776,9 +1251,9 @@ class zlib_t
 							err_msg ) };
 				}
 
-				m_write_pos += provided_out_buffer_size - m_zlib_stream.avail_out;
+				m_write_pos += provided_out_buffer_size - m_zlib_stream->avail_out;
 
-				if( 0 == m_zlib_stream.avail_out && Z_STREAM_END != operation_result )
+				if( 0 == m_zlib_stream->avail_out && Z_STREAM_END != operation_result )
 				{
 					// Looks like not all the output was obtained.
 					// There is a minor chance that it just happened to
@@ -788,7 +1263,7 @@ class zlib_t
 					continue;
 				}
 
-				if( 0 == m_zlib_stream.avail_in )
+				if( 0 == m_zlib_stream->avail_in )
 				{
 					// All the input was consumed.
 					break;
@@ -799,16 +1274,19 @@ class zlib_t
 		//! Handle incoming data for decompression operation.
 		/*
 			Data and its size must be already in
-			`m_zlib_stream.next_in`, `m_zlib_stream.avail_in`.
+			`m_zlib_stream->next_in`, `m_zlib_stream->avail_in`.
 		*/
 		void
 		write_decompress_impl( int flush )
 		{
+			if( m_output_limit_exceeded )
+				return;
+
 			while( true )
 			{
 				const auto provided_out_buffer_size = prepare_out_buffer();
 
-				int operation_result = inflate( &m_zlib_stream, flush );
+				int operation_result = inflate( m_zlib_stream.get(), flush );
 				if( !( Z_OK == operation_result ||
 						Z_BUF_ERROR == operation_result ||
 						Z_STREAM_END == operation_result ) )
@@ -821,9 +1299,24 @@ class zlib_t
 							get_error_msg() ) };
 				}
 
-				m_write_pos += provided_out_buffer_size - m_zlib_stream.avail_out;
+				m_write_pos += provided_out_buffer_size - m_zlib_stream->avail_out;
 
-				if( 0 == m_zlib_stream.avail_out && Z_STREAM_END != operation_result )
+				if( m_write_pos > m_max_output_size )
+				{
+					m_output_limit_exceeded = true;
+					break;
+				}
+
+				if( Z_STREAM_END == operation_result )
+				{
+					// Nothing more can be decompressed, the rest of input
+					// (if any) must be ignored. Otherwise inflate() would
+					// return Z_STREAM_END without consuming input forever.
+					m_stream_end_reached = true;
+					break;
+				}
+
+				if( 0 == m_zlib_stream->avail_out )
 				{
 					// Looks like not all the output was obtained.
 					// There is a minor chance that it just happened to
@@ -833,7 +1326,7 @@ class zlib_t
 					continue;
 				}
 
-				if( 0 == m_zlib_stream.avail_in )
+				if( 0 == m_zlib_stream->avail_in )
 				{
 					// All the input was consumed.
 					break;
@@ -852,7 +1345,11 @@ class zlib_t
 		bool m_zlib_stream_initialized{ false };
 
 		//! zlib stream.
-		z_stream m_zlib_stream;
+		/*!
+			Since v.0.6.18 it is allocated separately to be kept in
+			a pool of streams after the end of the transformation.
+		*/
+		impl::zlib_stream_unique_ptr_t m_zlib_stream;
 
 		//! Output buffer.
 		std::string m_out_buffer;
@@ -860,6 +1357,18 @@ class zlib_t
 		std::size_t m_write_pos{ 0 };
 
 		bool m_operation_is_complete{ false };
+
+		//! Flag: inflate() has returned Z_STREAM_END.
+		//! @since v.0.6.18
+		bool m_stream_end_reached{ false };
+
+		//! The max size of decompressed output.
+		//! @since v.0.6.18
+		std::size_t m_max_output_size{ std::numeric_limits< std::size_t >::max() };
+
+		//! Flag: decompression was stopped because of m_max_output_size.
+		//! @since v.0.6.18
+		bool m_output_limit_exceeded{ false };
 };
 
 /** @name Helper functions for doing zlib transformation with less boilerplate.
@@ -961,6 +1470,10 @@ inline std::string content_encoding_token( params_t::format_t f )
 	{
 		result.assign( "gzip" );
 	}
+	if( params_t::format_t::raw_deflate == f )
+	{
+		throw exception_t{ "raw deflate is not a content-coding" };
+	}
 
 	return result;
 }
@@ -1333,11 +1846,11 @@ handle_body(
 
 	if( is_equal_caseless( content_encoding, "deflate" ) )
 	{
-		return handler( deflate_decompress( req.body() ) );
+		return handler( deflate_decompress( req.body_as_string() ) );
 	}
 	else if( is_equal_caseless( content_encoding, "gzip" ) )
 	{
-		return handler( gzip_decompress( req.body() ) );
+		return handler( gzip_decompress( req.body_as_string() ) );
 	}
 	else if( !is_equal_caseless( content_encoding, "identity" ) )
 	{
@@ -1348,7 +1861,7 @@ handle_body(
 		};
 	}
 
-	return handler( req.body() );
+	return handler( req.body_as_string() );
 }
 
 } /* namespace zlib */
@@ -0,0 +1,70 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief Detection of x86 instruction sets at run time.
+ *
+ * @since v.0.6.18
+ */
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+
+namespace restinio
+{
+
+namespace utils
+{
+
+namespace impl
+{
+
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && \
+		( defined( __x86_64__ ) || defined( __i386__ ) )
+
+#define RESTINIO_HAS_X86_CPU_FEATURES
+
+//
+// x86_features_t
+//
+
+//! Instruction sets supported by the CPU.
+struct x86_features_t
+{
+	bool m_ssse3;
+	bool m_avx2;
+};
+
+//! Detect instruction sets supported by the CPU.
+/*!
+ * The detection is performed only once.
+ *
+ * It is used for selection of SIMD code compiled with target options
+ * (GCC `#pragma GCC target`, clang `#pragma clang attribute`) when
+ * the instruction set isn't enabled at compile time.
+ */
+RESTINIO_NODISCARD
+inline const x86_features_t &
+x86_features() noexcept
+{
+	static const x86_features_t value = []() noexcept {
+		__builtin_cpu_init();
+		return x86_features_t{
+			0 != __builtin_cpu_supports( "ssse3" ),
+			0 != __builtin_cpu_supports( "avx2" )
+		};
+	}();
+
+	return value;
+}
+
+#endif
+
+} /* namespace impl */
+
+} /* namespace utils */
+
+} /* namespace restinio */
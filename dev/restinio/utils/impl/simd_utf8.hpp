@@ -0,0 +1,577 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief Validation of UTF-8 sequences by SIMD blocks.
+ *
+ * @since v.0.6.18
+ */
+
+#pragma once
+
+#include <restinio/compiler_features.hpp>
+
+#include <restinio/utils/impl/cpu_features.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+#if !defined( RESTINIO_SIMD_UTF8_SCALAR_ONLY )
+	#if defined( __SSE2__ ) || defined( _M_X64 ) || \
+			( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+		#define RESTINIO_SIMD_UTF8_USE_SSE2
+		#include <emmintrin.h>
+	#endif
+
+	#if defined( __SSSE3__ )
+		#define RESTINIO_SIMD_UTF8_USE_SSSE3
+		#include <tmmintrin.h>
+	#endif
+
+	#if defined( __AVX2__ )
+		#define RESTINIO_SIMD_UTF8_USE_AVX2
+		#include <immintrin.h>
+	#endif
+
+	#if ( defined( __ARM_NEON ) || defined( __ARM_NEON__ ) ) && \
+			( defined( __aarch64__ ) || defined( _M_ARM64 ) )
+		#define RESTINIO_SIMD_UTF8_USE_NEON
+		#include <arm_neon.h>
+	#endif
+
+	// If AVX2 isn't enabled at compile time then SSSE3 and AVX2 versions
+	// are compiled with target options and are selected at run time.
+	#if !defined( RESTINIO_SIMD_UTF8_USE_AVX2 ) && \
+			!defined( RESTINIO_SIMD_UTF8_NO_RUNTIME_DISPATCH ) && \
+			defined( RESTINIO_HAS_X86_CPU_FEATURES )
+		#define RESTINIO_SIMD_UTF8_RUNTIME_DISPATCH
+		#include <immintrin.h>
+	#endif
+#endif
+
+#define RESTINIO_SIMD_UTF8_PRAGMA( x ) _Pragma( #x )
+
+#if !defined( RESTINIO_SIMD_UTF8_RUNTIME_DISPATCH )
+	#define RESTINIO_SIMD_UTF8_TARGET_BEGIN( isa )
+	#define RESTINIO_SIMD_UTF8_TARGET_END
+#elif defined( __clang__ )
+	#define RESTINIO_SIMD_UTF8_TARGET_BEGIN( isa ) \
+		RESTINIO_SIMD_UTF8_PRAGMA( clang attribute push( \
+				__attribute__(( target( isa ) )), apply_to = function ) )
+	#define RESTINIO_SIMD_UTF8_TARGET_END \
+		RESTINIO_SIMD_UTF8_PRAGMA( clang attribute pop )
+#else
+	#define RESTINIO_SIMD_UTF8_TARGET_BEGIN( isa ) \
+		RESTINIO_SIMD_UTF8_PRAGMA( GCC push_options ) \
+		RESTINIO_SIMD_UTF8_PRAGMA( GCC target( isa ) )
+	#define RESTINIO_SIMD_UTF8_TARGET_END \
+		RESTINIO_SIMD_UTF8_PRAGMA( GCC pop_options )
+#endif
+
+namespace restinio
+{
+
+namespace utils
+{
+
+namespace impl
+{
+
+namespace simd_utf8
+{
+
+//
+// sequence_size
+//
+
+/*!
+ * @brief Check one UTF-8 sequence that starts at @a p.
+ *
+ * Overlong sequences, surrogates and values above 0x10FFFF are invalid
+ * (see RFC 3629, section 4).
+ *
+ * @return the size of the sequence or 0 if the sequence is invalid or
+ * incomplete.
+ */
+RESTINIO_NODISCARD
+inline std::size_t
+sequence_size( const std::uint8_t * p, const std::uint8_t * end ) noexcept
+{
+	const std::uint8_t first = p[ 0 ];
+	if( first < 0x80u )
+		return 1u;
+
+	std::size_t size;
+	std::uint8_t min_second = 0x80u;
+	std::uint8_t max_second = 0xBFu;
+
+	if( first < 0xC2u )
+		return 0u;
+	else if( first < 0xE0u )
+		size = 2u;
+	else if( first < 0xF0u )
+	{
+		size = 3u;
+		if( 0xE0u == first )
+			min_second = 0xA0u;
+		else if( 0xEDu == first )
+			max_second = 0x9Fu;
+	}
+	else if( first < 0xF5u )
+	{
+		size = 4u;
+		if( 0xF0u == first )
+			min_second = 0x90u;
+		else if( 0xF4u == first )
+			max_second = 0x8Fu;
+	}
+	else
+		return 0u;
+
+	if( static_cast< std::size_t >( end - p ) < size )
+		return 0u;
+
+	if( p[ 1 ] < min_second || p[ 1 ] > max_second )
+		return 0u;
+
+	for( std::size_t i = 2u; i != size; ++i )
+		if( 0x80u != ( p[ i ] & 0xC0u ) )
+			return 0u;
+
+	return size;
+}
+
+//
+// skip_ascii
+//
+
+//! Find the first non-ASCII char.
+/*!
+ * Data is processed by 16 bytes (if SSE2 is available), then by
+ * 64-bit words and then byte by byte.
+ *
+ * @return @a end if there is no such char.
+ */
+RESTINIO_NODISCARD
+inline const std::uint8_t *
+skip_ascii( const std::uint8_t * p, const std::uint8_t * end ) noexcept
+{
+#if defined( RESTINIO_SIMD_UTF8_USE_SSE2 )
+	for( ; end - p >= 16; p += 16 )
+	{
+		const int mask = _mm_movemask_epi8(
+				_mm_loadu_si128( reinterpret_cast< const __m128i * >( p ) ) );
+		if( 0 != mask )
+			break;
+	}
+#endif
+
+	for( ; end - p >= 8; p += 8 )
+	{
+		std::uint64_t w;
+		std::memcpy( &w, p, sizeof(w) );
+		if( 0u != ( w & 0x8080808080808080ull ) )
+			break;
+	}
+
+	while( p != end && *p < 0x80u )
+		++p;
+
+	return p;
+}
+
+//
+// validate_scalar
+//
+
+//! Check a sequence of complete UTF-8 chars without SIMD lookups.
+RESTINIO_NODISCARD
+inline bool
+validate_scalar( const std::uint8_t * p, std::size_t size ) noexcept
+{
+	const auto * end = p + size;
+	while( p != end )
+	{
+		if( *p < 0x80u )
+			p = skip_ascii( p, end );
+		else
+		{
+			const auto n = sequence_size( p, end );
+			if( 0u == n )
+				return false;
+			p += n;
+		}
+	}
+
+	return true;
+}
+
+//
+// Tables for validation by lookups.
+//
+// The approach is described in: John Keiser, Daniel Lemire,
+// "Validating UTF-8 In Less Than One Instruction Per Byte",
+// Software: Practice and Experience 51 (5), 2021.
+//
+// Every pair of adjacent bytes is classified by three lookups: by the
+// high nibble of the first byte, by the low nibble of the first byte and
+// by the high nibble of the second byte. A bit that is set in all three
+// results is an error (except two_conts that is checked separately).
+//
+
+//! A lead byte without enough continuations: `11______ 0_______`
+//! or `11______ 11______`.
+constexpr std::uint8_t too_short = 1u << 0;
+//! A continuation without a lead byte: `0_______ 10______`.
+constexpr std::uint8_t too_long = 1u << 1;
+//! `11100000 100_____`.
+constexpr std::uint8_t overlong_3 = 1u << 2;
+//! Values above 0x10FFFF: `11110100 1001____`, `11110100 101_____`,
+//! `11110101-11111111 1001____`, `11110101-11111111 101_____`.
+constexpr std::uint8_t too_large = 1u << 3;
+//! `11101101 101_____`.
+constexpr std::uint8_t surrogate = 1u << 4;
+//! `1100000_ 10______`.
+constexpr std::uint8_t overlong_2 = 1u << 5;
+//! `11110101-11111111 1000____`.
+constexpr std::uint8_t too_large_1000 = 1u << 6;
+//! `11110000 1000____` (shares the bit with too_large_1000).
+constexpr std::uint8_t overlong_4 = 1u << 6;
+//! `10______ 10______` (valid only for the third and fourth bytes).
+constexpr std::uint8_t two_conts = 1u << 7;
+//! Classes that don't depend on the low nibble of the first byte.
+constexpr std::uint8_t carry = too_short | too_long | two_conts;
+
+//! Lookup tables for classification of pairs of bytes.
+template< typename T = void >
+struct lookup_tables_t
+{
+	//! Classes by the high nibble of the first byte.
+	static constexpr std::uint8_t byte_1_high[ 16 ] = {
+		// 0_______ ________ <ASCII in byte 1>
+		too_long, too_long, too_long, too_long,
+		too_long, too_long, too_long, too_long,
+		// 10______ ________ <continuation in byte 1>
+		two_conts, two_conts, two_conts, two_conts,
+		// 1100____ ________ <two byte lead in byte 1>
+		too_short | overlong_2,
+		// 1101____ ________ <two byte lead in byte 1>
+		too_short,
+		// 1110____ ________ <three byte lead in byte 1>
+		too_short | overlong_3 | surrogate,
+		// 1111____ ________ <four+ byte lead in byte 1>
+		too_short | too_large | too_large_1000 | overlong_4
+	};
+
+	//! Classes by the low nibble of the first byte.
+	static constexpr std::uint8_t byte_1_low[ 16 ] = {
+		// ____0000 ________
+		carry | overlong_3 | overlong_2 | overlong_4,
+		// ____0001 ________
+		carry | overlong_2,
+		// ____001_ ________
+		carry,
+		carry,
+		// ____0100 ________
+		carry | too_large,
+		// ____0101 ________
+		carry | too_large | too_large_1000,
+		// ____011_ ________
+		carry | too_large | too_large_1000,
+		carry | too_large | too_large_1000,
+		// ____1___ ________
+		carry | too_large | too_large_1000,
+		carry | too_large | too_large_1000,
+		carry | too_large | too_large_1000,
+		carry | too_large | too_large_1000,
+		carry | too_large | too_large_1000,
+		// ____1101 ________
+		carry | too_large | too_large_1000 | surrogate,
+		carry | too_large | too_large_1000,
+		carry | too_large | too_large_1000
+	};
+
+	//! Classes by the high nibble of the second byte.
+	static constexpr std::uint8_t byte_2_high[ 16 ] = {
+		// ________ 0_______ <ASCII in byte 2>
+		too_short, too_short, too_short, too_short,
+		too_short, too_short, too_short, too_short,
+		// ________ 1000____
+		too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+		// ________ 1001____
+		too_long | overlong_2 | two_conts | overlong_3 | too_large,
+		// ________ 101_____
+		too_long | overlong_2 | two_conts | surrogate | too_large,
+		too_long | overlong_2 | two_conts | surrogate | too_large,
+		// ________ 11______ <lead byte in byte 2>
+		too_short, too_short, too_short, too_short
+	};
+};
+
+template< typename T >
+constexpr std::uint8_t lookup_tables_t< T >::byte_1_high[ 16 ];
+
+template< typename T >
+constexpr std::uint8_t lookup_tables_t< T >::byte_1_low[ 16 ];
+
+template< typename T >
+constexpr std::uint8_t lookup_tables_t< T >::byte_2_high[ 16 ];
+
+#if defined( RESTINIO_SIMD_UTF8_USE_SSSE3 ) || \
+		defined( RESTINIO_SIMD_UTF8_RUNTIME_DISPATCH )
+RESTINIO_SIMD_UTF8_TARGET_BEGIN( "ssse3" )
+
+namespace ssse3
+{
+
+//! Operations with 16-byte blocks by SSSE3.
+struct simd_t
+{
+	using vector_t = __m128i;
+	static constexpr std::size_t size = 16u;
+
+	static vector_t load( const std::uint8_t * p ) noexcept
+	{ return _mm_loadu_si128( reinterpret_cast< const __m128i * >( p ) ); }
+
+	static vector_t table( const std::uint8_t (&t)[ 16 ] ) noexcept
+	{ return load( t ); }
+
+	static vector_t set1( std::uint8_t v ) noexcept
+	{ return _mm_set1_epi8( static_cast< char >( v ) ); }
+
+	static vector_t zero() noexcept { return _mm_setzero_si128(); }
+
+	static vector_t or_( vector_t a, vector_t b ) noexcept { return _mm_or_si128( a, b ); }
+	static vector_t and_( vector_t a, vector_t b ) noexcept { return _mm_and_si128( a, b ); }
+	static vector_t xor_( vector_t a, vector_t b ) noexcept { return _mm_xor_si128( a, b ); }
+	static vector_t subs( vector_t a, vector_t b ) noexcept { return _mm_subs_epu8( a, b ); }
+
+	static vector_t high_nibbles( vector_t v ) noexcept
+	{ return _mm_and_si128( _mm_srli_epi16( v, 4 ), set1( 0x0Fu ) ); }
+
+	static vector_t low_nibbles( vector_t v ) noexcept
+	{ return _mm_and_si128( v, set1( 0x0Fu ) ); }
+
+	static vector_t lookup( vector_t t, vector_t nibbles ) noexcept
+	{ return _mm_shuffle_epi8( t, nibbles ); }
+
+	template< int N >
+	static vector_t prev( vector_t input, vector_t prev_input ) noexcept
+	{ return _mm_alignr_epi8( input, prev_input, 16 - N ); }
+
+	static bool is_ascii( vector_t v ) noexcept
+	{ return 0 == _mm_movemask_epi8( v ); }
+
+	static bool is_zero( vector_t v ) noexcept
+	{ return 0xFFFF == _mm_movemask_epi8( _mm_cmpeq_epi8( v, zero() ) ); }
+};
+
+#include <restinio/utils/impl/simd_utf8_lookups.ipp>
+
+} /* namespace ssse3 */
+
+RESTINIO_SIMD_UTF8_TARGET_END
+#endif
+
+#if defined( RESTINIO_SIMD_UTF8_USE_AVX2 ) || \
+		defined( RESTINIO_SIMD_UTF8_RUNTIME_DISPATCH )
+RESTINIO_SIMD_UTF8_TARGET_BEGIN( "avx2" )
+
+namespace avx2
+{
+
+//! Operations with 32-byte blocks by AVX2.
+struct simd_t
+{
+	using vector_t = __m256i;
+	static constexpr std::size_t size = 32u;
+
+	static vector_t load( const std::uint8_t * p ) noexcept
+	{ return _mm256_loadu_si256( reinterpret_cast< const __m256i * >( p ) ); }
+
+	static vector_t table( const std::uint8_t (&t)[ 16 ] ) noexcept
+	{
+		return _mm256_broadcastsi128_si256(
+				_mm_loadu_si128( reinterpret_cast< const __m128i * >( t ) ) );
+	}
+
+	static vector_t set1( std::uint8_t v ) noexcept
+	{ return _mm256_set1_epi8( static_cast< char >( v ) ); }
+
+	static vector_t zero() noexcept { return _mm256_setzero_si256(); }
+
+	static vector_t or_( vector_t a, vector_t b ) noexcept { return _mm256_or_si256( a, b ); }
+	static vector_t and_( vector_t a, vector_t b ) noexcept { return _mm256_and_si256( a, b ); }
+	static vector_t xor_( vector_t a, vector_t b ) noexcept { return _mm256_xor_si256( a, b ); }
+	static vector_t subs( vector_t a, vector_t b ) noexcept { return _mm256_subs_epu8( a, b ); }
+
+	static vector_t high_nibbles( vector_t v ) noexcept
+	{ return _mm256_and_si256( _mm256_srli_epi16( v, 4 ), set1( 0x0Fu ) ); }
+
+	static vector_t low_nibbles( vector_t v ) noexcept
+	{ return _mm256_and_si256( v, set1( 0x0Fu ) ); }
+
+	static vector_t lookup( vector_t t, vector_t nibbles ) noexcept
+	{ return _mm256_shuffle_epi8( t, nibbles ); }
+
+	template< int N >
+	static vector_t prev( vector_t input, vector_t prev_input ) noexcept
+	{
+		return _mm256_alignr_epi8( input,
+				_mm256_permute2x128_si256( prev_input, input, 0x21 ), 16 - N );
+	}
+
+	static bool is_ascii( vector_t v ) noexcept
+	{ return 0 == _mm256_movemask_epi8( v ); }
+
+	static bool is_zero( vector_t v ) noexcept
+	{ return 0 != _mm256_testz_si256( v, v ); }
+};
+
+#include <restinio/utils/impl/simd_utf8_lookups.ipp>
+
+} /* namespace avx2 */
+
+RESTINIO_SIMD_UTF8_TARGET_END
+#endif
+
+#if defined( RESTINIO_SIMD_UTF8_USE_NEON )
+namespace neon
+{
+
+//! Operations with 16-byte blocks by NEON.
+struct simd_t
+{
+	using vector_t = uint8x16_t;
+	static constexpr std::size_t size = 16u;
+
+	static vector_t load( const std::uint8_t * p ) noexcept { return vld1q_u8( p ); }
+
+	static vector_t table( const std::uint8_t (&t)[ 16 ] ) noexcept
+	{ return vld1q_u8( t ); }
+
+	static vector_t set1( std::uint8_t v ) noexcept { return vdupq_n_u8( v ); }
+
+	static vector_t zero() noexcept { return vdupq_n_u8( 0u ); }
+
+	static vector_t or_( vector_t a, vector_t b ) noexcept { return vorrq_u8( a, b ); }
+	static vector_t and_( vector_t a, vector_t b ) noexcept { return vandq_u8( a, b ); }
+	static vector_t xor_( vector_t a, vector_t b ) noexcept { return veorq_u8( a, b ); }
+	static vector_t subs( vector_t a, vector_t b ) noexcept { return vqsubq_u8( a, b ); }
+
+	static vector_t high_nibbles( vector_t v ) noexcept { return vshrq_n_u8( v, 4 ); }
+
+	static vector_t low_nibbles( vector_t v ) noexcept
+	{ return vandq_u8( v, set1( 0x0Fu ) ); }
+
+	static vector_t lookup( vector_t t, vector_t nibbles ) noexcept
+	{ return vqtbl1q_u8( t, nibbles ); }
+
+	template< int N >
+	static vector_t prev( vector_t input, vector_t prev_input ) noexcept
+	{ return vextq_u8( prev_input, input, 16 - N ); }
+
+	static bool is_ascii( vector_t v ) noexcept { return vmaxvq_u8( v ) < 0x80u; }
+
+	static bool is_zero( vector_t v ) noexcept { return 0u == vmaxvq_u8( v ); }
+};
+
+#include <restinio/utils/impl/simd_utf8_lookups.ipp>
+
+} /* namespace neon */
+#endif
+
+#if defined( RESTINIO_SIMD_UTF8_RUNTIME_DISPATCH )
+//
+// available_lookups
+//
+
+//! Instruction sets for validation by lookups.
+enum class lookups_t
+{
+	none,
+	ssse3,
+	avx2
+};
+
+//! Detect the best instruction set supported by the CPU.
+/*!
+ * The detection is performed only once.
+ */
+RESTINIO_NODISCARD
+inline lookups_t
+available_lookups() noexcept
+{
+	static const lookups_t value = []() noexcept {
+		const auto & features = x86_features();
+		if( features.m_avx2 )
+			return lookups_t::avx2;
+		else if( features.m_ssse3 )
+			return lookups_t::ssse3;
+		return lookups_t::none;
+	}();
+
+	return value;
+}
+#endif
+
+//
+// validate
+//
+
+//! Check a sequence of complete UTF-8 chars.
+/*!
+ * 32-byte blocks are used if AVX2 is enabled at compile time (e.g. by
+ * `-mavx2`), 16-byte blocks if SSSE3 (e.g. by `-mssse3`) or AArch64 NEON
+ * is available.
+ *
+ * If AVX2 isn't enabled at compile time, GCC and clang on x86 compile
+ * AVX2 and SSSE3 versions anyway and select one of them at run time
+ * by the CPU features. Define RESTINIO_SIMD_UTF8_NO_RUNTIME_DISPATCH
+ * to disable that.
+ *
+ * Otherwise ASCII chars are skipped by 16 bytes (if SSE2 is available)
+ * or by 64-bit words and other chars are checked one by one.
+ * Define RESTINIO_SIMD_UTF8_SCALAR_ONLY to disable SIMD at all.
+ */
+RESTINIO_NODISCARD
+inline bool
+validate( const std::uint8_t * data, std::size_t size ) noexcept
+{
+#if defined( RESTINIO_SIMD_UTF8_USE_AVX2 )
+	return avx2::validate_by_lookups( data, size );
+#elif defined( RESTINIO_SIMD_UTF8_RUNTIME_DISPATCH )
+	switch( available_lookups() )
+	{
+		case lookups_t::avx2:
+			return avx2::validate_by_lookups( data, size );
+
+		case lookups_t::ssse3:
+			return ssse3::validate_by_lookups( data, size );
+
+		case lookups_t::none:
+		break;
+	}
+	return validate_scalar( data, size );
+#elif defined( RESTINIO_SIMD_UTF8_USE_SSSE3 )
+	return ssse3::validate_by_lookups( data, size );
+#elif defined( RESTINIO_SIMD_UTF8_USE_NEON )
+	return neon::validate_by_lookups( data, size );
+#else
+	return validate_scalar( data, size );
+#endif
+}
+
+} /* namespace simd_utf8 */
+
+} /* namespace impl */
+
+} /* namespace utils */
+
+} /* namespace restinio */
+
+#undef RESTINIO_SIMD_UTF8_TARGET_END
+#undef RESTINIO_SIMD_UTF8_TARGET_BEGIN
+#undef RESTINIO_SIMD_UTF8_PRAGMA
@@ -0,0 +1,97 @@
+/*
+ * RESTinio
+ */
+
+/*!
+ * @file
+ * @brief Validation of UTF-8 sequences by SIMD lookups.
+ *
+ * Is included into a namespace with simd_t for every instruction set,
+ * so the code is compiled with target options of that instruction set.
+ *
+ * @since v.0.6.18
+ */
+
+//
+// validate_by_lookups
+//
+
+//! Check a sequence of complete UTF-8 chars by SIMD lookups.
+/*!
+ * Blocks that contain only ASCII chars are checked just for an
+ * incomplete sequence at the end of the previous block.
+ */
+RESTINIO_NODISCARD
+inline bool
+validate_by_lookups( const std::uint8_t * data, std::size_t size ) noexcept
+{
+	using vector_t = simd_t::vector_t;
+
+	const vector_t byte_1_high = simd_t::table( lookup_tables_t<>::byte_1_high );
+	const vector_t byte_1_low = simd_t::table( lookup_tables_t<>::byte_1_low );
+	const vector_t byte_2_high = simd_t::table( lookup_tables_t<>::byte_2_high );
+
+	// A char at the end of a block can't be a lead byte of a sequence
+	// longer than the rest of the block.
+	std::uint8_t max_values[ simd_t::size ];
+	std::memset( max_values, 0xFF, sizeof(max_values) );
+	max_values[ simd_t::size - 3u ] = 0xF0u - 1u;
+	max_values[ simd_t::size - 2u ] = 0xE0u - 1u;
+	max_values[ simd_t::size - 1u ] = 0xC0u - 1u;
+	const vector_t max_value = simd_t::load( max_values );
+
+	vector_t error = simd_t::zero();
+	vector_t prev_input = simd_t::zero();
+	vector_t prev_incomplete = simd_t::zero();
+
+	// The rest is padded by zeros. At least one zero follows the data,
+	// so an incomplete sequence at the end is detected as too_short.
+	std::uint8_t tail[ simd_t::size ] = {};
+
+	for( std::size_t i = 0u; ; i += simd_t::size )
+	{
+		const bool is_last_block = size - i < simd_t::size;
+
+		vector_t input;
+		if( is_last_block )
+		{
+			std::memcpy( tail, data + i, size - i );
+			input = simd_t::load( tail );
+		}
+		else
+			input = simd_t::load( data + i );
+
+		if( simd_t::is_ascii( input ) )
+			error = simd_t::or_( error, prev_incomplete );
+		else
+		{
+			const vector_t prev1 = simd_t::prev< 1 >( input, prev_input );
+			const vector_t special_cases = simd_t::and_(
+					simd_t::and_(
+						simd_t::lookup( byte_1_high, simd_t::high_nibbles( prev1 ) ),
+						simd_t::lookup( byte_1_low, simd_t::low_nibbles( prev1 ) ) ),
+					simd_t::lookup( byte_2_high, simd_t::high_nibbles( input ) ) );
+
+			// The third and fourth bytes of sequences should be continuations
+			// and only they can be a continuation after a continuation.
+			const vector_t prev2 = simd_t::prev< 2 >( input, prev_input );
+			const vector_t prev3 = simd_t::prev< 3 >( input, prev_input );
+			const vector_t must_be_continuation = simd_t::and_(
+					simd_t::or_(
+						simd_t::subs( prev2, simd_t::set1( 0xE0u - 0x80u ) ),
+						simd_t::subs( prev3, simd_t::set1( 0xF0u - 0x80u ) ) ),
+					simd_t::set1( 0x80u ) );
+
+			error = simd_t::or_( error,
+					simd_t::xor_( must_be_continuation, special_cases ) );
+
+			prev_incomplete = simd_t::subs( input, max_value );
+		}
+		prev_input = input;
+
+		if( is_last_block )
+			break;
+	}
+
+	return simd_t::is_zero( error );
+}
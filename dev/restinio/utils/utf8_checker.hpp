@@ -13,6 +13,8 @@
 
 #include <restinio/compiler_features.hpp>
 
+#include <restinio/utils/impl/simd_utf8.hpp>
+
 #include <cstdint>
 
 namespace restinio
@@ -308,6 +310,64 @@ public:
 		return (state_t::invalid != m_state);
 	}
 
+	/*!
+	 * Checks a part of byte sequence.
+	 *
+	 * It gives the same result as calls to process_byte() for every
+	 * byte of @a data, but whole UTF-8 chars in the middle of @a data are
+	 * checked by SIMD blocks (see impl::simd_utf8::validate()). An incomplete
+	 * char at the end of @a data can be continued by the next call.
+	 *
+	 * After a successful call current_symbol() returns the last char
+	 * of @a data (if finalized() returns `true`).
+	 *
+	 * @retval true if the sequence is still valid.
+	 *
+	 * @retval false if the sequence is invalid an there is no sense
+	 * to continue checking.
+	 *
+	 * @since v.0.6.18
+	 */
+	RESTINIO_NODISCARD
+	bool
+	process_bytes( const char * data, std::size_t size ) noexcept
+	{
+		if( state_t::invalid == m_state )
+			return false;
+
+		const auto * p = reinterpret_cast< const std::uint8_t * >( data );
+		const auto * end = p + size;
+
+		// Complete a char started by previous bytes.
+		for( ; p != end && state_t::wait_first_byte != m_state; ++p )
+			if( !process_byte( *p ) )
+				return false;
+
+		if( p == end )
+			return true;
+
+		// The last char (that can be incomplete) is processed by
+		// process_byte() to keep the state of the checker.
+		// There can't be more than 3 continuation bytes in a valid
+		// char, so it's enough to check just 4 last bytes.
+		const auto * last = end - 1;
+		while( last != p && end - last < 4 && 0x80u == (*last & 0xC0u) )
+			--last;
+
+		if( !impl::simd_utf8::validate(
+				p, static_cast< std::size_t >( last - p ) ) )
+		{
+			m_state = state_t::invalid;
+			return false;
+		}
+
+		for( ; last != end; ++last )
+			if( !process_byte( *last ) )
+				return false;
+
+		return true;
+	}
+
 	/*!
 	 * @return true if the current sequence finalized.
 	 */
@@ -30,15 +30,8 @@ check_utf8_is_correct( string_view_t sv ) noexcept
 {
 	restinio::utils::utf8_checker_t checker;
 
-	for( const auto & ch : sv )
-	{
-		if( !checker.process_byte( static_cast<std::uint8_t>(ch) ) )
-		{
-			return false;
-		}
-	}
-
-	return checker.finalized();
+	return checker.process_bytes( sv.data(), sv.size() ) &&
+			checker.finalized();
 }
 
 } /* namespace impl */
@@ -0,0 +1,113 @@
+/*
+	restinio
+*/
+
+/*!
+	An interface of compression of websocket messages.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/optional.hpp>
+#include <restinio/string_view.hpp>
+#include <restinio/websocket/message.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace restinio
+{
+
+namespace websocket
+{
+
+namespace basic
+{
+
+namespace impl
+{
+
+//
+// ws_compression_t
+//
+
+//! An interface of compression of messages negotiated by an extension.
+/*!
+	An instance is owned by ws_connection_t and is used only on the
+	connection's executor, so implementations don't need any locks.
+
+	Compressed messages are marked by RSV1 bit in the header of the first
+	frame of the message (see RFC 7692).
+
+	There is no dependency on zlib here, so connections without
+	compression don't require zlib. An implementation of
+	permessage-deflate is in restinio/websocket/permessage_deflate.hpp.
+
+	@since v.0.6.18
+*/
+class ws_compression_t
+{
+	public:
+		virtual ~ws_compression_t() = default;
+
+		//! Should an outgoing message with the first frame of that size
+		//! be compressed?
+		virtual bool
+		should_compress( std::size_t first_frame_payload_size ) const noexcept = 0;
+
+		//! Compress the payload of the next frame of an outgoing message.
+		virtual std::string
+		compress_frame(
+			string_view_t payload,
+			final_frame_flag_t final_flag ) = 0;
+
+		//! Decompress the payload of the next frame of an incoming message.
+		/*!
+			\return empty optional if the decompressed message is too big.
+
+			\throw exception_t if the payload can't be decompressed.
+		*/
+		virtual optional_t< std::string >
+		decompress_frame(
+			string_view_t payload,
+			final_frame_flag_t final_flag ) = 0;
+
+		//! Type of handler for pieces of decompressed data.
+		using decompressed_piece_handler_t = std::function< void( std::string ) >;
+
+		//! Decompress a part of the payload of a streamed frame by pieces.
+		/*!
+			Every @a max_piece_size bytes of decompressed data are passed
+			to @a handler as soon as they are obtained. So no more than
+			@a max_piece_size bytes of output are kept in memory regardless
+			of the compression ratio.
+
+			The limit for the size of the whole decompressed message isn't
+			applied to streamed frames.
+
+			\return the rest of decompressed data (less than
+			@a max_piece_size bytes, can be empty).
+
+			\throw exception_t if the payload can't be decompressed.
+		*/
+		virtual std::string
+		decompress_frame_by_pieces(
+			string_view_t payload,
+			final_frame_flag_t final_flag,
+			std::size_t max_piece_size,
+			const decompressed_piece_handler_t & handler ) = 0;
+};
+
+//! Alias for unique pointer to ws_compression_t.
+using ws_compression_unique_ptr_t = std::unique_ptr< ws_compression_t >;
+
+} /* namespace impl */
+
+} /* namespace basic */
+
+} /* namespace websocket */
+
+} /* namespace restinio */
@@ -22,6 +22,7 @@
 #include <restinio/websocket/message.hpp>
 #include <restinio/websocket/impl/ws_parser.hpp>
 #include <restinio/websocket/impl/ws_protocol_validator.hpp>
+#include <restinio/websocket/impl/ws_compression.hpp>
 
 #include <restinio/utils/impl/safe_uint_truncate.hpp>
 
@@ -60,6 +61,7 @@ class ws_outgoing_data_t
 		void
 		append( write_group_t wg )
 		{
+			m_queued_bytes += size_of( wg );
 			m_awaiting_write_groups.emplace( std::move( wg ) );
 		}
 
@@ -72,14 +74,58 @@ class ws_outgoing_data_t
 			{
 				result = std::move( m_awaiting_write_groups.front() );
 				m_awaiting_write_groups.pop();
+				m_queued_bytes -= size_of( *result );
 			}
 
 			return result;
 		}
 
+		//! Extract the first write group if @a predicate returns true for it.
+		/*!
+			@since v.0.6.18
+		*/
+		template< typename Predicate >
+		optional_t< write_group_t >
+		pop_ready_buffers_if( Predicate && predicate )
+		{
+			optional_t< write_group_t > result;
+
+			if( !m_awaiting_write_groups.empty() &&
+				predicate( m_awaiting_write_groups.front() ) )
+				result = pop_ready_buffers();
+
+			return result;
+		}
+
+		//! The size of data waiting in the queue.
+		/*!
+			@since v.0.6.18
+		*/
+		std::size_t
+		queued_bytes() const noexcept
+		{
+			return m_queued_bytes;
+		}
+
 	private:
+		static std::size_t
+		size_of( const write_group_t & wg ) noexcept
+		{
+			std::size_t result = 0u;
+			for( const auto & item : wg.items() )
+				result += item.size();
+
+			return result;
+		}
+
 		//! A queue of buffers.
 		write_groups_queue_t m_awaiting_write_groups;
+
+		//! The size of data in m_awaiting_write_groups.
+		/*!
+			@since v.0.6.18
+		*/
+		std::size_t m_queued_bytes{ 0u };
 };
 
 //
@@ -100,8 +146,26 @@ struct connection_input_t
 	restinio::impl::fixed_buffer_t m_buf;
 
 	//! Current payload.
+	/*!
+		Holds the current chunk of the payload if the frame is streamed.
+	*/
 	std::string m_payload;
 
+	//! The max size of payload chunks of the current frame.
+	/*!
+		Is zero if the current frame isn't streamed.
+
+		@since v.0.6.18
+	*/
+	std::size_t m_chunk_size{ 0u };
+
+	//! Has the first fragment of the current streamed frame been passed
+	//! to the message handler?
+	/*!
+		@since v.0.6.18
+	*/
+	bool m_first_fragment_passed{ false };
+
 	//! Prepare parser for reading new http-message.
 	void
 	reset_parser_and_payload()
@@ -148,17 +212,28 @@ class ws_connection_t final
 			stream_socket_t socket,
 			lifetime_monitor_t lifetime_monitor,
 			//! \}
-			message_handler_t msg_handler )
-			:	ws_connection_base_t{ conn_id }
+			message_handler_t msg_handler,
+			//! Compression of messages negotiated by an extension
+			//! (can be nullptr).
+			//! @since v.0.6.18
+			ws_compression_unique_ptr_t compression =
+				ws_compression_unique_ptr_t{} )
+			:	ws_connection_base_t{ conn_id, nullptr != compression }
 			,	executor_wrapper_base_t{ socket.get_executor() }
 			,	m_settings{ std::move( settings ) }
 			,	m_socket{ std::move( socket ) }
 			,	m_lifetime_monitor{ std::move( lifetime_monitor ) }
 			,	m_timer_guard{ m_settings->create_timer_guard() }
+			,	m_write_delay_timer{ m_socket.get_executor() }
 			,	m_input{ websocket_header_max_size() }
 			,	m_msg_handler{ std::move( msg_handler ) }
 			,	m_logger{ *( m_settings->m_logger ) }
+			,	m_write_output_ctx{ m_settings->m_max_coalesced_write_size }
+			,	m_compression{ std::move( compression ) }
 		{
+			if( m_compression )
+				m_protocol_validator.allow_compressed_messages();
+
 			// Notify of a new connection instance.
 			m_logger.trace( [&]{
 					return fmt::format(
@@ -371,7 +446,255 @@ class ws_connection_t final
 					}
 				} );
 		}
+
+		//! Write a data frame that can be compressed.
+		/*!
+			@since v.0.6.18
+		*/
+		virtual void
+		write_data_frame(
+			final_frame_flag_t final_flag,
+			opcode_t opcode,
+			writable_item_t payload,
+			write_status_cb_t wscb ) override
+		{
+			//! Run write message on io_context loop if possible.
+			asio_ns::dispatch(
+				this->get_executor(),
+				[ this,
+					ctx = shared_from_this(),
+					final_flag,
+					opcode,
+					payload = std::move( payload ),
+					wscb = std::move( wscb ) ]
+				() mutable noexcept
+				{
+					try
+					{
+						if( write_state_t::write_enabled == m_write_state )
+							write_data_impl(
+								make_data_frame_write_group(
+									final_flag,
+									opcode,
+									std::move( payload ),
+									std::move( wscb ) ),
+								false );
+						else
+						{
+							m_logger.warn( [&]{
+								return fmt::format(
+										RESTINIO_FMT_FORMAT_STRING(
+											"[ws_connection:{}] cannot write to websocket: "
+											"write operations disabled" ),
+										connection_id() );
+							} );
+						}
+					}
+					catch( const std::exception & ex )
+					{
+						trigger_error_and_close(
+							status_code_t::unexpected_condition,
+							[&]{
+								return fmt::format(
+									RESTINIO_FMT_FORMAT_STRING(
+										"[ws_connection:{}] unable to write data frame: {}" ),
+									connection_id(),
+									ex.what() );
+							} );
+					}
+				} );
+		}
+
+		//! Write a prepared message if it fits into the limit of
+		//! outgoing data.
+		/*!
+			@since v.0.6.18
+		*/
+		virtual void
+		write_prepared_message(
+			prepared_message_t message,
+			outgoing_queue_limit_t limit ) override
+		{
+			//! Run write message on io_context loop if possible.
+			asio_ns::dispatch(
+				this->get_executor(),
+				[ this,
+					ctx = shared_from_this(),
+					message = std::move( message ),
+					limit ]
+				() mutable noexcept
+				{
+					try
+					{
+						if( write_state_t::write_enabled == m_write_state )
+							write_prepared_message_impl( message, limit );
+						else
+						{
+							m_logger.warn( [&]{
+								return fmt::format(
+										RESTINIO_FMT_FORMAT_STRING(
+											"[ws_connection:{}] cannot write to websocket: "
+											"write operations disabled" ),
+										connection_id() );
+							} );
+						}
+					}
+					catch( const std::exception & ex )
+					{
+						trigger_error_and_close(
+							status_code_t::unexpected_condition,
+							[&]{
+								return fmt::format(
+									RESTINIO_FMT_FORMAT_STRING(
+										"[ws_connection:{}] unable to write prepared "
+										"message: {}" ),
+									connection_id(),
+									ex.what() );
+							} );
+					}
+				} );
+		}
+
+		//! Set the max size of payload chunks of streamed data frames.
+		/*!
+			@since v.0.6.18
+		*/
+		virtual void
+		payload_streaming( std::size_t max_chunk_size ) override
+		{
+			asio_ns::dispatch(
+				this->get_executor(),
+				[ this, ctx = shared_from_this(), max_chunk_size ]() noexcept
+				{
+					m_payload_streaming_chunk_size = max_chunk_size;
+				} );
+		}
+
 	private:
+		//! Implementation of writing a prepared message performed
+		//! on the asio_ns::io_context.
+		/*!
+			@since v.0.6.18
+		*/
+		void
+		write_prepared_message_impl(
+			const prepared_message_t & message,
+			const outgoing_queue_limit_t & limit )
+		{
+			// The limit is applied only if there is some data waiting
+			// in the queue, so a message bigger than the limit is
+			// accepted by a connection that keeps up with writes.
+			const auto queued_bytes = m_outgoing_data.queued_bytes();
+			if( 0u != queued_bytes &&
+				( message.frame_size() > limit.m_max_queued_bytes ||
+					queued_bytes > limit.m_max_queued_bytes - message.frame_size() ) )
+			{
+				if( outgoing_overflow_policy_t::drop_message == limit.m_policy )
+				{
+					m_logger.warn( [&]{
+						return fmt::format(
+								RESTINIO_FMT_FORMAT_STRING(
+									"[ws_connection:{}] prepared message is dropped, "
+									"queued bytes: {}" ),
+								connection_id(),
+								m_outgoing_data.queued_bytes() );
+					} );
+				}
+				else
+				{
+					trigger_error_and_close(
+						status_code_t::going_away,
+						[&]{
+							return fmt::format(
+								RESTINIO_FMT_FORMAT_STRING(
+									"[ws_connection:{}] too much outgoing data, "
+									"queued bytes: {}" ),
+								connection_id(),
+								m_outgoing_data.queued_bytes() );
+						} );
+				}
+
+				return;
+			}
+
+			if( m_compression && !is_control_frame( message.opcode() ) )
+				// Compression depends on the state of the connection,
+				// so only the payload is shared.
+				write_data_impl(
+					make_data_frame_write_group(
+						message.final_flag(),
+						message.opcode(),
+						message.payload_as_writable_item(),
+						write_status_cb_t{} ),
+					false );
+			else
+			{
+				writable_items_container_t bufs;
+				bufs.emplace_back( message.frame_as_writable_item() );
+
+				write_data_impl( write_group_t{ std::move( bufs ) }, false );
+			}
+		}
+
+		//! Make a write group for a data frame (compress it if necessary).
+		/*!
+			Frames of a message are compressed if the first frame of
+			the message was compressed.
+
+			@since v.0.6.18
+		*/
+		write_group_t
+		make_data_frame_write_group(
+			final_frame_flag_t final_flag,
+			opcode_t opcode,
+			writable_item_t payload,
+			write_status_cb_t wscb )
+		{
+			const auto buf = payload.buf();
+			const string_view_t data{
+				static_cast< const char * >( buf.data() ), buf.size() };
+
+			if( opcode_t::continuation_frame != opcode )
+				m_outgoing_message_compressed =
+					m_compression->should_compress( data.size() );
+
+			writable_items_container_t bufs;
+			bufs.reserve( 2 );
+
+			if( m_outgoing_message_compressed )
+			{
+				std::string compressed =
+					m_compression->compress_frame( data, final_flag );
+
+				message_details_t details{
+					final_flag, opcode, compressed.size() };
+				// Only the first frame of a message is marked.
+				details.m_rsv1_flag = opcode_t::continuation_frame != opcode;
+
+				bufs.emplace_back( impl::write_message_details( details ) );
+				bufs.emplace_back( std::move( compressed ) );
+			}
+			else
+			{
+				bufs.emplace_back(
+					impl::write_message_details(
+						final_flag, opcode, data.size() ) );
+				bufs.emplace_back( std::move( payload ) );
+			}
+
+			if( final_frame == final_flag )
+				m_outgoing_message_compressed = false;
+
+			write_group_t wg{ std::move( bufs ) };
+
+			if( wscb )
+			{
+				wg.after_write_notificator( std::move( wscb ) );
+			}
+
+			return wg;
+		}
+
 		//! Standard close routine.
 		/*!
 		 * @note
@@ -408,6 +731,13 @@ class ws_connection_t final
 							[&] {
 								m_socket.close();
 							} );
+
+					restinio::utils::suppress_exceptions(
+							m_logger,
+							"ws_connection.close_impl.write_delay_timer.cancel",
+							[&] {
+								m_write_delay_timer.cancel();
+							} );
 				} );
 		}
 
@@ -446,10 +776,11 @@ class ws_connection_t final
 			bufs.emplace_back( std::move( payload ) );
 			m_outgoing_data.append( write_group_t{ std::move( bufs ) } );
 
-			init_write_if_necessary();
-
 			// No more data must be written.
+			// NOTE: a close frame is written without a delay.
 			m_write_state = write_state_t::write_disabled;
+
+			init_write_if_necessary();
 		}
 
 		//! Send close frame to peer.
@@ -671,6 +1002,19 @@ class ws_connection_t final
 			const auto payload_length =
 					restinio::utils::impl::uint64_to_size_t(md.payload_len());
 
+			// Since v.0.6.18 payloads of big data frames can be passed
+			// to the message handler by chunks.
+			m_input.m_chunk_size = 0u;
+			if( 0u != m_payload_streaming_chunk_size &&
+				!is_control_frame( md.m_opcode ) &&
+				payload_length > m_payload_streaming_chunk_size )
+			{
+				m_input.m_chunk_size = m_payload_streaming_chunk_size;
+				m_input.m_first_fragment_passed = false;
+				read_payload_chunk( payload_length );
+				return;
+			}
+
 			m_input.m_payload.resize( payload_length );
 
 			if( payload_length == 0 )
@@ -832,6 +1176,322 @@ class ws_connection_t final
 			}
 		}
 
+		//! Start reading the next chunk of the payload of a streamed frame.
+		/*!
+			The chunk is filled completely before it is handled, so the size
+			of fragments passed to the message handler doesn't depend on
+			TCP segmentation.
+
+			@since v.0.6.18
+		*/
+		void
+		read_payload_chunk(
+			//! The size of the remainder of unfetched payload.
+			std::size_t length_remaining,
+			//! Validate payload and call handler.
+			bool do_validate_payload_and_call_msg_handler = true )
+		{
+			const auto chunk_size =
+				std::min( length_remaining, m_input.m_chunk_size );
+			m_input.m_payload.resize( chunk_size );
+
+			// Some bytes can be received together with the header
+			// or with the previous chunk.
+			const auto buffered_length =
+				std::min( m_input.m_buf.length(), chunk_size );
+			if( 0u != buffered_length )
+			{
+				std::memcpy(
+					&m_input.m_payload.front(),
+					m_input.m_buf.bytes(),
+					buffered_length );
+
+				m_input.m_buf.consumed_bytes( buffered_length );
+			}
+
+			if( chunk_size == buffered_length )
+			{
+				after_read_payload_chunk(
+					length_remaining,
+					chunk_size,
+					do_validate_payload_and_call_msg_handler );
+
+				return;
+			}
+
+			asio_ns::async_read(
+				m_socket,
+				asio_ns::buffer(
+					&m_input.m_payload[ buffered_length ],
+					chunk_size - buffered_length ),
+				asio_ns::bind_executor(
+					this->get_executor(),
+					[ this,
+						ctx = shared_from_this(),
+						length_remaining,
+						buffered_length,
+						do_validate_payload_and_call_msg_handler ]
+						( const asio_ns::error_code & ec, std::size_t length ) noexcept
+						{
+							try
+							{
+								if( !ec )
+									after_read_payload_chunk(
+										length_remaining,
+										buffered_length + length,
+										do_validate_payload_and_call_msg_handler );
+								else
+									handle_read_error(
+										"reading message payload error", ec );
+							}
+							catch( const std::exception & ex )
+							{
+								trigger_error_and_close(
+									status_code_t::unexpected_condition,
+									[&]{
+										return fmt::format(
+											RESTINIO_FMT_FORMAT_STRING(
+												"[ws_connection:{}] after read payload "
+												"chunk callback error: {}" ),
+											connection_id(),
+											ex.what() );
+									} );
+							}
+						} ) );
+		}
+
+		//! Handle a received chunk of the payload of a streamed frame.
+		/*!
+			The chunk is unmasked, validated, decompressed (if necessary)
+			and passed to the message handler as fragments of the message
+			(see pass_payload_fragment()). A chunk of a compressed frame
+			is decompressed into pieces that are not bigger than
+			the chunk size, each piece is passed as a separate fragment.
+
+			@since v.0.6.18
+		*/
+		void
+		after_read_payload_chunk(
+			std::size_t length_remaining,
+			std::size_t length,
+			bool do_validate_payload_and_call_msg_handler )
+		{
+			m_logger.trace( [&]{
+				return fmt::format(
+						RESTINIO_FMT_FORMAT_STRING(
+							"[ws_connection:{}] received payload chunk: {} bytes" ),
+						this->connection_id(),
+						length );
+			} );
+
+			assert( length <= length_remaining );
+
+			const std::size_t next_length_remaining = length_remaining - length;
+
+			if( !do_validate_payload_and_call_msg_handler )
+			{
+				skip_payload( next_length_remaining );
+				return;
+			}
+
+			const auto & md = m_input.m_parser.current_message();
+			const auto final_flag =
+				( 0u == next_length_remaining && md.m_final_flag ) ?
+					final_frame : not_final_frame;
+
+			m_input.m_payload.resize( length );
+
+			auto validation_result =
+				m_protocol_validator.process_and_unmask_next_payload_part(
+					&m_input.m_payload.front(), length );
+
+			if( validation_state_t::payload_part_is_valid == validation_result &&
+				read_state_t::read_any_frame == m_read_state &&
+				m_protocol_validator.is_current_frame_compressed() )
+			{
+				decompress_and_pass_payload_chunk(
+						final_flag, next_length_remaining );
+				return;
+			}
+
+			if( validation_state_t::payload_part_is_valid == validation_result &&
+				0u == next_length_remaining )
+			{
+				// A truncated UTF-8 sequence at the end of the message
+				// is detected here.
+				validation_result = m_protocol_validator.finish_frame();
+			}
+
+			if( validation_state_t::payload_part_is_valid != validation_result &&
+				validation_state_t::frame_is_valid != validation_result )
+			{
+				handle_invalid_streamed_payload(
+						validation_result, next_length_remaining );
+				return;
+			}
+
+			pass_payload_fragment( final_flag, std::move( m_input.m_payload ) );
+
+			continue_payload_streaming( next_length_remaining );
+		}
+
+		//! Decompress a chunk of a streamed frame and pass it by pieces.
+		/*!
+			@since v.0.6.18
+		*/
+		void
+		decompress_and_pass_payload_chunk(
+			//! Is it the end of the frame with the final flag?
+			final_frame_flag_t final_flag,
+			//! The size of the remainder of unfetched payload.
+			std::size_t next_length_remaining )
+		{
+			auto validation_result = validation_state_t::payload_part_is_valid;
+
+			std::string rest;
+			try
+			{
+				rest = m_compression->decompress_frame_by_pieces(
+						m_input.m_payload,
+						final_flag,
+						m_input.m_chunk_size,
+						[&]( std::string piece ) {
+							// Pieces after an invalid one are dropped.
+							if( validation_state_t::payload_part_is_valid !=
+									validation_result )
+								return;
+
+							validation_result =
+								m_protocol_validator.process_decompressed_payload_part(
+										piece.data(), piece.size() );
+
+							if( validation_state_t::payload_part_is_valid ==
+									validation_result )
+								pass_payload_fragment(
+										not_final_frame, std::move( piece ) );
+						} );
+			}
+			catch( const std::exception & ex )
+			{
+				m_logger.error( [&]{
+					return fmt::format(
+							RESTINIO_FMT_FORMAT_STRING(
+								"[ws_connection:{}] unable to decompress payload: {}" ),
+							connection_id(),
+							ex.what() );
+				} );
+
+				handle_decompression_failure(
+						status_code_t::invalid_message_data, next_length_remaining );
+				return;
+			}
+
+			if( validation_state_t::payload_part_is_valid == validation_result )
+				validation_result =
+					m_protocol_validator.process_decompressed_payload_part(
+							rest.data(), rest.size() );
+
+			if( validation_state_t::payload_part_is_valid == validation_result &&
+				0u == next_length_remaining )
+			{
+				validation_result = m_protocol_validator.finish_frame();
+			}
+
+			if( validation_state_t::payload_part_is_valid != validation_result &&
+				validation_state_t::frame_is_valid != validation_result )
+			{
+				handle_invalid_streamed_payload(
+						validation_result, next_length_remaining );
+				return;
+			}
+
+			// An empty fragment is passed only if it has the final flag.
+			if( !rest.empty() || final_frame == final_flag )
+				pass_payload_fragment( final_flag, std::move( rest ) );
+
+			continue_payload_streaming( next_length_remaining );
+		}
+
+		//! Pass a fragment of a streamed frame to the message handler.
+		/*!
+			Only the first fragment of a frame has the opcode of the frame
+			(next fragments are continuation frames) and only the last
+			fragment of the final frame has the final flag.
+
+			@since v.0.6.18
+		*/
+		void
+		pass_payload_fragment(
+			final_frame_flag_t final_flag,
+			std::string payload )
+		{
+			if( read_state_t::read_any_frame != m_read_state )
+				return;
+
+			const auto opcode = m_input.m_first_fragment_passed ?
+					opcode_t::continuation_frame :
+					m_input.m_parser.current_message().m_opcode;
+			m_input.m_first_fragment_passed = true;
+
+			call_message_handler(
+				std::make_shared< message_t >(
+					final_flag,
+					opcode,
+					std::move( payload ) ) );
+		}
+
+		//! Handle invalid payload of a streamed frame.
+		/*!
+			@since v.0.6.18
+		*/
+		void
+		handle_invalid_streamed_payload(
+			validation_state_t validation_result,
+			//! The size of the remainder of unfetched payload.
+			std::size_t length_remaining )
+		{
+			handle_invalid_payload( validation_result );
+
+			// The rest of the frame is skipped.
+			m_protocol_validator.reset();
+			skip_payload( length_remaining );
+		}
+
+		//! Read the next chunk of a streamed frame or the next header.
+		/*!
+			@since v.0.6.18
+		*/
+		void
+		continue_payload_streaming( std::size_t length_remaining )
+		{
+			if( 0u != length_remaining )
+				read_payload_chunk( length_remaining );
+			else if( read_state_t::read_nothing != m_read_state )
+				start_read_header();
+		}
+
+		//! Skip the rest of the payload of a streamed frame.
+		/*!
+			@since v.0.6.18
+		*/
+		void
+		skip_payload( std::size_t length_remaining )
+		{
+			if( 0u == length_remaining )
+			{
+				if( read_state_t::read_nothing != m_read_state )
+					start_read_header();
+			}
+			else
+			{
+				// Skip checking payload for this frame:
+				const bool do_validate_payload_and_call_msg_handler = false;
+				read_payload_chunk(
+					length_remaining,
+					do_validate_payload_and_call_msg_handler );
+			}
+		}
+
 		//! Call user message handler with current message.
 		void
 		call_message_handler( message_handle_t close_frame )
@@ -954,11 +1614,99 @@ class ws_connection_t final
 			}
 		}
 
+		//! Decompress the payload of the current frame.
+		/*!
+			\return false if the payload can't be decompressed (the case is
+			already handled).
+
+			@since v.0.6.18
+		*/
+		bool
+		decompress_current_payload(
+			//! Is it the end of the frame with the final flag?
+			final_frame_flag_t final_flag )
+		{
+			optional_t< std::string > decompressed;
+			try
+			{
+				decompressed = m_compression->decompress_frame(
+						m_input.m_payload, final_flag );
+			}
+			catch( const std::exception & ex )
+			{
+				m_logger.error( [&]{
+					return fmt::format(
+							RESTINIO_FMT_FORMAT_STRING(
+								"[ws_connection:{}] unable to decompress payload: {}" ),
+							connection_id(),
+							ex.what() );
+				} );
+
+				handle_decompression_failure(
+						status_code_t::invalid_message_data, 0u );
+				return false;
+			}
+
+			if( !decompressed )
+			{
+				m_logger.error( [&]{
+					return fmt::format(
+							RESTINIO_FMT_FORMAT_STRING(
+								"[ws_connection:{}] decompressed message is too big" ),
+							connection_id() );
+				} );
+
+				handle_decompression_failure(
+						status_code_t::too_big_message, 0u );
+				return false;
+			}
+
+			m_input.m_payload = std::move( *decompressed );
+
+			return true;
+		}
+
+		//! Handle a failure of decompression of the current frame.
+		/*!
+			@since v.0.6.18
+		*/
+		void
+		handle_decompression_failure(
+			status_code_t status,
+			//! The size of the remainder of unfetched payload.
+			std::size_t length_remaining )
+		{
+			m_close_frame_to_peer.run_if_first(
+				[&]{
+					send_close_frame_to_peer( status );
+					start_waiting_close_frame_only();
+				} );
+
+			call_close_handler_if_necessary( status );
+
+			// The rest of the message is skipped, so the validator
+			// must be ready for new frames.
+			m_protocol_validator.reset();
+			skip_payload( length_remaining );
+		}
+
 		void
 		call_handler_on_current_message()
 		{
 			auto & md = m_input.m_parser.current_message();
 
+			if( read_state_t::read_any_frame == m_read_state &&
+				m_protocol_validator.is_current_frame_compressed() )
+			{
+				if( !decompress_current_payload(
+						md.m_final_flag ? final_frame : not_final_frame ) )
+					return;
+
+				// UTF-8 errors are handled after finish_frame().
+				m_protocol_validator.process_decompressed_payload_part(
+						m_input.m_payload.data(), m_input.m_payload.size() );
+			}
+
 			const auto validation_result = m_protocol_validator.finish_frame();
 			if( validation_state_t::frame_is_valid == validation_result )
 			{
@@ -1090,15 +1838,83 @@ class ws_connection_t final
 
 		//! Checks if there is something to write,
 		//! and if so starts write operation.
+		/*!
+			Since v.0.6.18 the write operation can be delayed if
+			websocket_write_coalescing_delay is set. The delay isn't used
+			if there is enough data to fill a write operation or
+			if writes are disabled (a close frame is queued).
+		*/
 		void
 		init_write_if_necessary()
 		{
 			if( !m_write_output_ctx.transmitting() )
 			{
-				init_write();
+				if( std::chrono::microseconds::zero() == m_write_delay ||
+					write_state_t::write_disabled == m_write_state ||
+					m_outgoing_data.queued_bytes() >=
+						m_write_output_ctx.max_coalesced_bytes() )
+				{
+					m_write_delayed = false;
+					init_write();
+				}
+				else if( !m_write_delayed )
+				{
+					delay_write();
+				}
 			}
 		}
 
+		//! Wait before writing to gather more outgoing frames.
+		/*!
+			@since v.0.6.18
+		*/
+		void
+		delay_write()
+		{
+			m_logger.trace( [&]{
+				return fmt::format(
+					RESTINIO_FMT_FORMAT_STRING(
+						"[ws_connection:{}] delay write for {} us" ),
+					connection_id(),
+					m_write_delay.count() );
+			} );
+
+			m_write_delayed = true;
+
+			m_write_delay_timer.expires_after( m_write_delay );
+			m_write_delay_timer.async_wait(
+				asio_ns::bind_executor(
+					this->get_executor(),
+					[ this, ctx = shared_from_this() ]
+					( const asio_ns::error_code & ec ) noexcept
+					{
+						// A stale timer can't start a write operation
+						// because m_write_delayed is reset by init_write_if_necessary().
+						if( ec || !m_write_delayed || !m_socket.is_open() )
+							return;
+
+						try
+						{
+							m_write_delayed = false;
+							if( !m_write_output_ctx.transmitting() )
+								init_write();
+						}
+						catch( const std::exception & ex )
+						{
+							trigger_error_and_close(
+								status_code_t::unexpected_condition,
+								[&]{
+									return fmt::format(
+										RESTINIO_FMT_FORMAT_STRING(
+											"[ws_connection:{}] delayed write "
+											"failed: {}" ),
+										connection_id(),
+										ex.what() );
+								} );
+						}
+					} ) );
+		}
+
 		//! Initiate write operation.
 		void
 		init_write()
@@ -1122,11 +1938,43 @@ class ws_connection_t final
 				m_write_output_ctx.start_next_write_group(
 					std::move( next_write_group ) );
 
+				// Since v.0.6.18 all queued frames are written together
+				// with the first one if they fit into the limits of
+				// a single gather write operation.
+				coalesce_ready_write_groups();
+
 				// Start the loop of sending data from current write group.
 				handle_current_write_ctx();
 			}
 		}
 
+		//! Append queued write groups to the current write operation.
+		/*!
+			@since v.0.6.18
+		*/
+		void
+		coalesce_ready_write_groups()
+		{
+			const auto can_coalesce = [this]( const write_group_t & wg ) {
+					return m_write_output_ctx.can_coalesce( wg );
+				};
+
+			while( auto next_write_group =
+					m_outgoing_data.pop_ready_buffers_if( can_coalesce ) )
+			{
+				m_logger.trace( [&]{
+					return fmt::format(
+						RESTINIO_FMT_FORMAT_STRING(
+							"[ws_connection:{}] append write group, size: {}" ),
+						this->connection_id(),
+						next_write_group->items_count() );
+				} );
+
+				m_write_output_ctx.append_write_group(
+					std::move( *next_write_group ) );
+			}
+		}
+
 		// Use aliases for shorter names.
 		using none_write_operation_t = ::restinio::impl::write_group_output_ctx_t::none_write_operation_t;
 		using trivial_write_operation_t = ::restinio::impl::write_group_output_ctx_t::trivial_write_operation_t;
@@ -1243,9 +2091,15 @@ class ws_connection_t final
 			// Group notificators are called from here (if exist):
 			m_write_output_ctx.finish_write_group();
 
+			// The first write group contains the upgrade response,
+			// so the delay is used only after it.
+			m_write_delay = m_settings->m_websocket_write_coalescing_delay;
+
 			// Start another write opertion
 			// if there is something to send.
-			init_write_if_necessary();
+			// NOTE: frames queued during the write operation have
+			// already waited, so they are written without a delay.
+			init_write();
 		}
 
 		//! Handle write response finished.
@@ -1344,6 +2198,22 @@ class ws_connection_t final
 		tcp_connection_ctx_weak_handle_t m_prepared_weak_ctx;
 		timer_guard_t m_timer_guard;
 
+		//! A timer for delayed writes.
+		//! @since v.0.6.18
+		asio_ns::steady_timer m_write_delay_timer;
+
+		//! A delay before writing outgoing frames.
+		/*!
+			Is zero until the upgrade response is written.
+
+			@since v.0.6.18
+		*/
+		std::chrono::microseconds m_write_delay{ 0 };
+
+		//! Is a write operation delayed?
+		//! @since v.0.6.18
+		bool m_write_delayed{ false };
+
 		void
 		check_timeout_impl()
 		{
@@ -1421,6 +2291,23 @@ class ws_connection_t final
 		//! A waek handler for owning ws_t to use it when call message handler.
 		ws_weak_handle_t m_websocket_weak_handle;
 
+		//! Compression of messages (can be nullptr).
+		//! @since v.0.6.18
+		ws_compression_unique_ptr_t m_compression;
+
+		//! Is the current outgoing message compressed?
+		//! @since v.0.6.18
+		bool m_outgoing_message_compressed{ false };
+
+		//! The max size of payload chunks of streamed data frames.
+		/*!
+			Data frames with bigger payloads are passed to the message
+			handler by chunks. Zero means that streaming is disabled.
+
+			@since v.0.6.18
+		*/
+		std::size_t m_payload_streaming_chunk_size{ 0u };
+
 		//! Websocket output states.
 		enum class write_state_t
 		{
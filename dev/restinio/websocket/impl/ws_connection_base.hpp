@@ -13,6 +13,8 @@
 #include <restinio/tcp_connection_ctx_base.hpp>
 #include <restinio/common_types.hpp>
 #include <restinio/buffers.hpp>
+#include <restinio/websocket/message.hpp>
+#include <restinio/websocket/prepared_message.hpp>
 
 namespace restinio
 {
@@ -38,10 +40,28 @@ class ws_connection_base_t
 	:	public tcp_connection_ctx_base_t
 {
 	public:
-		ws_connection_base_t( connection_id_t id )
+		ws_connection_base_t(
+			connection_id_t id,
+			//! Are data messages compressed by the connection?
+			//! @since v.0.6.18
+			bool compresses_data_frames = false )
 			:	tcp_connection_ctx_base_t{ id }
+			,	m_compresses_data_frames{ compresses_data_frames }
 		{}
 
+		//! Are data messages compressed by the connection?
+		/*!
+			If it's true then data frames should be passed to
+			write_data_frame() instead of write_data().
+
+			@since v.0.6.18
+		*/
+		bool
+		compresses_data_frames() const noexcept
+		{
+			return m_compresses_data_frames;
+		}
+
 		//! Shutdown websocket.
 		virtual void
 		shutdown() = 0;
@@ -59,6 +79,41 @@ class ws_connection_base_t
 		write_data(
 			write_group_t wg,
 			bool is_close_frame ) = 0;
+
+		//! Write a data frame that can be compressed by the connection.
+		/*!
+			The header of the frame is made by the connection.
+
+			@since v.0.6.18
+		*/
+		virtual void
+		write_data_frame(
+			final_frame_flag_t final_flag,
+			opcode_t opcode,
+			writable_item_t payload,
+			write_status_cb_t wscb ) = 0;
+
+		//! Write a prepared message if it fits into the limit of
+		//! outgoing data.
+		/*!
+			@since v.0.6.18
+		*/
+		virtual void
+		write_prepared_message(
+			prepared_message_t message,
+			outgoing_queue_limit_t limit ) = 0;
+
+		//! Set the max size of payload chunks of streamed data frames.
+		/*!
+			Zero disables streaming.
+
+			@since v.0.6.18
+		*/
+		virtual void
+		payload_streaming( std::size_t max_chunk_size ) = 0;
+
+	private:
+		const bool m_compresses_data_frames;
 };
 
 //! Alias for WebSocket connection handle.
@@ -0,0 +1,186 @@
+/*
+	restinio
+*/
+
+/*!
+	Masking and unmasking of websocket payload by words and SIMD blocks.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/utils/impl/bitops.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+#if !defined( RESTINIO_WS_MASKING_SCALAR_ONLY )
+	#if defined( __SSE2__ ) || defined( _M_X64 ) || \
+			( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+		#define RESTINIO_WS_MASKING_USE_SSE2
+		#include <emmintrin.h>
+	#endif
+
+	#if defined( __AVX2__ )
+		#define RESTINIO_WS_MASKING_USE_AVX2
+		#include <immintrin.h>
+	#endif
+
+	#if defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+		#define RESTINIO_WS_MASKING_USE_NEON
+		#include <arm_neon.h>
+	#endif
+#endif
+
+namespace restinio
+{
+
+namespace websocket
+{
+
+namespace basic
+{
+
+namespace impl
+{
+
+//! The size of the largest block that is masked at once.
+/*!
+	It's 32 bytes with AVX2, 16 bytes with SSE2 or NEON and 8 bytes
+	(a 64-bit word) otherwise. Define RESTINIO_WS_MASKING_SCALAR_ONLY
+	to use only 64-bit words.
+*/
+#if defined( RESTINIO_WS_MASKING_USE_AVX2 )
+constexpr std::size_t ws_masking_block_size = 32u;
+#elif defined( RESTINIO_WS_MASKING_USE_SSE2 ) || defined( RESTINIO_WS_MASKING_USE_NEON )
+constexpr std::size_t ws_masking_block_size = 16u;
+#else
+constexpr std::size_t ws_masking_block_size = 8u;
+#endif
+
+//! Payloads of that size or greater are aligned before masking.
+/*!
+	Aligning requires masking of up to ws_masking_block_size - 1 bytes
+	one by one, so it is only worth it for large payloads.
+*/
+constexpr std::size_t ws_masking_align_threshold = 8u * ws_masking_block_size;
+
+//! Do mask/unmask operation with a part of payload in place.
+/*!
+	Data is processed by SIMD blocks (if available), then by 64-bit
+	words and then byte by byte. Large parts are processed byte by byte
+	up to the first address aligned to ws_masking_block_size, smaller
+	parts are processed by unaligned loads and stores.
+
+	@param masking_key The masking key of a frame.
+	@param key_offset The number of bytes of the frame payload that
+	were processed before @a data (only the remainder of division by 4
+	is important).
+	@param data Bytes to be masked/unmasked.
+	@param size The number of bytes to be masked/unmasked.
+*/
+inline void
+mask_unmask_bytes(
+	std::uint32_t masking_key,
+	std::size_t key_offset,
+	char * data,
+	std::size_t size ) noexcept
+{
+	using namespace ::restinio::utils::impl::bitops;
+
+	const std::uint8_t key[ 4 ] = {
+		n_bits_from< std::uint8_t, 24 >(masking_key),
+		n_bits_from< std::uint8_t, 16 >(masking_key),
+		n_bits_from< std::uint8_t, 8 >(masking_key),
+		n_bits_from< std::uint8_t, 0 >(masking_key),
+	};
+
+	if( size >= ws_masking_align_threshold )
+	{
+		const auto misalignment = reinterpret_cast< std::uintptr_t >( data ) %
+				ws_masking_block_size;
+		const std::size_t head = 0u == misalignment ? 0u :
+				ws_masking_block_size - misalignment;
+
+		for( std::size_t i = 0u; i != head; ++i )
+			data[ i ] = static_cast< char >(
+					static_cast< std::uint8_t >( data[ i ] ) ^
+					key[ ( key_offset + i ) % 4u ] );
+
+		data += head;
+		size -= head;
+		key_offset += head;
+	}
+
+	// The key as it should be applied to data (the size of every block
+	// is a multiple of 4, so the key doesn't change from block to block).
+	const std::uint8_t mask[ 4 ] = {
+		key[ key_offset % 4u ],
+		key[ ( key_offset + 1u ) % 4u ],
+		key[ ( key_offset + 2u ) % 4u ],
+		key[ ( key_offset + 3u ) % 4u ],
+	};
+	std::uint32_t mask32;
+	std::memcpy( &mask32, mask, sizeof(mask32) );
+
+	std::size_t i = 0u;
+
+#if defined( RESTINIO_WS_MASKING_USE_AVX2 )
+	{
+		const __m256i m = _mm256_set1_epi32( static_cast< int >( mask32 ) );
+		for( ; size - i >= 32u; i += 32u )
+		{
+			auto * p = reinterpret_cast< __m256i * >( data + i );
+			_mm256_storeu_si256( p, _mm256_xor_si256( _mm256_loadu_si256( p ), m ) );
+		}
+	}
+#endif
+
+#if defined( RESTINIO_WS_MASKING_USE_SSE2 )
+	{
+		const __m128i m = _mm_set1_epi32( static_cast< int >( mask32 ) );
+		for( ; size - i >= 16u; i += 16u )
+		{
+			auto * p = reinterpret_cast< __m128i * >( data + i );
+			_mm_storeu_si128( p, _mm_xor_si128( _mm_loadu_si128( p ), m ) );
+		}
+	}
+#endif
+
+#if defined( RESTINIO_WS_MASKING_USE_NEON )
+	{
+		const uint8x16_t m = vreinterpretq_u8_u32( vdupq_n_u32( mask32 ) );
+		for( ; size - i >= 16u; i += 16u )
+		{
+			auto * p = reinterpret_cast< std::uint8_t * >( data + i );
+			vst1q_u8( p, veorq_u8( vld1q_u8( p ), m ) );
+		}
+	}
+#endif
+
+	{
+		const std::uint64_t m = ( static_cast< std::uint64_t >( mask32 ) << 32 ) |
+				mask32;
+		for( ; size - i >= sizeof(m); i += sizeof(m) )
+		{
+			std::uint64_t w;
+			std::memcpy( &w, data + i, sizeof(w) );
+			w ^= m;
+			std::memcpy( data + i, &w, sizeof(w) );
+		}
+	}
+
+	// The tail.
+	for( ; i != size; ++i )
+		data[ i ] = static_cast< char >(
+				static_cast< std::uint8_t >( data[ i ] ) ^ mask[ i % 4u ] );
+}
+
+} /* namespace impl */
+
+} /* namespace basic */
+
+} /* namespace websocket */
+
+} /* namespace restinio */
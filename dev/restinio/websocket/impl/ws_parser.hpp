@@ -10,6 +10,7 @@
 
 #include <restinio/exception.hpp>
 #include <restinio/websocket/message.hpp>
+#include <restinio/websocket/impl/ws_masking.hpp>
 
 #include <restinio/utils/impl/bitops.hpp>
 
@@ -484,27 +485,15 @@ class ws_parser_t
 };
 
 //! Do msak/unmask operation with buffer.
+/*!
+	Since v.0.6.18 the buffer is processed by words and SIMD blocks,
+	see mask_unmask_bytes().
+*/
 inline void
 mask_unmask_payload( std::uint32_t masking_key, raw_data_t & payload )
 {
-	using namespace ::restinio::utils::impl::bitops;
-
-	const std::size_t MASK_SIZE = 4;
-	const uint8_t mask[ MASK_SIZE ] = {
-		n_bits_from< std::uint8_t, 24 >(masking_key),
-		n_bits_from< std::uint8_t, 16 >(masking_key),
-		n_bits_from< std::uint8_t, 8 >(masking_key),
-		n_bits_from< std::uint8_t, 0 >(masking_key),
-	};
-
-	const auto payload_size = payload.size();
-	for( std::size_t i = 0; i < payload_size; )
-	{
-		for( std::size_t j = 0; j < MASK_SIZE && i < payload_size; ++j, ++i )
-		{
-			payload[ i ] ^= mask[ j ];
-		}
-	}
+	if( !payload.empty() )
+		mask_unmask_bytes( masking_key, 0u, &payload[ 0 ], payload.size() );
 }
 
 //! Serialize websocket message details into bytes buffer.
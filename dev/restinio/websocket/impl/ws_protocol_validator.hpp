@@ -121,7 +121,8 @@ struct unmasker_t
 	unmasker_t() = default;
 
 	unmasker_t( uint32_t masking_key )
-	:	m_mask{
+	:	m_masking_key{ masking_key }
+	,	m_mask{
 			{::restinio::utils::impl::bitops::n_bits_from< std::uint8_t, 24 >(
 				masking_key),
 			::restinio::utils::impl::bitops::n_bits_from< std::uint8_t, 16 >(
@@ -143,11 +144,23 @@ struct unmasker_t
 		return masked_byte ^ m_mask[ (m_processed_bytes_count++) % 4 ];
 	}
 
+	//! Do unmask operation with a sequence of bytes in place.
+	/*!
+		@since v.0.6.18
+	*/
+	void
+	unmask_bytes( char * data, std::size_t size ) noexcept
+	{
+		mask_unmask_bytes( m_masking_key, m_processed_bytes_count, data, size );
+		m_processed_bytes_count += size;
+	}
+
 	//! Reset to initial state.
 	void
 	reset( uint32_t masking_key )
 	{
 		m_processed_bytes_count = 0;
+		m_masking_key = masking_key;
 
 		m_mask = mask_array_t{
 			{::restinio::utils::impl::bitops::n_bits_from< std::uint8_t, 24 >(
@@ -163,6 +176,10 @@ struct unmasker_t
 
 	using mask_array_t = std::array< uint8_t, websocket_masking_key_size>;
 
+	//! Masking key.
+	//! @since v.0.6.18
+	uint32_t m_masking_key{ 0 };
+
 	//! Bytes array with masking key.
 	mask_array_t m_mask;
 
@@ -202,6 +219,33 @@ class ws_protocol_validator_t
 		{
 		}
 
+		//! Allow RSV1 bit in the first frame of data messages.
+		/*!
+			RSV1 marks compressed messages when permessage-deflate
+			extension is negotiated (see RFC 7692). Payloads of compressed
+			text messages aren't checked for UTF-8 correctness, decompressed
+			data should be passed to process_decompressed_payload_part()
+			for that.
+
+			@since v.0.6.18
+		*/
+		void
+		allow_compressed_messages() noexcept
+		{
+			m_compressed_messages_allowed = true;
+		}
+
+		//! Is payload of the current frame a part of a compressed message?
+		/*!
+			@since v.0.6.18
+		*/
+		bool
+		is_current_frame_compressed() const noexcept
+		{
+			return m_compressed_message &&
+				!is_control_frame( m_current_frame.m_opcode );
+		}
+
 		//! Start work with new frame.
 		/*!
 			\attention methods finish_frame() or reset() should be called before
@@ -221,11 +265,13 @@ class ws_protocol_validator_t
 					case opcode_t::text_frame:
 						if( !frame.m_final_flag )
 							m_previous_data_frame = previous_data_frame_t::text;
+						m_compressed_message = frame.m_rsv1_flag;
 					break;
 
 					case opcode_t::binary_frame:
 						if( !frame.m_final_flag )
 							m_previous_data_frame = previous_data_frame_t::binary;
+						m_compressed_message = frame.m_rsv1_flag;
 					break;
 
 					case opcode_t::connection_close_frame:
@@ -286,13 +332,57 @@ class ws_protocol_validator_t
 			else
 				return m_validation_state;
 
-			for( size_t i = 0; i < size; ++i )
+			// Since v.0.6.18 the whole part is unmasked at once, payloads
+			// of text frames are checked by blocks and only payloads of close
+			// frames are checked byte by byte.
+			if( m_unmask_flag )
+				m_unmasker.unmask_bytes( data, size );
+
+			if( is_text_payload() )
 			{
-				data[i] = static_cast<char>(process_payload_byte(
-					static_cast<std::uint8_t>(data[i]) ));
+				if( !m_utf8_checker.process_bytes( data, size ) )
+					set_validation_state(
+						validation_state_t::incorrect_utf8_data );
+			}
+			else if( payload_should_be_validated() )
+				for( size_t i = 0; i < size; ++i )
+				{
+					validate_payload_byte( static_cast<std::uint8_t>(data[i]) );
 
-				if( m_validation_state != validation_state_t::payload_part_is_valid )
-					break;
+					if( m_validation_state != validation_state_t::payload_part_is_valid )
+						break;
+				}
+
+			return m_validation_state;
+		}
+
+		//! Validate decompressed data of the current frame.
+		/*!
+			Should be called for compressed frames after
+			process_and_unmask_next_payload_part() (or process_next_payload_part())
+			and before finish_frame().
+
+			@since v.0.6.18
+		*/
+		validation_state_t
+		process_decompressed_payload_part( const char * data, size_t size )
+		{
+			if( m_working_state == working_state_t::empty_state )
+				throw exception_t( "current state is empty" );
+
+			if( is_state_still_valid() )
+				set_validation_state(
+					validation_state_t::payload_part_is_valid );
+			else
+				return m_validation_state;
+
+			if( m_current_frame.m_opcode == opcode_t::text_frame ||
+				(m_current_frame.m_opcode == opcode_t::continuation_frame &&
+					m_previous_data_frame == previous_data_frame_t::text) )
+			{
+				if( !m_utf8_checker.process_bytes( data, size ) )
+					set_validation_state(
+						validation_state_t::incorrect_utf8_data );
 			}
 
 			return m_validation_state;
@@ -327,6 +417,12 @@ class ws_protocol_validator_t
 					previous_data_frame_t::none;
 			}
 
+			if( !is_control_frame(m_current_frame.m_opcode) &&
+				m_current_frame.m_final_flag )
+			{
+				m_compressed_message = false;
+			}
+
 			// Remember current frame vaidation state and return this value.
 			auto this_frame_validation_state = m_validation_state;
 
@@ -344,6 +440,7 @@ class ws_protocol_validator_t
 			m_working_state = working_state_t::empty_state;
 			m_previous_data_frame =
 				previous_data_frame_t::none;
+			m_compressed_message = false;
 
 			m_utf8_checker.reset();
 		}
@@ -378,7 +475,10 @@ class ws_protocol_validator_t
 				set_validation_state(
 					validation_state_t::empty_mask_from_client_side );
 			}
-			else if( frame.m_rsv1_flag != 0 ||
+			else if( ( frame.m_rsv1_flag != 0 &&
+					!( m_compressed_messages_allowed &&
+						( frame.m_opcode == opcode_t::text_frame ||
+							frame.m_opcode == opcode_t::binary_frame ) ) ) ||
 				frame.m_rsv2_flag != 0 ||
 				frame.m_rsv3_flag != 0)
 			{
@@ -408,9 +508,47 @@ class ws_protocol_validator_t
 			byte = m_unmask_flag?
 				m_unmasker.unmask_byte( byte ): byte;
 
-			if( m_current_frame.m_opcode == opcode_t::text_frame ||
+			validate_payload_byte( byte );
+
+			return byte;
+		}
+
+		//! Does payload of the current frame need a byte by byte validation?
+		/*!
+			Only payloads of text frames (with their continuation frames)
+			and close frames are validated.
+
+			@since v.0.6.18
+		*/
+		bool
+		payload_should_be_validated() const noexcept
+		{
+			return is_text_payload() ||
+				m_current_frame.m_opcode == opcode_t::connection_close_frame;
+		}
+
+		//! Is payload of the current frame a part of an uncompressed
+		//! text message?
+		/*!
+			@since v.0.6.18
+		*/
+		bool
+		is_text_payload() const noexcept
+		{
+			return !m_compressed_message &&
+				(m_current_frame.m_opcode == opcode_t::text_frame ||
 				(m_current_frame.m_opcode == opcode_t::continuation_frame &&
-					m_previous_data_frame == previous_data_frame_t::text) )
+					m_previous_data_frame == previous_data_frame_t::text));
+		}
+
+		//! Validate unmasked payload byte.
+		/*!
+			@since v.0.6.18
+		*/
+		void
+		validate_payload_byte( std::uint8_t byte )
+		{
+			if( is_text_payload() )
 			{
 				if( !m_utf8_checker.process_byte( byte ) )
 				{
@@ -439,8 +577,6 @@ class ws_protocol_validator_t
 							validation_state_t::incorrect_utf8_data );
 				}
 			}
-
-			return byte;
 		}
 
 		//! Check previous frame type.
@@ -576,6 +712,14 @@ class ws_protocol_validator_t
 		//! This flag set if it's need to unmask payload parts.
 		bool m_unmask_flag{ false };
 
+		//! Can data messages be compressed (marked by RSV1)?
+		//! @since v.0.6.18
+		bool m_compressed_messages_allowed{ false };
+
+		//! Is the current data message compressed?
+		//! @since v.0.6.18
+		bool m_compressed_message{ false };
+
 		//! Unmask payload coming from client side.
 		unmasker_t m_unmasker;
 };
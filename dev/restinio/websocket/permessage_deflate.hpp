@@ -0,0 +1,738 @@
+/*
+	restinio
+*/
+
+/*!
+	WebSocket permessage-deflate extension (RFC 7692).
+
+	This header isn't included by restinio/websocket/websocket.hpp because
+	it requires zlib.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/websocket/websocket.hpp>
+#include <restinio/transforms/zlib.hpp>
+#include <restinio/helpers/http_field_parsers/sec-websocket-extensions.hpp>
+
+#include <algorithm>
+
+namespace restinio
+{
+
+namespace websocket
+{
+
+namespace basic
+{
+
+//
+// permessage_deflate_params_t
+//
+
+//! Server side parameters of permessage-deflate extension.
+/*!
+	Usage example:
+	\code
+	namespace rws = restinio::websocket::basic;
+
+	auto ws = rws::upgrade< traits_t >(
+		*req,
+		rws::activation_t::immediate,
+		rws::permessage_deflate_params_t{}
+			.client_no_context_takeover( true )
+			.server_max_window_bits( 12 )
+			.min_compressed_size( 64 ),
+		message_handler );
+	\endcode
+
+	\note
+	Limits of window bits are the upper limits. Offers of clients can make
+	windows smaller. If the window of the server can't be 9 bits or greater
+	(a client asks for 8 bits, that isn't supported by zlib) the offer is
+	declined.
+
+	@since v.0.6.18
+*/
+class permessage_deflate_params_t
+{
+	public:
+		//! Don't use messages sent before for compression of a new message.
+		/*!
+			Compression context is released after every message, that saves
+			memory of idle connections but makes compression worse.
+		*/
+		bool server_no_context_takeover() const noexcept
+		{ return m_server_no_context_takeover; }
+
+		permessage_deflate_params_t &
+		server_no_context_takeover( bool v ) & noexcept
+		{
+			m_server_no_context_takeover = v;
+			return *this;
+		}
+
+		permessage_deflate_params_t &&
+		server_no_context_takeover( bool v ) && noexcept
+		{
+			return std::move( this->server_no_context_takeover( v ) );
+		}
+
+		//! Ask clients not to use messages sent before for compression
+		//! of a new message.
+		/*!
+			Decompression context is released after every message.
+		*/
+		bool client_no_context_takeover() const noexcept
+		{ return m_client_no_context_takeover; }
+
+		permessage_deflate_params_t &
+		client_no_context_takeover( bool v ) & noexcept
+		{
+			m_client_no_context_takeover = v;
+			return *this;
+		}
+
+		permessage_deflate_params_t &&
+		client_no_context_takeover( bool v ) && noexcept
+		{
+			return std::move( this->client_no_context_takeover( v ) );
+		}
+
+		//! The size of compression window of the server.
+		int server_max_window_bits() const noexcept
+		{ return m_server_max_window_bits; }
+
+		//! Set the size of compression window of the server.
+		/*!
+			Must be an integer value in the range of 9 to 15.
+		*/
+		permessage_deflate_params_t &
+		server_max_window_bits( int v ) &
+		{
+			ensure_window_bits_in_range( v, 9, "server_max_window_bits" );
+			m_server_max_window_bits = v;
+			return *this;
+		}
+
+		permessage_deflate_params_t &&
+		server_max_window_bits( int v ) &&
+		{
+			return std::move( this->server_max_window_bits( v ) );
+		}
+
+		//! The size of compression window of clients.
+		int client_max_window_bits() const noexcept
+		{ return m_client_max_window_bits; }
+
+		//! Set the size of compression window of clients.
+		/*!
+			Must be an integer value in the range of 8 to 15.
+
+			\note
+			Clients are asked for a smaller window only if they declare
+			support of client_max_window_bits in their offers.
+		*/
+		permessage_deflate_params_t &
+		client_max_window_bits( int v ) &
+		{
+			ensure_window_bits_in_range( v, 8, "client_max_window_bits" );
+			m_client_max_window_bits = v;
+			return *this;
+		}
+
+		permessage_deflate_params_t &&
+		client_max_window_bits( int v ) &&
+		{
+			return std::move( this->client_max_window_bits( v ) );
+		}
+
+		//! Compression level.
+		int compression_level() const noexcept { return m_compression_level; }
+
+		//! Set compression level.
+		/*!
+			Must be an integer value in the range of -1 to 9.
+		*/
+		permessage_deflate_params_t &
+		compression_level( int v ) &
+		{
+			// Let zlib params do the check.
+			transforms::zlib::make_raw_deflate_compress_params( v );
+			m_compression_level = v;
+			return *this;
+		}
+
+		permessage_deflate_params_t &&
+		compression_level( int v ) &&
+		{
+			return std::move( this->compression_level( v ) );
+		}
+
+		//! Compression mem_level.
+		int mem_level() const noexcept { return m_mem_level; }
+
+		//! Set compression mem_level.
+		/*!
+			Must be an integer value in the range of 1 to 9.
+		*/
+		permessage_deflate_params_t &
+		mem_level( int v ) &
+		{
+			// Let zlib params do the check.
+			transforms::zlib::make_raw_deflate_compress_params().mem_level( v );
+			m_mem_level = v;
+			return *this;
+		}
+
+		permessage_deflate_params_t &&
+		mem_level( int v ) &&
+		{
+			return std::move( this->mem_level( v ) );
+		}
+
+		//! Messages with the first frame smaller than that are sent
+		//! without compression.
+		std::size_t min_compressed_size() const noexcept
+		{ return m_min_compressed_size; }
+
+		permessage_deflate_params_t &
+		min_compressed_size( std::size_t v ) & noexcept
+		{
+			m_min_compressed_size = v;
+			return *this;
+		}
+
+		permessage_deflate_params_t &&
+		min_compressed_size( std::size_t v ) && noexcept
+		{
+			return std::move( this->min_compressed_size( v ) );
+		}
+
+		//! Max size of decompressed incoming message.
+		/*!
+			The connection is closed with status_code_t::too_big_message
+			if a decompressed message is bigger.
+
+			Frames that are passed to the message handler by chunks
+			(see ws_t::payload_streaming()) are not counted: each chunk
+			of such a frame is decompressed into pieces that are not bigger
+			than the chunk size.
+		*/
+		std::size_t max_decompressed_message_size() const noexcept
+		{ return m_max_decompressed_message_size; }
+
+		permessage_deflate_params_t &
+		max_decompressed_message_size( std::size_t v ) & noexcept
+		{
+			m_max_decompressed_message_size = v;
+			return *this;
+		}
+
+		permessage_deflate_params_t &&
+		max_decompressed_message_size( std::size_t v ) && noexcept
+		{
+			return std::move( this->max_decompressed_message_size( v ) );
+		}
+
+	private:
+		static void
+		ensure_window_bits_in_range( int v, int min, const char * name )
+		{
+			if( v < min || v > MAX_WBITS )
+			{
+				throw exception_t{
+					fmt::format(
+						RESTINIO_FMT_FORMAT_STRING(
+							"invalid {}: {}, must be "
+							"an integer value in the range of {} to {}" ),
+						name,
+						v,
+						min,
+						MAX_WBITS ) };
+			}
+		}
+
+		bool m_server_no_context_takeover{ false };
+		bool m_client_no_context_takeover{ false };
+		int m_server_max_window_bits{ MAX_WBITS };
+		int m_client_max_window_bits{ MAX_WBITS };
+		int m_compression_level{ -1 };
+		//! NOTE: zlib's default (8) is used instead of MAX_MEM_LEVEL
+		//! because of the memory used by every connection.
+		int m_mem_level{ 8 };
+		std::size_t m_min_compressed_size{ 0u };
+		std::size_t m_max_decompressed_message_size{ 16u * 1024u * 1024u };
+};
+
+//
+// permessage_deflate_agreement_t
+//
+
+//! The result of negotiation of permessage-deflate extension.
+/*!
+	@since v.0.6.18
+*/
+struct permessage_deflate_agreement_t
+{
+	//! Parameters of the server.
+	permessage_deflate_params_t m_params;
+
+	bool m_server_no_context_takeover{ false };
+	bool m_client_no_context_takeover{ false };
+
+	//! The size of compression window of the server.
+	int m_server_max_window_bits{ MAX_WBITS };
+	//! Should server_max_window_bits be in the response?
+	bool m_server_max_window_bits_in_response{ false };
+
+	//! The size of compression window of the client.
+	/*!
+		Is in the response only if it is less than 15.
+	*/
+	int m_client_max_window_bits{ MAX_WBITS };
+
+	//! Make the value of Sec-WebSocket-Extensions field of the response.
+	RESTINIO_NODISCARD
+	std::string
+	response_field_value() const
+	{
+		std::string result{ "permessage-deflate" };
+
+		if( m_server_no_context_takeover )
+			result += "; server_no_context_takeover";
+		if( m_client_no_context_takeover )
+			result += "; client_no_context_takeover";
+		if( m_server_max_window_bits_in_response )
+			result += "; server_max_window_bits=" +
+					std::to_string( m_server_max_window_bits );
+		if( m_client_max_window_bits < MAX_WBITS )
+			result += "; client_max_window_bits=" +
+					std::to_string( m_client_max_window_bits );
+
+		return result;
+	}
+};
+
+namespace impl
+{
+
+//! Parse the value of window bits parameter (8 to 15).
+RESTINIO_NODISCARD
+inline optional_t< int >
+parse_window_bits( string_view_t what ) noexcept
+{
+	if( 1u == what.size() && '8' <= what[ 0 ] && what[ 0 ] <= '9' )
+		return what[ 0 ] - '0';
+	if( 2u == what.size() && '1' == what[ 0 ] &&
+		'0' <= what[ 1 ] && what[ 1 ] <= '5' )
+		return 10 + ( what[ 1 ] - '0' );
+
+	return nullopt;
+}
+
+//! Try to accept an offer of permessage-deflate extension.
+/*!
+	See RFC 7692, section 7.1.
+*/
+RESTINIO_NODISCARD
+inline optional_t< permessage_deflate_agreement_t >
+try_accept_permessage_deflate_offer(
+	const http_field_parsers::parameter_with_optional_value_container_t & offer,
+	const permessage_deflate_params_t & params )
+{
+	permessage_deflate_agreement_t result;
+	result.m_params = params;
+	result.m_server_no_context_takeover = params.server_no_context_takeover();
+	result.m_client_no_context_takeover = params.client_no_context_takeover();
+	result.m_server_max_window_bits = params.server_max_window_bits();
+	result.m_server_max_window_bits_in_response =
+			params.server_max_window_bits() < MAX_WBITS;
+
+	bool client_max_window_bits_offered = false;
+	int client_max_window_bits = params.client_max_window_bits();
+
+	for( std::size_t i = 0u; i != offer.size(); ++i )
+	{
+		const auto & name = offer[ i ].first;
+		const auto & value = offer[ i ].second;
+
+		// Every parameter can be used only once.
+		for( std::size_t j = 0u; j != i; ++j )
+			if( name == offer[ j ].first )
+				return nullopt;
+
+		if( "server_no_context_takeover" == name )
+		{
+			if( value )
+				return nullopt;
+			result.m_server_no_context_takeover = true;
+		}
+		else if( "client_no_context_takeover" == name )
+		{
+			// It is just a hint for the server.
+			if( value )
+				return nullopt;
+		}
+		else if( "server_max_window_bits" == name )
+		{
+			const auto bits = value ? parse_window_bits( *value ) : nullopt;
+			if( !bits )
+				return nullopt;
+			result.m_server_max_window_bits =
+					std::min( result.m_server_max_window_bits, *bits );
+			result.m_server_max_window_bits_in_response = true;
+		}
+		else if( "client_max_window_bits" == name )
+		{
+			client_max_window_bits_offered = true;
+			if( value )
+			{
+				const auto bits = parse_window_bits( *value );
+				if( !bits )
+					return nullopt;
+				client_max_window_bits = std::min( client_max_window_bits, *bits );
+			}
+		}
+		else
+			// Unknown parameter.
+			return nullopt;
+	}
+
+	// zlib doesn't support windows of 8 bits for compression.
+	if( result.m_server_max_window_bits < 9 )
+		return nullopt;
+
+	if( client_max_window_bits_offered )
+		result.m_client_max_window_bits = client_max_window_bits;
+
+	return result;
+}
+
+} /* namespace impl */
+
+//
+// negotiate_permessage_deflate()
+//
+
+//! Negotiate permessage-deflate extension for an upgrade request.
+/*!
+	The first acceptable offer from Sec-WebSocket-Extensions fields is
+	accepted. Offers of other extensions and invalid fields are ignored.
+
+	\return empty optional if there is no acceptable offer.
+
+	@since v.0.6.18
+*/
+RESTINIO_NODISCARD
+inline optional_t< permessage_deflate_agreement_t >
+negotiate_permessage_deflate(
+	const http_header_fields_t & request_fields,
+	const permessage_deflate_params_t & params )
+{
+	optional_t< permessage_deflate_agreement_t > result;
+
+	request_fields.for_each_value_of(
+		http_field::sec_websocket_extensions,
+		[&]( string_view_t value ) {
+			const auto extensions =
+				http_field_parsers::sec_websocket_extensions_value_t::try_parse(
+						value );
+			if( extensions )
+				for( const auto & e : extensions->extensions )
+					if( "permessage-deflate" == e.name )
+					{
+						result = impl::try_accept_permessage_deflate_offer(
+								e.params, params );
+						if( result )
+							return http_header_fields_t::stop_enumeration();
+					}
+
+			return http_header_fields_t::continue_enumeration();
+		} );
+
+	return result;
+}
+
+namespace impl
+{
+
+//! The initial size of buffers for compressed and decompressed data.
+constexpr std::size_t permessage_deflate_reserve_buffer_size = 4u * 1024u;
+
+//! The tail of data compressed with Z_SYNC_FLUSH.
+constexpr char permessage_deflate_tail[] = { '\x00', '\x00', '\xFF', '\xFF' };
+
+//
+// permessage_deflate_t
+//
+
+//! Compression of messages of a connection by permessage-deflate extension.
+/*!
+	Every frame is compressed with Z_SYNC_FLUSH, so a frame can be sent
+	as soon as it is compressed. The tail of the last frame of a message
+	(0x00 0x00 0xFF 0xFF) is removed and it is appended to the last frame of
+	incoming message before decompression (see RFC 7692, section 7.2).
+
+	zlib streams are created on demand. If there is no context takeover
+	for one of directions then the stream is destroyed after every message.
+*/
+class permessage_deflate_t final : public ws_compression_t
+{
+	public:
+		explicit permessage_deflate_t( permessage_deflate_agreement_t agreement )
+			:	m_agreement{ std::move( agreement ) }
+		{}
+
+		bool
+		should_compress(
+			std::size_t first_frame_payload_size ) const noexcept override
+		{
+			return first_frame_payload_size >=
+					m_agreement.m_params.min_compressed_size();
+		}
+
+		std::string
+		compress_frame(
+			string_view_t payload,
+			final_frame_flag_t final_flag ) override
+		{
+			auto & z = deflater();
+			z.write( payload );
+			z.flush();
+
+			auto result = shrink( z.giveaway_output() );
+
+			if( final_frame == final_flag )
+			{
+				if( ends_with_tail( result ) )
+					result.resize( result.size() - tail_size );
+
+				if( m_agreement.m_server_no_context_takeover )
+					m_deflater.reset();
+			}
+
+			return result;
+		}
+
+		optional_t< std::string >
+		decompress_frame(
+			string_view_t payload,
+			final_frame_flag_t final_flag ) override
+		{
+			auto & z = inflater();
+
+			// Decompression is stopped by zlib_t as soon as the message
+			// becomes too big, so a small frame can't be inflated into
+			// a huge buffer.
+			z.max_output_size(
+					m_agreement.m_params.max_decompressed_message_size() -
+					m_decompressed_message_size );
+
+			z.write( payload );
+			if( final_frame == final_flag )
+				z.write( string_view_t{ permessage_deflate_tail, tail_size } );
+
+			if( z.is_output_limit_exceeded() )
+				return too_big_message();
+
+			auto result = shrink( z.giveaway_output() );
+
+			if( final_frame == final_flag )
+			{
+				m_decompressed_message_size = 0u;
+
+				// A stream ended by the final block (BFINAL) can't be used
+				// for the next message.
+				if( m_agreement.m_client_no_context_takeover ||
+					z.is_stream_end_reached() )
+					m_inflater.reset();
+			}
+			else
+				m_decompressed_message_size += result.size();
+
+			return result;
+		}
+
+		std::string
+		decompress_frame_by_pieces(
+			string_view_t payload,
+			final_frame_flag_t final_flag,
+			std::size_t max_piece_size,
+			const decompressed_piece_handler_t & handler ) override
+		{
+			auto & z = inflater();
+
+			z.write_by_portions( payload, max_piece_size, handler );
+			if( final_frame == final_flag )
+				z.write_by_portions(
+						string_view_t{ permessage_deflate_tail, tail_size },
+						max_piece_size,
+						handler );
+
+			auto result = shrink( z.giveaway_output() );
+
+			if( final_frame == final_flag )
+			{
+				m_decompressed_message_size = 0u;
+
+				if( m_agreement.m_client_no_context_takeover ||
+					z.is_stream_end_reached() )
+					m_inflater.reset();
+			}
+
+			return result;
+		}
+
+	private:
+		static constexpr std::size_t tail_size = sizeof(permessage_deflate_tail);
+
+		static bool
+		ends_with_tail( const std::string & data ) noexcept
+		{
+			return data.size() >= tail_size &&
+				0 == data.compare( data.size() - tail_size, tail_size,
+						permessage_deflate_tail, tail_size );
+		}
+
+		//! Release unused memory of the buffer of zlib_t.
+		static std::string
+		shrink( std::string data )
+		{
+			if( data.capacity() - data.size() >= permessage_deflate_reserve_buffer_size / 2u )
+				data.shrink_to_fit();
+
+			return data;
+		}
+
+		optional_t< std::string >
+		too_big_message() noexcept
+		{
+			m_inflater.reset();
+			m_decompressed_message_size = 0u;
+			return nullopt;
+		}
+
+		transforms::zlib::zlib_t &
+		deflater()
+		{
+			if( !m_deflater )
+				m_deflater = std::make_unique< transforms::zlib::zlib_t >(
+					transforms::zlib::make_raw_deflate_compress_params(
+							m_agreement.m_params.compression_level() )
+						.window_bits( m_agreement.m_server_max_window_bits )
+						.mem_level( m_agreement.m_params.mem_level() )
+						.reserve_buffer_size( permessage_deflate_reserve_buffer_size ) );
+
+			return *m_deflater;
+		}
+
+		transforms::zlib::zlib_t &
+		inflater()
+		{
+			if( !m_inflater )
+				m_inflater = std::make_unique< transforms::zlib::zlib_t >(
+					transforms::zlib::make_raw_deflate_decompress_params()
+						.window_bits( m_agreement.m_client_max_window_bits )
+						.reserve_buffer_size( permessage_deflate_reserve_buffer_size ) );
+
+			return *m_inflater;
+		}
+
+		const permessage_deflate_agreement_t m_agreement;
+
+		std::unique_ptr< transforms::zlib::zlib_t > m_deflater;
+		std::unique_ptr< transforms::zlib::zlib_t > m_inflater;
+
+		//! The size of decompressed frames of the current message.
+		std::size_t m_decompressed_message_size{ 0u };
+};
+
+} /* namespace impl */
+
+//
+// upgrade()
+//
+
+//! Upgrade http-connection of a current request to a websocket connection
+//! with permessage-deflate extension.
+/*!
+	The extension is used only if the client offers it and the offer is
+	acceptable for @a params. Sec-WebSocket-Extensions field is added to
+	the response in that case.
+
+	@since v.0.6.18
+*/
+template <
+		typename Traits,
+		typename WS_Message_Handler >
+ws_handle_t
+upgrade(
+	//! Upgrade request.
+	generic_request_type_from_traits_t<Traits> & req,
+	//! Activation policy.
+	activation_t activation_flag,
+	//! Response header fields.
+	http_header_fields_t upgrade_response_header_fields,
+	//! Parameters of permessage-deflate extension.
+	const permessage_deflate_params_t & params,
+	//! Message handler.
+	WS_Message_Handler ws_message_handler )
+{
+	impl::ws_compression_unique_ptr_t compression;
+
+	auto agreement = negotiate_permessage_deflate( req.header(), params );
+	if( agreement )
+	{
+		upgrade_response_header_fields.set_field(
+			http_field::sec_websocket_extensions,
+			agreement->response_field_value() );
+
+		compression = std::make_unique< impl::permessage_deflate_t >(
+				std::move( *agreement ) );
+	}
+
+	return impl::upgrade_with_compression< Traits, WS_Message_Handler >(
+			req,
+			activation_flag,
+			std::move( upgrade_response_header_fields ),
+			std::move( ws_message_handler ),
+			std::move( compression ) );
+}
+
+//! Upgrade http-connection of a current request to a websocket connection
+//! with permessage-deflate extension.
+/*!
+	@since v.0.6.18
+*/
+template <
+		typename Traits,
+		typename WS_Message_Handler >
+ws_handle_t
+upgrade(
+	generic_request_type_from_traits_t<Traits> & req,
+	activation_t activation_flag,
+	const permessage_deflate_params_t & params,
+	WS_Message_Handler ws_message_handler )
+{
+	http_header_fields_t upgrade_response_header_fields;
+	upgrade_response_header_fields.set_field(
+		http_field::sec_websocket_accept,
+		impl::make_sec_websocket_accept_field_value( req.header() ) );
+
+	return
+		upgrade< Traits, WS_Message_Handler >(
+			req,
+			activation_flag,
+			std::move( upgrade_response_header_fields ),
+			params,
+			std::move( ws_message_handler ) );
+}
+
+} /* namespace basic */
+
+} /* namespace websocket */
+
+} /* namespace restinio */
@@ -0,0 +1,228 @@
+/*
+	restinio
+*/
+
+/*!
+	A websocket message serialized once to be sent to many connections.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <restinio/buffers.hpp>
+#include <restinio/exception.hpp>
+#include <restinio/websocket/message.hpp>
+#include <restinio/websocket/impl/ws_parser.hpp>
+
+#include <limits>
+#include <memory>
+
+namespace restinio
+{
+
+namespace websocket
+{
+
+namespace basic
+{
+
+namespace impl
+{
+
+//
+// prepared_frame_t
+//
+
+//! A serialized frame (the header and the payload in one buffer).
+struct prepared_frame_t
+{
+	prepared_frame_t(
+		final_frame_flag_t final_flag,
+		opcode_t opcode,
+		string_view_t payload )
+		:	m_final_flag{ final_flag }
+		,	m_opcode{ opcode }
+	{
+		m_frame = write_message_details( final_flag, opcode, payload.size() );
+		m_header_size = m_frame.size();
+
+		m_frame.reserve( m_header_size + payload.size() );
+		m_frame.append( payload.data(), payload.size() );
+	}
+
+	//! @name Datasizeable interface.
+	///@{
+	const char * data() const noexcept { return m_frame.data(); }
+	std::size_t size() const noexcept { return m_frame.size(); }
+	///@}
+
+	const final_frame_flag_t m_final_flag;
+	const opcode_t m_opcode;
+	std::string m_frame;
+	std::size_t m_header_size;
+};
+
+//
+// prepared_payload_t
+//
+
+//! The payload of a prepared frame without the header.
+/*!
+	Is used for connections that compress messages themselves.
+	Holds the frame, so the payload can be queued without copying.
+*/
+struct prepared_payload_t
+{
+	std::shared_ptr< const prepared_frame_t > m_frame;
+
+	//! @name Datasizeable interface.
+	///@{
+	const char * data() const noexcept
+	{
+		return m_frame->data() + m_frame->m_header_size;
+	}
+
+	std::size_t size() const noexcept
+	{
+		return m_frame->size() - m_frame->m_header_size;
+	}
+	///@}
+};
+
+} /* namespace impl */
+
+//
+// prepared_message_t
+//
+
+//! A websocket message serialized once to be sent to many connections.
+/*!
+	The frame (the header and the payload) is stored in one refcounted
+	buffer. Sending a prepared message to a connection only queues a
+	reference to that buffer, the frame isn't copied.
+
+	Copies of prepared_message_t are cheap and refer to the same buffer.
+
+	\note
+	Close frames can't be prepared, they should be sent by
+	ws_t::send_message() because a close frame changes the state
+	of a connection.
+
+	\see broadcast()
+
+	@since v.0.6.18
+*/
+class prepared_message_t
+{
+	public:
+		prepared_message_t(
+			final_frame_flag_t final_flag,
+			opcode_t opcode,
+			string_view_t payload )
+			:	m_frame{ make_frame( final_flag, opcode, payload ) }
+		{}
+
+		explicit prepared_message_t( const message_t & msg )
+			:	prepared_message_t{
+					msg.final_flag(), msg.opcode(), msg.payload() }
+		{}
+
+		final_frame_flag_t final_flag() const noexcept
+		{ return m_frame->m_final_flag; }
+
+		opcode_t opcode() const noexcept { return m_frame->m_opcode; }
+
+		//! The payload of the message.
+		string_view_t
+		payload() const noexcept
+		{
+			return string_view_t{
+				m_frame->data() + m_frame->m_header_size,
+				m_frame->size() - m_frame->m_header_size };
+		}
+
+		//! The size of the whole frame (with the header).
+		std::size_t frame_size() const noexcept { return m_frame->size(); }
+
+		//! The frame as a writable item (without copying).
+		writable_item_t
+		frame_as_writable_item() const
+		{
+			return writable_item_t{ m_frame };
+		}
+
+		//! The payload as a writable item (without copying).
+		writable_item_t
+		payload_as_writable_item() const
+		{
+			return writable_item_t{ impl::prepared_payload_t{ m_frame } };
+		}
+
+	private:
+		static std::shared_ptr< const impl::prepared_frame_t >
+		make_frame(
+			final_frame_flag_t final_flag,
+			opcode_t opcode,
+			string_view_t payload )
+		{
+			if( opcode_t::connection_close_frame == opcode )
+				throw exception_t{ "close frame can't be a prepared message" };
+
+			return std::make_shared< const impl::prepared_frame_t >(
+					final_flag, opcode, payload );
+		}
+
+		std::shared_ptr< const impl::prepared_frame_t > m_frame;
+};
+
+//
+// outgoing_overflow_policy_t
+//
+
+//! What to do with a prepared message if a connection has too much
+//! data waiting to be sent.
+/*!
+	@since v.0.6.18
+*/
+enum class outgoing_overflow_policy_t
+{
+	//! The message isn't sent to the connection.
+	drop_message,
+	//! The connection is closed without waiting for outgoing data.
+	/*!
+		The message handler gets a close frame with
+		status_code_t::going_away.
+	*/
+	close_connection
+};
+
+//
+// outgoing_queue_limit_t
+//
+
+//! A limit of outgoing data of a connection for prepared messages.
+/*!
+	Only data waiting in the queue of a connection is counted (data that
+	is being written to the socket isn't).
+
+	A message is always accepted if the queue is empty (even if the
+	message is bigger than the limit), so a big broadcast isn't lost
+	for connections that aren't slow.
+
+	@since v.0.6.18
+*/
+struct outgoing_queue_limit_t
+{
+	//! Max size of data waiting to be sent.
+	std::size_t m_max_queued_bytes{ std::numeric_limits< std::size_t >::max() };
+
+	//! What to do if a message doesn't fit into the limit.
+	outgoing_overflow_policy_t m_policy{ outgoing_overflow_policy_t::drop_message };
+};
+
+} /* namespace basic */
+
+} /* namespace websocket */
+
+} /* namespace restinio */
@@ -119,6 +119,19 @@ class ws_t
 				if( restinio::writable_item_type_t::trivial_write_operation ==
 					payload.write_type() )
 				{
+					if( m_ws_connection_handle->compresses_data_frames() &&
+						!impl::is_control_frame( opcode ) )
+					{
+						// The header depends on the result of compression,
+						// so it's made by the connection.
+						m_ws_connection_handle->write_data_frame(
+							final_flag,
+							opcode,
+							std::move( payload ),
+							std::move( wscb ) );
+						return;
+					}
+
 					writable_items_container_t bufs;
 					bufs.reserve( 2 );
 
@@ -177,19 +190,197 @@ class ws_t
 				std::move( wscb ) );
 		}
 
+		//! Send a prepared message.
+		/*!
+			The frame of the message isn't copied. The message is sent only
+			if it fits into the limit of outgoing data of the connection
+			(see outgoing_queue_limit()).
+
+			@since v.0.6.18
+		*/
+		void
+		send_message( const prepared_message_t & msg )
+		{
+			if( m_ws_connection_handle )
+			{
+				m_ws_connection_handle->write_prepared_message(
+						msg, m_outgoing_queue_limit );
+			}
+			else
+			{
+				throw exception_t{ "websocket is not available" };
+			}
+		}
+
+		//! Get the limit of outgoing data for prepared messages.
+		/*!
+			@since v.0.6.18
+		*/
+		const outgoing_queue_limit_t &
+		outgoing_queue_limit() const noexcept
+		{
+			return m_outgoing_queue_limit;
+		}
+
+		//! Set the limit of outgoing data for prepared messages.
+		/*!
+			There is no limit by default.
+
+			Usage example:
+			\code
+			// Drop broadcast messages for a slow consumer.
+			ws->outgoing_queue_limit(
+				256u * 1024u,
+				rws::outgoing_overflow_policy_t::drop_message );
+			\endcode
+
+			@since v.0.6.18
+		*/
+		void
+		outgoing_queue_limit(
+			std::size_t max_queued_bytes,
+			outgoing_overflow_policy_t policy ) noexcept
+		{
+			m_outgoing_queue_limit.m_max_queued_bytes = max_queued_bytes;
+			m_outgoing_queue_limit.m_policy = policy;
+		}
+
+		//! Pass payloads of big data frames to the message handler by chunks.
+		/*!
+			If a payload of a data frame is bigger than @a max_chunk_size
+			then the frame isn't collected in memory. Instead the payload
+			is read by chunks of @a max_chunk_size bytes (the last chunk
+			can be smaller) and the message handler gets every chunk as
+			soon as it is read. Chunks are unmasked, decompressed (if
+			permessage-deflate is used) and validated (UTF-8 of text
+			messages is checked incrementally, a chunk can end in the
+			middle of a code point).
+
+			A chunk of a compressed frame is decompressed into pieces that
+			are not bigger than @a max_chunk_size and every piece is passed
+			to the handler as a separate chunk. So the memory used for
+			a streamed frame is bounded by @a max_chunk_size regardless of
+			the compression ratio. permessage_deflate_params_t's
+			max_decompressed_message_size() isn't applied to streamed
+			frames.
+
+			Chunks look like fragments of the message:
+			only the first chunk of a frame has the opcode of the frame
+			(next chunks have opcode_t::continuation_frame) and only the
+			last chunk of the final frame has the final flag. So handlers
+			that already support fragmented messages work without changes.
+
+			Control frames and data frames that are not bigger than
+			@a max_chunk_size are passed as usual.
+
+			Zero @a max_chunk_size disables streaming (it is the default).
+
+			Usage example:
+			\code
+			auto ws = rws::upgrade< traits_t >(
+				*req,
+				rws::activation_t::delayed,
+				[file]( rws::ws_handle_t, rws::message_handle_t m ) {
+					file->write( m->payload() );
+					if( m->is_final() )
+						file->close();
+				} );
+
+			// Frames bigger than 64 KiB are streamed.
+			ws->payload_streaming( 64u * 1024u );
+			activate( *ws );
+			\endcode
+
+			\note
+			The setting is applied to frames whose headers are read after
+			it, so it should be set before activate() to be applied to
+			all frames.
+
+			@since v.0.6.18
+		*/
+		void
+		payload_streaming( std::size_t max_chunk_size )
+		{
+			if( m_ws_connection_handle )
+			{
+				m_ws_connection_handle->payload_streaming( max_chunk_size );
+			}
+			else
+			{
+				throw exception_t{ "websocket is not available" };
+			}
+		}
+
 		//! Get the remote endpoint of the underlying connection.
 		const endpoint_t & remote_endpoint() const noexcept { return m_remote_endpoint; }
 
+		template< typename Ws_Handles >
+		friend std::size_t
+		broadcast( const Ws_Handles & handles, const prepared_message_t & msg );
+
 	private:
 		impl::ws_connection_handle_t m_ws_connection_handle;
 
 		//! Remote endpoint for this ws-connection.
 		const endpoint_t m_remote_endpoint;
+
+		//! The limit of outgoing data for prepared messages.
+		/*!
+			@since v.0.6.18
+		*/
+		outgoing_queue_limit_t m_outgoing_queue_limit;
 };
 
 //! Alias for ws_t handle.
 using ws_handle_t = std::shared_ptr< ws_t >;
 
+//
+// broadcast()
+//
+
+//! Send a prepared message to many websockets.
+/*!
+	The frame is serialized once (by prepared_message_t) and every
+	connection gets a reference to the same buffer. Limits of outgoing data
+	of every connection are applied (see ws_t::outgoing_queue_limit()).
+
+	Empty handles and closed websockets are skipped.
+
+	Usage example:
+	\code
+	std::vector< rws::ws_handle_t > subscribers = ...;
+
+	rws::broadcast(
+		subscribers,
+		rws::prepared_message_t{
+			rws::final_frame, rws::opcode_t::text_frame, market_data_json } );
+	\endcode
+
+	\return the number of websockets the message was passed to.
+
+	@since v.0.6.18
+*/
+template< typename Ws_Handles >
+std::size_t
+broadcast(
+	//! A container of ws_handle_t.
+	const Ws_Handles & handles,
+	//! The message.
+	const prepared_message_t & msg )
+{
+	std::size_t result = 0u;
+
+	for( const ws_handle_t & ws : handles )
+		if( ws && ws->m_ws_connection_handle )
+		{
+			ws->m_ws_connection_handle->write_prepared_message(
+					msg, ws->m_outgoing_queue_limit );
+			++result;
+		}
+
+	return result;
+}
+
 //
 // activation_t
 //
@@ -203,16 +394,44 @@ enum class activation_t
 	delayed
 };
 
+namespace impl
+{
+
 //
-// upgrade()
+// make_sec_websocket_accept_field_value()
 //
 
-//! Upgrade http-connection of a current request to a websocket connection.
+//! Make the value of Sec-WebSocket-Accept field for an upgrade request.
+/*!
+	@since v.0.6.18
+*/
+inline std::string
+make_sec_websocket_accept_field_value( const http_request_header_t & header )
+{
+	const char * websocket_accept_field_suffix = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+	const auto ws_key =
+		header.get_field( restinio::http_field::sec_websocket_key ) +
+		websocket_accept_field_suffix;
+
+	auto digest = restinio::utils::sha1::make_digest( ws_key );
+
+	return utils::base64::encode( utils::sha1::to_string( digest ) );
+}
+
+//
+// upgrade_with_compression()
+//
+
+//! Upgrade http-connection of a current request to a websocket connection
+//! that can compress messages.
+/*!
+	@since v.0.6.18
+*/
 template <
 		typename Traits,
 		typename WS_Message_Handler >
 ws_handle_t
-upgrade(
+upgrade_with_compression(
 	//! Upgrade request.
 	generic_request_type_from_traits_t<Traits> & req,
 	//! Activation policy.
@@ -220,7 +439,9 @@ upgrade(
 	//! Response header fields.
 	http_header_fields_t upgrade_response_header_fields,
 	//! Message handler.
-	WS_Message_Handler ws_message_handler )
+	WS_Message_Handler ws_message_handler,
+	//! Compression of messages (can be nullptr).
+	ws_compression_unique_ptr_t compression )
 {
 	// TODO: check if upgrade request?
 
@@ -256,7 +477,8 @@ upgrade(
 			std::move( upgrade_internals.m_settings ),
 			std::move( upgrade_internals.m_socket ),
 			std::move( upgrade_internals.m_lifetime_monitor ),
-			std::move( ws_message_handler ) );
+			std::move( ws_message_handler ),
+			std::move( compression ) );
 
 	writable_items_container_t upgrade_response_bufs;
 	{
@@ -289,6 +511,35 @@ upgrade(
 	return result;
 }
 
+} /* namespace impl */
+
+//
+// upgrade()
+//
+
+//! Upgrade http-connection of a current request to a websocket connection.
+template <
+		typename Traits,
+		typename WS_Message_Handler >
+ws_handle_t
+upgrade(
+	//! Upgrade request.
+	generic_request_type_from_traits_t<Traits> & req,
+	//! Activation policy.
+	activation_t activation_flag,
+	//! Response header fields.
+	http_header_fields_t upgrade_response_header_fields,
+	//! Message handler.
+	WS_Message_Handler ws_message_handler )
+{
+	return impl::upgrade_with_compression< Traits, WS_Message_Handler >(
+			req,
+			activation_flag,
+			std::move( upgrade_response_header_fields ),
+			std::move( ws_message_handler ),
+			impl::ws_compression_unique_ptr_t{} );
+}
+
 template <
 		typename Traits,
 		typename WS_Message_Handler >
@@ -349,20 +600,10 @@ upgrade(
 	activation_t activation_flag,
 	WS_Message_Handler ws_message_handler )
 {
-	const char * websocket_accept_field_suffix = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
-	const auto ws_key =
-		req.header().get_field( restinio::http_field::sec_websocket_key ) +
-		websocket_accept_field_suffix;
-
-	auto digest = restinio::utils::sha1::make_digest( ws_key );
-
-	std::string sec_websocket_accept_field_value = utils::base64::encode(
-		utils::sha1::to_string( digest ) );
-
 	http_header_fields_t upgrade_response_header_fields;
 	upgrade_response_header_fields.set_field(
 		http_field::sec_websocket_accept,
-		std::move( sec_websocket_accept_field_value ) );
+		impl::make_sec_websocket_accept_field_value( req.header() ) );
 
 	return
 		upgrade< Traits, WS_Message_Handler >(
@@ -0,0 +1,434 @@
+/*
+	restinio
+*/
+
+/*!
+	Timer factory implementation based on a hashed timing wheel.
+
+	@since v.0.6.18
+*/
+
+#pragma once
+
+#include <cassert>
+#include <memory>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#include <restinio/asio_include.hpp>
+#include <restinio/exception.hpp>
+#include <restinio/null_mutex.hpp>
+
+#include <restinio/utils/suppress_exceptions.hpp>
+
+#include <restinio/timer_common.hpp>
+#include <restinio/compiler_features.hpp>
+
+namespace restinio
+{
+
+//
+// basic_wheel_timer_manager_t
+//
+
+//! Timer factory implementation using a hashed timing wheel.
+/*!
+ * Unlike asio_timer_manager_t this manager doesn't create an asio timer
+ * for every connection. All timer guards created by the manager are
+ * stored in a single timing wheel (an array of slots each holding
+ * an intrusive doubly-linked list of guards). The wheel is driven by one
+ * asio timer that fires every `check_period / ticks_per_period`.
+ *
+ * Scheduling and cancellation of a guard are O(1) operations: a guard is
+ * just linked to (or unlinked from) a list in the appropriate slot.
+ *
+ * Because all guards of a manager use the same check period the wheel
+ * doesn't need several levels: a guard scheduled at tick T is always
+ * fired at tick T+ticks_per_period and the wheel has ticks_per_period+1
+ * slots.
+ *
+ * A check_timeout() for a connection will be invoked not earlier than
+ * `check_period - check_period/ticks_per_period` and not later than
+ * `check_period` after the scheduling.
+ *
+ * Usage example:
+ * \code
+ * struct my_traits : public restinio::default_traits_t {
+ * 	using timer_manager_t = restinio::wheel_timer_manager_t;
+ * };
+ * ...
+ * restinio::run(
+ * 	restinio::on_thread_pool< my_traits >( 4 )
+ * 		.timer_manager( std::chrono::seconds{ 1 }, 8u )
+ * 		...
+ * \endcode
+ *
+ * @tparam Mutex type of mutex to be used for protection of the wheel.
+ * std::mutex should be used if io_context is run on several threads.
+ * null_mutex_t can be used for single-threaded servers.
+ *
+ * @since v.0.6.18
+ */
+template< typename Mutex >
+class basic_wheel_timer_manager_t final
+	:	public std::enable_shared_from_this< basic_wheel_timer_manager_t< Mutex > >
+{
+	public:
+		//! Type of mutex used by that manager.
+		using mutex_t = Mutex;
+
+		//! Default number of wheel ticks per check period.
+		static constexpr std::size_t default_ticks_per_period = 4u;
+
+		basic_wheel_timer_manager_t(
+			asio_ns::io_context & io_context,
+			std::chrono::steady_clock::duration check_period,
+			std::size_t ticks_per_period = default_ticks_per_period )
+			:	m_tick_strand{ io_context.get_executor() }
+			,	m_tick_timer{ io_context }
+			,	m_tick_period{ make_tick_period( check_period, ticks_per_period ) }
+			,	m_ticks_per_period{ ticks_per_period }
+			,	m_slots( ticks_per_period + 1u, nullptr )
+		{}
+
+		basic_wheel_timer_manager_t( const basic_wheel_timer_manager_t & ) = delete;
+		basic_wheel_timer_manager_t( basic_wheel_timer_manager_t && ) = delete;
+
+		//! Timer guard for async operations.
+		/*!
+		 * A guard is an item of an intrusive list. It can be moved only
+		 * while it isn't scheduled.
+		 */
+		class timer_guard_t final
+		{
+			friend class basic_wheel_timer_manager_t;
+
+			public:
+				timer_guard_t(
+					std::shared_ptr< basic_wheel_timer_manager_t > manager ) noexcept
+					:	m_manager{ std::move( manager ) }
+				{}
+
+				timer_guard_t( timer_guard_t && other ) noexcept
+					:	m_manager{ std::move( other.m_manager ) }
+				{
+					// Only an unscheduled guard can be moved.
+					assert( !other.m_linked );
+				}
+
+				timer_guard_t( const timer_guard_t & ) = delete;
+				timer_guard_t & operator=( const timer_guard_t & ) = delete;
+				timer_guard_t & operator=( timer_guard_t && ) = delete;
+
+				~timer_guard_t()
+				{
+					cancel();
+				}
+
+				//! Schedule timeouts check invocation.
+				/*!
+				 * If the guard is already scheduled it will be rescheduled.
+				 */
+				void
+				schedule( tcp_connection_ctx_weak_handle_t weak_handle )
+				{
+					m_manager->schedule_guard( *this, std::move( weak_handle ) );
+				}
+
+				//! Cancel timeout guard if any.
+				void
+				cancel() noexcept
+				{
+					if( m_manager )
+						m_manager->cancel_guard( *this );
+				}
+
+			private:
+				//! Manager the guard belongs to.
+				std::shared_ptr< basic_wheel_timer_manager_t > m_manager;
+
+				//! A handle for connection to be checked.
+				tcp_connection_ctx_weak_handle_t m_weak_handle;
+
+				//! @name Intrusive list links.
+				//! Are protected by manager's mutex.
+				//! \{
+				timer_guard_t * m_prev{ nullptr };
+				timer_guard_t * m_next{ nullptr };
+				std::size_t m_slot{ 0u };
+				bool m_linked{ false };
+				//! \}
+		};
+
+		//! Create guard for connection.
+		timer_guard_t
+		create_timer_guard()
+		{
+			return timer_guard_t{ this->shared_from_this() };
+		}
+
+		//! @name Start/stop timer manager.
+		///@{
+		void
+		start()
+		{
+			asio_ns::dispatch(
+				m_tick_strand,
+				[self = this->shared_from_this()] {
+					if( !self->m_running )
+					{
+						self->m_running = true;
+						self->m_next_tick_at =
+							std::chrono::steady_clock::now() + self->m_tick_period;
+						self->schedule_next_tick();
+					}
+				} );
+		}
+
+		void
+		stop()
+		{
+			asio_ns::dispatch(
+				m_tick_strand,
+				[self = this->shared_from_this()] {
+					self->m_running = false;
+					restinio::utils::suppress_exceptions_quietly(
+							[&]{ self->m_tick_timer.cancel(); } );
+				} );
+		}
+		///@}
+
+		struct factory_t final
+		{
+			//! Check period for timer events.
+			const std::chrono::steady_clock::duration
+				m_check_period{ std::chrono::seconds{ 1 } };
+
+			//! The number of wheel ticks per one check period.
+			const std::size_t m_ticks_per_period{ default_ticks_per_period };
+
+			factory_t() noexcept {}
+			factory_t( std::chrono::steady_clock::duration check_period ) noexcept
+				:	m_check_period{ check_period }
+			{}
+			factory_t(
+				std::chrono::steady_clock::duration check_period,
+				std::size_t ticks_per_period ) noexcept
+				:	m_check_period{ check_period }
+				,	m_ticks_per_period{ ticks_per_period }
+			{}
+
+			//! Create an instance of timer manager.
+			auto
+			create( asio_ns::io_context & io_context ) const
+			{
+				return std::make_shared< basic_wheel_timer_manager_t >(
+						io_context,
+						m_check_period,
+						m_ticks_per_period );
+			}
+		};
+
+	private:
+		//! Strand for serializing access to the tick timer.
+		asio_ns::strand< default_asio_executor > m_tick_strand;
+
+		//! The only timer that drives the wheel.
+		asio_ns::steady_timer m_tick_timer;
+
+		//! Duration of one tick.
+		const std::chrono::steady_clock::duration m_tick_period;
+
+		//! The number of ticks for one check period.
+		const std::size_t m_ticks_per_period;
+
+		//! Time point for the next tick.
+		/*!
+		 * Is used only on m_tick_strand.
+		 */
+		std::chrono::steady_clock::time_point m_next_tick_at;
+
+		//! Is the wheel running?
+		/*!
+		 * Is used only on m_tick_strand.
+		 */
+		bool m_running{ false };
+
+		//! Temporary storage for handles to be checked on the current tick.
+		/*!
+		 * Is used only on m_tick_strand. Kept as a member to avoid
+		 * allocations on every tick.
+		 */
+		std::vector< tcp_connection_ctx_weak_handle_t > m_expired;
+
+		//! Lock for the wheel.
+		mutex_t m_lock;
+
+		//! Heads of guard lists for every slot.
+		std::vector< timer_guard_t * > m_slots;
+
+		//! Index of the current slot.
+		std::size_t m_current_slot{ 0u };
+
+		static std::chrono::steady_clock::duration
+		make_tick_period(
+			std::chrono::steady_clock::duration check_period,
+			std::size_t ticks_per_period )
+		{
+			if( 0u == ticks_per_period )
+				throw exception_t{ "ticks_per_period can't be zero" };
+
+			const auto tick_period = check_period /
+					static_cast< std::chrono::steady_clock::duration::rep >(
+							ticks_per_period );
+			if( tick_period <= std::chrono::steady_clock::duration::zero() )
+				throw exception_t{ "check_period is too small for ticks_per_period" };
+
+			return tick_period;
+		}
+
+		//! Link a guard to a slot.
+		/*!
+		 * @attention
+		 * Must be called with m_lock acquired.
+		 */
+		void
+		link( timer_guard_t & guard, std::size_t slot ) noexcept
+		{
+			guard.m_slot = slot;
+			guard.m_prev = nullptr;
+			guard.m_next = m_slots[ slot ];
+			if( guard.m_next )
+				guard.m_next->m_prev = &guard;
+			m_slots[ slot ] = &guard;
+			guard.m_linked = true;
+		}
+
+		//! Unlink a guard from its slot.
+		/*!
+		 * @attention
+		 * Must be called with m_lock acquired.
+		 */
+		void
+		unlink( timer_guard_t & guard ) noexcept
+		{
+			if( guard.m_prev )
+				guard.m_prev->m_next = guard.m_next;
+			else
+				m_slots[ guard.m_slot ] = guard.m_next;
+
+			if( guard.m_next )
+				guard.m_next->m_prev = guard.m_prev;
+
+			guard.m_prev = guard.m_next = nullptr;
+			guard.m_linked = false;
+		}
+
+		void
+		schedule_guard(
+			timer_guard_t & guard,
+			tcp_connection_ctx_weak_handle_t weak_handle )
+		{
+			std::lock_guard< mutex_t > lock{ m_lock };
+
+			if( guard.m_linked )
+				unlink( guard );
+
+			guard.m_weak_handle = std::move( weak_handle );
+			link( guard, ( m_current_slot + m_ticks_per_period ) % m_slots.size() );
+		}
+
+		void
+		cancel_guard( timer_guard_t & guard ) noexcept
+		{
+			std::lock_guard< mutex_t > lock{ m_lock };
+
+			if( guard.m_linked )
+			{
+				unlink( guard );
+				guard.m_weak_handle.reset();
+			}
+		}
+
+		void
+		schedule_next_tick()
+		{
+			m_tick_timer.expires_at( m_next_tick_at );
+			m_tick_timer.async_wait(
+				asio_ns::bind_executor(
+					m_tick_strand,
+					[self = this->shared_from_this()]( const auto & ec ) {
+						if( !ec && self->m_running )
+							self->on_tick();
+					} ) );
+		}
+
+		//! Handle the next tick of the wheel.
+		void
+		on_tick()
+		{
+			{
+				std::lock_guard< mutex_t > lock{ m_lock };
+
+				m_current_slot = ( m_current_slot + 1u ) % m_slots.size();
+
+				auto * guard = m_slots[ m_current_slot ];
+				while( guard )
+				{
+					auto * next = guard->m_next;
+
+					m_expired.push_back( std::move( guard->m_weak_handle ) );
+					guard->m_prev = guard->m_next = nullptr;
+					guard->m_linked = false;
+
+					guard = next;
+				}
+				m_slots[ m_current_slot ] = nullptr;
+			}
+
+			for( auto & weak_handle : m_expired )
+			{
+				if( auto h = weak_handle.lock() )
+				{
+					restinio::utils::suppress_exceptions_quietly(
+							[&]{ h->check_timeout( h ); } );
+				}
+			}
+			m_expired.clear();
+
+			// Ticks are counted from the start time to avoid a drift.
+			// But if the tick handler is late for more than one tick
+			// there is no sense to fire all the missed ticks immediately.
+			m_next_tick_at += m_tick_period;
+			const auto now = std::chrono::steady_clock::now();
+			if( m_next_tick_at < now )
+				m_next_tick_at = now;
+
+			schedule_next_tick();
+		}
+};
+
+//
+// wheel_timer_manager_t
+//
+
+//! Timing wheel timer manager for servers that run io_context on
+//! several threads.
+/*!
+ * @since v.0.6.18
+ */
+using wheel_timer_manager_t = basic_wheel_timer_manager_t< std::mutex >;
+
+//
+// single_thread_wheel_timer_manager_t
+//
+
+//! Timing wheel timer manager for single-threaded servers.
+/*!
+ * @since v.0.6.18
+ */
+using single_thread_wheel_timer_manager_t =
+	basic_wheel_timer_manager_t< null_mutex_t >;
+
+} /* namespace restinio */
@@ -22,6 +22,10 @@ MxxRu::Cpp::composite_target {
 	required_prj( "test/buffers/prj.ut.rb" )
 	required_prj( "test/response_coordinator/prj.ut.rb" )
 	required_prj( "test/write_group_output_ctx/prj.ut.rb" )
+	required_prj( "test/wheel_timer_manager/prj.ut.rb" )
+	required_prj( "test/read_buffer_pool/prj.ut.rb" )
+	required_prj( "test/request_arena/prj.ut.rb" )
+	required_prj( "test/simd_http_parser/prj.ut.rb" )
 	required_prj( "test/from_string/prj.ut.rb" )
 	required_prj( "test/uri_helpers/prj.ut.rb" )
 
@@ -40,8 +44,12 @@ MxxRu::Cpp::composite_target {
 	required_prj( "test/handle_requests/build_tests.rb" )
 
 	required_prj( "test/run_on_thread_pool/prj.rb" )
+	required_prj( "test/run_sharded/prj.ut.rb" )
 
 	required_prj( "test/http_pipelining/sequence/prj.ut.rb" )
+	if 'unix' == toolset.tag( 'target_os' ) && ENV.has_key?( 'RESTINIO_ASIO_IO_URING' )
+		required_prj( "test/http_pipelining/sequence_io_uring/prj.ut.rb" )
+	end
 	required_prj( "test/http_pipelining/timeouts/prj.ut.rb" )
 
 	required_prj( "test/sendfile/prj.ut.rb" )
@@ -62,6 +70,7 @@ MxxRu::Cpp::composite_target {
 	# ================================================================
 	# Benches for implementation tuning.
 	required_prj( "test/to_lower_bench/prj.rb" )
+	required_prj( "test/string_to_field_bench/prj.rb" )
 
 	# ================================================================
 	# Websocket tests
@@ -71,6 +80,10 @@ MxxRu::Cpp::composite_target {
 	required_prj( "test/websocket/validators/prj.ut.rb" )
 	required_prj( "test/websocket/ws_connection/prj.ut.rb" )
 	required_prj( "test/websocket/notificators/prj.ut.rb" )
+	required_prj( "test/websocket/permessage_deflate/prj.ut.rb" )
+	required_prj( "test/websocket/broadcast/prj.ut.rb" )
+	required_prj( "test/websocket/write_batching/prj.ut.rb" )
+	required_prj( "test/websocket/payload_streaming/prj.ut.rb" )
 
 	# ================================================================
 	# File upload support.
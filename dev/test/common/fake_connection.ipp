@@ -1,3 +1,5 @@
+#pragma once
+
 struct fake_connection_t : public restinio::impl::connection_base_t
 {
 	fake_connection_t() : restinio::impl::connection_base_t{ 0 }
@@ -0,0 +1,267 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for streamed request bodies.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+
+#include <mutex>
+#include <thread>
+
+struct test_traits_t : public restinio::default_traits_t {
+	using logger_t = utest_logger_t;
+};
+
+//
+// collecting_handler_t
+//
+
+//! Collects the body and (optionally) pauses reading after every part.
+class collecting_handler_t final
+	:	public restinio::request_body_stream_handler_t
+{
+	public:
+		collecting_handler_t(
+			restinio::request_body_stream_control_t control,
+			bool pause_after_every_part,
+			std::vector< std::thread > & resumers,
+			std::mutex & resumers_lock )
+			:	m_control{ std::move( control ) }
+			,	m_pause_after_every_part{ pause_after_every_part }
+			,	m_resumers{ resumers }
+			,	m_resumers_lock{ resumers_lock }
+		{}
+
+		void
+		on_chunk_started( const restinio::chunk_info_t & chunk ) override
+		{
+			m_chunks.push_back( chunk );
+		}
+
+		restinio::body_stream_action_t
+		on_body_part( restinio::string_view_t data ) override
+		{
+			m_body.append( data.data(), data.size() );
+			++m_parts;
+
+			if( m_body.find( "ABORT" ) != std::string::npos )
+				return restinio::body_stream_action_t::abort;
+
+			if( !m_pause_after_every_part )
+				return restinio::body_stream_action_t::continue_reading;
+
+			// Reading will be resumed from another thread.
+			std::lock_guard< std::mutex > lock{ m_resumers_lock };
+			m_resumers.emplace_back( [control = m_control] {
+					std::this_thread::sleep_for( std::chrono::milliseconds( 5 ) );
+					control.resume_reading();
+				} );
+
+			return restinio::body_stream_action_t::pause_reading;
+		}
+
+		const std::string & body() const noexcept { return m_body; }
+		std::size_t parts() const noexcept { return m_parts; }
+		const std::vector< restinio::chunk_info_t > & chunks() const noexcept
+		{ return m_chunks; }
+
+	private:
+		const restinio::request_body_stream_control_t m_control;
+		const bool m_pause_after_every_part;
+		std::vector< std::thread > & m_resumers;
+		std::mutex & m_resumers_lock;
+
+		std::string m_body;
+		std::size_t m_parts{ 0u };
+		std::vector< restinio::chunk_info_t > m_chunks;
+};
+
+//
+// test_server_t
+//
+
+class test_server_t
+{
+	public:
+		using http_server_t = restinio::http_server_t< test_traits_t >;
+
+		explicit test_server_t( std::size_t max_body_size )
+			:	m_server{
+					restinio::own_io_context(),
+					[this, max_body_size]( auto & settings ) {
+						settings
+							.port( utest_default_port() )
+							.address( "127.0.0.1" )
+							.incoming_http_msg_limits(
+								restinio::incoming_http_msg_limits_t{}
+									.max_body_size( max_body_size ) )
+							.request_body_stream_handler_factory(
+								[this]( const restinio::http_request_header_t & h,
+									restinio::request_body_stream_control_t control )
+								{
+									return make_handler( h, std::move( control ) );
+								} )
+							.request_handler( []( auto req ) {
+								return handle_request( std::move( req ) );
+							} );
+					} }
+			,	m_other_thread{ m_server }
+		{
+			m_other_thread.run();
+		}
+
+		~test_server_t()
+		{
+			m_other_thread.stop_and_join();
+
+			for( auto & t : m_resumers )
+				t.join();
+		}
+
+	private:
+		http_server_t m_server;
+		other_work_thread_for_server_t< http_server_t > m_other_thread;
+
+		std::mutex m_resumers_lock;
+		std::vector< std::thread > m_resumers;
+
+		restinio::request_body_stream_handler_unique_ptr_t
+		make_handler(
+			const restinio::http_request_header_t & h,
+			restinio::request_body_stream_control_t control )
+		{
+			restinio::request_body_stream_handler_unique_ptr_t result;
+
+			// Only POST requests to /stream... are streamed.
+			if( restinio::http_method_post() == h.method() &&
+				0u == h.path().find( "/stream" ) )
+			{
+				result = std::make_unique< collecting_handler_t >(
+						std::move( control ),
+						h.path() == "/stream/paused",
+						m_resumers,
+						m_resumers_lock );
+			}
+
+			return result;
+		}
+
+		static restinio::request_handling_status_t
+		handle_request( restinio::request_handle_t req )
+		{
+			std::string reply;
+
+			if( auto * handler = dynamic_cast< collecting_handler_t * >(
+					req->body_stream_handler() ) )
+			{
+				reply = "streamed:" + std::to_string( req->body().size() ) +
+						":" + handler->body();
+
+				if( auto * chunked = req->chunked_input_info() )
+				{
+					REQUIRE( chunked->chunk_count() == handler->chunks().size() );
+					for( const auto & ch : handler->chunks() )
+						reply += ":" + ch.make_string_view_nonchecked(
+								handler->body() ).to_string();
+				}
+			}
+			else
+				reply = "collected:" + req->body();
+
+			req->create_response()
+				.append_header( "Content-Type", "text/plain; charset=utf-8" )
+				.set_body( std::move( reply ) )
+				.done();
+
+			return restinio::request_accepted();
+		}
+};
+
+std::string
+make_request( const std::string & path, const std::string & body )
+{
+	return
+		"POST " + path + " HTTP/1.1\r\n"
+		"Host: localhost\r\n"
+		"Content-Length: " + std::to_string( body.size() ) + "\r\n"
+		"Connection: close\r\n"
+		"\r\n" +
+		body;
+}
+
+TEST_CASE( "Streamed body" , "[body_stream][content_length]" )
+{
+	test_server_t server{ 16u };
+
+	std::string response;
+
+	// The body is longer than max_body_size but it isn't collected.
+	const std::string body = "0123456789abcdefghijklmnopqrstuvwxyz";
+	REQUIRE_NOTHROW( response = do_request( make_request( "/stream", body ) ) );
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "streamed:0:" + body ) );
+
+	// Requests without streaming handler are limited as usual.
+	REQUIRE_NOTHROW( response = do_request( make_request( "/collect", "0123" ) ) );
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "collected:0123" ) );
+
+	REQUIRE_THROWS( do_request( make_request( "/collect", body ) ) );
+}
+
+TEST_CASE( "Streamed chunked body" , "[body_stream][chunked]" )
+{
+	test_server_t server{ 16u };
+
+	std::string response;
+
+	REQUIRE_NOTHROW( response = do_request(
+			"POST /stream HTTP/1.1\r\n"
+			"Host: localhost\r\n"
+			"Transfer-Encoding: chunked\r\n"
+			"Connection: close\r\n"
+			"\r\n"
+			"5\r\n"
+			"Hello\r\n"
+			"1\r\n"
+			",\r\n"
+			"6\r\n"
+			" World\r\n"
+			"0\r\n"
+			"\r\n" ) );
+
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith(
+			"streamed:0:Hello, World:Hello:,: World" ) );
+}
+
+TEST_CASE( "Paused reading of streamed body" , "[body_stream][pause]" )
+{
+	test_server_t server{ 16u };
+
+	std::string body;
+	for( std::size_t i = 0u; i != 64u * 1024u; ++i )
+		body += static_cast< char >( 'a' + i % 26u );
+
+	std::string response;
+	REQUIRE_NOTHROW( response = do_request(
+			make_request( "/stream/paused", body ) ) );
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "streamed:0:" + body ) );
+}
+
+TEST_CASE( "Aborted streamed body" , "[body_stream][abort]" )
+{
+	test_server_t server{ 16u };
+
+	std::string response;
+	REQUIRE_THROWS( do_request( make_request( "/stream", "0123ABORT456" ) ) );
+
+	// The server is still alive.
+	REQUIRE_NOTHROW( response = do_request( make_request( "/stream", "0123" ) ) );
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "streamed:0:0123" ) );
+}
@@ -6,7 +6,9 @@ MxxRu::Cpp::composite_target {
 	%w[
 		chunked_output
 		echo_body
+		body_stream
 		method
+		date_field
 		notificators
 		output_and_buffers
 		remote_endpoint
@@ -26,4 +28,8 @@ MxxRu::Cpp::composite_target {
 	].each do |name|
 		required_prj "test/handle_requests/#{name}/prj.ut.rb"
 	end
+
+	if 'unix' == toolset.tag( 'target_os' ) && ENV.has_key?( 'RESTINIO_ASIO_IO_URING' )
+		required_prj "test/handle_requests/echo_body_io_uring/prj.ut.rb"
+	end
 }
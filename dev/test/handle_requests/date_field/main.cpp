@@ -0,0 +1,88 @@
+/*
+	restinio
+*/
+
+/*!
+	Test automatic Date field.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+
+TEST_CASE( "Date field in every response" , "[date_field]" )
+{
+	using http_server_t =
+		restinio::http_server_t<
+			restinio::traits_t<
+				restinio::asio_timer_manager_t,
+				utest_logger_t > >;
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.add_date_field( true )
+				.request_handler(
+					[]( auto req ){
+						if( "/explicit" == req->header().path() )
+							req->create_response()
+								.append_header_date_field(
+									std::chrono::system_clock::from_time_t( 784111777 ) )
+								.set_body( "explicit" )
+								.done();
+						else if( "/now" == req->header().path() )
+						{
+							auto resp = req->create_response();
+							resp.append_header_date_field();
+							// The field is visible, unlike the one that is
+							// added by add_date_field().
+							resp.set_body(
+									resp.header().has_field( restinio::http_field::date ) ?
+										"visible" : "invisible" );
+							resp.done();
+						}
+						else
+							req->create_response()
+								.set_body( "implicit" )
+								.done();
+
+						return restinio::request_accepted();
+					} );
+		} };
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	const auto make_request = []( const char * path ) {
+		return std::string{ "GET " } + path + " HTTP/1.1\r\n"
+			"Host: 127.0.0.1\r\n"
+			"Connection: close\r\n"
+			"\r\n";
+	};
+
+	std::string response;
+
+	REQUIRE_NOTHROW( response = do_request( make_request( "/" ) ) );
+	REQUIRE_THAT( response, Catch::Matchers::Contains( "\r\nDate: " ) );
+	REQUIRE_THAT( response, Catch::Matchers::Contains( " GMT\r\n" ) );
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "implicit" ) );
+
+	REQUIRE_NOTHROW( response = do_request( make_request( "/explicit" ) ) );
+	REQUIRE_THAT( response, Catch::Matchers::Contains(
+			"\r\nDate: Sun, 06 Nov 1994 08:49:37 GMT\r\n" ) );
+	REQUIRE( response.find( "Date: " ) == response.rfind( "Date: " ) );
+
+	REQUIRE_NOTHROW( response = do_request( make_request( "/now" ) ) );
+	REQUIRE_THAT( response, Catch::Matchers::Contains( "\r\nDate: " ) );
+	REQUIRE( response.find( "Date: " ) == response.rfind( "Date: " ) );
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( "visible" ) );
+	REQUIRE_THAT( response, !Catch::Matchers::EndsWith( "invisible" ) );
+
+	other_thread.stop_and_join();
+}
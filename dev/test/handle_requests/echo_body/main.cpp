@@ -161,3 +161,279 @@ TEST_CASE( "HTTP echo server (single_thread_connection_limiter)" , "[echo]" )
 	perform_test< single_thread_connection_limiter_traits_t >();
 }
 
+
+struct zero_copy_body_traits_t : public restinio::default_traits_t {
+	using logger_t = utest_logger_t;
+
+	static constexpr bool use_zero_copy_request_body = true;
+};
+
+TEST_CASE( "HTTP echo server (zero_copy_request_body)" , "[echo]" )
+{
+	perform_test< zero_copy_body_traits_t >();
+}
+
+struct request_arena_traits_t : public restinio::default_traits_t {
+	using logger_t = utest_logger_t;
+
+	static constexpr bool use_request_arena = true;
+};
+
+TEST_CASE( "HTTP echo server (request_arena)" , "[echo][request_arena]" )
+{
+	perform_test< request_arena_traits_t >();
+}
+
+//! Send a big body and get a response with info about its slices.
+template< typename Traits >
+std::string
+do_body_slices_request( const std::string & body )
+{
+	using http_server_t = restinio::http_server_t< Traits >;
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				// Small buffer to get the body in several slices.
+				.buffer_size( 64u )
+				.request_handler( []( auto req ) {
+					std::string body_from_slices;
+					for( const auto & slice : req->body_slices() )
+						body_from_slices.append( slice.data(), slice.size() );
+
+					req->create_response()
+						.append_header( "Content-Type", "text/plain; charset=utf-8" )
+						.append_header( "Slices-Count",
+							std::to_string( req->body_slices().slices_count() ) )
+						.append_header( "Same-Body",
+							body_from_slices == req->body() ? "yes" : "no" )
+						.append_header( "Body-Size",
+							std::to_string( req->body_size() ) )
+						.set_body( std::move( body_from_slices ) )
+						.done();
+					return restinio::request_accepted();
+				} );
+		}
+	};
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	std::string response;
+	REQUIRE_NOTHROW( response = do_request(
+			"POST /data HTTP/1.0\r\n"
+			"Content-Length: " + std::to_string( body.size() ) + "\r\n"
+			"Connection: close\r\n"
+			"\r\n" +
+			body ) );
+
+	other_thread.stop_and_join();
+
+	REQUIRE_THAT( response, Catch::Matchers::Contains( "Same-Body: yes" ) );
+	REQUIRE_THAT( response, Catch::Matchers::Contains(
+			"Body-Size: " + std::to_string( body.size() ) + "\r\n" ) );
+	REQUIRE_THAT( response, Catch::Matchers::EndsWith( body ) );
+
+	return response;
+}
+
+TEST_CASE( "Body slices (zero_copy_request_body)" , "[echo][body_slices]" )
+{
+	const auto response = do_body_slices_request< zero_copy_body_traits_t >(
+			std::string( 1000, 'z' ) );
+
+	REQUIRE_THAT( response,
+			!Catch::Matchers::Contains( "Slices-Count: 1\r\n" ) );
+}
+
+TEST_CASE( "Body slices (body as string)" , "[echo][body_slices]" )
+{
+	const auto response = do_body_slices_request< no_connection_limiter_traits_t >(
+			std::string( 1000, 'z' ) );
+
+	// The whole body is a single slice.
+	REQUIRE_THAT( response,
+			Catch::Matchers::Contains( "Slices-Count: 1\r\n" ) );
+}
+
+//! Logger that keeps trace messages of a server.
+struct trace_storage_t
+{
+	std::mutex m_lock;
+	std::vector< std::string > m_messages;
+
+	std::size_t
+	count( const std::string & what )
+	{
+		std::lock_guard< std::mutex > l{ m_lock };
+		return static_cast< std::size_t >( std::count_if(
+				m_messages.begin(), m_messages.end(),
+				[&]( const std::string & m ) {
+					return std::string::npos != m.find( what );
+				} ) );
+	}
+};
+
+class trace_logger_t
+{
+	public:
+		trace_logger_t( trace_storage_t & storage ) noexcept
+			:	m_storage{ storage }
+		{}
+
+		template< typename Message_Builder >
+		void
+		trace( Message_Builder && msg_builder )
+		{
+			auto msg = msg_builder();
+			std::lock_guard< std::mutex > l{ m_storage.m_lock };
+			m_storage.m_messages.push_back( std::move( msg ) );
+		}
+
+		template< typename Message_Builder >
+		void info( Message_Builder && ) {}
+
+		template< typename Message_Builder >
+		void warn( Message_Builder && ) {}
+
+		template< typename Message_Builder >
+		void error( Message_Builder && ) {}
+
+	private:
+		trace_storage_t & m_storage;
+};
+
+using trace_logger_traits_t = restinio::traits_t<
+		restinio::asio_timer_manager_t,
+		trace_logger_t >;
+
+//! Send requests on a keep-alive connection with a pause between them.
+/*!
+ * If @a close_after is true then the client closes the connection after
+ * the last response instead of sending `Connection: close`.
+ */
+void
+do_keep_alive_requests(
+	trace_storage_t & storage,
+	std::chrono::steady_clock::duration pause,
+	bool close_after = false )
+{
+	using http_server_t = restinio::http_server_t< trace_logger_traits_t >;
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[&storage]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.buffer_size( 128u )
+				.release_idle_read_buffers( true )
+				.read_buffer_pool_capacity( 2u )
+				.timer_manager( std::chrono::milliseconds( 50 ) )
+				.logger( storage )
+				.request_handler( []( auto req ) {
+					req->create_response()
+						.append_header( "Content-Type", "text/plain; charset=utf-8" )
+						.set_body( req->body() )
+						.done();
+					return restinio::request_accepted();
+				} );
+		}
+	};
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	do_with_socket( [pause, close_after]( auto & socket, auto & /*io_context*/ ) {
+		const auto make_request = []( const std::string & body, bool last ) {
+			return
+				"POST /data HTTP/1.1\r\n"
+				"Host: 127.0.0.1\r\n"
+				"Content-Length: " + std::to_string( body.size() ) + "\r\n" +
+				( last ? "Connection: close\r\n" : "" ) +
+				"\r\n" +
+				body;
+		};
+
+		const std::size_t requests = 3u;
+		for( std::size_t i = 0u; i != requests; ++i )
+		{
+			const bool last = ( i + 1u == requests );
+			const std::string body( 300u - i * 50u, static_cast< char >( 'a' + i ) );
+			restinio::asio_ns::write( socket,
+					restinio::asio_ns::buffer(
+							make_request( body, last && !close_after ) ) );
+
+			std::string response;
+			restinio::asio_ns::error_code ec;
+			while( !ec &&
+					std::string::npos == response.find( body ) )
+			{
+				char data[ 512 ];
+				const auto n = socket.read_some(
+						restinio::asio_ns::buffer( data ), ec );
+				response.append( data, n );
+			}
+			REQUIRE_FALSE( ec );
+			REQUIRE_THAT( response, Catch::Matchers::EndsWith( body ) );
+
+			if( !last )
+				std::this_thread::sleep_for( pause );
+		}
+
+		if( close_after )
+			socket.close();
+	} );
+
+	if( close_after )
+	{
+		// Let the server handle EOF.
+		for( int i = 0; i != 100 &&
+				0u == storage.count( "EOF and no request" ); ++i )
+			std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+	}
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Keep-alive requests with pooled read buffers" ,
+	"[echo][read_buffer_pool]" )
+{
+	trace_storage_t storage;
+	do_keep_alive_requests( storage, std::chrono::milliseconds( 0 ) );
+
+	// The connection waits for every request without a block and
+	// then reads the request directly into a block from the pool.
+	REQUIRE( 3u == storage.count( "wait for incoming data" ) );
+	REQUIRE( 0u == storage.count( "read into peek area" ) );
+	REQUIRE( 0u == storage.count( "release idle read buffer" ) );
+}
+
+TEST_CASE( "Pooled read buffers aren't held between requests" ,
+	"[echo][read_buffer_pool]" )
+{
+	trace_storage_t storage;
+	do_keep_alive_requests( storage, std::chrono::milliseconds( 300 ) );
+
+	// Pauses don't change anything: the block is returned to the pool
+	// before every wait, so there is nothing to release by timeout checks.
+	REQUIRE( 3u == storage.count( "wait for incoming data" ) );
+	REQUIRE( 0u == storage.count( "read into peek area" ) );
+	REQUIRE( 0u == storage.count( "release idle read buffer" ) );
+}
+
+TEST_CASE( "Pooled read buffer isn't taken on EOF" ,
+	"[echo][read_buffer_pool]" )
+{
+	trace_storage_t storage;
+	do_keep_alive_requests(
+			storage, std::chrono::milliseconds( 0 ), true );
+
+	// EOF is read into the peek area without taking a block.
+	REQUIRE( 4u == storage.count( "wait for incoming data" ) );
+	REQUIRE( 1u == storage.count( "read into peek area" ) );
+	REQUIRE( 1u == storage.count( "EOF and no request" ) );
+}
@@ -8,6 +8,8 @@
 
 #include <catch2/catch.hpp>
 
+#include <future>
+
 #include <restinio/all.hpp>
 
 #include <test/common/utest_logger.hpp>
@@ -189,3 +191,181 @@ TEST_CASE( "Timeout on handling request" , "[timeout][handle_request]" )
 	other_thread.stop_and_join();
 	req_to_store.reset();
 }
+
+using wheel_timer_traits_t =
+	restinio::traits_t<
+		restinio::wheel_timer_manager_t,
+		utest_logger_t >;
+
+TEST_CASE( "Timeout on reading requests (wheel timer manager)" ,
+	"[timeout][read][wheel_timer_manager]" )
+{
+	using http_server_t = restinio::http_server_t< wheel_timer_traits_t >;
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.timer_manager( std::chrono::milliseconds( 4 ), 4u )
+				.read_next_http_message_timelimit( std::chrono::milliseconds( 5 ) )
+				.request_handler( []( auto ){
+					return restinio::request_rejected();
+				} );
+		}
+	};
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	do_with_socket( [ & ]( auto & socket, auto & /*io_context*/ ){
+
+		const std::string a_part_of_request{ "GET / HTT" };
+
+		REQUIRE_NOTHROW(
+			restinio::asio_ns::write( socket, restinio::asio_ns::buffer( a_part_of_request ) )
+			);
+
+		std::array< char, 64 > data{};
+		restinio::asio_ns::error_code error;
+
+		size_t length =
+			restinio::asio_ns::read( socket, restinio::asio_ns::buffer(data), error );
+
+		REQUIRE( 0 == length );
+		REQUIRE( error == restinio::asio_ns::error::eof );
+	} );
+
+	other_thread.stop_and_join();
+}
+
+TEST_CASE( "Timeout on handling request (wheel timer manager)" ,
+	"[timeout][handle_request][wheel_timer_manager]" )
+{
+	using http_server_t = restinio::http_server_t< wheel_timer_traits_t >;
+
+	restinio::request_handle_t req_to_store;
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[ & ]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.timer_manager( std::chrono::milliseconds( 4 ), 4u )
+				.handle_request_timeout( std::chrono::milliseconds( 5 ) )
+				.request_handler( [ & ]( auto req ){
+
+					// Store connection.
+					req_to_store = std::move( req );
+
+					// Signal that request is going to be handled.
+					return restinio::request_accepted();
+				} );
+		}
+	};
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	do_with_socket( [ & ]( auto & socket, auto & /*io_context*/ ){
+
+		const std::string request{
+			"GET / HTTP/1.1\r\n"
+			"Host: 127.0.0.1\r\n"
+			"User-Agent: unit-test\r\n"
+			"Accept: */*\r\n"
+			"Connection: close\r\n"
+			"\r\n" };
+
+		REQUIRE_NOTHROW(
+			restinio::asio_ns::write( socket, restinio::asio_ns::buffer( request ) )
+			);
+
+		std::array< char, 1024 > data{};
+		restinio::asio_ns::error_code error;
+
+		size_t length =
+			restinio::asio_ns::read( socket, restinio::asio_ns::buffer(data), error );
+
+		REQUIRE( 0 == length );
+		REQUIRE( error == restinio::asio_ns::error::eof );
+	} );
+
+	other_thread.stop_and_join();
+	req_to_store.reset();
+}
+
+TEST_CASE( "Timeout on writing response (wheel timer manager)" ,
+	"[timeout][write][wheel_timer_manager]" )
+{
+	using http_server_t = restinio::http_server_t< wheel_timer_traits_t >;
+
+	std::promise< restinio::request_handle_t > req_promise;
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[ & ]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.timer_manager( std::chrono::milliseconds( 4 ), 4u )
+				.write_http_response_timelimit( std::chrono::milliseconds( 20 ) )
+				.request_handler( [ & ]( auto req ){
+					// The response is created outside of the handler,
+					// so the write operation is guarded by its own timelimit.
+					req_promise.set_value( std::move( req ) );
+
+					return restinio::request_accepted();
+				} );
+		}
+	};
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	// The response is too big to be sent while the client doesn't read it.
+	const std::size_t body_size = 32u * 1024u * 1024u;
+
+	do_with_socket( [ & ]( auto & socket, auto & /*io_context*/ ){
+
+		// Receive buffer of the client is limited to make the response
+		// stuck in the server.
+		socket.set_option(
+				restinio::asio_ns::socket_base::receive_buffer_size{ 16 * 1024 } );
+
+		const std::string request{
+			"GET / HTTP/1.1\r\n"
+			"Host: 127.0.0.1\r\n"
+			"User-Agent: unit-test\r\n"
+			"Accept: */*\r\n"
+			"\r\n" };
+
+		REQUIRE_NOTHROW(
+			restinio::asio_ns::write( socket, restinio::asio_ns::buffer( request ) )
+			);
+
+		req_promise.get_future().get()->create_response()
+			.append_header( "Content-Type", "text/plain; charset=utf-8" )
+			.set_body( std::string( body_size, 'x' ) )
+			.done();
+
+		// Don't read the response until the write operation is timed out.
+		std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+
+		std::vector< char > data( 64u * 1024u );
+		restinio::asio_ns::error_code error;
+		std::size_t total_length = 0u;
+
+		while( !error )
+			total_length += socket.read_some(
+					restinio::asio_ns::buffer( data ), error );
+
+		REQUIRE( total_length < body_size );
+		REQUIRE( ( error == restinio::asio_ns::error::eof ||
+				error == restinio::asio_ns::error::connection_reset ) );
+	} );
+
+	other_thread.stop_and_join();
+}
@@ -9,6 +9,7 @@
 #include <catch2/catch.hpp>
 
 #include <iterator>
+#include <limits>
 #include <set>
 
 #include <restinio/all.hpp>
@@ -518,6 +519,141 @@ TEST_CASE( "Removement of fields" , "[header][fields][remove_field][remove_all_o
 	}
 }
 
+TEST_CASE( "Index of fields" , "[header][fields][index]" )
+{
+	http_header_fields_t fields;
+
+	fields.add_field( "X-Custom", "1" );
+	fields.add_field( http_field_t::host, "localhost" );
+	fields.add_field( "accept", "text/plain" );
+	fields.add_field( "x-custom", "2" );
+	fields.add_field( http_field_t::accept, "text/html" );
+	fields.add_field( "X-Another", "3" );
+
+	REQUIRE( 6 == fields.fields_count() );
+
+	// The first occurrences are found.
+	REQUIRE( "text/plain" == fields.value_of( http_field_t::accept ) );
+	REQUIRE( "text/plain" == fields.value_of( "Accept" ) );
+	REQUIRE( "1" == fields.value_of( "X-CUSTOM" ) );
+	REQUIRE( "localhost" == fields.value_of( "HOST" ) );
+	REQUIRE( "3" == fields.value_of( "x-another" ) );
+	REQUIRE_FALSE( fields.has_field( http_field_t::date ) );
+	REQUIRE_FALSE( fields.has_field( "X-Custom-2" ) );
+	REQUIRE( fields.has_field( http_field_t::field_unspecified ) );
+
+	// Positions are changed by removal of fields.
+	REQUIRE( fields.remove_field( "x-custom" ) );
+	REQUIRE( "localhost" == fields.value_of( http_field_t::host ) );
+	REQUIRE( "text/plain" == fields.value_of( http_field_t::accept ) );
+	REQUIRE( "2" == fields.value_of( "X-Custom" ) );
+
+	REQUIRE( fields.remove_field( http_field_t::accept ) );
+	REQUIRE( "text/html" == fields.value_of( http_field_t::accept ) );
+	REQUIRE( "2" == fields.value_of( "X-Custom" ) );
+
+	REQUIRE( 1u == fields.remove_all_of( "X-Custom" ) );
+	REQUIRE( "text/html" == fields.value_of( http_field_t::accept ) );
+	REQUIRE( "3" == fields.value_of( "X-Another" ) );
+
+	REQUIRE( 1u == fields.remove_all_of( http_field_t::host ) );
+	REQUIRE_FALSE( fields.has_field( http_field_t::host ) );
+	REQUIRE( "text/html" == fields.value_of( "accept" ) );
+	REQUIRE( "3" == fields.value_of( "X-Another" ) );
+
+	// The order of fields is kept.
+	std::vector< std::string > names;
+	for( const auto & f : fields )
+		names.push_back( f.name() );
+	REQUIRE( names == std::vector< std::string >{ "Accept", "X-Another" } );
+
+	// Swapped fields are swapped with the index.
+	http_header_fields_t other;
+	other.set_field( http_field_t::date, "today" );
+	other.swap_fields( fields );
+
+	REQUIRE( "today" == fields.value_of( http_field_t::date ) );
+	REQUIRE_FALSE( fields.has_field( http_field_t::accept ) );
+	REQUIRE( "text/html" == other.value_of( http_field_t::accept ) );
+	REQUIRE_FALSE( other.has_field( http_field_t::date ) );
+}
+
+TEST_CASE( "Index of fields (many fields)" , "[header][fields][index]" )
+{
+	http_header_fields_t fields;
+
+	// More known fields than can be indexed by positions.
+	const auto last_id = static_cast< std::size_t >(
+			http_field_t::field_unspecified );
+	for( std::size_t i = last_id; i != 0u; --i )
+	{
+		const auto id = static_cast< http_field_t >( i - 1u );
+		fields.add_field( id, std::to_string( i - 1u ) );
+		fields.add_field( "X-Field-" + std::to_string( i ), "-" );
+	}
+
+	REQUIRE( 2u * last_id == fields.fields_count() );
+
+	for( std::size_t i = 0u; i != last_id; ++i )
+	{
+		const auto id = static_cast< http_field_t >( i );
+		REQUIRE( std::to_string( i ) == fields.value_of( id ) );
+		REQUIRE( std::to_string( i ) == fields.value_of( field_to_string( id ) ) );
+	}
+
+	REQUIRE( "-" == fields.value_of( "x-field-1" ) );
+
+	// Remove all custom fields, the rest should be indexed again.
+	for( std::size_t i = last_id; i != 0u; --i )
+		REQUIRE( fields.remove_field( "X-Field-" + std::to_string( i ) ) );
+
+	REQUIRE( last_id == fields.fields_count() );
+
+	for( std::size_t i = 0u; i != last_id; ++i )
+	{
+		const auto id = static_cast< http_field_t >( i );
+		REQUIRE( std::to_string( i ) == fields.value_of( id ) );
+	}
+}
+
+TEST_CASE( "Index of fields (custom names)" , "[header][fields][index]" )
+{
+	// Names with the same length and the same first, middle and last
+	// characters have different hashes.
+	REQUIRE( restinio::impl::caseless_hash( "X-Request-A" ) !=
+			restinio::impl::caseless_hash( "X-Request-B" ) );
+	REQUIRE( restinio::impl::caseless_hash( "X-Request-A" ) ==
+			restinio::impl::caseless_hash( "x-request-a" ) );
+
+	// Those names have the same hash.
+	REQUIRE( restinio::impl::caseless_hash( "X-Request-cihv" ) ==
+			restinio::impl::caseless_hash( "X-Request-m0aa" ) );
+
+	http_header_fields_t fields;
+
+	fields.add_field( "X-Request-A", "a" );
+	fields.add_field( "X-Request-cihv", "1" );
+	fields.add_field( "X-Request-B", "b" );
+	fields.add_field( "X-Request-m0aa", "2" );
+	fields.add_field( "x-request-cihv", "3" );
+
+	REQUIRE( "a" == fields.value_of( "x-request-a" ) );
+	REQUIRE( "b" == fields.value_of( "X-REQUEST-B" ) );
+	REQUIRE_FALSE( fields.has_field( "X-Request-C" ) );
+
+	REQUIRE( "1" == fields.value_of( "X-Request-CIHV" ) );
+	REQUIRE( "2" == fields.value_of( "x-request-m0aa" ) );
+
+	REQUIRE( fields.remove_field( "X-Request-cihv" ) );
+	REQUIRE( "2" == fields.value_of( "X-Request-m0aa" ) );
+	REQUIRE( "3" == fields.value_of( "X-Request-cihv" ) );
+
+	REQUIRE( fields.remove_field( "X-Request-m0aa" ) );
+	REQUIRE_FALSE( fields.has_field( "X-Request-m0aa" ) );
+	REQUIRE( "3" == fields.value_of( "X-Request-cihv" ) );
+	REQUIRE( "b" == fields.value_of( "X-Request-B" ) );
+}
+
 TEST_CASE( "Enumeration of field's values" , "[header][fields][for_each_value_of]" )
 {
 	SECTION( "By name (single value)" )
@@ -923,6 +1059,45 @@ TEST_CASE( "working with string_to_field()" , "[header][string_to_field]" )
 #undef RESTINIO_FIELD_FROM_STRIN_TEST
 }
 
+TEST_CASE( "string_to_field() for different cases and unknown names" ,
+		"[header][string_to_field]" )
+{
+	for( std::size_t i = 0u;
+		i != static_cast< std::size_t >( http_field_t::field_unspecified );
+		++i )
+	{
+		const auto id = static_cast< http_field_t >( i );
+		std::string name{ field_to_string( id ) };
+
+		std::transform( name.begin(), name.end(), name.begin(),
+				[]( unsigned char c ) { return static_cast< char >( std::tolower( c ) ); } );
+		REQUIRE( id == string_to_field( name ) );
+
+		std::transform( name.begin(), name.end(), name.begin(),
+				[]( unsigned char c ) { return static_cast< char >( std::toupper( c ) ); } );
+		REQUIRE( id == string_to_field( name ) );
+
+		// Names that differ in one char or in the length aren't recognized.
+		name.back() = '~';
+		REQUIRE( http_field_t::field_unspecified == string_to_field( name ) );
+		name.pop_back();
+		REQUIRE( id != string_to_field( name ) );
+	}
+
+	REQUIRE( http_field_t::field_unspecified == string_to_field( "" ) );
+	REQUIRE( http_field_t::field_unspecified == string_to_field( "Connection" ) );
+	REQUIRE( http_field_t::field_unspecified == string_to_field( "Content-Length" ) );
+	REQUIRE( http_field_t::field_unspecified == string_to_field( "X-Request-Id" ) );
+	REQUIRE( http_field_t::field_unspecified == string_to_field( "Hosts" ) );
+	REQUIRE( http_field_t::field_unspecified == string_to_field( "H0st" ) );
+	// Control chars must not be mixed with '-' or digits.
+	REQUIRE( http_field_t::field_unspecified == string_to_field( "If\rMatch" ) );
+	REQUIRE( http_field_t::field_unspecified == string_to_field( "HTTP\x12-Settings" ) );
+	REQUIRE( http_field_t::field_unspecified == string_to_field( "Accept\rEncoding" ) );
+	REQUIRE( http_field_t::field_unspecified == string_to_field(
+			"Access-Control-Allow-Credentials-And-More" ) );
+}
+
 TEST_CASE( "Connection" , "[header][connection]" )
 {
 	using namespace Catch;
@@ -986,6 +1161,223 @@ TEST_CASE( "Connection" , "[header][connection]" )
 }
 
 
+TEST_CASE( "Date field" , "[header][date]" )
+{
+	using namespace Catch;
+
+	// 1994-11-06 08:49:37 UTC.
+	REQUIRE( "Sun, 06 Nov 1994 08:49:37 GMT" ==
+			make_date_field_value( std::time_t{ 784111777 } ) );
+	// 2000-02-29 23:59:59 UTC.
+	REQUIRE( "Tue, 29 Feb 2000 23:59:59 GMT" ==
+			make_date_field_value( std::time_t{ 951868799 } ) );
+
+	// The year always has four digits.
+	if( sizeof( std::time_t ) >= sizeof( std::int64_t ) )
+	{
+		const auto far_future = static_cast< std::time_t >( 1000000000000000ll );
+		REQUIRE( "Fri, 31 Dec 9999 23:59:59 GMT" ==
+				make_date_field_value( far_future ) );
+		REQUIRE( "Sat, 01 Jan 0000 00:00:00 GMT" ==
+				make_date_field_value( -far_future ) );
+	}
+
+	{
+		impl::date_field_cache_t cache;
+		REQUIRE( "Sun, 06 Nov 1994 08:49:37 GMT" == cache.get( 784111777 ) );
+		REQUIRE( "Sun, 06 Nov 1994 08:49:38 GMT" == cache.get( 784111778 ) );
+	}
+
+	{
+		http_response_header_t h;
+		h.use_cached_date_field( true );
+		const auto serialized = impl::create_header_string( h );
+
+		REQUIRE_THAT( serialized, Contains( "\r\nDate: " ) );
+		REQUIRE( serialized.size() <=
+				impl::calculate_approx_buffer_size_for_header( h ) );
+	}
+
+	{
+		// Explicitly set field has priority.
+		http_response_header_t h;
+		h.use_cached_date_field( true );
+		h.set_field( http_field_t::date, "Sun, 06 Nov 1994 08:49:37 GMT" );
+		const auto serialized = impl::create_header_string( h );
+
+		REQUIRE_THAT( serialized,
+				Contains( "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\n" ) );
+		REQUIRE( serialized.find( "Date: " ) == serialized.rfind( "Date: " ) );
+	}
+}
+
+TEST_CASE( "Header serializer" , "[header][serializer]" )
+{
+	SECTION( "uint64_to_chars" )
+	{
+		const auto to_str = []( std::uint64_t v ) {
+			char buf[ 20 ];
+			return std::string{ buf, impl::uint64_to_chars( v, buf ) };
+		};
+
+		REQUIRE( "0" == to_str( 0u ) );
+		REQUIRE( "7" == to_str( 7u ) );
+		REQUIRE( "10" == to_str( 10u ) );
+		REQUIRE( "99" == to_str( 99u ) );
+		REQUIRE( "100" == to_str( 100u ) );
+		REQUIRE( "12345" == to_str( 12345u ) );
+		REQUIRE( "1000000000" == to_str( 1000000000u ) );
+		REQUIRE( "18446744073709551615" ==
+				to_str( std::numeric_limits< std::uint64_t >::max() ) );
+	}
+
+	SECTION( "precomputed status line" )
+	{
+		http_response_header_t h{ status_ok() };
+		h.should_keep_alive( true );
+		h.content_length( 1234 );
+		h.set_field( http_field_t::content_type, "text/plain" );
+		h.set_field( "Server", "RESTinio" );
+		h.set_field( "X-Custom", "value" );
+
+		const auto serialized = impl::create_header_string( h );
+		REQUIRE( serialized ==
+				"HTTP/1.1 200 OK\r\n"
+				"Connection: keep-alive\r\n"
+				"Content-Length: 1234\r\n"
+				"Content-Type: text/plain\r\n"
+				"Server: RESTinio\r\n"
+				"X-Custom: value\r\n"
+				"\r\n" );
+	}
+
+	SECTION( "custom reason phrase and version" )
+	{
+		http_response_header_t h{
+				http_status_line_t{ status_code::not_found, "Nothing Here" } };
+		h.connection( http_connection_header_t::upgrade );
+
+		REQUIRE( impl::create_header_string( h,
+					impl::content_length_field_presence_t::skip_content_length ) ==
+				"HTTP/1.1 404 Nothing Here\r\n"
+				"Connection: Upgrade\r\n"
+				"\r\n" );
+
+		h.http_minor( 0 );
+		h.status_line( status_not_found() );
+		REQUIRE( impl::create_header_string( h ) ==
+				"HTTP/1.0 404 Not Found\r\n"
+				"Connection: Upgrade\r\n"
+				"Content-Length: 0\r\n"
+				"\r\n" );
+	}
+
+	SECTION( "unknown status code" )
+	{
+		http_response_header_t h{
+				http_status_line_t{ http_status_code_t{ 299 }, "Whatever" } };
+
+		REQUIRE( impl::create_header_string( h ) ==
+				"HTTP/1.1 299 Whatever\r\n"
+				"Connection: close\r\n"
+				"Content-Length: 0\r\n"
+				"\r\n" );
+	}
+
+	SECTION( "all standard statuses" )
+	{
+		const http_status_line_t statuses[] = {
+			status_continue(), status_switching_protocols(), status_ok(),
+			status_created(), status_accepted(),
+			status_non_authoritative_information(), status_no_content(),
+			status_reset_content(), status_partial_content(),
+			status_multiple_choices(), status_moved_permanently(),
+			status_found(), status_see_other(), status_not_modified(),
+			status_use_proxy(), status_temporary_redirect(),
+			status_bad_request(), status_unauthorized(),
+			status_payment_required(), status_forbidden(), status_not_found(),
+			status_method_not_allowed(), status_not_acceptable(),
+			status_proxy_authentication_required(), status_request_time_out(),
+			status_conflict(), status_gone(), status_length_required(),
+			status_precondition_failed(), status_payload_too_large(),
+			status_uri_too_long(), status_unsupported_media_type(),
+			status_requested_range_not_satisfiable(),
+			status_expectation_failed(), status_internal_server_error(),
+			status_not_implemented(), status_bad_gateway(),
+			status_service_unavailable(), status_gateway_time_out(),
+			status_http_version_not_supported(), status_permanent_redirect(),
+			status_processing(), status_multi_status(),
+			status_unprocessable_entity(), status_locked(),
+			status_failed_dependency(), status_insufficient_storage(),
+			status_precondition_required(), status_too_many_requests(),
+			status_request_header_fields_too_large(),
+			status_network_authentication_required()
+		};
+
+		for( const auto & s : statuses )
+		{
+			const auto line = impl::precomputed_status_line( s.status_code() );
+			REQUIRE_FALSE( line.empty() );
+			REQUIRE( std::string{ line.m_data, line.m_size } ==
+					"HTTP/1.1 " + std::to_string( s.status_code().raw_code() ) +
+					" " + s.reason_phrase() + "\r\n" );
+		}
+	}
+
+	SECTION( "names of fields are kept as set" )
+	{
+		http_response_header_t h{ status_ok() };
+		h.set_field( "content-TYPE", "text/plain" );
+		h.set_field( "x-unknown-field", "value" );
+		h.set_field( http_field_t::cache_control, "no-cache" );
+
+		REQUIRE( impl::create_header_string( h ) ==
+				"HTTP/1.1 200 OK\r\n"
+				"Connection: close\r\n"
+				"Content-Length: 0\r\n"
+				"content-TYPE: text/plain\r\n"
+				"x-unknown-field: value\r\n"
+				"Cache-Control: no-cache\r\n"
+				"\r\n" );
+	}
+
+	SECTION( "reusable header buffer" )
+	{
+		impl::response_header_buffer_slot_t slot;
+
+		http_response_header_t h{ status_ok() };
+		h.set_field( "Server", "RESTinio" );
+
+		const auto as_string = []( const writable_item_t & item ) {
+			return std::string{
+					static_cast< const char * >( item.buf().data() ),
+					item.buf().size() };
+		};
+
+		const void * last_data = nullptr;
+		{
+			const auto first = impl::create_header_buffer( h, slot );
+			REQUIRE( impl::create_header_string( h ) == as_string( first ) );
+
+			// The first buffer is still in use, so another one is created.
+			const auto second = impl::create_header_buffer( h, slot );
+			REQUIRE( first.buf().data() != second.buf().data() );
+			last_data = second.buf().data();
+		}
+
+		{
+			// The last created buffer is reused when it isn't in use.
+			const auto item = impl::create_header_buffer( h, slot );
+			REQUIRE( last_data == item.buf().data() );
+		}
+
+		h.status_line( status_not_found() );
+		h.set_field( "X-Custom", "value" );
+		const auto item = impl::create_header_buffer( h, slot );
+		REQUIRE( impl::create_header_string( h ) == as_string( item ) );
+	}
+}
+
 TEST_CASE( "Query" , "[header][query string][query path]" )
 {
 	auto append = []( http_request_header_t & h, const std::string & part ){
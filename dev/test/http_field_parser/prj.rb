@@ -24,5 +24,6 @@ MxxRu::Cpp::exe_target {
 	cpp_source( "user-agent.cpp" )
 	cpp_source( "transfer-encoding.cpp" )
 	cpp_source( "host.cpp" )
+	cpp_source( "sec-websocket-extensions.cpp" )
 }
 
@@ -0,0 +1,80 @@
+/*
+	restinio
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/helpers/http_field_parsers/sec-websocket-extensions.hpp>
+
+TEST_CASE( "Sec-WebSocket-Extensions", "[sec-websocket-extensions]" )
+{
+	using namespace restinio::http_field_parsers;
+	using namespace std::string_literals;
+
+	using extension_t = sec_websocket_extensions_value_t::extension_t;
+
+	{
+		const auto result = sec_websocket_extensions_value_t::try_parse(
+				"" );
+
+		REQUIRE( !result );
+	}
+
+	{
+		const auto result = sec_websocket_extensions_value_t::try_parse(
+				"permessage-deflate;" );
+
+		REQUIRE( !result );
+	}
+
+	{
+		const auto result = sec_websocket_extensions_value_t::try_parse(
+				"permessage-deflate" );
+
+		REQUIRE( result );
+
+		const sec_websocket_extensions_value_t::extension_container_t expected{
+			extension_t{ "permessage-deflate"s, {} }
+		};
+
+		REQUIRE( expected == result->extensions );
+	}
+
+	{
+		const auto result = sec_websocket_extensions_value_t::try_parse(
+				"Permessage-Deflate; Client_Max_Window_Bits" );
+
+		REQUIRE( result );
+
+		const sec_websocket_extensions_value_t::extension_container_t expected{
+			extension_t{ "permessage-deflate"s, {
+				{ "client_max_window_bits"s, restinio::nullopt }
+			} }
+		};
+
+		REQUIRE( expected == result->extensions );
+	}
+
+	{
+		const auto result = sec_websocket_extensions_value_t::try_parse(
+				"permessage-deflate; server_max_window_bits=10; "
+				"client_max_window_bits=\"12\", "
+				"permessage-deflate ;server_no_context_takeover, "
+				"x-webkit-deflate-frame" );
+
+		REQUIRE( result );
+
+		const sec_websocket_extensions_value_t::extension_container_t expected{
+			extension_t{ "permessage-deflate"s, {
+				{ "server_max_window_bits"s, "10"s },
+				{ "client_max_window_bits"s, "12"s }
+			} },
+			extension_t{ "permessage-deflate"s, {
+				{ "server_no_context_takeover"s, restinio::nullopt }
+			} },
+			extension_t{ "x-webkit-deflate-frame"s, {} }
+		};
+
+		REQUIRE( expected == result->extensions );
+	}
+}
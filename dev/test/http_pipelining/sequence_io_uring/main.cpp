@@ -0,0 +1,12 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests of pipelining on io_uring backend of asio.
+*/
+
+// RESTINIO_ASIO_USE_IO_URING is defined for the whole target
+// by the build files.
+
+#include "../sequence/main.cpp"
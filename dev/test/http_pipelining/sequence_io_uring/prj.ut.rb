@@ -0,0 +1,7 @@
+require 'mxx_ru/binary_unittest'
+
+Mxx_ru::setup_target(
+	Mxx_ru::Binary_unittest_target.new(
+		"test/http_pipelining/sequence_io_uring/prj.ut.rb",
+		"test/http_pipelining/sequence_io_uring/prj.rb" )
+)
@@ -0,0 +1,134 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for read buffer pool.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+
+using namespace restinio;
+using namespace restinio::impl;
+
+void
+put_data( fixed_buffer_t & buf, string_view_t data )
+{
+	auto asio_buf = buf.make_asio_buffer();
+	REQUIRE( data.size() <= asio_ns::buffer_size( asio_buf ) );
+	std::memcpy( asio_buf.data(), data.data(), data.size() );
+	buf.obtained_bytes( data.size() );
+}
+
+TEST_CASE( "acquire and release" , "[read_buffer_pool]" )
+{
+	read_buffer_pool_t pool{ 128u, 2u };
+
+	auto b1 = pool.acquire();
+	auto b2 = pool.acquire();
+	auto b3 = pool.acquire();
+	const auto * p1 = b1.get();
+
+	REQUIRE( 0u == pool.free_blocks() );
+
+	pool.release( std::move( b1 ) );
+	pool.release( std::move( b2 ) );
+	// The pool is full, block is deallocated.
+	pool.release( std::move( b3 ) );
+	REQUIRE( 2u == pool.free_blocks() );
+
+	auto b4 = pool.acquire();
+	REQUIRE( 1u == pool.free_blocks() );
+
+	auto b5 = pool.acquire();
+	REQUIRE( p1 == b5.get() );
+
+	// A block referenced by someone else isn't returned to the pool.
+	auto b5_copy = b5;
+	pool.release( std::move( b5 ) );
+	REQUIRE( 0u == pool.free_blocks() );
+}
+
+TEST_CASE( "fixed_buffer without pool" , "[read_buffer_pool]" )
+{
+	fixed_buffer_t buf{ 128u, nullptr };
+
+	REQUIRE( buf.has_block() );
+	REQUIRE( 128u == asio_ns::buffer_size( buf.make_asio_buffer() ) );
+
+	buf.release_block();
+	REQUIRE( buf.has_block() );
+}
+
+TEST_CASE( "fixed_buffer with pool" , "[read_buffer_pool]" )
+{
+	read_buffer_pool_t pool{ 128u, 4u };
+
+	{
+		fixed_buffer_t buf{ 128u, &pool };
+		REQUIRE_FALSE( buf.has_block() );
+		REQUIRE( buf.has_pool() );
+
+		// The first read goes into a block from the pool.
+		REQUIRE( 128u == asio_ns::buffer_size( buf.make_asio_buffer() ) );
+		REQUIRE_FALSE( buf.is_peek_read() );
+		put_data( buf, "GET / HTTP/1.1\r\n" );
+		REQUIRE( buf.has_block() );
+		const auto * block = buf.bytes();
+
+		// Unconsumed data prevents the release.
+		buf.release_block();
+		REQUIRE( buf.has_block() );
+
+		buf.consumed_bytes( 4u );
+		REQUIRE( "/ HTTP/1.1\r\n" == std::string( buf.bytes(), buf.length() ) );
+		buf.consumed_bytes( buf.length() );
+
+		// Reads without a release use the same block.
+		REQUIRE( 128u == asio_ns::buffer_size( buf.make_asio_buffer() ) );
+		REQUIRE_FALSE( buf.is_peek_read() );
+		put_data( buf, "Host: localhost\r\n\r\n" );
+		REQUIRE( block == buf.bytes() );
+		buf.consumed_bytes( buf.length() );
+
+		buf.release_block();
+		REQUIRE_FALSE( buf.has_block() );
+		REQUIRE( 1u == pool.free_blocks() );
+
+		// Peek read after the release.
+		const std::size_t peek_size = fixed_buffer_t::peek_size;
+		REQUIRE( peek_size == asio_ns::buffer_size( buf.make_asio_buffer() ) );
+		REQUIRE( buf.is_peek_read() );
+		put_data( buf, "GET" );
+		REQUIRE( 0u == pool.free_blocks() );
+		REQUIRE( "GET" == std::string( buf.bytes(), buf.length() ) );
+		buf.consumed_bytes( buf.length() );
+
+		// The block is kept after the peek read.
+		REQUIRE( 128u == asio_ns::buffer_size( buf.make_asio_buffer() ) );
+		REQUIRE_FALSE( buf.is_peek_read() );
+	}
+
+	// The block is returned by the destructor.
+	REQUIRE( 1u == pool.free_blocks() );
+}
+
+TEST_CASE( "fixed_buffer with shared block" , "[read_buffer_pool]" )
+{
+	read_buffer_pool_t pool{ 128u, 4u };
+	fixed_buffer_t buf{ 128u, &pool };
+
+	put_data( buf, "body" );
+	auto keeper = buf.share_block();
+	const auto * data = buf.bytes();
+	buf.consumed_bytes( buf.length() );
+
+	buf.release_block();
+	REQUIRE_FALSE( buf.has_block() );
+	REQUIRE( 0u == pool.free_blocks() );
+
+	put_data( buf, "other" );
+	REQUIRE( "body" == std::string( data, 4u ) );
+}
@@ -0,0 +1,327 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for request arena.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+#include <restinio/impl/request_arena.hpp>
+
+#include <test/common/pub.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <future>
+#include <new>
+
+#if defined(__GNUG__) && !defined(__clang__) && __GNUC__ >= 11
+// Replaced operator new/delete use malloc/free.
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+using namespace restinio;
+using namespace restinio::impl;
+
+namespace
+{
+
+std::atomic< std::size_t > g_allocations{ 0u };
+
+//! Allocations made by the current thread.
+thread_local std::size_t t_allocations{ 0u };
+
+} /* anonymous namespace */
+
+// Every allocation in the test is counted.
+void *
+operator new( std::size_t size )
+{
+	++g_allocations;
+	++t_allocations;
+	if( void * p = std::malloc( size ? size : 1u ) )
+		return p;
+	throw std::bad_alloc{};
+}
+
+void
+operator delete( void * p ) noexcept
+{
+	std::free( p );
+}
+
+void
+operator delete( void * p, std::size_t ) noexcept
+{
+	std::free( p );
+}
+
+#include "../common/fake_connection.ipp"
+
+//
+// allocations_counter_t
+//
+
+//! Counts allocations made since the construction.
+class allocations_counter_t
+{
+	public:
+		allocations_counter_t() : m_started{ g_allocations.load() } {}
+
+		std::size_t
+		count() const { return g_allocations.load() - m_started; }
+
+	private:
+		const std::size_t m_started;
+};
+
+template< typename T >
+using arena_allocator_t = request_arena_allocator_t< T >;
+
+TEST_CASE( "Reuse of a block" , "[request_arena]" )
+{
+	request_arena_t arena{ 256u };
+
+	allocations_counter_t counter;
+
+	for( int i = 0; i != 100; ++i )
+	{
+		auto p = std::allocate_shared< std::array< char, 64 > >(
+				arena_allocator_t< char >{ arena } );
+		REQUIRE( p );
+	}
+
+	// Only the block is allocated.
+	REQUIRE( 1u == counter.count() );
+}
+
+TEST_CASE( "New block for pinned block" , "[request_arena]" )
+{
+	request_arena_t arena{ 256u };
+
+	allocations_counter_t counter;
+
+	// The first object will pin the first block.
+	auto p1 = std::allocate_shared< std::array< char, 64 > >(
+			arena_allocator_t< char >{ arena } );
+	auto p2 = std::allocate_shared< std::array< char, 64 > >(
+			arena_allocator_t< char >{ arena } );
+	REQUIRE( 1u == counter.count() );
+
+	// There is no space for the next object in the first block.
+	auto p3 = std::allocate_shared< std::array< char, 64 > >(
+			arena_allocator_t< char >{ arena } );
+	REQUIRE( 2u == counter.count() );
+
+	p1.reset();
+	p2.reset();
+	p3.reset();
+
+	// The second block is reused.
+	auto p4 = std::allocate_shared< std::array< char, 64 > >(
+			arena_allocator_t< char >{ arena } );
+	REQUIRE( 2u == counter.count() );
+
+	// The object can outlive the arena.
+	p4->fill( 'x' );
+}
+
+TEST_CASE( "Too big object" , "[request_arena]" )
+{
+	request_arena_t arena{ 256u };
+
+	allocations_counter_t counter;
+
+	auto p1 = std::allocate_shared< std::array< char, 512 > >(
+			arena_allocator_t< char >{ arena } );
+	REQUIRE( 1u == counter.count() );
+
+	auto p2 = std::allocate_shared< std::array< char, 16 > >(
+			arena_allocator_t< char >{ arena } );
+	REQUIRE( 2u == counter.count() );
+
+	// The block is reused but the big object is allocated every time.
+	p1 = std::allocate_shared< std::array< char, 512 > >(
+			arena_allocator_t< char >{ arena } );
+	p2 = std::allocate_shared< std::array< char, 16 > >(
+			arena_allocator_t< char >{ arena } );
+	REQUIRE( 3u == counter.count() );
+}
+
+TEST_CASE( "Alignment" , "[request_arena]" )
+{
+	request_arena_t arena;
+
+	for( std::size_t size = 1u; size != 100u; ++size )
+	{
+		void * p = arena.allocate( size );
+		REQUIRE( 0u == reinterpret_cast< std::uintptr_t >( p ) %
+				alignof( std::max_align_t ) );
+		request_arena_t::deallocate( p );
+	}
+}
+
+TEST_CASE( "Request objects" , "[request_arena]" )
+{
+	const auto connection = std::make_shared< fake_connection_t >();
+	const restinio::endpoint_t endpoint{
+			restinio::asio_ns::ip::make_address_v4( "127.0.0.1" ),
+			3000 };
+	no_extra_data_factory_t extra_data_factory;
+
+	const auto make_header = [] {
+		return http_request_header_t{ http_method_get(), "/" };
+	};
+
+	SECTION( "make_shared" )
+	{
+		auto header = make_header();
+		allocations_counter_t counter;
+
+		for( int i = 0; i != 10; ++i )
+		{
+			auto req = std::make_shared< request_t >(
+					0u,
+					header,
+					std::string{},
+					connection,
+					endpoint,
+					extra_data_factory );
+			REQUIRE( req );
+		}
+
+		// One allocation for every request object.
+		REQUIRE( 10u == counter.count() );
+	}
+
+	SECTION( "arena" )
+	{
+		request_arena_t arena;
+		auto header = make_header();
+		allocations_counter_t counter;
+
+		for( int i = 0; i != 10; ++i )
+		{
+			auto req = std::allocate_shared< request_t >(
+					arena_allocator_t< request_t >{ arena },
+					0u,
+					header,
+					std::string{},
+					connection,
+					endpoint,
+					extra_data_factory );
+			REQUIRE( req );
+		}
+
+		// Just one block for all requests.
+		REQUIRE( 1u == counter.count() );
+	}
+}
+
+//! Count allocations made on the server thread between calls of
+//! the request handler for a series of pipelined requests.
+/*!
+ * Everything that is done for a request from the parsing of it till
+ * the call of the request handler is counted.
+ */
+template< typename Traits >
+std::vector< std::size_t >
+allocations_between_requests()
+{
+	using http_server_t = restinio::http_server_t< Traits >;
+
+	constexpr std::size_t requests_count = 16u;
+
+	std::vector< std::size_t > allocations;
+	allocations.reserve( requests_count );
+
+	std::promise< void > all_handled;
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[&]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.max_pipelined_requests( requests_count + 1u )
+				.request_handler( [&]( auto req ) {
+					allocations.push_back( t_allocations );
+					if( requests_count == allocations.size() )
+						all_handled.set_value();
+
+					// The request is destroyed without a response.
+					req.reset();
+					return restinio::request_accepted();
+				} );
+		}
+	};
+
+	other_work_thread_for_server_t< http_server_t > other_thread( http_server );
+	other_thread.run();
+
+	// All requests have the same size.
+	std::string requests;
+	for( std::size_t i = 10u; i != 10u + requests_count; ++i )
+		requests +=
+			"GET /api/v1/items/" + std::to_string( i ) +
+				"?fields=name,description,price HTTP/1.1\r\n"
+			"Host: restinio.localdomain\r\n"
+			"User-Agent: restinio-request-arena-test\r\n"
+			"Accept: application/json, text/plain\r\n"
+			"X-Request-Id: 0123456789abcdef-" + std::to_string( i ) + "\r\n"
+			"\r\n";
+
+	REQUIRE_NOTHROW( do_with_socket(
+		[&]( auto & socket, auto & /*io_context*/ ) {
+			restinio::asio_ns::write(
+					socket, restinio::asio_ns::buffer( requests ) );
+
+			all_handled.get_future().wait();
+		} ) );
+
+	other_thread.stop_and_join();
+
+	std::vector< std::size_t > result;
+	for( std::size_t i = 1u; i != allocations.size(); ++i )
+		result.push_back( allocations[ i ] - allocations[ i - 1u ] );
+
+	return result;
+}
+
+struct default_server_traits_t : public restinio::default_traits_t
+{
+	using logger_t = restinio::null_logger_t;
+};
+
+struct arena_server_traits_t : public default_server_traits_t
+{
+	static constexpr bool use_request_arena = true;
+};
+
+TEST_CASE( "Allocations per request" , "[request_arena][server]" )
+{
+	SECTION( "without arena" )
+	{
+		const auto allocations =
+				allocations_between_requests< default_server_traits_t >();
+
+		// The request object, the vector of fields and strings
+		// of the request target and of fields are allocated every time.
+		for( const auto n : allocations )
+			REQUIRE( n >= 6u );
+	}
+
+	SECTION( "arena" )
+	{
+		const auto allocations =
+				allocations_between_requests< arena_server_traits_t >();
+
+		// The memory of a previous request is reused. The first requests
+		// may need more memory for fields.
+		for( std::size_t i = 2u; i < allocations.size(); ++i )
+			REQUIRE( 0u == allocations[ i ] );
+	}
+}
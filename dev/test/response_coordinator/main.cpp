@@ -1699,6 +1699,72 @@ TEST_CASE( "response_coordinator merge write groups" , "[response_coordinator][m
 }
 
 
+TEST_CASE( "response_coordinator pop_ready_buffers_if" , "[response_coordinator][pop_if]" )
+{
+	response_coordinator_t coordinator{ 4 };
+
+	request_id_t req_id[ 4 ];
+
+	for( auto & id : req_id )
+		CHECK_NOTHROW( id = coordinator.register_new_request() );
+
+	const auto append = [&]( std::size_t i, std::vector< std::string > bufs,
+		response_connection_attr_t conn_attr ) {
+			CHECK_NOTHROW( coordinator.append_response(
+				req_id[ i ],
+				response_output_flags_t{ response_is_complete(), conn_attr },
+				write_group_t{ make_buffers( std::move( bufs ) ) } ) );
+		};
+
+	const auto accept_all = []( const write_group_t & ) { return true; };
+	const auto reject_all = []( const write_group_t & ) { return false; };
+
+	// Nothing is ready.
+	REQUIRE_FALSE( coordinator.pop_ready_buffers_if( accept_all ) );
+
+	append( 1, { "1a", "1b" }, connection_should_keep_alive() );
+
+	// #0 isn't ready yet.
+	REQUIRE_FALSE( coordinator.pop_ready_buffers_if( accept_all ) );
+
+	append( 0, { "0a" }, connection_should_keep_alive() );
+	append( 2, { "2a", "2b", "2c" }, connection_should_close() );
+	append( 3, { "3a" }, connection_should_keep_alive() );
+
+	REQUIRE_FALSE( coordinator.pop_ready_buffers_if( reject_all ) );
+
+	{
+		auto r = coordinator.pop_ready_buffers_if( accept_all );
+		REQUIRE( r );
+		REQUIRE( req_id[ 0 ] == r->second );
+		REQUIRE( concat_bufs( r->first ) == "0a" );
+	}
+
+	{
+		std::size_t items_seen{ 0u };
+		auto r = coordinator.pop_ready_buffers_if(
+			[&]( const write_group_t & wg ) {
+				items_seen = wg.items_count();
+				return true;
+			} );
+		REQUIRE( r );
+		REQUIRE( 2u == items_seen );
+		REQUIRE( req_id[ 1 ] == r->second );
+		REQUIRE( concat_bufs( r->first ) == "1a1b" );
+	}
+
+	{
+		auto r = coordinator.pop_ready_buffers_if( accept_all );
+		REQUIRE( r );
+		REQUIRE( req_id[ 2 ] == r->second );
+		REQUIRE( concat_bufs( r->first ) == "2a2b2c" );
+	}
+
+	// Response #2 closes the connection so nothing more can be taken.
+	REQUIRE( coordinator.closed() );
+	REQUIRE_FALSE( coordinator.pop_ready_buffers_if( accept_all ) );
+}
+
 TEST_CASE( "response_coordinator reset" , "[response_coordinator][connection_close]" )
 {
 	{
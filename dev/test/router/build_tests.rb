@@ -9,10 +9,13 @@ MxxRu::Cpp::composite_target {
 	required_prj( "test/router/easy_parser_router_dsl/prj.ut.rb" )
 	required_prj( "test/router/easy_parser_path_to_tuple/prj.ut.rb" )
 	required_prj( "test/router/easy_parser_path_to_params/prj.ut.rb" )
+	required_prj( "test/router/static_easy_parser_router/prj.ut.rb" )
 
 	required_prj( "test/router/express/prj.ut.rb" )
 	required_prj( "test/router/express_router/prj.ut.rb" )
 	required_prj( "test/router/express_router_user_data_simple/prj.ut.rb" )
+	required_prj( "test/router/radix_express_router/prj.ut.rb" )
+	required_prj( "test/router/route_hits/prj.ut.rb" )
 	required_prj( "test/router/express_router_bench/prj.rb" )
 
 	if RestinioPCREFind.has_pcre(toolset)
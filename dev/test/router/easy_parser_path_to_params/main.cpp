@@ -543,3 +543,121 @@ TEST_CASE( "Http method matchers (test_user_data)" ,
 	> >();
 }
 
+
+template< typename Router >
+void
+tc_leading_literals_index()
+{
+	int last_handler_called = -1;
+
+	auto extract_last_handler_called = [&]{
+		int result = last_handler_called;
+		last_handler_called = -1;
+		return result;
+	};
+
+	auto handle = [&]( auto && route ) {
+		return [&last_handler_called, route]( const auto &, auto && ... ) {
+			last_handler_called = route;
+			return request_accepted();
+		};
+	};
+
+	Router router;
+
+	// Leading literal: "/api/v1/users".
+	router.add_handler(
+		http_method_get(),
+		epr::path_to_params( "/api/v1/users" ),
+		handle( 0 ) );
+
+	// Leading literal: "/api/".
+	router.add_handler(
+		restinio::router::any_of_methods(
+				http_method_get(), http_method_post() ),
+		epr::path_to_params( "/api/", epr::path_fragment_p(), "/users" ),
+		handle( 1 ) );
+
+	// Leading literal: "/api/v2/items".
+	router.add_handler(
+		http_method_get(),
+		epr::path_to_params( epr::exact( "/api/v2" ), std::string{ "/items" } ),
+		handle( 2 ) );
+
+	// Leading literal: "/api/v1/users".
+	router.add_handler(
+		http_method_post(),
+		epr::path_to_params( epr::exact_p( "/api/v1" ) >> epr::skip(), "/users" ),
+		handle( 3 ) );
+
+	// Leading literal: "/".
+	router.add_handler(
+		http_method_get(),
+		epr::path_to_params(
+			"/", epr::path_fragment_p(), "/", epr::path_fragment_p(), "/items" ),
+		handle( 4 ) );
+
+	// Leading literal: "/api/v3/items".
+	router.add_handler(
+		http_method_get(),
+		epr::path_to_params( "/api/v3/items" ),
+		handle( 5 ) );
+
+	// No leading literal.
+	router.add_handler(
+		restinio::router::none_of_methods( http_method_get() ),
+		epr::path_to_params(
+			epr::symbol_p( '/' ) >> epr::skip(), "other" ),
+		handle( 6 ) );
+
+	// Leading literal: "/ap" (splits existing nodes of the index).
+	router.add_handler(
+		http_method_get(),
+		epr::path_to_params( string_view_t{ "/ap" }, epr::path_fragment_p() ),
+		handle( 7 ) );
+
+	const auto check = [&]( int expected, std::string target,
+		http_method_id_t method )
+	{
+		INFO( method.c_str() << " " << target );
+		const auto r = router(
+				create_fake_request( router, std::move( target ), method ) );
+		if( expected < 0 )
+			REQUIRE( request_not_handled() == r );
+		else
+			REQUIRE( request_accepted() == r );
+		REQUIRE( expected == extract_last_handler_called() );
+	};
+
+	check( 0, "/api/v1/users", http_method_get() );
+	check( 0, "/api/v1/users/", http_method_get() );
+	check( 1, "/api/v1/users", http_method_post() );
+	check( 1, "/api/x/users", http_method_get() );
+	check( -1, "/api/x/users", http_method_delete() );
+	check( 2, "/api/v2/items", http_method_get() );
+	check( -1, "/api/v2/items", http_method_post() );
+	check( 4, "/api/v3/items", http_method_get() );
+	check( 4, "/a/b/items", http_method_get() );
+	check( 6, "/other", http_method_post() );
+	check( 6, "/other", http_method_delete() );
+	check( -1, "/other", http_method_get() );
+	check( 7, "/api", http_method_get() );
+	check( 7, "/apx", http_method_get() );
+	check( -1, "/ap", http_method_get() );
+	check( -1, "/", http_method_get() );
+	check( -1, "", http_method_get() );
+}
+
+TEST_CASE( "Leading literals index (no_user_data)" ,
+		"[easy_parser][leading_literals][no_user_data]" )
+{
+	tc_leading_literals_index< restinio::router::easy_parser_router_t >();
+}
+
+TEST_CASE( "Leading literals index (test_user_data)" ,
+		"[easy_parser][leading_literals][test_user_data]" )
+{
+	tc_leading_literals_index< restinio::router::generic_easy_parser_router_t<
+		test::ud_factory_t
+	> >();
+}
@@ -87,3 +87,33 @@ TEST_CASE("normal path_to_tuple", "[path_to_tuple]")
 	REQUIRE( 4325 == std::get<1>(*r) );
 }
 
+
+TEST_CASE("leading literal", "[path_to_tuple][path_to_params][leading_literal]")
+{
+	auto id_p = epr::non_negative_decimal_number_p<int>();
+
+	const restinio::string_view_t slash{ "/" };
+	std::string books_tag{ "books" };
+
+	REQUIRE( "/api/v1/books/" == epr::path_to_tuple(
+			slash, "api", slash, "v1", slash, books_tag, std::string{"/"},
+			id_p,
+			slash, "versions" ).leading_literal() );
+
+	REQUIRE( "/api/v1/books/" == epr::path_to_params(
+			epr::exact( "/api/v1" ),
+			epr::exact_p( restinio::string_view_t{ "/books/" } ) >> epr::skip(),
+			id_p ).leading_literal() );
+
+	REQUIRE( "/api/v1/books" == epr::path_to_params(
+			"/api", epr::exact_p( "/v1" ), "/books" ).leading_literal() );
+
+	REQUIRE( "/api" == epr::path_to_params(
+			"/api", epr::caseless_exact_p( "/v1" ), "/books" ).leading_literal() );
+
+	REQUIRE( "/api/v1/books" == epr::path_to_params(
+			"/api/v1/books" ).leading_literal() );
+
+	REQUIRE( epr::path_to_tuple(
+			id_p, "/api/v1/books" ).leading_literal().empty() );
+}
@@ -159,3 +159,102 @@ TEST_CASE( "value_or" , "[value_or]" )
 															"2.71828" );
 }
 
+
+TEST_CASE( "Simple routes without regex" , "[path2regex][simple_route_matcher]" )
+{
+	struct route_t
+	{
+		const char * m_path;
+		path2regex::options_t m_options;
+		bool m_simple;
+	};
+
+	const std::vector< route_t > routes{
+		{ "", {}, true },
+		{ "/", {}, true },
+		{ "/", path2regex::options_t{}.strict( true ), true },
+		{ "/api/v1/users", {}, true },
+		{ "/api/v1/users/", {}, true },
+		{ "/api/v1/users/", path2regex::options_t{}.strict( true ), true },
+		{ "/api/v1/users/:id", {}, true },
+		{ "/API/v1/users/:id", path2regex::options_t{}.sensitive( true ), true },
+		{ "/api/v1/users/:id/orders/:order", {}, true },
+		{ "/:a/:b/:c", {}, true },
+		{ "/user-:id/info", {}, true },
+		{ "/(\\d+)/:x", {}, false },
+		{ "/api/v1/users/:id(\\d+)", {}, false },
+		{ "/files/:name(.*)", {}, false },
+		{ "/opt/:a?", {}, false },
+		{ "/rep/:parts+", {}, false },
+		{ "/ext/:file.:ext", {}, false },
+		{ "/ext/:file.json", {}, false },
+		{ "/prefix", path2regex::options_t{}.ending( false ), false },
+		{ "/ends", path2regex::options_t{}.ends_with( { "?" } ), false },
+		{ "/escaped\\:colon/:p", {}, true },
+	};
+
+	const std::vector< std::string > targets{
+		"", "/", "//",
+		"/api/v1/users", "/api/v1/users/", "/api/v1/users//", "/API/V1/USERS",
+		"/api/v1/users/42", "/api/v1/users/42/", "/API/v1/users/42",
+		"/api/v1/users/42/orders/7", "/api/v1/users/42/orders/7/",
+		"/api/v1/users//orders/7", "/api/v1/users/42/orders/",
+		"/a/b/c", "/a/b/c/", "/a/b", "/a//c", "/a/b/c/d",
+		"/user-42/info", "/user-/info", "/USER-42/INFO",
+		"/123/x", "/files/a/b", "/opt/", "/rep/a/b", "/ext/a.b",
+		"/prefix/x", "/ends", "/escaped:colon/1",
+	};
+
+	const auto make_matcher = []( const route_t & r, bool use_simple ) {
+		auto matcher_data =
+			path2regex::path2regex< restinio::router::impl::route_params_appender_t, regex_engine_t >(
+				r.m_path,
+				r.m_options );
+
+		REQUIRE( r.m_simple == static_cast< bool >( matcher_data.m_simple_matcher ) );
+
+		return route_matcher_t{
+				http_method_get(),
+				std::move( matcher_data.m_regex ),
+				std::move( matcher_data.m_named_params_buffer ),
+				std::move( matcher_data.m_param_appender_sequence ),
+				use_simple ?
+					std::move( matcher_data.m_simple_matcher ) :
+					restinio::nullopt };
+	};
+
+	const auto describe = []( const route_matcher_t & rm, const std::string & target ) {
+		route_params_t params;
+		restinio::router::impl::target_path_holder_t target_path{ target };
+		if( !rm.match_route( target_path, params ) )
+			return std::string{ "<no match>" };
+
+		std::string result{ params.match().data(), params.match().size() };
+		for( const auto & p :
+			restinio::router::impl::route_params_accessor_t::named_parameters( params ) )
+		{
+			result += " " + std::string{ p.first.data(), p.first.size() } +
+					"=" + std::string{ p.second.data(), p.second.size() };
+		}
+		for( const auto & p :
+			restinio::router::impl::route_params_accessor_t::indexed_parameters( params ) )
+		{
+			result += " [" + std::string{ p.data(), p.size() } + "]";
+		}
+
+		return result;
+	};
+
+	for( const auto & r : routes )
+	{
+		const auto regex_matcher = make_matcher( r, false );
+		const auto simple_matcher = make_matcher( r, true );
+
+		for( const auto & target : targets )
+		{
+			INFO( "route: '" << r.m_path << "', target: '" << target << "'" );
+			REQUIRE( describe( regex_matcher, target ) ==
+					describe( simple_matcher, target ) );
+		}
+	}
+}
@@ -0,0 +1,223 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for express router with radix tree.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <iterator>
+
+#include <restinio/all.hpp>
+#include <restinio/router/radix_express.hpp>
+
+using namespace restinio;
+
+using express_router_t = restinio::router::radix_express_router_t<>;
+using restinio::router::route_params_t;
+
+#include "../../common/fake_connection.ipp"
+
+template< typename Regex_Engine, typename Extra_Data_Factory >
+auto
+create_fake_request(
+	const restinio::router::generic_radix_express_router_t<
+			Regex_Engine, Extra_Data_Factory > &,
+	std::string target,
+	http_method_id_t method = http_method_get() )
+{
+	using request_t = restinio::generic_request_t<
+			typename Extra_Data_Factory::data_t
+	>;
+
+	Extra_Data_Factory extra_data_factory;
+	return std::make_shared< request_t >(
+			0,
+			http_request_header_t{ method, std::move( target ) },
+			"",
+			std::make_shared< fake_connection_t >(),
+			restinio::endpoint_t{
+				restinio::asio_ns::ip::make_address_v4("127.0.0.1"),
+				3000 },
+			extra_data_factory );
+}
+
+#include "../express_router/tests.ipp"
+
+//! Description of a handled request for comparison of routers.
+struct handled_t
+{
+	int m_route{ -1 };
+	std::string m_match;
+	std::vector< std::pair< std::string, std::string > > m_named;
+	std::vector< std::string > m_indexed;
+
+	bool
+	operator==( const handled_t & o ) const
+	{
+		return m_route == o.m_route && m_match == o.m_match &&
+				m_named == o.m_named && m_indexed == o.m_indexed;
+	}
+};
+
+std::ostream &
+operator<<( std::ostream & to, const handled_t & h )
+{
+	to << "{route: " << h.m_route << ", match: '" << h.m_match << "', named: [";
+	for( const auto & p : h.m_named )
+		to << p.first << "='" << p.second << "' ";
+	to << "], indexed: [";
+	for( const auto & p : h.m_indexed )
+		to << "'" << p << "' ";
+	return to << "]}";
+}
+
+template< typename Router >
+handled_t
+route_request( Router & router, handled_t & last, std::string target,
+	http_method_id_t method )
+{
+	last = handled_t{};
+	(void)router( create_fake_request( router, std::move( target ), method ) );
+	return last;
+}
+
+TEST_CASE( "Same results as express_router_t" , "[radix_express][equivalence]" )
+{
+	struct route_t
+	{
+		http_method_id_t m_method;
+		const char * m_path;
+		path2regex::options_t m_options;
+	};
+
+	const std::vector< route_t > routes{
+		{ http_method_get(), "/", {} },
+		{ http_method_get(), "/api/v1/users", {} },
+		{ http_method_post(), "/api/v1/users", {} },
+		{ http_method_get(), "/api/v1/users/:id(\\d+)", {} },
+		{ http_method_get(), "/api/v1/users/:name", {} },
+		{ http_method_get(), "/api/v1/users/:id/orders", {} },
+		{ http_method_delete(), "/api/v1/users/:id/orders/:order", {} },
+		{ http_method_get(), "/api/v1/users/me", {} },
+		{ http_method_get(), "/API/V2/Items", path2regex::options_t{}.sensitive( true ) },
+		{ http_method_get(), "/api/v2/items", {} },
+		{ http_method_get(), "/files/:name(.*)", {} },
+		{ http_method_get(), "/files/static/:file", {} },
+		{ http_method_get(), "/opt/:a/:b?", {} },
+		{ http_method_get(), "/rep/:parts+", {} },
+		{ http_method_get(), "/ext/:file.:ext", {} },
+		{ http_method_get(), "/dash/v-:version/info", {} },
+		{ http_method_get(), "/strict/", path2regex::options_t{}.strict( true ) },
+		{ http_method_get(), "/prefix", path2regex::options_t{}.ending( false ) },
+		{ http_method_get(), "/(\\d+)/:x", {} },
+		{ http_method_get(), "/:a/:b/:c", {} },
+		{ http_method_get(), "/a/:b/c", {} },
+		{ http_method_get(), "/a/b/:c", {} },
+		{ http_method_get(), "/escaped\\:colon/:p", {} },
+		{ http_method_get(), "/news/:year(\\d{4})-:month(\\d{2})", {} },
+	};
+
+	const std::vector< std::string > targets{
+		"/", "//", "",
+		"/api/v1/users", "/api/v1/users/", "/API/V1/USERS", "/api/v1/users//",
+		"/api/v1/users/42", "/api/v1/users/john", "/api/v1/users/me",
+		"/api/v1/users/me/", "/api/v1/users/42/orders", "/api/v1/users/42/orders/",
+		"/api/v1/users/42/orders/7", "/api/v1/users/42/orders/7/",
+		"/api/v1/users/42/orders/7/x", "/api/v1/Users/Me",
+		"/API/V2/Items", "/api/v2/items", "/Api/V2/Items",
+		"/files/a/b/c.txt", "/files/static/x.css", "/files/static/", "/files/",
+		"/opt/1", "/opt/1/2", "/opt/1/2/3", "/rep/a/b/c", "/rep/",
+		"/ext/a.b", "/ext/a.b.c", "/ext/abc",
+		"/dash/v-1.2/info", "/dash/v-/info", "/dash/v1/info",
+		"/strict/", "/strict", "/strict//",
+		"/prefix", "/prefix/", "/prefix/more", "/prefixmore",
+		"/123/x", "/123/x/", "/a/b/c", "/a/x/c", "/a/b/x", "/x/y/z", "/x/y/z/",
+		"/a//c", "/escaped:colon/1", "/escaped/colon/1",
+		"/news/2017-04", "/news/17-04",
+		"/%7Eu/a/b", "/a/b/c?query",
+	};
+
+	const std::vector< http_method_id_t > methods{
+		http_method_get(), http_method_post(), http_method_delete()
+	};
+
+	handled_t last;
+	restinio::router::express_router_t<> linear;
+	express_router_t radix;
+
+	for( std::size_t i = 0u; i < routes.size(); ++i )
+	{
+		const auto make_handler = [&last, i]() {
+			return [&last, i]( auto, route_params_t p ) {
+				using restinio::router::impl::route_params_accessor_t;
+
+				last.m_route = static_cast< int >( i );
+				last.m_match = std::string{ p.match().data(), p.match().size() };
+				for( const auto & np : route_params_accessor_t::named_parameters( p ) )
+					last.m_named.emplace_back(
+							std::string{ np.first.data(), np.first.size() },
+							std::string{ np.second.data(), np.second.size() } );
+				for( const auto & ip : route_params_accessor_t::indexed_parameters( p ) )
+					last.m_indexed.emplace_back( ip.data(), ip.size() );
+
+				return request_accepted();
+			};
+		};
+
+		const auto & r = routes[ i ];
+		linear.add_handler( r.m_method, r.m_path, r.m_options, make_handler() );
+		radix.add_handler( r.m_method, r.m_path, r.m_options, make_handler() );
+	}
+
+	for( const auto & target : targets )
+		for( const auto & method : methods )
+		{
+			INFO( method.c_str() << " " << target );
+			REQUIRE( route_request( linear, last, target, method ) ==
+					route_request( radix, last, target, method ) );
+		}
+
+	// Some results that should be found.
+	REQUIRE( 3 == route_request( radix, last, "/api/v1/users/42", http_method_get() ).m_route );
+	REQUIRE( 4 == route_request( radix, last, "/api/v1/users/me", http_method_get() ).m_route );
+	REQUIRE( 6 == route_request( radix, last, "/api/v1/users/42/orders/7", http_method_delete() ).m_route );
+	REQUIRE( 8 == route_request( radix, last, "/API/V2/Items", http_method_get() ).m_route );
+	REQUIRE( 9 == route_request( radix, last, "/Api/V2/Items", http_method_get() ).m_route );
+}
+
+TEST_CASE( "Many routes" , "[radix_express][many_routes]" )
+{
+	handled_t last;
+	express_router_t router;
+
+	for( int i = 0; i < 1000; ++i )
+	{
+		router.http_get(
+			"/api/v1/resource" + std::to_string( i ) + "/:id/items/:item",
+			[&last, i]( auto, route_params_t p ) {
+				last.m_route = i;
+				last.m_named.emplace_back(
+						std::string{ p[ "id" ].data(), p[ "id" ].size() },
+						std::string{ p[ "item" ].data(), p[ "item" ].size() } );
+				return request_accepted();
+			} );
+	}
+
+	for( int i = 0; i < 1000; i += 7 )
+	{
+		const auto h = route_request( router, last,
+				"/api/v1/resource" + std::to_string( i ) + "/42/items/abc",
+				http_method_get() );
+		REQUIRE( i == h.m_route );
+		REQUIRE( "42" == h.m_named.at( 0 ).first );
+		REQUIRE( "abc" == h.m_named.at( 0 ).second );
+	}
+
+	REQUIRE( -1 == route_request( router, last,
+			"/api/v1/resource1000/42/items/abc", http_method_get() ).m_route );
+	REQUIRE( -1 == route_request( router, last,
+			"/api/v1/resource1/42/items/abc", http_method_post() ).m_route );
+}
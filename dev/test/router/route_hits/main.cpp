@@ -0,0 +1,412 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for route hits counters and adaptive order of routes.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+#include <restinio/router/easy_parser_router.hpp>
+
+#include <atomic>
+#include <thread>
+
+using namespace restinio;
+
+namespace epr = restinio::router::easy_parser_router;
+
+using express_router_t = restinio::router::express_router_t<>;
+using restinio::router::route_params_t;
+
+#include "../fake_connection_and_request.ipp"
+
+template< typename Regex_Engine, typename Extra_Data_Factory >
+auto
+create_fake_request(
+	const restinio::router::generic_express_router_t<
+			Regex_Engine, Extra_Data_Factory > &,
+	std::string target,
+	http_method_id_t method = http_method_get() )
+{
+	using request_t = restinio::generic_request_t<
+			typename Extra_Data_Factory::data_t
+	>;
+
+	Extra_Data_Factory extra_data_factory;
+	return std::make_shared< request_t >(
+			0,
+			http_request_header_t{ method, std::move( target ) },
+			"",
+			std::make_shared< fake_connection_t >(),
+			restinio::endpoint_t{
+				restinio::asio_ns::ip::make_address_v4("127.0.0.1"),
+				3000 },
+			extra_data_factory );
+}
+
+std::vector< std::uint64_t >
+hits_of( const std::vector< restinio::router::route_hits_t > & hits )
+{
+	std::vector< std::uint64_t > result;
+	for( const auto & h : hits )
+	{
+		REQUIRE( result.size() == h.m_route );
+		result.push_back( h.m_hits );
+	}
+
+	return result;
+}
+
+//! Method matcher that counts attempts of matching.
+struct counting_matcher_t final : public restinio::router::method_matcher_t
+{
+	std::size_t * m_calls;
+
+	explicit counting_matcher_t( std::size_t & calls ) : m_calls{ &calls }
+	{}
+
+	RESTINIO_NODISCARD
+	bool
+	match( const http_method_id_t & ) const noexcept override
+	{
+		++(*m_calls);
+		return true;
+	}
+};
+
+TEST_CASE( "leading literal of express route" , "[express][leading_literal]" )
+{
+	using restinio::router::impl::leading_literal_of_route;
+
+	const path2regex::options_t options;
+
+	REQUIRE( "/api/v1/users" == leading_literal_of_route( "/api/v1/users", options ) );
+	REQUIRE( "/api/v1/users/" ==
+			leading_literal_of_route( "/api/v1/users/:id", options ) );
+	REQUIRE( "/api/v1/users/" ==
+			leading_literal_of_route( "/api/v1/users/:id(\\d+)/orders", options ) );
+	REQUIRE( "/api/v1/users" ==
+			leading_literal_of_route( "/api/v1/users/:id?", options ) );
+	REQUIRE( "/api/v1/users" ==
+			leading_literal_of_route( "/api/v1/users/:id*", options ) );
+	REQUIRE( "/api/v1/users/" ==
+			leading_literal_of_route( "/api/v1/users/:id+", options ) );
+	REQUIRE( "/" == leading_literal_of_route( "/:id", options ) );
+	REQUIRE( "" == leading_literal_of_route( ":id", options ) );
+	REQUIRE( "" == leading_literal_of_route( "", options ) );
+}
+
+TEST_CASE( "routes that may conflict" , "[may_conflict]" )
+{
+	using restinio::router::impl::route_conflict_info_t;
+	using restinio::router::impl::may_conflict;
+
+	const route_conflict_info_t get_users{ http_method_get(), "/Users" };
+	const route_conflict_info_t get_user{ http_method_get(), "/users/" };
+	const route_conflict_info_t post_user{ http_method_post(), "/users/" };
+	const route_conflict_info_t any_user{ nullopt, "/users/" };
+	const route_conflict_info_t get_books{ http_method_get(), "/books" };
+	const route_conflict_info_t get_any{ http_method_get(), "" };
+
+	REQUIRE( may_conflict( get_users, get_user ) );
+	REQUIRE( may_conflict( get_user, get_users ) );
+	REQUIRE( !may_conflict( get_user, post_user ) );
+	REQUIRE( may_conflict( get_user, any_user ) );
+	REQUIRE( may_conflict( post_user, any_user ) );
+	REQUIRE( !may_conflict( get_users, get_books ) );
+	REQUIRE( !may_conflict( any_user, get_books ) );
+	REQUIRE( may_conflict( get_any, get_books ) );
+	REQUIRE( may_conflict( get_any, any_user ) );
+}
+
+TEST_CASE( "express router hits" , "[express][route_hits]" )
+{
+	express_router_t router;
+
+	const auto handler = []( auto, auto ){ return request_accepted(); };
+
+	router.http_get( "/users", handler );
+	router.http_get( "/users/:id", handler );
+
+	REQUIRE( router.route_hits().empty() );
+
+	REQUIRE( request_accepted() ==
+			router( create_fake_request( router, "/users/1" ) ) );
+	REQUIRE( router.route_hits().empty() );
+
+	router.enable_route_hits_counting();
+	router.http_post( "/users", handler );
+
+	REQUIRE( hits_of( router.route_hits() ) ==
+			std::vector< std::uint64_t >{ 0u, 0u, 0u } );
+
+	REQUIRE( request_accepted() ==
+			router( create_fake_request( router, "/users/1" ) ) );
+	REQUIRE( request_accepted() ==
+			router( create_fake_request( router, "/users/2" ) ) );
+	REQUIRE( request_accepted() ==
+			router( create_fake_request( router, "/users" ) ) );
+	REQUIRE( request_accepted() ==
+			router( create_fake_request( router, "/users", http_method_post() ) ) );
+	REQUIRE( request_not_handled() ==
+			router( create_fake_request( router, "/books" ) ) );
+
+	REQUIRE( hits_of( router.route_hits() ) ==
+			std::vector< std::uint64_t >{ 1u, 2u, 1u } );
+
+	router.reset_route_hits();
+	REQUIRE( hits_of( router.route_hits() ) ==
+			std::vector< std::uint64_t >{ 0u, 0u, 0u } );
+}
+
+TEST_CASE( "express router adaptive order" , "[express][adaptive_route_order]" )
+{
+	std::size_t calls[ 3 ] = { 0u, 0u, 0u };
+	int last_handler_called = -1;
+
+	const auto make_handler = [&]( int route ) {
+		return [&last_handler_called, route]( auto, auto ) {
+			last_handler_called = route;
+			return request_accepted();
+		};
+	};
+
+	express_router_t router;
+	router.enable_adaptive_route_order( 4u );
+
+	router.add_handler( counting_matcher_t{ calls[ 0 ] }, "/a", make_handler( 0 ) );
+	router.add_handler( counting_matcher_t{ calls[ 1 ] }, "/b", make_handler( 1 ) );
+	router.add_handler( counting_matcher_t{ calls[ 2 ] }, "/c", make_handler( 2 ) );
+
+	REQUIRE_THROWS_AS( router.enable_adaptive_route_order( 4u ), exception_t );
+
+	// Routes are checked in order of registration before the first reordering.
+	for( int i = 0; i != 3; ++i )
+	{
+		REQUIRE( request_accepted() ==
+				router( create_fake_request( router, "/c" ) ) );
+		REQUIRE( 2 == last_handler_called );
+	}
+	REQUIRE( 3u == calls[ 0 ] );
+	REQUIRE( 3u == calls[ 1 ] );
+	REQUIRE( 3u == calls[ 2 ] );
+
+	// The 4th request leads to reordering.
+	REQUIRE( request_accepted() ==
+			router( create_fake_request( router, "/c" ) ) );
+	REQUIRE( 2 == last_handler_called );
+
+	// Now the hot route is checked first.
+	for( auto & c : calls )
+		c = 0u;
+	REQUIRE( request_accepted() ==
+			router( create_fake_request( router, "/c" ) ) );
+	REQUIRE( 2 == last_handler_called );
+	REQUIRE( 0u == calls[ 0 ] );
+	REQUIRE( 0u == calls[ 1 ] );
+	REQUIRE( 1u == calls[ 2 ] );
+
+	REQUIRE( request_accepted() ==
+			router( create_fake_request( router, "/a" ) ) );
+	REQUIRE( 0 == last_handler_called );
+	REQUIRE( 1u == calls[ 0 ] );
+	REQUIRE( 0u == calls[ 1 ] );
+	REQUIRE( 2u == calls[ 2 ] );
+
+	REQUIRE( hits_of( router.route_hits() ) ==
+			std::vector< std::uint64_t >{ 1u, 0u, 5u } );
+}
+
+TEST_CASE( "express router adaptive order keeps first match" ,
+		"[express][adaptive_route_order][equivalence]" )
+{
+	int last_handler_called = -1;
+
+	const auto make_handler = [&]( int route ) {
+		return [&last_handler_called, route]( auto, auto ) {
+			last_handler_called = route;
+			return request_accepted();
+		};
+	};
+
+	const auto fill = [&]( express_router_t & router ) {
+		router.http_get( "/books", make_handler( 0 ) );
+		router.http_get( "/books/:id(\\d+)", make_handler( 1 ) );
+		router.http_get( "/books/:name", make_handler( 2 ) );
+		router.http_post( "/books", make_handler( 3 ) );
+		router.add_handler(
+				restinio::router::any_of_methods(
+					http_method_put(), http_method_delete() ),
+				"/books/:id", make_handler( 4 ) );
+		router.http_get( "/:any", make_handler( 5 ) );
+		router.http_get( "/authors/:id?", make_handler( 6 ) );
+		router.http_get( "/Authors/top", make_handler( 7 ) );
+		router.add_handler(
+				restinio::router::none_of_methods( http_method_get() ),
+				"/authors/:id", make_handler( 8 ) );
+		router.http_get( "/books/:id/versions/:v", make_handler( 9 ) );
+	};
+
+	express_router_t plain_router;
+	fill( plain_router );
+
+	express_router_t adaptive_router;
+	adaptive_router.enable_adaptive_route_order( 1u );
+	fill( adaptive_router );
+
+	const std::vector< std::string > targets{
+		"/authors/top", "/books/1/versions/2", "/books/1", "/authors/top",
+		"/books/abc", "/books", "/authors", "/authors/1", "/authors/top",
+		"/AUTHORS/TOP", "/x", "/", "/books/1/versions/2", "/authors/top",
+		"/books/1", "/books/1", "/books/1", "/books/1/versions/2"
+	};
+
+	for( int round = 0; round != 3; ++round )
+		for( const auto & target : targets )
+			for( const auto & method : { http_method_get(), http_method_post(),
+					http_method_put(), http_method_delete() } )
+			{
+				INFO( method.c_str() << " " << target );
+
+				last_handler_called = -1;
+				const auto plain_result = plain_router(
+						create_fake_request( plain_router, target, method ) );
+				const auto plain_handler = last_handler_called;
+
+				last_handler_called = -1;
+				const auto adaptive_result = adaptive_router(
+						create_fake_request( adaptive_router, target, method ) );
+
+				REQUIRE( plain_result == adaptive_result );
+				REQUIRE( plain_handler == last_handler_called );
+			}
+}
+
+TEST_CASE( "express router adaptive order in several threads" ,
+		"[express][adaptive_route_order][threads]" )
+{
+	express_router_t router;
+	router.enable_adaptive_route_order( 1u );
+
+	std::atomic< int > wrong_handler_calls{ 0 };
+	const auto make_handler = [&]( std::string expected_target ) {
+		return [&wrong_handler_calls, expected_target]( auto req, auto ) {
+			if( req->header().path() != expected_target )
+				++wrong_handler_calls;
+			return request_accepted();
+		};
+	};
+
+	router.http_get( "/a", make_handler( "/a" ) );
+	router.http_get( "/b", make_handler( "/b" ) );
+	router.http_get( "/c", make_handler( "/c" ) );
+
+	constexpr std::size_t threads_count = 4u;
+	constexpr std::size_t requests_per_thread = 2000u;
+
+	// Every request leads to reordering, so threads replace the order
+	// while others use it.
+	std::vector< std::thread > threads;
+	for( std::size_t t = 0u; t != threads_count; ++t )
+		threads.emplace_back( [&router, t] {
+			const char * targets[] = { "/a", "/b", "/c" };
+			for( std::size_t i = 0u; i != requests_per_thread; ++i )
+			{
+				// Different threads make different routes hot.
+				const auto target = targets[ ( i % 5u ) ? t % 3u : i % 3u ];
+				(void)router( create_fake_request( router, target ) );
+			}
+		} );
+
+	for( auto & t : threads )
+		t.join();
+
+	REQUIRE( 0 == wrong_handler_calls );
+
+	std::uint64_t total = 0u;
+	for( const auto h : hits_of( router.route_hits() ) )
+		total += h;
+	REQUIRE( threads_count * requests_per_thread == total );
+}
+
+TEST_CASE( "several express routers with adaptive order in one thread" ,
+		"[express][adaptive_route_order]" )
+{
+	int last_handler_called = -1;
+	const auto make_handler = [&]( int route ) {
+		return [&last_handler_called, route]( auto, auto ) {
+			last_handler_called = route;
+			return request_accepted();
+		};
+	};
+
+	// Every thread caches the order of a router, the cache shouldn't
+	// be mixed up between routers.
+	express_router_t first;
+	first.enable_adaptive_route_order( 2u );
+	first.http_get( "/a", make_handler( 0 ) );
+	first.http_get( "/b", make_handler( 1 ) );
+
+	express_router_t second;
+	second.enable_adaptive_route_order( 3u );
+	second.http_get( "/b", make_handler( 10 ) );
+	second.http_get( "/c", make_handler( 11 ) );
+	second.http_get( "/a", make_handler( 12 ) );
+
+	for( int i = 0; i != 10; ++i )
+	{
+		REQUIRE( request_accepted() == first( create_fake_request( first, "/b" ) ) );
+		REQUIRE( 1 == last_handler_called );
+		REQUIRE( request_not_handled() ==
+				first( create_fake_request( first, "/c" ) ) );
+
+		REQUIRE( request_accepted() ==
+				second( create_fake_request( second, "/a" ) ) );
+		REQUIRE( 12 == last_handler_called );
+		REQUIRE( request_accepted() ==
+				second( create_fake_request( second, "/c" ) ) );
+		REQUIRE( 11 == last_handler_called );
+	}
+}
+
+TEST_CASE( "easy_parser router hits" , "[easy_parser_router][route_hits]" )
+{
+	restinio::router::easy_parser_router_t router;
+
+	const auto id_p = epr::non_negative_decimal_number_p< int >();
+
+	router.http_get( epr::path_to_params( "/users" ),
+			[]( const auto & ) { return request_accepted(); } );
+	router.http_get( epr::path_to_params( "/users/", id_p ),
+			[]( const auto &, int ) { return request_accepted(); } );
+
+	REQUIRE( router.route_hits().empty() );
+
+	router.enable_route_hits_counting();
+	router.add_handler(
+			restinio::router::any_of_methods(
+				http_method_post(), http_method_put() ),
+			epr::path_to_params( "/users/", id_p ),
+			[]( const auto &, int ) { return request_rejected(); } );
+
+	REQUIRE( request_accepted() ==
+			router( create_fake_request( router, "/users/1" ) ) );
+	REQUIRE( request_accepted() ==
+			router( create_fake_request( router, "/users/2/" ) ) );
+	REQUIRE( request_accepted() ==
+			router( create_fake_request( router, "/users" ) ) );
+	REQUIRE( request_rejected() ==
+			router( create_fake_request( router, "/users/1", http_method_put() ) ) );
+	REQUIRE( request_not_handled() ==
+			router( create_fake_request( router, "/users/x" ) ) );
+
+	REQUIRE( hits_of( router.route_hits() ) ==
+			std::vector< std::uint64_t >{ 1u, 2u, 1u } );
+
+	router.reset_route_hits();
+	REQUIRE( hits_of( router.route_hits() ) ==
+			std::vector< std::uint64_t >{ 0u, 0u, 0u } );
+}
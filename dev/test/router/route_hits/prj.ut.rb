@@ -0,0 +1,9 @@
+require 'mxx_ru/binary_unittest'
+
+path = 'test/router/route_hits'
+
+Mxx_ru::setup_target(
+	Mxx_ru::Binary_unittest_target.new(
+		"#{path}/prj.ut.rb",
+		"#{path}/prj.rb" )
+)
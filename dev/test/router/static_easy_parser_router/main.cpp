@@ -0,0 +1,226 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for static easy_parser-based router.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+#include <restinio/router/static_easy_parser_router.hpp>
+
+using namespace restinio;
+
+namespace epr = restinio::router::easy_parser_router;
+
+#include "../fake_connection_and_request.ipp"
+#include "../../common/test_extra_data_factory.ipp"
+
+template< typename Extra_Data_Factory >
+auto
+create_fake_request(
+	std::string target,
+	http_method_id_t method = http_method_get() )
+{
+	using request_t = restinio::generic_request_t<
+			typename Extra_Data_Factory::data_t
+	>;
+
+	Extra_Data_Factory extra_data_factory;
+	return std::make_shared< request_t >(
+			0,
+			http_request_header_t{ method, std::move( target ) },
+			"",
+			std::make_shared< fake_connection_t >(),
+			restinio::endpoint_t{
+				restinio::asio_ns::ip::make_address_v4("127.0.0.1"),
+				3000 },
+			extra_data_factory );
+}
+
+template< typename Extra_Data_Factory >
+void
+tc_static_router()
+{
+	int last_handler_called = -1;
+	std::string last_params;
+
+	auto extract_last_handler_called = [&]{
+		int result = last_handler_called;
+		last_handler_called = -1;
+		return result;
+	};
+
+	auto id_p = epr::non_negative_decimal_number_p<int>();
+
+	auto router = restinio::router::make_static_easy_parser_router<
+			Extra_Data_Factory >(
+		epr::route( http_method_get(),
+			epr::path_to_params( "/api/v1/users" ),
+			[&]( const auto & ) {
+				last_handler_called = 0;
+				return request_accepted();
+			} ),
+		epr::route( http_method_get(),
+			epr::path_to_params( "/api/v1/users/", id_p ),
+			[&]( const auto &, int id ) {
+				last_handler_called = 1;
+				last_params = std::to_string( id );
+				return request_accepted();
+			} ),
+		epr::route(
+			restinio::router::any_of_methods(
+					http_method_get(), http_method_post() ),
+			epr::path_to_tuple(
+					"/api/v1/users/", epr::path_fragment_p(),
+					"/", epr::path_fragment_p() ),
+			[&]( const auto &, const auto & params ) {
+				last_handler_called = 2;
+				last_params = std::get<0>( params ) + "," + std::get<1>( params );
+				return request_accepted();
+			} ),
+		epr::route( restinio::router::none_of_methods( http_method_get() ),
+			epr::path_to_params( epr::symbol_p( '/' ) >> epr::skip(),
+					epr::path_fragment_p() ),
+			[&]( const auto &, const std::string & p ) {
+				last_handler_called = 3;
+				last_params = p;
+				return request_accepted();
+			} ),
+		epr::route( http_method_delete(),
+			epr::path_to_params( "/api/v1/users/", id_p ),
+			[&]( const auto &, int ) {
+				last_handler_called = 4;
+				return request_rejected();
+			} ) );
+
+	const auto check = [&]( int expected, std::string target,
+		http_method_id_t method )
+	{
+		INFO( method.c_str() << " " << target );
+		last_params.clear();
+		const auto r = router( create_fake_request< Extra_Data_Factory >(
+				std::move( target ), method ) );
+		if( expected < 0 )
+			REQUIRE( request_not_handled() == r );
+		else if( 4 == expected )
+			REQUIRE( request_rejected() == r );
+		else
+			REQUIRE( request_accepted() == r );
+		REQUIRE( expected == extract_last_handler_called() );
+	};
+
+	check( 0, "/api/v1/users", http_method_get() );
+	check( 0, "/api/v1/users/", http_method_get() );
+	check( -1, "/api/v1/user", http_method_get() );
+
+	check( 1, "/api/v1/users/42", http_method_get() );
+	REQUIRE( "42" == last_params );
+	check( 1, "/api/v1/users/42/", http_method_get() );
+	REQUIRE( "42" == last_params );
+
+	check( 2, "/api/v1/users/42/orders", http_method_get() );
+	REQUIRE( "42,orders" == last_params );
+	check( 2, "/api/v1/users/42/orders", http_method_post() );
+	check( -1, "/api/v1/users/42/orders", http_method_put() );
+
+	// Percent-encoded unreserved chars are normalized.
+	check( 1, "/api/v1/%75sers/%34%32", http_method_get() );
+	REQUIRE( "42" == last_params );
+
+	check( 3, "/api", http_method_post() );
+	REQUIRE( "api" == last_params );
+	check( -1, "/api", http_method_get() );
+
+	check( 4, "/api/v1/users/42", http_method_delete() );
+	check( -1, "/", http_method_delete() );
+	check( -1, "", http_method_get() );
+}
+
+TEST_CASE( "static router (no_user_data)" ,
+		"[static_easy_parser_router][no_user_data]" )
+{
+	tc_static_router< restinio::no_extra_data_factory_t >();
+}
+
+TEST_CASE( "static router (test_user_data)" ,
+		"[static_easy_parser_router][test_user_data]" )
+{
+	tc_static_router< test::ud_factory_t >();
+}
+
+TEST_CASE( "same results as easy_parser_router_t" ,
+		"[static_easy_parser_router][equivalence]" )
+{
+	int last_handler_called = -1;
+
+	auto make_handler = [&]( int route ) {
+		return [&last_handler_called, route]( const auto &, auto && ... ) {
+			last_handler_called = route;
+			return request_accepted();
+		};
+	};
+
+	auto id_p = epr::non_negative_decimal_number_p<int>();
+
+	const auto static_router = restinio::router::make_static_easy_parser_router(
+		epr::route( http_method_get(),
+			epr::path_to_params( "/books" ), make_handler( 0 ) ),
+		epr::route( http_method_get(),
+			epr::path_to_params( "/books/", id_p ), make_handler( 1 ) ),
+		epr::route( http_method_get(),
+			epr::path_to_params( "/books/", epr::path_fragment_p() ),
+			make_handler( 2 ) ),
+		epr::route( http_method_post(),
+			epr::path_to_params( "/books" ), make_handler( 3 ) ),
+		epr::route( restinio::router::any_of_methods(
+				http_method_put(), http_method_delete() ),
+			epr::path_to_params( "/books/", id_p, "/versions/", id_p ),
+			make_handler( 4 ) ),
+		epr::route( http_method_get(),
+			epr::path_to_params( epr::exact( "/b" ), epr::path_fragment_p() ),
+			make_handler( 5 ) ) );
+
+	restinio::router::easy_parser_router_t dynamic_router;
+	dynamic_router.http_get( epr::path_to_params( "/books" ), make_handler( 0 ) );
+	dynamic_router.http_get( epr::path_to_params( "/books/", id_p ),
+			make_handler( 1 ) );
+	dynamic_router.http_get(
+			epr::path_to_params( "/books/", epr::path_fragment_p() ),
+			make_handler( 2 ) );
+	dynamic_router.http_post( epr::path_to_params( "/books" ), make_handler( 3 ) );
+	dynamic_router.add_handler( restinio::router::any_of_methods(
+				http_method_put(), http_method_delete() ),
+			epr::path_to_params( "/books/", id_p, "/versions/", id_p ),
+			make_handler( 4 ) );
+	dynamic_router.http_get(
+			epr::path_to_params( epr::exact( "/b" ), epr::path_fragment_p() ),
+			make_handler( 5 ) );
+
+	const std::vector< std::string > targets{
+		"", "/", "/books", "/books/", "/books/1", "/books/1/", "/books/abc",
+		"/books/1/versions/2", "/books/1/versions/x", "/bo", "/b", "/b/",
+		"/booksx", "/BOOKS", "/%62ooks/1"
+	};
+
+	for( const auto & target : targets )
+		for( const auto & method : { http_method_get(), http_method_post(),
+				http_method_put(), http_method_delete() } )
+		{
+			INFO( method.c_str() << " " << target );
+
+			last_handler_called = -1;
+			const auto static_result = static_router(
+					create_fake_request< no_extra_data_factory_t >( target, method ) );
+			const auto static_handler = last_handler_called;
+
+			last_handler_called = -1;
+			const auto dynamic_result = dynamic_router(
+					create_fake_request( dynamic_router, target, method ) );
+
+			REQUIRE( dynamic_result == static_result );
+			REQUIRE( last_handler_called == static_handler );
+		}
+}
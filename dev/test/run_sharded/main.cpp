@@ -0,0 +1,214 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for sharded run mode.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+
+#include <csignal>
+#include <set>
+#include <mutex>
+
+using traits_t = restinio::single_thread_traits_t<
+		restinio::asio_timer_manager_t,
+		utest_logger_t >;
+
+const char * request_str =
+	"GET / HTTP/1.1\r\n"
+	"Host: 127.0.0.1\r\n"
+	"User-Agent: unit-test\r\n"
+	"Accept: */*\r\n"
+	"Connection: close\r\n"
+	"\r\n";
+
+TEST_CASE( "sharded server start/stop" , "[sharded_http_server]" )
+{
+	std::mutex lock;
+	std::set< std::thread::id > handler_threads;
+
+	restinio::sharded_http_server_t< traits_t > server{
+		4u,
+		[&]( std::size_t shard_index, auto & settings ) {
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.request_handler( [&, shard_index]( auto req ) {
+					{
+						std::lock_guard< std::mutex > l{ lock };
+						handler_threads.insert( std::this_thread::get_id() );
+					}
+
+					req->create_response()
+						.append_header( "Content-Type", "text/plain; charset=utf-8" )
+						.set_body( std::to_string( shard_index ) )
+						.done();
+
+					return restinio::request_accepted();
+				} );
+		} };
+
+	REQUIRE( 4u == server.shards_count() );
+
+	server.start();
+	REQUIRE( server.started() );
+
+	for( int i = 0; i != 32; ++i )
+	{
+		std::string response;
+		REQUIRE_NOTHROW( response = do_request( request_str ) );
+		REQUIRE_THAT( response, Catch::Matchers::StartsWith( "HTTP/1.1 200 OK" ) );
+	}
+
+	std::thread stopper{ [&server] { restinio::initiate_shutdown( server ); } };
+	stopper.join();
+	server.wait();
+
+	REQUIRE_FALSE( server.started() );
+	REQUIRE_FALSE( handler_threads.empty() );
+	REQUIRE( handler_threads.size() <= 4u );
+}
+
+TEST_CASE( "sharded server open failure" , "[sharded_http_server]" )
+{
+	// The port is already in use by an ordinary acceptor.
+	restinio::asio_ns::io_context ctx;
+	restinio::asio_ns::ip::tcp::acceptor busy{
+		ctx,
+		restinio::asio_ns::ip::tcp::endpoint{
+			restinio::asio_ns::ip::make_address( "127.0.0.1" ),
+			utest_default_port() } };
+
+	restinio::sharded_http_server_t< traits_t > server{
+		2u,
+		[&]( std::size_t, auto & settings ) {
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.request_handler( []( auto ) {
+					return restinio::request_rejected();
+				} );
+		} };
+
+	REQUIRE_THROWS( server.start() );
+	REQUIRE_FALSE( server.started() );
+}
+
+TEST_CASE( "sharded server thread init hook" , "[sharded_http_server]" )
+{
+	restinio::sharded_http_server_t< traits_t > server{
+		3u,
+		[&]( std::size_t, auto & settings ) {
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.request_handler( []( auto req ) {
+					return req->create_response().done();
+				} );
+		} };
+
+	std::vector< std::size_t > shard_indexes;
+	std::set< std::thread::native_handle_type > handles;
+
+#if defined(__linux__)
+	auto pin = restinio::pin_shard_threads_to_cpus();
+#endif
+
+	server.thread_init_hook(
+		[&]( std::size_t shard_index, std::thread::native_handle_type handle ) {
+			shard_indexes.push_back( shard_index );
+			handles.insert( handle );
+#if defined(__linux__)
+			pin( shard_index, handle );
+#endif
+		} );
+
+	server.start();
+
+	REQUIRE( std::vector< std::size_t >{ 0u, 1u, 2u } == shard_indexes );
+	REQUIRE( 3u == handles.size() );
+
+	std::string response;
+	REQUIRE_NOTHROW( response = do_request( request_str ) );
+	REQUIRE_THAT( response, Catch::Matchers::StartsWith( "HTTP/1.1 200 OK" ) );
+
+	REQUIRE_THROWS( server.thread_init_hook( {} ) );
+
+	server.stop();
+	server.wait();
+}
+
+TEST_CASE( "sharded server thread init hook failure" , "[sharded_http_server]" )
+{
+	restinio::sharded_http_server_t< traits_t > server{
+		2u,
+		[&]( std::size_t, auto & settings ) {
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.request_handler( []( auto ) {
+					return restinio::request_rejected();
+				} );
+		} };
+
+	server.thread_init_hook(
+		[]( std::size_t shard_index, std::thread::native_handle_type ) {
+			if( 1u == shard_index )
+				throw std::runtime_error{ "hook failure" };
+		} );
+
+	REQUIRE_THROWS_AS( server.start(), std::runtime_error );
+	REQUIRE_FALSE( server.started() );
+}
+
+TEST_CASE( "run on sharded threads" , "[run][sharded_http_server]" )
+{
+	std::thread client{ [] {
+		// The first request can be refused because it can be issued
+		// when server is not fully started yet.
+		for( int attempts = 0; attempts != 16; ++attempts )
+		{
+			try
+			{
+				const auto response = do_request( request_str );
+				if( std::string::npos != response.find( "HTTP/1.1 200 OK" ) )
+					break;
+			}
+			catch( const std::exception & )
+			{}
+			std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+		}
+
+		// Break signal should stop all shards.
+		std::raise( SIGINT );
+	} };
+
+	std::atomic< std::size_t > hook_calls{ 0u };
+
+	REQUIRE_NOTHROW( restinio::run(
+		restinio::on_sharded_threads< traits_t >(
+			2u,
+			[]( std::size_t, auto & settings ) {
+				settings
+					.port( utest_default_port() )
+					.address( "127.0.0.1" )
+					.request_handler( []( auto req ) {
+						return req->create_response().done();
+					} );
+			} )
+		.thread_init_hook(
+			[&]( std::size_t, std::thread::native_handle_type ) {
+				++hook_calls;
+			} ) ) );
+
+	client.join();
+
+	REQUIRE( 2u == hook_calls );
+}
@@ -0,0 +1,7 @@
+require 'mxx_ru/binary_unittest'
+
+Mxx_ru::setup_target(
+	Mxx_ru::Binary_unittest_target.new(
+		"test/simd_http_parser/prj.ut.rb",
+		"test/simd_http_parser/prj.rb" )
+)
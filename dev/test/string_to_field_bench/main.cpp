@@ -0,0 +1,485 @@
+/*
+	restinio
+*/
+
+/*!
+	Benchmark for string_to_field() approaches.
+
+	Compares the perfect hash table used by restinio::string_to_field()
+	with the switch by the length of the name (the way it was done
+	before v.0.6.18).
+*/
+
+#include <restinio/http_headers.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <cctype>
+
+//
+// switch_string_to_field()
+//
+
+//! The implementation of string_to_field() from v.0.6.17.
+inline restinio::http_field_t
+switch_string_to_field( restinio::string_view_t field ) noexcept
+{
+	const char * field_name = field.data();
+	const std::size_t field_name_size = field.size();
+
+#define RESTINIO_HTTP_CHECK_FOR_FIELD( field_id, candidate_field_name ) \
+	if( restinio::impl::is_equal_caseless(field_name, #candidate_field_name , field_name_size ) ) \
+		return restinio::http_field_t:: field_id;
+
+	switch( field_name_size )
+	{
+		case 2:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( if_,                          If )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( im,                           IM )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( te,                           TE )
+			break;
+
+		case 3:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( age,                          Age )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( dav,                          DAV )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( ext,                          Ext )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( man,                          Man )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( opt,                          Opt )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( p3p,                          P3P )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( pep,                          PEP )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( tcn,                          TCN )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( ttl,                          TTL )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( uri,                          URI )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( via,                          Via )
+			break;
+
+		case 4:
+			// Known to be more used first:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( host,                         Host )
+
+			RESTINIO_HTTP_CHECK_FOR_FIELD( a_im,                         A-IM )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( alpn,                         ALPN )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( dasl,                         DASL )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( date,                         Date )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( etag,                         ETag )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( from,                         From )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( link,                         Link )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( safe,                         Safe )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( slug,                         SLUG )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( vary,                         Vary )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( cost,                         Cost )
+			break;
+
+		case 5:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( allow,                        Allow )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( c_ext,                        C-Ext )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( c_man,                        C-Man )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( c_opt,                        C-Opt )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( c_pep,                        C-PEP )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( close,                        Close )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( depth,                        Depth )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( label,                        Label )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( meter,                        Meter )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( range,                        Range )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( topic,                        Topic )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( subok,                        SubOK )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( subst,                        Subst )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( title,                        Title )
+			break;
+
+		case 6:
+			// Known to be more used first:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( accept,                       Accept )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( cookie,                       Cookie )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( server,                       Server )
+
+			RESTINIO_HTTP_CHECK_FOR_FIELD( digest,                       Digest )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( expect,                       Expect )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( origin,                       Origin )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( pragma,                       Pragma )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( prefer,                       Prefer )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( public_,                      Public )
+			break;
+
+		case 7:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( alt_svc,                      Alt-Svc )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( cookie2,                      Cookie2 )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( expires,                      Expires )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( hobareg,                      Hobareg )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( referer,                      Referer )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( timeout,                      Timeout )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( trailer,                      Trailer )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( urgency,                      Urgency )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( upgrade,                      Upgrade )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( warning,                      Warning )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( version,                      Version )
+			break;
+
+		case 8:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( alt_used,                     Alt-Used )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( if_match,                     If-Match )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( if_range,                     If-Range )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( location,                     Location )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( pep_info,                     Pep-Info )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( position,                     Position )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( protocol,                     Protocol )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( optional,                     Optional )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_color,                     UA-Color )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_media,                     UA-Media )
+			break;
+
+		case 9:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( forwarded,                    Forwarded )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( negotiate,                    Negotiate )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( overwrite,                    Overwrite )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_pixels,                    UA-Pixels )
+			break;
+
+		case 10:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( alternates,                   Alternates )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( c_pep_info,                   C-PEP-Info )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( content_id,                   Content-ID )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( delta_base,                   Delta-Base )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( getprofile,                   GetProfile )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( keep_alive,                   Keep-Alive )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( lock_token,                   Lock-Token )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( pics_label,                   PICS-Label )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( set_cookie,                   Set-Cookie )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( setprofile,                   SetProfile )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( soapaction,                   SoapAction )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( status_uri,                   Status-URI )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( user_agent,                   User-Agent )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( compliance,                   Compliance )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( message_id,                   Message-ID )
+			break;
+
+		case 11:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_post,                  Accept-Post )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( content_md5,                  Content-MD5 )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( destination,                  Destination )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( retry_after,                  Retry-After )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( set_cookie2,                  Set-Cookie2 )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( want_digest,                  Want-Digest )
+			break;
+
+		case 12:
+			// Known to be more used first:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( content_type,                 Content-Type )
+
+			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_patch,                 Accept-Patch )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( content_base,                 Content-Base )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( derived_from,                 Derived-From )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( max_forwards,                 Max-Forwards )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( mime_version,                 MIME-Version )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( schedule_tag,                 Schedule-Tag )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( redirect_ref,                 Redirect-Ref )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( variant_vary,                 Variant-Vary )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( method_check,                 Method-Check )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( referer_root,                 Referer-Root )
+			break;
+
+		case 13:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_ranges,                Accept-Ranges )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( authorization,                Authorization )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( cache_control,                Cache-Control )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( content_range,                Content-Range )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( default_style,                Default-Style )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( if_none_match,                If-None-Match )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( last_modified,                Last-Modified )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( ordering_type,                Ordering-Type )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( profileobject,                ProfileObject )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( protocol_info,                Protocol-Info )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_resolution,                UA-Resolution )
+			break;
+
+		case 14:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_charset,               Accept-Charset )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( http2_settings,               HTTP2-Settings )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( protocol_query,               Protocol-Query )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_features,               Proxy-Features )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( schedule_reply,               Schedule-Reply )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( non_compliance,               Non-Compliance )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control,               Access-Control )
+			break;
+
+		case 15:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_encoding,              Accept-Encoding )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_features,              Accept-Features )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_language,              Accept-Language )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_datetime,              Accept-Datetime )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( content_version,              Content-Version )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( differential_id,              Differential-ID )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( public_key_pins,              Public-Key-Pins )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( security_scheme,              Security-Scheme )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( x_frame_options,              X-Frame-Options )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_accept,              X-Device-Accept )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( resolution_hint,              Resolution-Hint )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( ediint_features,              EDIINT-Features )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( ua_windowpixels,              UA-Windowpixels )
+			break;
+
+		case 16:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( accept_additions,             Accept-Additions )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( caldav_timezones,             CalDAV-Timezones )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( content_encoding,             Content-Encoding )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( content_language,             Content-Language )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( content_location,             Content-Location )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( memento_datetime,             Memento-Datetime )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( protocol_request,             Protocol-Request )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( www_authenticate,             WWW-Authenticate )
+			break;
+
+		case 17:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( if_modified_since,            If-Modified-Since )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_instruction,            Proxy-Instruction )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_key,            Sec-WebSocket-Key )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( surrogate_control,            Surrogate-Control )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( transfer_encoding,            Transfer-Encoding )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( resolver_location,            Resolver-Location )
+			break;
+
+		case 18:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( content_style_type,           Content-Style-Type )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( preference_applied,           Preference-Applied )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_authenticate,           Proxy-Authenticate )
+			break;
+
+		case 19:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( authentication_info,          Authentication-Info )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( content_disposition,          Content-Disposition )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( content_script_type,          Content-Script-Type )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( if_unmodified_since,          If-Unmodified-Since )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_authorization,          Proxy-Authorization )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_user_agent,          X-Device-User-Agent )
+			break;
+
+		case 20:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_accept,         Sec-WebSocket-Accept )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( surrogate_capability,         Surrogate-Capability )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( method_check_expires,         Method-Check-Expires )
+			break;
+
+		case 21:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( apply_to_redirect_ref,        Apply-To-Redirect-Ref )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( if_schedule_tag_match,        If-Schedule-Tag-Match )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_version,        Sec-WebSocket-Version )
+			break;
+
+		case 22:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( authentication_control,       Authentication-Control )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_protocol,       Sec-WebSocket-Protocol )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_max_age,       Access-Control-Max-Age )
+			break;
+
+		case 23:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_accept_charset,      X-Device-Accept-Charset )
+			break;
+
+		case 24:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( sec_websocket_extensions,     Sec-WebSocket-Extensions )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_accept_encoding,     X-Device-Accept-Encoding )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( x_device_accept_language,     X-Device-Accept-Language )
+			break;
+
+		case 25:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( optional_www_authenticate,    Optional-WWW-Authenticate )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( proxy_authentication_info,    Proxy-Authentication-Info )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( strict_transport_security,    Strict-Transport-Security )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( content_transfer_encoding,    Content-Transfer-Encoding )
+			break;
+
+		case 27:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( public_key_pins_report_only,  Public-Key-Pins-Report-Only )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_allow_origin,  Access-Control-Allow-Origin )
+			break;
+
+		case 28:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_allow_headers, Access-Control-Allow-Headers )
+			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_allow_methods, Access-Control-Allow-Methods )
+			break;
+
+		case 29:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_request_method,    Access-Control-Request-Method )
+			break;
+
+		case 30:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_request_headers,   Access-Control-Request-Headers )
+			break;
+
+		case 32:
+			RESTINIO_HTTP_CHECK_FOR_FIELD( access_control_allow_credentials, Access-Control-Allow-Credentials )
+			break;
+	}
+
+#undef RESTINIO_HTTP_CHECK_FOR_FIELD
+
+	return restinio::http_field_t::field_unspecified;
+}
+
+//
+// Distributions of names.
+//
+
+//! A name and its relative frequency.
+struct weighted_name_t
+{
+	const char * m_name;
+	unsigned m_weight;
+};
+
+//! Header fields of requests from browsers.
+const std::vector< weighted_name_t > browser_names{
+	{ "Host", 100 },
+	{ "User-Agent", 100 },
+	{ "Accept", 100 },
+	{ "Accept-Language", 95 },
+	{ "Accept-Encoding", 100 },
+	{ "Connection", 90 },
+	{ "Referer", 70 },
+	{ "Cookie", 60 },
+	{ "Upgrade-Insecure-Requests", 40 },
+	{ "Sec-Fetch-Dest", 80 },
+	{ "Sec-Fetch-Mode", 80 },
+	{ "Sec-Fetch-Site", 80 },
+	{ "Sec-Fetch-User", 40 },
+	{ "Sec-Ch-Ua", 60 },
+	{ "Sec-Ch-Ua-Mobile", 60 },
+	{ "Sec-Ch-Ua-Platform", 60 },
+	{ "If-None-Match", 20 },
+	{ "If-Modified-Since", 20 },
+	{ "Cache-Control", 30 },
+	{ "Pragma", 10 },
+	{ "Origin", 20 },
+	{ "DNT", 10 },
+};
+
+//! Header fields of requests from API clients and proxies.
+const std::vector< weighted_name_t > api_names{
+	{ "Host", 100 },
+	{ "User-Agent", 100 },
+	{ "Accept", 90 },
+	{ "Content-Type", 70 },
+	{ "Content-Length", 70 },
+	{ "Authorization", 80 },
+	{ "Accept-Encoding", 60 },
+	{ "Connection", 50 },
+	{ "X-Forwarded-For", 60 },
+	{ "X-Forwarded-Proto", 60 },
+	{ "X-Real-IP", 40 },
+	{ "X-Request-Id", 50 },
+	{ "Forwarded", 10 },
+	{ "Via", 20 },
+	{ "Traceparent", 30 },
+	{ "Transfer-Encoding", 10 },
+	{ "Expect", 5 },
+	{ "Idempotency-Key", 10 },
+};
+
+//! Make a sequence of names with the given distribution.
+/*!
+ * If @a lower_case is true all names are converted to lower case
+ * (the way they come through HTTP/2 proxies).
+ */
+std::vector< std::string >
+make_names(
+	const std::vector< weighted_name_t > & distribution,
+	bool lower_case )
+{
+	std::vector< unsigned > weights;
+	for( const auto & n : distribution )
+		weights.push_back( n.m_weight );
+
+	std::mt19937 generator{ 42u };
+	std::discrete_distribution< std::size_t > index{
+			weights.begin(), weights.end() };
+
+	std::vector< std::string > result;
+	for( std::size_t i = 0u; i != 1000u; ++i )
+	{
+		std::string name{ distribution[ index( generator ) ].m_name };
+		if( lower_case )
+			for( auto & c : name )
+				c = static_cast< char >(
+						std::tolower( static_cast< unsigned char >( c ) ) );
+
+		result.push_back( std::move( name ) );
+	}
+
+	return result;
+}
+
+template< typename Lookup >
+void
+run_bench(
+	const std::string & tag,
+	const std::vector< std::string > & names,
+	std::size_t iterations,
+	Lookup lookup )
+{
+	std::size_t known = 0u;
+
+	const auto started_at = std::chrono::steady_clock::now();
+	for( std::size_t i = 0u; i != iterations; ++i )
+		for( const auto & n : names )
+			if( restinio::http_field_t::field_unspecified != lookup( n ) )
+				++known;
+	const auto finished_at = std::chrono::steady_clock::now();
+
+	const double ns = static_cast< double >(
+			std::chrono::duration_cast< std::chrono::nanoseconds >(
+					finished_at - started_at ).count() );
+
+	std::cout << tag << ": "
+		<< ns / static_cast< double >( iterations * names.size() )
+		<< " ns/name (known: " << known / iterations << ")" << std::endl;
+}
+
+int
+main( int argc, const char * argv[] )
+{
+	try
+	{
+		std::size_t iterations = 10000u;
+		if( 1 < argc )
+			iterations = std::stoul( argv[ 1 ] );
+
+		const auto by_switch = []( const std::string & n ) {
+			return switch_string_to_field( n );
+		};
+		const auto by_perfect_hash = []( const std::string & n ) {
+			return restinio::string_to_field( n );
+		};
+
+		struct case_t
+		{
+			const char * m_tag;
+			std::vector< std::string > m_names;
+		};
+
+		const case_t cases[] = {
+			{ "browser", make_names( browser_names, false ) },
+			{ "browser (lower case)", make_names( browser_names, true ) },
+			{ "api", make_names( api_names, false ) },
+			{ "api (lower case)", make_names( api_names, true ) }
+		};
+
+		for( const auto & c : cases )
+		{
+			run_bench( std::string{ c.m_tag } + ", switch",
+					c.m_names, iterations, by_switch );
+			run_bench( std::string{ c.m_tag } + ", perfect hash",
+					c.m_names, iterations, by_perfect_hash );
+		}
+	}
+	catch( const std::exception & ex )
+	{
+		std::cerr << "Error: " << ex.what() << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
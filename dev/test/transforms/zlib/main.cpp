@@ -63,6 +63,20 @@ TEST_CASE( "Create parameters for zlib transformators" , "[zlib][params][create_
 		REQUIRE( rtz::params_t::format_t::gzip == params.format() );
 	}
 
+	{
+		auto params = rtz::make_raw_deflate_compress_params();
+
+		REQUIRE( rtz::params_t::operation_t::compress == params.operation() );
+		REQUIRE( rtz::params_t::format_t::raw_deflate == params.format() );
+	}
+
+	{
+		auto params = rtz::make_raw_deflate_decompress_params();
+
+		REQUIRE( rtz::params_t::operation_t::decompress == params.operation() );
+		REQUIRE( rtz::params_t::format_t::raw_deflate == params.format() );
+	}
+
 	{
 		auto params = rtz::make_identity_params();
 
@@ -646,3 +660,229 @@ TEST_CASE( "write check input size" , "[zlib][write][large input]" )
 		REQUIRE_THROWS( zc.write( large_input ) );
 	}
 }
+
+TEST_CASE( "raw deflate" , "[zlib][compress][decompress][raw_deflate]" )
+{
+	namespace rtz = restinio::transforms::zlib;
+
+	const std::string input_data =
+		"The zlib compression library provides "
+		"in-memory compression and decompression functions, "
+		"including integrity checks of the uncompressed data.";
+
+	const auto compressed = rtz::transform(
+			input_data, rtz::make_raw_deflate_compress_params() );
+
+	// No zlib header (0x78) at the beginning.
+	REQUIRE( 0x78 != static_cast< unsigned char >( compressed[ 0 ] ) );
+
+	REQUIRE( input_data == rtz::transform(
+			compressed, rtz::make_raw_deflate_decompress_params() ) );
+
+	// "Hello" from RFC 7692, section 7.2.3.1.
+	{
+		rtz::zlib_t zc{ rtz::make_raw_deflate_compress_params() };
+		zc.write( "Hello" );
+		zc.flush();
+
+		const std::string expected{
+				"\xF2\x48\xCD\xC9\xC9\x07\x00\x00\x00\xFF\xFF", 11u };
+		REQUIRE( expected == zc.giveaway_output() );
+	}
+}
+
+TEST_CASE( "data after the end of stream" , "[zlib][decompress][stream_end]" )
+{
+	namespace rtz = restinio::transforms::zlib;
+
+	const std::string input_data{ "Hello, World!" };
+
+	for( auto params : { rtz::make_deflate_decompress_params(),
+			rtz::make_gzip_decompress_params() } )
+	{
+		const auto compressed = rtz::transform( input_data,
+				rtz::params_t{
+					rtz::params_t::operation_t::compress, params.format() } );
+
+		rtz::zlib_t zd{ params };
+		REQUIRE( !zd.is_stream_end_reached() );
+
+		zd.write( compressed.substr( 0u, compressed.size() / 2u ) );
+		REQUIRE( !zd.is_stream_end_reached() );
+
+		// There is some garbage after the end of compressed data.
+		zd.write( compressed.substr( compressed.size() / 2u ) + "garbage" );
+		REQUIRE( zd.is_stream_end_reached() );
+
+		zd.complete();
+		REQUIRE( input_data == zd.giveaway_output() );
+	}
+}
+
+TEST_CASE( "max output size" , "[zlib][decompress][max_output_size]" )
+{
+	namespace rtz = restinio::transforms::zlib;
+
+	// About 16KiB of compressed data for 16MiB of output.
+	const auto compressed = rtz::transform(
+			std::string( 16u * 1024u * 1024u, 'a' ),
+			rtz::make_deflate_compress_params() );
+
+	SECTION( "limit is exceeded" )
+	{
+		rtz::zlib_t zd{ rtz::make_deflate_decompress_params() };
+		zd.max_output_size( 1000u );
+
+		zd.write( compressed );
+		REQUIRE( zd.is_output_limit_exceeded() );
+		// Decompression is stopped right after the limit.
+		REQUIRE( 1001u == zd.output_size() );
+
+		// The rest of input is ignored.
+		zd.write( compressed );
+		REQUIRE( 1001u == zd.output_size() );
+	}
+
+	SECTION( "limit isn't exceeded" )
+	{
+		rtz::zlib_t zd{ rtz::make_deflate_decompress_params() };
+		zd.max_output_size( 16u * 1024u * 1024u );
+
+		zd.write( compressed );
+		zd.complete();
+		REQUIRE_FALSE( zd.is_output_limit_exceeded() );
+		REQUIRE( 16u * 1024u * 1024u == zd.giveaway_output().size() );
+	}
+}
+
+TEST_CASE( "write by portions" , "[zlib][decompress][write_by_portions]" )
+{
+	namespace rtz = restinio::transforms::zlib;
+
+	std::string input_data;
+	while( input_data.size() < 4u * 1024u * 1024u )
+		input_data += "Highly compressible text. ";
+
+	const auto compressed = rtz::transform(
+			input_data,
+			rtz::make_deflate_compress_params() );
+
+	rtz::zlib_t zd{ rtz::make_deflate_decompress_params() };
+
+	const std::size_t portion_size = 1000u;
+	std::string output;
+	std::size_t portions = 0u;
+
+	// Input is passed by small parts, every part gives a lot of output.
+	restinio::string_view_t input{ compressed };
+	while( !input.empty() )
+	{
+		const auto part = input.substr( 0u, 100u );
+		input.remove_prefix( part.size() );
+
+		zd.write_by_portions( part, portion_size,
+			[&]( std::string portion ) {
+				REQUIRE( portion_size == portion.size() );
+				output += portion;
+				++portions;
+			} );
+
+		REQUIRE( zd.output_size() < portion_size );
+	}
+
+	REQUIRE( zd.is_stream_end_reached() );
+	output += zd.giveaway_output();
+
+	REQUIRE( input_data.size() / portion_size == portions );
+	REQUIRE( input_data == output );
+
+	rtz::zlib_t zc{ rtz::make_deflate_compress_params() };
+	REQUIRE_THROWS( zc.write_by_portions( "data", portion_size,
+			[]( std::string ) {} ) );
+}
+
+TEST_CASE( "stream pool" , "[zlib][stream_pool]" )
+{
+	namespace rtz = restinio::transforms::zlib;
+
+	// Drop streams left by other tests.
+	rtz::stream_pool_capacity( 0u );
+	REQUIRE( 0u == rtz::idle_streams_count() );
+	rtz::stream_pool_capacity( rtz::default_stream_pool_capacity );
+
+	const std::string input_data{
+		"The zlib compression library provides "
+		"in-memory compression and decompression functions, "
+		"including integrity checks of the uncompressed data." };
+
+	const auto compressed = rtz::gzip_compress( input_data );
+	REQUIRE( 1u == rtz::idle_streams_count() );
+
+	// A reused stream gives the same result.
+	REQUIRE( compressed == rtz::gzip_compress( input_data ) );
+	REQUIRE( 1u == rtz::idle_streams_count() );
+
+	// Streams for other params aren't reused.
+	REQUIRE( input_data == rtz::gzip_decompress( compressed ) );
+	REQUIRE( 2u == rtz::idle_streams_count() );
+	REQUIRE( compressed != rtz::gzip_compress( input_data, 1 ) );
+	REQUIRE( 3u == rtz::idle_streams_count() );
+
+	{
+		rtz::zlib_t z1{ rtz::make_gzip_compress_params() };
+		rtz::zlib_t z2{ rtz::make_gzip_compress_params() };
+		REQUIRE( 2u == rtz::idle_streams_count() );
+	}
+	REQUIRE( 4u == rtz::idle_streams_count() );
+
+	// A stream is reset after incomplete or failed transformation.
+	{
+		rtz::zlib_t zc{ rtz::make_gzip_compress_params() };
+		zc.write( "garbage" );
+	}
+	{
+		rtz::zlib_t zd{ rtz::make_gzip_decompress_params() };
+		REQUIRE_THROWS_AS( zd.write( "garbage" ), restinio::exception_t );
+	}
+	REQUIRE( compressed == rtz::gzip_compress( input_data ) );
+	REQUIRE( input_data == rtz::gzip_decompress( compressed ) );
+
+	// Zero capacity disables the pool.
+	rtz::stream_pool_capacity( 0u );
+	REQUIRE( 0u == rtz::idle_streams_count() );
+	REQUIRE( compressed == rtz::gzip_compress( input_data ) );
+	REQUIRE( 0u == rtz::idle_streams_count() );
+
+	rtz::stream_pool_capacity( 2u );
+	{
+		rtz::zlib_t z1{ rtz::make_gzip_compress_params() };
+		rtz::zlib_t z2{ rtz::make_gzip_compress_params() };
+		rtz::zlib_t z3{ rtz::make_gzip_compress_params() };
+	}
+	REQUIRE( 2u == rtz::idle_streams_count() );
+
+	rtz::stream_pool_capacity( rtz::default_stream_pool_capacity );
+}
+
+TEST_CASE( "zlib_t destroyed after the stream pool" , "[zlib][stream_pool]" )
+{
+	namespace rtz = restinio::transforms::zlib;
+
+	bool completed = false;
+
+	std::thread worker{ [&completed] {
+		// It is constructed before the pool of the thread,
+		// so it is destroyed after the pool.
+		static thread_local std::unique_ptr< rtz::zlib_t > late_zlib;
+		late_zlib = std::make_unique< rtz::zlib_t >(
+				rtz::make_gzip_compress_params() );
+
+		late_zlib->write( "data" );
+		late_zlib->complete();
+
+		completed = !late_zlib->giveaway_output().empty();
+	} };
+	worker.join();
+
+	REQUIRE( completed );
+}
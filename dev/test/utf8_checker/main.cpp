@@ -11,6 +11,7 @@
 #include <restinio/utils/utf8_checker.hpp>
 
 #include <initializer_list>
+#include <random>
 #include <string>
 
 RESTINIO_NODISCARD
@@ -26,7 +27,7 @@ make_from( std::initializer_list<int> values )
 }
 
 bool
-is_valid( const std::string & what )
+is_valid_by_bytes( const std::string & what )
 {
 	restinio::utils::utf8_checker_t checker;
 
@@ -39,6 +40,50 @@ is_valid( const std::string & what )
 	return checker.finalized();
 }
 
+bool
+is_valid_by_block( const std::string & what )
+{
+	restinio::utils::utf8_checker_t checker;
+
+	return checker.process_bytes( what.data(), what.size() ) &&
+			checker.finalized();
+}
+
+bool
+is_valid( const std::string & what )
+{
+	const bool result = is_valid_by_bytes( what );
+	REQUIRE( result == is_valid_by_block( what ) );
+
+	return result;
+}
+
+//! Append UTF-8 representation of a value (without any checks).
+void
+append_utf8( std::string & to, std::uint32_t v )
+{
+	if( v < 0x80u )
+		to += static_cast<char>( v );
+	else if( v < 0x800u )
+	{
+		to += static_cast<char>( 0xC0u | (v >> 6) );
+		to += static_cast<char>( 0x80u | (v & 0x3Fu) );
+	}
+	else if( v < 0x10000u )
+	{
+		to += static_cast<char>( 0xE0u | (v >> 12) );
+		to += static_cast<char>( 0x80u | ((v >> 6) & 0x3Fu) );
+		to += static_cast<char>( 0x80u | (v & 0x3Fu) );
+	}
+	else
+	{
+		to += static_cast<char>( 0xF0u | (v >> 18) );
+		to += static_cast<char>( 0x80u | ((v >> 12) & 0x3Fu) );
+		to += static_cast<char>( 0x80u | ((v >> 6) & 0x3Fu) );
+		to += static_cast<char>( 0x80u | (v & 0x3Fu) );
+	}
+}
+
 TEST_CASE( "Basic checks", "[utf-8][basic]" )
 {
 	{
@@ -472,3 +517,121 @@ TEST_CASE( "Illegal code positions", "[utf-8][illegal-positions]" )
 	) ) );
 }
 
+
+TEST_CASE( "Block checks of all pairs of bytes", "[utf-8][process_bytes]" )
+{
+	// Every pair of bytes is placed at different positions of ASCII text
+	// to cross boundaries of SIMD blocks.
+	for( const std::size_t position : { 0u, 14u, 15u, 31u, 40u } )
+	{
+		std::string text( 48u, 'a' );
+		for( unsigned first = 0x80u; first != 0x100u; ++first )
+			for( unsigned second = 0u; second != 0x100u; ++second )
+			{
+				text[ position ] = static_cast<char>( first );
+				text[ position + 1u ] = static_cast<char>( second );
+
+				const bool expected = is_valid_by_bytes( text );
+				if( expected != is_valid_by_block( text ) )
+				{
+					INFO( "position: " << position << ", bytes: " <<
+							first << " " << second );
+					REQUIRE( expected == is_valid_by_block( text ) );
+				}
+			}
+	}
+}
+
+TEST_CASE( "Block checks of random sequences", "[utf-8][process_bytes]" )
+{
+	std::mt19937 gen{ 20211018u };
+
+	const auto random = [&gen]( std::uint32_t max ) {
+		return std::uniform_int_distribution< std::uint32_t >{ 0u, max }( gen );
+	};
+
+	const auto make_text = [&]() {
+		std::string text;
+		const auto length = random( 300u );
+		while( text.size() < length )
+		{
+			switch( random( 9u ) )
+			{
+				case 0: // Random byte.
+					text += static_cast<char>( random( 0xFFu ) );
+				break;
+
+				case 1: // A value from the whole range (including invalid ones).
+					append_utf8( text, random( 0x13FFFFu ) );
+				break;
+
+				case 2: // A value near boundaries.
+				{
+					static const std::uint32_t boundaries[] = {
+						0x80u, 0x800u, 0xD800u, 0xE000u, 0x10000u, 0x110000u };
+					append_utf8( text,
+							boundaries[ random( 5u ) ] + random( 2u ) - 1u );
+				}
+				break;
+
+				case 3: // ASCII text.
+					text.append( random( 70u ), 'x' );
+				break;
+
+				case 4: // Two-byte chars.
+					append_utf8( text, 0x80u + random( 0x77Fu ) );
+				break;
+
+				case 5: // Three-byte chars.
+					append_utf8( text, 0x800u + random( 0xC7FFu ) );
+				break;
+
+				default: // Four-byte chars.
+					append_utf8( text, 0x10000u + random( 0xFFFFFu ) );
+				break;
+			}
+		}
+
+		// Damage some texts.
+		if( !text.empty() && 0u == random( 3u ) )
+			text[ random( static_cast<std::uint32_t>( text.size() - 1u ) ) ] =
+					static_cast<char>( random( 0xFFu ) );
+
+		return text;
+	};
+
+	for( int i = 0; i != 20000; ++i )
+	{
+		const auto text = make_text();
+
+		// Process the text by random parts.
+		restinio::utils::utf8_checker_t by_bytes;
+		restinio::utils::utf8_checker_t by_blocks;
+
+		bool bytes_result = true;
+		bool blocks_result = true;
+		std::size_t pos = 0u;
+		while( pos != text.size() )
+		{
+			const auto part = std::min< std::size_t >(
+					text.size() - pos, random( 70u ) );
+
+			for( std::size_t j = pos; j != pos + part && bytes_result; ++j )
+				bytes_result = by_bytes.process_byte(
+						static_cast<std::uint8_t>( text[ j ] ) );
+			blocks_result = by_blocks.process_bytes( text.data() + pos, part );
+			pos += part;
+
+			INFO( "text #" << i << ", size: " << text.size() << ", pos: " << pos );
+			REQUIRE( bytes_result == blocks_result );
+			if( !bytes_result )
+				break;
+
+			REQUIRE( by_bytes.finalized() == by_blocks.finalized() );
+			if( part && by_bytes.finalized() )
+				REQUIRE( by_bytes.current_symbol() == by_blocks.current_symbol() );
+		}
+
+		REQUIRE( is_valid_by_bytes( text ) == is_valid_by_block( text ) );
+	}
+}
@@ -0,0 +1,330 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for prepared messages and broadcasting.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+#include <restinio/websocket/websocket.hpp>
+#include <restinio/websocket/permessage_deflate.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+#include <test/websocket/common/pub.hpp>
+
+using namespace std::literals::string_literals;
+
+namespace rws = restinio::websocket::basic;
+
+TEST_CASE( "prepared message" , "[prepared_message]" )
+{
+	{
+		rws::prepared_message_t msg{
+			rws::final_frame, rws::opcode_t::text_frame, "Hello" };
+
+		REQUIRE( rws::final_frame == msg.final_flag() );
+		REQUIRE( rws::opcode_t::text_frame == msg.opcode() );
+		REQUIRE( "Hello" == msg.payload() );
+		REQUIRE( 7u == msg.frame_size() );
+
+		const auto frame = msg.frame_as_writable_item();
+		REQUIRE( 7u == frame.size() );
+		REQUIRE( "\x81\x05Hello"s == std::string(
+				static_cast< const char * >( frame.buf().data() ), frame.size() ) );
+
+		const auto payload = msg.payload_as_writable_item();
+		REQUIRE( "Hello"s == std::string(
+				static_cast< const char * >( payload.buf().data() ), payload.size() ) );
+
+		// Copies refer to the same frame.
+		const auto copy = msg;
+		REQUIRE( frame.buf().data() == copy.frame_as_writable_item().buf().data() );
+	}
+	{
+		const std::string payload( 126u, 'a' );
+		rws::prepared_message_t msg{ rws::message_t{
+			rws::not_final_frame, rws::opcode_t::binary_frame, payload } };
+
+		REQUIRE( rws::not_final_frame == msg.final_flag() );
+		REQUIRE( payload == msg.payload() );
+		REQUIRE( 4u + 126u == msg.frame_size() );
+
+		const auto frame = msg.frame_as_writable_item();
+		const auto * data = static_cast< const unsigned char * >( frame.buf().data() );
+		REQUIRE( 0x02 == data[ 0 ] );
+		REQUIRE( 126 == data[ 1 ] );
+		REQUIRE( 0 == data[ 2 ] );
+		REQUIRE( 126 == data[ 3 ] );
+	}
+
+	REQUIRE_THROWS_AS(
+		rws::prepared_message_t(
+			rws::final_frame,
+			rws::opcode_t::connection_close_frame,
+			rws::status_code_to_bin( rws::status_code_t::normal_closure ) ),
+		restinio::exception_t );
+}
+
+using traits_t =
+	restinio::traits_t<
+		restinio::asio_timer_manager_t,
+		utest_logger_t >;
+
+using http_server_t = restinio::http_server_t< traits_t >;
+
+std::string
+make_upgrade_request( const std::string & extensions )
+{
+	return
+		"GET /chat HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"Upgrade: websocket\r\n"
+		"Connection: Upgrade\r\n"
+		"Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+		"Sec-WebSocket-Version: 13\r\n" +
+		( extensions.empty() ? std::string{} :
+			"Sec-WebSocket-Extensions: " + extensions + "\r\n" ) +
+		"\r\n";
+}
+
+//! Connect to the server and read the upgrade response.
+void
+connect_and_upgrade(
+	restinio::asio_ns::ip::tcp::socket & socket,
+	const std::string & extensions )
+{
+	socket.connect( restinio::asio_ns::ip::tcp::endpoint{
+			restinio::asio_ns::ip::make_address_v4( "127.0.0.1" ),
+			utest_default_port() } );
+
+	const auto request = make_upgrade_request( extensions );
+	restinio::asio_ns::write( socket, restinio::asio_ns::buffer( request ) );
+
+	restinio::asio_ns::streambuf b;
+	restinio::asio_ns::read_until( socket, b, "\r\n\r\n" );
+	const std::string response{
+			restinio::asio_ns::buffers_begin( b.data() ),
+			restinio::asio_ns::buffers_end( b.data() ) };
+	REQUIRE( std::string::npos != response.find( "101 Switching Protocols" ) );
+}
+
+//! Read a small frame from a server.
+std::pair< std::uint8_t, std::string >
+read_server_frame( restinio::asio_ns::ip::tcp::socket & socket )
+{
+	std::array< std::uint8_t, 2 > header;
+	restinio::asio_ns::read( socket, restinio::asio_ns::buffer( header ) );
+	REQUIRE( header[ 1 ] < 126u );
+
+	std::string payload( header[ 1 ], '\0' );
+	restinio::asio_ns::read( socket,
+			restinio::asio_ns::buffer( &payload[ 0 ], payload.size() ) );
+
+	return { header[ 0 ], std::move( payload ) };
+}
+
+//! A server that keeps all websockets.
+class broadcast_server_t
+{
+	public:
+		broadcast_server_t()
+			:	m_server{
+					restinio::own_io_context(),
+					[this]( auto & settings ){
+						settings
+							.port( utest_default_port() )
+							.address( "127.0.0.1" )
+							.request_handler(
+								[this]( auto req ){
+									return this->on_request( std::move( req ) );
+								} );
+					} }
+			,	m_other_thread{ m_server }
+		{
+			m_other_thread.run();
+		}
+
+		~broadcast_server_t()
+		{
+			run_on_server( [this]{ m_websockets.clear(); } );
+			m_other_thread.stop_and_join();
+		}
+
+		//! Wait for upgrade of the specified number of websockets.
+		void
+		wait_for_websockets( std::size_t count )
+		{
+			for( std::size_t size = 0u; size != count; )
+			{
+				std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+				run_on_server( [&]{ size = m_websockets.size(); } );
+			}
+		}
+
+		//! Run a function on the server thread and wait for its completion.
+		template< typename Lambda >
+		void
+		run_on_server( Lambda && lambda )
+		{
+			std::promise< void > p;
+			restinio::asio_ns::post(
+				m_server.io_context(),
+				[&]{
+					lambda();
+					p.set_value();
+				} );
+			p.get_future().get();
+		}
+
+		std::vector< rws::ws_handle_t > &
+		websockets() noexcept { return m_websockets; }
+
+		std::atomic< std::uint16_t > m_last_close_code{ 0 };
+
+	private:
+		restinio::request_handling_status_t
+		on_request( restinio::request_handle_t req )
+		{
+			if( restinio::http_connection_header_t::upgrade !=
+				req->header().connection() )
+				return restinio::request_rejected();
+
+			m_websockets.push_back(
+				rws::upgrade< traits_t >(
+					*req,
+					rws::activation_t::immediate,
+					rws::permessage_deflate_params_t{},
+					[this]( rws::ws_handle_t, rws::message_handle_t m ){
+						if( rws::opcode_t::connection_close_frame == m->opcode() )
+							m_last_close_code = static_cast< std::uint16_t >(
+									rws::status_code_from_bin( m->payload() ) );
+					} ) );
+
+			return restinio::request_accepted();
+		}
+
+		http_server_t m_server;
+		other_work_thread_for_server_t< http_server_t > m_other_thread;
+
+		//! Is accessed only on the server thread.
+		std::vector< rws::ws_handle_t > m_websockets;
+};
+
+TEST_CASE( "broadcast" , "[broadcast]" )
+{
+	broadcast_server_t server;
+
+	restinio::asio_ns::io_context io_context;
+	restinio::asio_ns::ip::tcp::socket plain{ io_context };
+	restinio::asio_ns::ip::tcp::socket compressed{ io_context };
+
+	connect_and_upgrade( plain, "" );
+	connect_and_upgrade( compressed, "permessage-deflate" );
+	server.wait_for_websockets( 2u );
+
+	const rws::prepared_message_t hello{
+		rws::final_frame, rws::opcode_t::text_frame, "Hello" };
+
+	SECTION( "to every websocket" )
+	{
+		server.run_on_server( [&]{
+			// Closed websockets are skipped.
+			server.websockets().push_back( rws::ws_handle_t{} );
+			REQUIRE( 2u == rws::broadcast( server.websockets(), hello ) );
+			server.websockets().pop_back();
+		} );
+
+		auto reply = read_server_frame( plain );
+		REQUIRE( 0x81 == reply.first );
+		REQUIRE( "Hello" == reply.second );
+
+		// The payload is compressed by the connection.
+		reply = read_server_frame( compressed );
+		REQUIRE( 0xC1 == reply.first );
+		REQUIRE( std::string{ "\xf2\x48\xcd\xc9\xc9\x07\x00", 7u } == reply.second );
+	}
+
+	SECTION( "message bigger than the limit" )
+	{
+		server.run_on_server( [&]{
+			for( auto & ws : server.websockets() )
+				ws->outgoing_queue_limit(
+					hello.frame_size() - 1u,
+					rws::outgoing_overflow_policy_t::close_connection );
+
+			// An empty queue accepts a message of any size.
+			REQUIRE( 2u == rws::broadcast( server.websockets(), hello ) );
+		} );
+
+		auto reply = read_server_frame( plain );
+		REQUIRE( 0x81 == reply.first );
+		REQUIRE( "Hello" == reply.second );
+
+		reply = read_server_frame( compressed );
+		REQUIRE( 0xC1 == reply.first );
+
+		REQUIRE( 0u == server.m_last_close_code );
+	}
+
+	SECTION( "drop message" )
+	{
+		server.run_on_server( [&]{
+			auto & ws = *server.websockets().front();
+			REQUIRE( std::numeric_limits< std::size_t >::max() ==
+					ws.outgoing_queue_limit().m_max_queued_bytes );
+
+			ws.outgoing_queue_limit(
+				hello.frame_size(),
+				rws::outgoing_overflow_policy_t::drop_message );
+
+			// The first message is being written, the second one waits
+			// in the queue, there is no room for the third one.
+			for( int i = 0; i != 3; ++i )
+				REQUIRE( 2u == rws::broadcast( server.websockets(), hello ) );
+		} );
+
+		for( int i = 0; i != 2; ++i )
+		{
+			const auto reply = read_server_frame( plain );
+			REQUIRE( 0x81 == reply.first );
+			REQUIRE( "Hello" == reply.second );
+		}
+
+		server.run_on_server( [&]{
+			server.websockets().front()->send_message( rws::prepared_message_t{
+				rws::final_frame, rws::opcode_t::text_frame, "Bye" } );
+		} );
+
+		const auto reply = read_server_frame( plain );
+		REQUIRE( 0x81 == reply.first );
+		REQUIRE( "Bye" == reply.second );
+	}
+
+	SECTION( "close connection" )
+	{
+		server.run_on_server( [&]{
+			server.websockets().front()->outgoing_queue_limit(
+				0u,
+				rws::outgoing_overflow_policy_t::close_connection );
+
+			for( int i = 0; i != 3; ++i )
+				REQUIRE( 2u == rws::broadcast( server.websockets(), hello ) );
+		} );
+
+		std::array< char, 16 > data;
+		restinio::asio_ns::error_code ec;
+		while( !ec )
+			plain.read_some( restinio::asio_ns::buffer( data ), ec );
+
+		REQUIRE( static_cast< std::uint16_t >( rws::status_code_t::going_away ) ==
+				server.m_last_close_code );
+
+		// The other connection is alive.
+		const auto reply = read_server_frame( compressed );
+		REQUIRE( 0xC1 == reply.first );
+	}
+}
@@ -97,6 +97,37 @@ TEST_CASE( "Validate mask and unmask operations" , "[websocket][parser][mask]" )
 	REQUIRE( bin_data == unmasked_bin_data_etalon );
 }
 
+TEST_CASE( "Mask and unmask by words and blocks" , "[websocket][parser][mask]" )
+{
+	const uint32_t mask_key = 0x37FA213D;
+	const std::uint8_t key[ 4 ] = { 0x37, 0xFA, 0x21, 0x3D };
+
+	// Extra bytes around data allow to check all alignments and
+	// that bytes outside of data aren't touched.
+	std::string buffer( 1024u + 64u, '\0' );
+
+	for( std::size_t size : { 0u, 1u, 3u, 7u, 8u, 15u, 16u, 17u, 31u, 32u, 33u,
+			63u, 64u, 65u, 100u, 1000u, 1024u } )
+		for( std::size_t start = 0u; start != 32u; ++start )
+			for( std::size_t key_offset = 0u; key_offset != 5u; ++key_offset )
+			{
+				INFO( "size: " << size << ", start: " << start <<
+						", key_offset: " << key_offset );
+
+				for( std::size_t i = 0u; i != buffer.size(); ++i )
+					buffer[ i ] = static_cast< char >( i * 7u + size );
+
+				std::string expected = buffer;
+				for( std::size_t i = 0u; i != size; ++i )
+					expected[ start + i ] = static_cast< char >(
+							static_cast< std::uint8_t >( expected[ start + i ] ) ^
+							key[ ( key_offset + i ) % 4u ] );
+
+				mask_unmask_bytes( mask_key, key_offset, &buffer[ start ], size );
+				REQUIRE( expected == buffer );
+			}
+}
+
 TEST_CASE( "Reset parser" , "[websocket][parser][reset]" )
 {
 	raw_data_t bin_data{ to_char_each({0x81, 0x05}) };
@@ -0,0 +1,411 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for streaming of payloads of big websocket frames.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+#include <restinio/websocket/websocket.hpp>
+#include <restinio/websocket/permessage_deflate.hpp>
+
+#include <random>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+
+using namespace std::literals::string_literals;
+
+namespace rws = restinio::websocket::basic;
+
+using traits_t =
+	restinio::traits_t<
+		restinio::asio_timer_manager_t,
+		utest_logger_t >;
+
+using http_server_t = restinio::http_server_t< traits_t >;
+
+constexpr std::size_t chunk_size = 4096u;
+
+std::string
+make_upgrade_request( const std::string & extensions )
+{
+	return
+		"GET /chat HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"Upgrade: websocket\r\n"
+		"Connection: Upgrade\r\n"
+		"Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+		"Sec-WebSocket-Version: 13\r\n" +
+		( extensions.empty() ? std::string{} :
+			"Sec-WebSocket-Extensions: " + extensions + "\r\n" ) +
+		"\r\n";
+}
+
+//! Connect to the server and read the upgrade response.
+void
+connect_and_upgrade(
+	restinio::asio_ns::ip::tcp::socket & socket,
+	const std::string & extensions )
+{
+	socket.connect( restinio::asio_ns::ip::tcp::endpoint{
+			restinio::asio_ns::ip::make_address_v4( "127.0.0.1" ),
+			utest_default_port() } );
+
+	const auto request = make_upgrade_request( extensions );
+	restinio::asio_ns::write( socket, restinio::asio_ns::buffer( request ) );
+
+	restinio::asio_ns::streambuf b;
+	restinio::asio_ns::read_until( socket, b, "\r\n\r\n" );
+	const std::string response{
+			restinio::asio_ns::buffers_begin( b.data() ),
+			restinio::asio_ns::buffers_end( b.data() ) };
+	REQUIRE( std::string::npos != response.find( "101 Switching Protocols" ) );
+}
+
+//! Make a masked frame from a client.
+std::string
+make_client_frame( std::uint8_t first_byte, const std::string & payload )
+{
+	const std::uint8_t mask[ 4 ] = { 0xAA, 0xBB, 0xCC, 0xDD };
+
+	std::string frame;
+	frame += static_cast< char >( first_byte );
+	if( payload.size() < 126u )
+		frame += static_cast< char >( 0x80u | payload.size() );
+	else
+	{
+		frame += static_cast< char >( 0x80u | 127u );
+		for( int shift = 56; shift >= 0; shift -= 8 )
+			frame += static_cast< char >(
+					( static_cast< std::uint64_t >( payload.size() ) >> shift ) & 0xFFu );
+	}
+
+	for( auto m : mask )
+		frame += static_cast< char >( m );
+	for( std::size_t i = 0u; i != payload.size(); ++i )
+		frame += static_cast< char >(
+				static_cast< std::uint8_t >( payload[ i ] ) ^ mask[ i % 4u ] );
+
+	return frame;
+}
+
+//! Make a text of the specified size with multibyte UTF-8 symbols.
+std::string
+make_text( std::size_t size )
+{
+	static const std::string symbols[] = {
+		"a", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80", "0123456789" };
+
+	std::mt19937 gen{ 42u };
+	std::uniform_int_distribution< int > symbol{ 0, 4 };
+
+	std::string result;
+	while( result.size() < size )
+		result += symbols[ symbol( gen ) ];
+
+	// Drop the last symbol if it is cut.
+	while( result.size() > size )
+		result.pop_back();
+	while( 0x80u == ( static_cast< std::uint8_t >( result.back() ) & 0xC0u ) )
+		result.pop_back();
+	if( static_cast< std::uint8_t >( result.back() ) >= 0xC0u )
+		result.pop_back();
+
+	return result;
+}
+
+//! Compress a message as a client with permessage-deflate does.
+std::string
+compress_message( const std::string & text )
+{
+	auto agreement = rws::negotiate_permessage_deflate(
+			[]{
+				restinio::http_header_fields_t fields;
+				fields.add_field(
+					restinio::http_field::sec_websocket_extensions,
+					"permessage-deflate" );
+				return fields;
+			}(),
+			rws::permessage_deflate_params_t{} );
+	REQUIRE( agreement );
+
+	rws::impl::permessage_deflate_t client{ *agreement };
+	return client.compress_frame( text, rws::final_frame );
+}
+
+//! A server that collects messages and chunks.
+class streaming_server_t
+{
+	public:
+		explicit streaming_server_t(
+			rws::permessage_deflate_params_t deflate_params = {} )
+			:	m_deflate_params{ std::move( deflate_params ) }
+			,	m_server{
+					restinio::own_io_context(),
+					[this]( auto & settings ){
+						settings
+							.port( utest_default_port() )
+							.address( "127.0.0.1" )
+							.request_handler(
+								[this]( auto req ){
+									return this->on_request( std::move( req ) );
+								} );
+					} }
+			,	m_other_thread{ m_server }
+		{
+			m_other_thread.run();
+		}
+
+		~streaming_server_t()
+		{
+			std::promise< void > p;
+			restinio::asio_ns::post(
+				m_server.io_context(),
+				[&]{
+					m_ws.reset();
+					p.set_value();
+				} );
+			p.get_future().get();
+
+			m_other_thread.stop_and_join();
+		}
+
+		//! Wait for a final message or a close frame.
+		std::vector< rws::message_handle_t >
+		wait_for_message()
+		{
+			std::vector< rws::message_handle_t > result;
+
+			for( int attempt = 0; attempt != 5000; ++attempt )
+			{
+				{
+					std::lock_guard< std::mutex > lock{ m_lock };
+					if( !m_messages.empty() && m_messages.back()->is_final() )
+					{
+						result.swap( m_messages );
+						break;
+					}
+				}
+				std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+			}
+
+			return result;
+		}
+
+	private:
+		restinio::request_handling_status_t
+		on_request( restinio::request_handle_t req )
+		{
+			if( restinio::http_connection_header_t::upgrade !=
+				req->header().connection() )
+				return restinio::request_rejected();
+
+			m_ws = rws::upgrade< traits_t >(
+				*req,
+				rws::activation_t::delayed,
+				m_deflate_params,
+				[this]( rws::ws_handle_t, rws::message_handle_t m ){
+					std::lock_guard< std::mutex > lock{ m_lock };
+					m_messages.push_back( std::move( m ) );
+				} );
+
+			m_ws->payload_streaming( chunk_size );
+			activate( *m_ws );
+
+			return restinio::request_accepted();
+		}
+
+		const rws::permessage_deflate_params_t m_deflate_params;
+
+		http_server_t m_server;
+		other_work_thread_for_server_t< http_server_t > m_other_thread;
+
+		//! Is accessed only on the server thread.
+		rws::ws_handle_t m_ws;
+
+		std::mutex m_lock;
+		std::vector< rws::message_handle_t > m_messages;
+};
+
+//! Check that chunks look like fragments of a message and join them.
+std::string
+join_chunks(
+	const std::vector< rws::message_handle_t > & chunks,
+	rws::opcode_t opcode )
+{
+	REQUIRE_FALSE( chunks.empty() );
+	REQUIRE( opcode == chunks.front()->opcode() );
+
+	std::string result;
+	for( std::size_t i = 0u; i != chunks.size(); ++i )
+	{
+		if( 0u != i )
+			REQUIRE( rws::opcode_t::continuation_frame == chunks[ i ]->opcode() );
+
+		REQUIRE( ( chunks.size() == i + 1u ) == chunks[ i ]->is_final() );
+
+		result += chunks[ i ]->payload();
+	}
+
+	return result;
+}
+
+TEST_CASE( "payload streaming" , "[payload_streaming]" )
+{
+	streaming_server_t server;
+
+	restinio::asio_ns::io_context io_context;
+	restinio::asio_ns::ip::tcp::socket socket{ io_context };
+
+	SECTION( "binary frame" )
+	{
+		connect_and_upgrade( socket, "" );
+
+		std::string payload( 1024u * 1024u, '\0' );
+		for( std::size_t i = 0u; i != payload.size(); ++i )
+			payload[ i ] = static_cast< char >( i * 31u );
+
+		restinio::asio_ns::write( socket, restinio::asio_ns::buffer(
+				make_client_frame( 0x82, payload ) ) );
+
+		const auto chunks = server.wait_for_message();
+		REQUIRE( chunks.size() > 1u );
+
+		// Chunks don't depend on TCP segmentation: all of them
+		// except the last one are full.
+		REQUIRE( ( payload.size() + chunk_size - 1u ) / chunk_size ==
+				chunks.size() );
+		for( std::size_t i = 0u; i + 1u != chunks.size(); ++i )
+			REQUIRE( chunk_size == chunks[ i ]->payload().size() );
+
+		REQUIRE( payload == join_chunks( chunks, rws::opcode_t::binary_frame ) );
+
+		// Small frames are passed as usual.
+		restinio::asio_ns::write( socket, restinio::asio_ns::buffer(
+				make_client_frame( 0x81, "Hello" ) ) );
+
+		const auto messages = server.wait_for_message();
+		REQUIRE( 1u == messages.size() );
+		REQUIRE( rws::opcode_t::text_frame == messages.front()->opcode() );
+		REQUIRE( "Hello" == messages.front()->payload() );
+	}
+
+	SECTION( "fragmented text message" )
+	{
+		connect_and_upgrade( socket, "" );
+
+		const auto text = make_text( 100000u );
+		// The boundary of frames can be inside of a symbol.
+		const auto first_part = text.substr( 0u, 50001u );
+		const auto second_part = text.substr( first_part.size() );
+
+		restinio::asio_ns::write( socket, restinio::asio_ns::buffer(
+				make_client_frame( 0x01, first_part ) +
+				make_client_frame( 0x89, "ping" ) +
+				make_client_frame( 0x80, second_part ) ) );
+
+		auto chunks = server.wait_for_message();
+
+		// The ping frame is passed between chunks.
+		const auto ping = std::find_if( chunks.begin(), chunks.end(),
+				[]( const auto & c ) {
+					return rws::opcode_t::ping_frame == c->opcode();
+				} );
+		REQUIRE( ping != chunks.end() );
+		REQUIRE( "ping" == (*ping)->payload() );
+		chunks.erase( ping );
+
+		REQUIRE( text == join_chunks( chunks, rws::opcode_t::text_frame ) );
+	}
+
+	SECTION( "invalid utf-8" )
+	{
+		connect_and_upgrade( socket, "" );
+
+		auto text = make_text( 100000u );
+		text[ 60000u ] = '\xff';
+
+		restinio::asio_ns::write( socket, restinio::asio_ns::buffer(
+				make_client_frame( 0x81, text ) ) );
+
+		// Chunks before the invalid one are passed.
+		const auto chunks = server.wait_for_message();
+		REQUIRE( chunks.size() > 1u );
+		for( std::size_t i = 0u; i + 1u != chunks.size(); ++i )
+			REQUIRE_FALSE( chunks[ i ]->is_final() );
+
+		REQUIRE( rws::opcode_t::connection_close_frame == chunks.back()->opcode() );
+		REQUIRE( rws::status_code_t::invalid_message_data ==
+				rws::status_code_from_bin( chunks.back()->payload() ) );
+
+		std::array< std::uint8_t, 4 > close_frame;
+		restinio::asio_ns::read( socket, restinio::asio_ns::buffer( close_frame ) );
+		REQUIRE( 0x88 == close_frame[ 0 ] );
+		REQUIRE( 0x03 == close_frame[ 2 ] );
+		REQUIRE( 0xEF == close_frame[ 3 ] );
+	}
+
+	SECTION( "compressed message" )
+	{
+		connect_and_upgrade( socket, "permessage-deflate" );
+
+		const auto text = make_text( 1024u * 1024u );
+
+		const auto compressed = compress_message( text );
+		REQUIRE( compressed.size() > chunk_size );
+
+		restinio::asio_ns::write( socket, restinio::asio_ns::buffer(
+				make_client_frame( 0xC1, compressed ) ) );
+
+		const auto chunks = server.wait_for_message();
+		REQUIRE( chunks.size() > 1u );
+		for( const auto & c : chunks )
+			REQUIRE( c->payload().size() <= chunk_size );
+		REQUIRE( text == join_chunks( chunks, rws::opcode_t::text_frame ) );
+	}
+}
+
+TEST_CASE( "compressed message above the message limit" ,
+	"[payload_streaming][permessage_deflate]" )
+{
+	// The limit isn't applied to streamed frames.
+	streaming_server_t server{
+			rws::permessage_deflate_params_t{}
+				.max_decompressed_message_size( 64u * 1024u ) };
+
+	restinio::asio_ns::io_context io_context;
+	restinio::asio_ns::ip::tcp::socket socket{ io_context };
+
+	connect_and_upgrade( socket, "permessage-deflate" );
+
+	// A highly compressible message: every compressed chunk is
+	// inflated into a lot of pieces.
+	std::string text;
+	while( text.size() < 8u * 1024u * 1024u )
+		text += "Highly compressible text. ";
+
+	const auto compressed = compress_message( text );
+	REQUIRE( compressed.size() > chunk_size );
+	REQUIRE( compressed.size() * 100u < text.size() );
+
+	restinio::asio_ns::write( socket, restinio::asio_ns::buffer(
+			make_client_frame( 0xC1, compressed ) ) );
+
+	const auto chunks = server.wait_for_message();
+	REQUIRE( chunks.size() >= text.size() / chunk_size );
+	for( const auto & c : chunks )
+		REQUIRE( c->payload().size() <= chunk_size );
+	REQUIRE( text == join_chunks( chunks, rws::opcode_t::text_frame ) );
+
+	// The connection is still alive.
+	restinio::asio_ns::write( socket, restinio::asio_ns::buffer(
+			make_client_frame( 0x81, "Hello" ) ) );
+
+	const auto messages = server.wait_for_message();
+	REQUIRE( 1u == messages.size() );
+	REQUIRE( "Hello" == messages.front()->payload() );
+}
@@ -0,0 +1,710 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for permessage-deflate extension.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+#include <restinio/websocket/permessage_deflate.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+#include <test/websocket/common/pub.hpp>
+
+using namespace std::literals::string_literals;
+
+namespace rws = restinio::websocket::basic;
+
+using restinio::http_header_fields_t;
+using restinio::http_field;
+
+http_header_fields_t
+make_fields( std::initializer_list< std::string > extensions )
+{
+	http_header_fields_t result;
+	for( const auto & e : extensions )
+		result.add_field( http_field::sec_websocket_extensions, e );
+
+	return result;
+}
+
+std::string
+negotiate(
+	std::initializer_list< std::string > extensions,
+	const rws::permessage_deflate_params_t & params =
+		rws::permessage_deflate_params_t{} )
+{
+	const auto agreement = rws::negotiate_permessage_deflate(
+			make_fields( extensions ), params );
+
+	return agreement ? agreement->response_field_value() : "<declined>"s;
+}
+
+rws::permessage_deflate_agreement_t
+make_agreement(
+	const rws::permessage_deflate_params_t & params =
+		rws::permessage_deflate_params_t{} )
+{
+	auto agreement = rws::negotiate_permessage_deflate(
+			make_fields( { "permessage-deflate" } ), params );
+	REQUIRE( agreement );
+
+	return *agreement;
+}
+
+const std::string rfc_hello{ to_char_each( {
+		0xf2, 0x48, 0xcd, 0xc9, 0xc9, 0x07, 0x00 } ) };
+
+const std::string rfc_hello_with_context{ to_char_each( {
+		0xf2, 0x00, 0x11, 0x00, 0x00 } ) };
+
+TEST_CASE( "permessage-deflate params" , "[permessage_deflate][params]" )
+{
+	rws::permessage_deflate_params_t params;
+
+	REQUIRE_FALSE( params.server_no_context_takeover() );
+	REQUIRE_FALSE( params.client_no_context_takeover() );
+	REQUIRE( 15 == params.server_max_window_bits() );
+	REQUIRE( 15 == params.client_max_window_bits() );
+	REQUIRE( -1 == params.compression_level() );
+	REQUIRE( 8 == params.mem_level() );
+	REQUIRE( 0u == params.min_compressed_size() );
+	REQUIRE( 16u * 1024u * 1024u == params.max_decompressed_message_size() );
+
+	REQUIRE_THROWS_AS( params.server_max_window_bits( 8 ), restinio::exception_t );
+	REQUIRE_THROWS_AS( params.server_max_window_bits( 16 ), restinio::exception_t );
+	REQUIRE_NOTHROW( params.server_max_window_bits( 9 ) );
+	REQUIRE_THROWS_AS( params.client_max_window_bits( 7 ), restinio::exception_t );
+	REQUIRE_THROWS_AS( params.client_max_window_bits( 16 ), restinio::exception_t );
+	REQUIRE_NOTHROW( params.client_max_window_bits( 8 ) );
+	REQUIRE_THROWS_AS( params.compression_level( 10 ), restinio::exception_t );
+	REQUIRE_THROWS_AS( params.compression_level( -2 ), restinio::exception_t );
+	REQUIRE_NOTHROW( params.compression_level( 9 ) );
+	REQUIRE_THROWS_AS( params.mem_level( 0 ), restinio::exception_t );
+	REQUIRE_THROWS_AS( params.mem_level( 10 ), restinio::exception_t );
+	REQUIRE_NOTHROW( params.mem_level( 1 ) );
+
+	REQUIRE( 9 == params.server_max_window_bits() );
+	REQUIRE( 8 == params.client_max_window_bits() );
+	REQUIRE( 9 == params.compression_level() );
+	REQUIRE( 1 == params.mem_level() );
+
+	const auto other = rws::permessage_deflate_params_t{}
+		.server_no_context_takeover( true )
+		.client_no_context_takeover( true )
+		.min_compressed_size( 64u )
+		.max_decompressed_message_size( 1024u );
+
+	REQUIRE( other.server_no_context_takeover() );
+	REQUIRE( other.client_no_context_takeover() );
+	REQUIRE( 64u == other.min_compressed_size() );
+	REQUIRE( 1024u == other.max_decompressed_message_size() );
+}
+
+TEST_CASE( "permessage-deflate negotiation" , "[permessage_deflate][negotiation]" )
+{
+	REQUIRE( "<declined>" == negotiate( {} ) );
+	REQUIRE( "<declined>" == negotiate( { "x-webkit-deflate-frame" } ) );
+
+	REQUIRE( "permessage-deflate" == negotiate( { "permessage-deflate" } ) );
+	REQUIRE( "permessage-deflate" == negotiate( { "Permessage-Deflate" } ) );
+	REQUIRE( "permessage-deflate" == negotiate(
+			{ "x-webkit-deflate-frame, permessage-deflate; client_max_window_bits" } ) );
+
+	SECTION( "window bits" )
+	{
+		REQUIRE( "permessage-deflate; server_max_window_bits=10" ==
+				negotiate( { "permessage-deflate; server_max_window_bits=10" } ) );
+		REQUIRE( "permessage-deflate; server_max_window_bits=10" ==
+				negotiate( { "permessage-deflate; server_max_window_bits=\"10\"" } ) );
+		REQUIRE( "permessage-deflate; server_max_window_bits=9" ==
+				negotiate(
+					{ "permessage-deflate; server_max_window_bits=10" },
+					rws::permessage_deflate_params_t{}.server_max_window_bits( 9 ) ) );
+		REQUIRE( "permessage-deflate; server_max_window_bits=12" ==
+				negotiate(
+					{ "permessage-deflate" },
+					rws::permessage_deflate_params_t{}.server_max_window_bits( 12 ) ) );
+
+		// zlib can't compress with 256 bytes window.
+		REQUIRE( "<declined>" ==
+				negotiate( { "permessage-deflate; server_max_window_bits=8" } ) );
+		REQUIRE( "permessage-deflate" ==
+				negotiate( { "permessage-deflate; server_max_window_bits=8, "
+						"permessage-deflate" } ) );
+
+		REQUIRE( "<declined>" ==
+				negotiate( { "permessage-deflate; server_max_window_bits" } ) );
+		REQUIRE( "<declined>" ==
+				negotiate( { "permessage-deflate; server_max_window_bits=010" } ) );
+		REQUIRE( "<declined>" ==
+				negotiate( { "permessage-deflate; server_max_window_bits=16" } ) );
+		REQUIRE( "<declined>" ==
+				negotiate( { "permessage-deflate; client_max_window_bits=7" } ) );
+
+		REQUIRE( "permessage-deflate" ==
+				negotiate( { "permessage-deflate; client_max_window_bits=15" } ) );
+		REQUIRE( "permessage-deflate; client_max_window_bits=10" ==
+				negotiate( { "permessage-deflate; client_max_window_bits=10" } ) );
+		REQUIRE( "permessage-deflate; client_max_window_bits=11" ==
+				negotiate(
+					{ "permessage-deflate; client_max_window_bits" },
+					rws::permessage_deflate_params_t{}.client_max_window_bits( 11 ) ) );
+		// A client can't be asked for a smaller window without
+		// client_max_window_bits in its offer.
+		REQUIRE( "permessage-deflate" ==
+				negotiate(
+					{ "permessage-deflate" },
+					rws::permessage_deflate_params_t{}.client_max_window_bits( 11 ) ) );
+	}
+
+	SECTION( "context takeover" )
+	{
+		REQUIRE( "permessage-deflate; server_no_context_takeover" ==
+				negotiate( { "permessage-deflate; server_no_context_takeover" } ) );
+		REQUIRE( "permessage-deflate" ==
+				negotiate( { "permessage-deflate; client_no_context_takeover" } ) );
+		REQUIRE( "permessage-deflate; server_no_context_takeover; "
+				"client_no_context_takeover; server_max_window_bits=12" ==
+				negotiate(
+					{ "permessage-deflate" },
+					rws::permessage_deflate_params_t{}
+						.server_no_context_takeover( true )
+						.client_no_context_takeover( true )
+						.server_max_window_bits( 12 ) ) );
+
+		REQUIRE( "<declined>" ==
+				negotiate( { "permessage-deflate; server_no_context_takeover=1" } ) );
+		REQUIRE( "<declined>" ==
+				negotiate( { "permessage-deflate; client_no_context_takeover=1" } ) );
+	}
+
+	SECTION( "invalid offers" )
+	{
+		REQUIRE( "<declined>" ==
+				negotiate( { "permessage-deflate; unknown_param" } ) );
+		REQUIRE( "<declined>" ==
+				negotiate( { "permessage-deflate; server_no_context_takeover; "
+						"server_no_context_takeover" } ) );
+
+		// Invalid values of the field are ignored.
+		REQUIRE( "<declined>" == negotiate( { "permessage-deflate;;" } ) );
+		REQUIRE( "permessage-deflate; server_max_window_bits=11" ==
+				negotiate( {
+					"permessage-deflate;;",
+					"permessage-deflate; unknown_param",
+					"permessage-deflate; server_max_window_bits=11",
+					"permessage-deflate" } ) );
+	}
+}
+
+TEST_CASE( "permessage-deflate compression" , "[permessage_deflate][compression]" )
+{
+	SECTION( "RFC 7692 examples" )
+	{
+		rws::impl::permessage_deflate_t server{ make_agreement() };
+
+		REQUIRE( rfc_hello == server.compress_frame( "Hello", rws::final_frame ) );
+
+		const auto hello = server.decompress_frame( rfc_hello, rws::final_frame );
+		REQUIRE( hello );
+		REQUIRE( "Hello" == *hello );
+
+		// The same LZ77 window is used for the second message.
+		const auto hello2 = server.decompress_frame(
+				rfc_hello_with_context, rws::final_frame );
+		REQUIRE( hello2 );
+		REQUIRE( "Hello" == *hello2 );
+
+		// A message in fragments.
+		const auto part1 = server.decompress_frame(
+				rfc_hello.substr( 0u, 3u ), rws::not_final_frame );
+		const auto part2 = server.decompress_frame(
+				rfc_hello.substr( 3u ), rws::final_frame );
+		REQUIRE( part1 );
+		REQUIRE( part2 );
+		REQUIRE( "Hello" == *part1 + *part2 );
+
+		// DEFLATE block with BFINAL set.
+		for( const auto & bfinal : {
+				to_char_each( { 0xf3, 0x48, 0xcd, 0xc9, 0xc9, 0x07, 0x00 } ),
+				to_char_each( { 0xf3, 0x48, 0xcd, 0xc9, 0xc9, 0x07, 0x00, 0x00 } ) } )
+		{
+			const auto r = server.decompress_frame( bfinal, rws::final_frame );
+			REQUIRE( r );
+			REQUIRE( "Hello" == *r );
+
+			// A new stream is started for the next message.
+			const auto next = server.decompress_frame( rfc_hello, rws::final_frame );
+			REQUIRE( next );
+			REQUIRE( "Hello" == *next );
+		}
+	}
+
+	SECTION( "roundtrip" )
+	{
+		rws::impl::permessage_deflate_t server{ make_agreement() };
+		rws::impl::permessage_deflate_t client{ make_agreement() };
+
+		std::string message;
+		for( int i = 0; i != 1000; ++i )
+			message += R"({"symbol":"ABC","price":)" + std::to_string( 1000 + i ) + "},";
+
+		for( int round = 0; round != 3; ++round )
+		{
+			// Fragments of different sizes.
+			std::string decompressed;
+			std::size_t compressed_size = 0u;
+			for( std::size_t pos = 0u, part = 1u; pos < message.size(); part *= 3u )
+			{
+				const auto size = std::min( part, message.size() - pos );
+				const auto final_flag = pos + size == message.size() ?
+						rws::final_frame : rws::not_final_frame;
+
+				const auto compressed = server.compress_frame(
+						restinio::string_view_t{ message }.substr( pos, size ),
+						final_flag );
+				compressed_size += compressed.size();
+
+				const auto r = client.decompress_frame( compressed, final_flag );
+				REQUIRE( r );
+				decompressed += *r;
+				pos += size;
+			}
+
+			REQUIRE( message == decompressed );
+			REQUIRE( compressed_size < message.size() / 4u );
+		}
+
+		// Empty message.
+		const auto compressed = server.compress_frame( "", rws::final_frame );
+		const auto r = client.decompress_frame( compressed, rws::final_frame );
+		REQUIRE( r );
+		REQUIRE( r->empty() );
+	}
+
+	SECTION( "context takeover" )
+	{
+		rws::impl::permessage_deflate_t server{ make_agreement() };
+
+		const auto first = server.compress_frame( "Hello", rws::final_frame );
+		const auto second = server.compress_frame( "Hello", rws::final_frame );
+		REQUIRE( rfc_hello == first );
+		REQUIRE( second.size() < first.size() );
+
+		rws::impl::permessage_deflate_t client{ make_agreement() };
+		REQUIRE( "Hello" == *client.decompress_frame( first, rws::final_frame ) );
+		REQUIRE( "Hello" == *client.decompress_frame( second, rws::final_frame ) );
+	}
+
+	SECTION( "no context takeover" )
+	{
+		rws::impl::permessage_deflate_t server{ make_agreement(
+				rws::permessage_deflate_params_t{}
+					.server_no_context_takeover( true )
+					.client_no_context_takeover( true ) ) };
+
+		REQUIRE( rfc_hello == server.compress_frame( "Hello", rws::final_frame ) );
+		REQUIRE( rfc_hello == server.compress_frame( "Hello", rws::final_frame ) );
+
+		REQUIRE( "Hello" == *server.decompress_frame( rfc_hello, rws::final_frame ) );
+		// There is no data from the previous message.
+		REQUIRE_THROWS_AS(
+				server.decompress_frame( rfc_hello_with_context, rws::final_frame ),
+				restinio::exception_t );
+	}
+
+	SECTION( "min compressed size" )
+	{
+		rws::impl::permessage_deflate_t server{ make_agreement(
+				rws::permessage_deflate_params_t{}.min_compressed_size( 64u ) ) };
+
+		REQUIRE_FALSE( server.should_compress( 0u ) );
+		REQUIRE_FALSE( server.should_compress( 63u ) );
+		REQUIRE( server.should_compress( 64u ) );
+	}
+
+	SECTION( "too big message" )
+	{
+		rws::impl::permessage_deflate_t peer{ make_agreement() };
+		rws::impl::permessage_deflate_t server{ make_agreement(
+				rws::permessage_deflate_params_t{}
+					.max_decompressed_message_size( 100u ) ) };
+
+		REQUIRE_FALSE( server.decompress_frame(
+				peer.compress_frame( std::string( 101u, 'a' ), rws::final_frame ),
+				rws::final_frame ) );
+
+		// The limit is for the whole message.
+		rws::impl::permessage_deflate_t peer2{ make_agreement() };
+		const auto part = std::string( 60u, 'b' );
+		const auto r = server.decompress_frame(
+				peer2.compress_frame( part, rws::not_final_frame ),
+				rws::not_final_frame );
+		REQUIRE( r );
+		REQUIRE( part == *r );
+		REQUIRE_FALSE( server.decompress_frame(
+				peer2.compress_frame( part, rws::final_frame ),
+				rws::final_frame ) );
+
+		// The next message is decompressed by a new stream.
+		REQUIRE( "Hello" == *server.decompress_frame( rfc_hello, rws::final_frame ) );
+		rws::impl::permessage_deflate_t peer3{ make_agreement() };
+		const auto max = std::string( 100u, 'c' );
+		REQUIRE( max == *server.decompress_frame(
+				peer3.compress_frame( max, rws::final_frame ),
+				rws::final_frame ) );
+
+		// A small frame with a huge message.
+		rws::impl::permessage_deflate_t peer4{ make_agreement() };
+		const auto huge = peer4.compress_frame(
+				std::string( 16u * 1024u * 1024u, 'd' ), rws::final_frame );
+		REQUIRE( huge.size() < 64u * 1024u );
+		REQUIRE_FALSE( server.decompress_frame( huge, rws::final_frame ) );
+	}
+
+	SECTION( "broken data" )
+	{
+		rws::impl::permessage_deflate_t server{ make_agreement() };
+
+		REQUIRE_THROWS_AS(
+				server.decompress_frame(
+					to_char_each( { 0xff, 0xff, 0xff, 0xff } ), rws::final_frame ),
+				restinio::exception_t );
+	}
+}
+
+TEST_CASE( "validation of compressed frames" , "[permessage_deflate][validators]" )
+{
+	using rws::impl::ws_protocol_validator_t;
+	using rws::impl::validation_state_t;
+	using rws::impl::message_details_t;
+
+	const auto make_frame = []( rws::final_frame_flag_t final_flag,
+		rws::opcode_t opcode, bool rsv1 )
+	{
+		message_details_t frame{ final_flag, opcode, 5u, 0xFFFFFFFF };
+		frame.m_rsv1_flag = rsv1;
+		return frame;
+	};
+
+	SECTION( "RSV1 isn't allowed without the extension" )
+	{
+		ws_protocol_validator_t validator;
+
+		REQUIRE( validation_state_t::non_zero_rsv_flags ==
+				validator.process_new_frame(
+					make_frame( rws::final_frame, rws::opcode_t::text_frame, true ) ) );
+	}
+
+	SECTION( "RSV1 is allowed only in the first frame of data messages" )
+	{
+		const auto check = [&]( const message_details_t & frame ) {
+			ws_protocol_validator_t validator;
+			validator.allow_compressed_messages();
+			return validator.process_new_frame( frame );
+		};
+
+		REQUIRE( validation_state_t::frame_header_is_valid == check(
+				make_frame( rws::final_frame, rws::opcode_t::text_frame, true ) ) );
+		REQUIRE( validation_state_t::frame_header_is_valid == check(
+				make_frame( rws::final_frame, rws::opcode_t::binary_frame, true ) ) );
+		REQUIRE( validation_state_t::non_zero_rsv_flags == check(
+				make_frame( rws::final_frame, rws::opcode_t::ping_frame, true ) ) );
+		REQUIRE( validation_state_t::non_zero_rsv_flags == check(
+				make_frame( rws::final_frame,
+					rws::opcode_t::connection_close_frame, true ) ) );
+		REQUIRE( validation_state_t::non_zero_rsv_flags == check(
+				make_frame( rws::final_frame,
+					rws::opcode_t::continuation_frame, true ) ) );
+	}
+
+	SECTION( "fragmented compressed message" )
+	{
+		ws_protocol_validator_t validator{ false };
+		validator.allow_compressed_messages();
+
+		const auto invalid_utf8 = to_char_each( { 0xff, 0xfe } );
+
+		REQUIRE( validation_state_t::frame_header_is_valid ==
+				validator.process_new_frame(
+					make_frame( rws::not_final_frame, rws::opcode_t::text_frame, true ) ) );
+		REQUIRE( validator.is_current_frame_compressed() );
+		// Compressed data isn't checked.
+		REQUIRE( validation_state_t::payload_part_is_valid ==
+				validator.process_next_payload_part(
+					invalid_utf8.data(), invalid_utf8.size() ) );
+		REQUIRE( validation_state_t::payload_part_is_valid ==
+				validator.process_decompressed_payload_part( "Hel", 3u ) );
+		REQUIRE( validation_state_t::frame_is_valid == validator.finish_frame() );
+
+		// A control frame in the middle.
+		REQUIRE( validation_state_t::frame_header_is_valid ==
+				validator.process_new_frame(
+					make_frame( rws::final_frame, rws::opcode_t::ping_frame, false ) ) );
+		REQUIRE_FALSE( validator.is_current_frame_compressed() );
+		REQUIRE( validation_state_t::frame_is_valid == validator.finish_frame() );
+
+		REQUIRE( validation_state_t::frame_header_is_valid ==
+				validator.process_new_frame(
+					make_frame( rws::final_frame,
+						rws::opcode_t::continuation_frame, false ) ) );
+		REQUIRE( validator.is_current_frame_compressed() );
+		REQUIRE( validation_state_t::payload_part_is_valid ==
+				validator.process_decompressed_payload_part( "lo", 2u ) );
+		REQUIRE( validation_state_t::frame_is_valid == validator.finish_frame() );
+
+		// The next message isn't compressed.
+		REQUIRE( validation_state_t::frame_header_is_valid ==
+				validator.process_new_frame(
+					make_frame( rws::final_frame, rws::opcode_t::text_frame, false ) ) );
+		REQUIRE_FALSE( validator.is_current_frame_compressed() );
+		REQUIRE( validation_state_t::incorrect_utf8_data ==
+				validator.process_next_payload_part(
+					invalid_utf8.data(), invalid_utf8.size() ) );
+	}
+
+	SECTION( "decompressed data is checked" )
+	{
+		ws_protocol_validator_t validator{ false };
+		validator.allow_compressed_messages();
+
+		const auto invalid_utf8 = to_char_each( { 0xff, 0xfe } );
+
+		REQUIRE( validation_state_t::frame_header_is_valid ==
+				validator.process_new_frame(
+					make_frame( rws::final_frame, rws::opcode_t::text_frame, true ) ) );
+		REQUIRE( validation_state_t::incorrect_utf8_data ==
+				validator.process_decompressed_payload_part(
+					invalid_utf8.data(), invalid_utf8.size() ) );
+		REQUIRE( validation_state_t::incorrect_utf8_data == validator.finish_frame() );
+	}
+
+	SECTION( "incomplete UTF-8 sequence at the end of a message" )
+	{
+		ws_protocol_validator_t validator{ false };
+		validator.allow_compressed_messages();
+
+		const auto incomplete = to_char_each( { 0xc3 } );
+
+		REQUIRE( validation_state_t::frame_header_is_valid ==
+				validator.process_new_frame(
+					make_frame( rws::final_frame, rws::opcode_t::text_frame, true ) ) );
+		REQUIRE( validation_state_t::payload_part_is_valid ==
+				validator.process_decompressed_payload_part(
+					incomplete.data(), incomplete.size() ) );
+		REQUIRE( validation_state_t::incorrect_utf8_data == validator.finish_frame() );
+	}
+}
+
+using traits_t =
+	restinio::traits_t<
+		restinio::asio_timer_manager_t,
+		utest_logger_t >;
+
+using http_server_t = restinio::http_server_t< traits_t >;
+
+std::string
+make_upgrade_request( const std::string & extensions )
+{
+	return
+		"GET /chat HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"Upgrade: websocket\r\n"
+		"Connection: Upgrade\r\n"
+		"Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+		"Sec-WebSocket-Version: 13\r\n" +
+		( extensions.empty() ? std::string{} :
+			"Sec-WebSocket-Extensions: " + extensions + "\r\n" ) +
+		"\r\n";
+}
+
+//! Make a masked frame from a client.
+std::string
+make_client_frame( std::uint8_t first_byte, const std::string & payload )
+{
+	REQUIRE( payload.size() < 126u );
+
+	const std::uint8_t mask[ 4 ] = { 0xAA, 0xBB, 0xCC, 0xDD };
+
+	std::string frame;
+	frame += static_cast< char >( first_byte );
+	frame += static_cast< char >( 0x80u | payload.size() );
+	for( auto m : mask )
+		frame += static_cast< char >( m );
+	for( std::size_t i = 0u; i != payload.size(); ++i )
+		frame += static_cast< char >(
+				static_cast< std::uint8_t >( payload[ i ] ) ^ mask[ i % 4u ] );
+
+	return frame;
+}
+
+//! Read a small frame from a server.
+std::pair< std::uint8_t, std::string >
+read_server_frame( restinio::asio_ns::ip::tcp::socket & socket )
+{
+	std::array< std::uint8_t, 2 > header;
+	restinio::asio_ns::read( socket, restinio::asio_ns::buffer( header ) );
+	REQUIRE( header[ 1 ] < 126u );
+
+	std::string payload( header[ 1 ], '\0' );
+	restinio::asio_ns::read( socket,
+			restinio::asio_ns::buffer( &payload[ 0 ], payload.size() ) );
+
+	return { header[ 0 ], std::move( payload ) };
+}
+
+TEST_CASE( "echo server with permessage-deflate" , "[permessage_deflate][echo]" )
+{
+	rws::ws_handle_t ws;
+
+	http_server_t http_server{
+		restinio::own_io_context(),
+		[&ws]( auto & settings ){
+			settings
+				.port( utest_default_port() )
+				.address( "127.0.0.1" )
+				.request_handler(
+					[&ws]( auto req ){
+						if( restinio::http_connection_header_t::upgrade ==
+							req->header().connection() )
+						{
+							ws = rws::upgrade< traits_t >(
+								*req,
+								rws::activation_t::immediate,
+								rws::permessage_deflate_params_t{},
+								[]( rws::ws_handle_t wsh, rws::message_handle_t m ){
+									if( rws::opcode_t::text_frame == m->opcode() ||
+										rws::opcode_t::binary_frame == m->opcode() ||
+										rws::opcode_t::continuation_frame == m->opcode() )
+									{
+										wsh->send_message( *m );
+									}
+								} );
+
+							return restinio::request_accepted();
+						}
+
+						return restinio::request_rejected();
+					} );
+		} };
+
+	other_work_thread_for_server_t<http_server_t> other_thread(http_server);
+	other_thread.run();
+
+	SECTION( "compressed messages" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ){
+			const auto request = make_upgrade_request(
+					"permessage-deflate; client_max_window_bits" );
+			restinio::asio_ns::write( socket, restinio::asio_ns::buffer( request ) );
+
+			restinio::asio_ns::streambuf b;
+			restinio::asio_ns::read_until( socket, b, "\r\n\r\n" );
+			std::string response{
+					restinio::asio_ns::buffers_begin( b.data() ),
+					restinio::asio_ns::buffers_end( b.data() ) };
+			REQUIRE( std::string::npos != response.find( "101 Switching Protocols" ) );
+			REQUIRE( std::string::npos != response.find(
+					"Sec-WebSocket-Extensions: permessage-deflate\r\n" ) );
+
+			rws::impl::permessage_deflate_t client{ make_agreement() };
+
+			// Compressed message.
+			restinio::asio_ns::write( socket, restinio::asio_ns::buffer(
+					make_client_frame( 0xC1, rfc_hello ) ) );
+			{
+				const auto reply = read_server_frame( socket );
+				REQUIRE( 0xC1 == reply.first );
+				REQUIRE( rfc_hello == reply.second );
+				REQUIRE( "Hello" == *client.decompress_frame(
+						reply.second, rws::final_frame ) );
+			}
+
+			// Uncompressed message, but the reply is compressed.
+			restinio::asio_ns::write( socket, restinio::asio_ns::buffer(
+					make_client_frame( 0x81, "Hello" ) ) );
+			{
+				const auto reply = read_server_frame( socket );
+				REQUIRE( 0xC1 == reply.first );
+				REQUIRE( "Hello" == *client.decompress_frame(
+						reply.second, rws::final_frame ) );
+			}
+
+			// Compressed message in fragments with the context of
+			// the previous message.
+			restinio::asio_ns::write( socket, restinio::asio_ns::buffer(
+					make_client_frame( 0x41, rfc_hello_with_context.substr( 0u, 2u ) ) +
+					make_client_frame( 0x89, "ping" ) +
+					make_client_frame( 0x80, rfc_hello_with_context.substr( 2u ) ) ) );
+			{
+				auto reply = read_server_frame( socket );
+				// The first frame of the reply is compressed.
+				REQUIRE( 0x41 == reply.first );
+				auto text = *client.decompress_frame(
+						reply.second, rws::not_final_frame );
+
+				reply = read_server_frame( socket );
+				REQUIRE( 0x80 == reply.first );
+				text += *client.decompress_frame(
+						reply.second, rws::final_frame );
+
+				REQUIRE( "Hello" == text );
+			}
+		} );
+	}
+
+	SECTION( "broken compressed message" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ){
+			const auto request = make_upgrade_request( "permessage-deflate" );
+			restinio::asio_ns::write( socket, restinio::asio_ns::buffer( request ) );
+
+			restinio::asio_ns::streambuf b;
+			restinio::asio_ns::read_until( socket, b, "\r\n\r\n" );
+
+			restinio::asio_ns::write( socket, restinio::asio_ns::buffer(
+					make_client_frame( 0xC1,
+						to_char_each( { 0xff, 0xff, 0xff, 0xff } ) ) ) );
+
+			const auto reply = read_server_frame( socket );
+			REQUIRE( 0x88 == reply.first );
+			REQUIRE( rws::status_code_t::invalid_message_data ==
+					rws::status_code_from_bin( reply.second ) );
+		} );
+	}
+
+	SECTION( "without extension" )
+	{
+		do_with_socket( [&]( auto & socket, auto & /*io_context*/ ){
+			const auto request = make_upgrade_request( "" );
+			restinio::asio_ns::write( socket, restinio::asio_ns::buffer( request ) );
+
+			restinio::asio_ns::streambuf b;
+			restinio::asio_ns::read_until( socket, b, "\r\n\r\n" );
+			std::string response{
+					restinio::asio_ns::buffers_begin( b.data() ),
+					restinio::asio_ns::buffers_end( b.data() ) };
+			REQUIRE( std::string::npos == response.find( "Sec-WebSocket-Extensions" ) );
+
+			restinio::asio_ns::write( socket, restinio::asio_ns::buffer(
+					make_client_frame( 0x81, "Hello" ) ) );
+			const auto reply = read_server_frame( socket );
+			REQUIRE( 0x81 == reply.first );
+			REQUIRE( "Hello" == reply.second );
+
+			// RSV1 is a protocol error without the extension.
+			restinio::asio_ns::write( socket, restinio::asio_ns::buffer(
+					make_client_frame( 0xC1, rfc_hello ) ) );
+			const auto close = read_server_frame( socket );
+			REQUIRE( 0x88 == close.first );
+		} );
+	}
+
+	restinio::asio_ns::post( http_server.io_context(), [&ws]{ ws.reset(); } );
+	other_thread.stop_and_join();
+}
@@ -183,6 +183,30 @@ TEST_CASE(
 		REQUIRE( unmasker.m_mask[2] == 0x21 );
 		REQUIRE( unmasker.m_mask[3] == 0x3D );
 	}
+	{
+		std::string payload( 1000u, '\0' );
+		for( std::size_t i = 0u; i != payload.size(); ++i )
+			payload[ i ] = static_cast< char >( i );
+
+		unmasker_t byte_unmasker{ 0x37FA213D };
+		std::string expected;
+		for( auto byte : payload )
+			expected.push_back(
+				static_cast<char>( byte_unmasker.unmask_byte(
+					static_cast<std::uint8_t>(byte) ) ) );
+
+		// Parts of different sizes.
+		unmasker_t unmasker{ 0x37FA213D };
+		std::size_t pos = 0u;
+		for( std::size_t part = 1u; pos != payload.size(); ++part )
+		{
+			const auto size = std::min( part, payload.size() - pos );
+			unmasker.unmask_bytes( &payload[ pos ], size );
+			pos += size;
+		}
+
+		REQUIRE( expected == payload );
+	}
 }
 
 TEST_CASE(
@@ -803,4 +827,63 @@ TEST_CASE(
 
 		REQUIRE( payload == "Hello" );
 	}
+	SECTION(
+		"Check utf-8 sequences split between parts and fragments" )
+	{
+		ws_protocol_validator_t validator;
+
+		// A 4-byte char is split between fragments and parts of them.
+		const std::string first_fragment = std::string( 100u, 'a' ) + "\xF0\x9F";
+		const std::string second_fragment = "\x98\x80" + std::string( 100u, 'b' );
+
+		message_details_t first_frame{
+			not_final_frame, opcode_t::text_frame,
+			first_fragment.size(), 0xFFFFFFFF };
+		message_details_t second_frame{
+			final_frame, opcode_t::continuation_frame,
+			second_fragment.size(), 0xFFFFFFFF };
+
+		REQUIRE( validator.process_new_frame( first_frame ) ==
+			validation_state_t::frame_header_is_valid );
+		std::string part = first_fragment.substr( 0u, 101u );
+		REQUIRE( validator.process_and_unmask_next_payload_part(
+			&part[0], part.size() ) ==
+			validation_state_t::payload_part_is_valid );
+		part = first_fragment.substr( 101u );
+		REQUIRE( validator.process_and_unmask_next_payload_part(
+			&part[0], part.size() ) ==
+			validation_state_t::payload_part_is_valid );
+		REQUIRE( validator.finish_frame() ==
+			validation_state_t::frame_is_valid );
+
+		REQUIRE( validator.process_new_frame( second_frame ) ==
+			validation_state_t::frame_header_is_valid );
+		part = second_fragment.substr( 0u, 1u );
+		REQUIRE( validator.process_and_unmask_next_payload_part(
+			&part[0], part.size() ) ==
+			validation_state_t::payload_part_is_valid );
+		part = second_fragment.substr( 1u );
+		REQUIRE( validator.process_and_unmask_next_payload_part(
+			&part[0], part.size() ) ==
+			validation_state_t::payload_part_is_valid );
+		REQUIRE( validator.finish_frame() ==
+			validation_state_t::frame_is_valid );
+	}
+	SECTION(
+		"Check surrogate in the middle of long text frame" )
+	{
+		ws_protocol_validator_t validator;
+
+		std::string payload = std::string( 70u, 'a' ) + "\xED\xA0\x80" +
+			std::string( 70u, 'b' );
+
+		message_details_t frame{
+			final_frame, opcode_t::text_frame, payload.size(), 0xFFFFFFFF };
+
+		REQUIRE( validator.process_new_frame( frame ) ==
+			validation_state_t::frame_header_is_valid );
+		REQUIRE( validator.process_and_unmask_next_payload_part(
+			&payload[0], payload.size() ) ==
+			validation_state_t::incorrect_utf8_data );
+	}
 }
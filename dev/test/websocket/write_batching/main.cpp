@@ -0,0 +1,269 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for writing of several websocket frames by one write operation.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+#include <restinio/websocket/websocket.hpp>
+
+#include <test/common/utest_logger.hpp>
+#include <test/common/pub.hpp>
+
+using namespace std::literals::string_literals;
+
+namespace rws = restinio::websocket::basic;
+
+using traits_t =
+	restinio::traits_t<
+		restinio::asio_timer_manager_t,
+		utest_logger_t >;
+
+using http_server_t = restinio::http_server_t< traits_t >;
+
+//! Connect to the server and read the upgrade response.
+void
+connect_and_upgrade( restinio::asio_ns::ip::tcp::socket & socket )
+{
+	socket.connect( restinio::asio_ns::ip::tcp::endpoint{
+			restinio::asio_ns::ip::make_address_v4( "127.0.0.1" ),
+			utest_default_port() } );
+
+	const std::string request{
+		"GET /chat HTTP/1.1\r\n"
+		"Host: 127.0.0.1\r\n"
+		"Upgrade: websocket\r\n"
+		"Connection: Upgrade\r\n"
+		"Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+		"Sec-WebSocket-Version: 13\r\n"
+		"\r\n" };
+	restinio::asio_ns::write( socket, restinio::asio_ns::buffer( request ) );
+
+	restinio::asio_ns::streambuf b;
+	restinio::asio_ns::read_until( socket, b, "\r\n\r\n" );
+	const std::string response{
+			restinio::asio_ns::buffers_begin( b.data() ),
+			restinio::asio_ns::buffers_end( b.data() ) };
+	REQUIRE( std::string::npos != response.find( "101 Switching Protocols" ) );
+}
+
+//! Read a small frame from a server.
+std::pair< std::uint8_t, std::string >
+read_server_frame( restinio::asio_ns::ip::tcp::socket & socket )
+{
+	std::array< std::uint8_t, 2 > header;
+	restinio::asio_ns::read( socket, restinio::asio_ns::buffer( header ) );
+	REQUIRE( header[ 1 ] < 126u );
+
+	std::string payload( header[ 1 ], '\0' );
+	restinio::asio_ns::read( socket,
+			restinio::asio_ns::buffer( &payload[ 0 ], payload.size() ) );
+
+	return { header[ 0 ], std::move( payload ) };
+}
+
+//! A server with one websocket.
+class ws_server_t
+{
+	public:
+		ws_server_t( std::chrono::microseconds write_delay )
+			:	m_server{
+					restinio::own_io_context(),
+					[this, write_delay]( auto & settings ){
+						settings
+							.port( utest_default_port() )
+							.address( "127.0.0.1" )
+							.websocket_write_coalescing_delay( write_delay )
+							.request_handler(
+								[this]( auto req ){
+									return this->on_request( std::move( req ) );
+								} );
+					} }
+			,	m_other_thread{ m_server }
+		{
+			m_other_thread.run();
+		}
+
+		~ws_server_t()
+		{
+			run_on_server( [this]{ m_ws.reset(); } );
+			m_other_thread.stop_and_join();
+		}
+
+		//! Wait for upgrade of the websocket.
+		void
+		wait_for_websocket()
+		{
+			for( bool upgraded = false; !upgraded; )
+			{
+				std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+				run_on_server( [&]{ upgraded = static_cast< bool >( m_ws ); } );
+			}
+		}
+
+		//! Run a function on the server thread and wait for its completion.
+		template< typename Lambda >
+		void
+		run_on_server( Lambda && lambda )
+		{
+			std::promise< void > p;
+			restinio::asio_ns::post(
+				m_server.io_context(),
+				[&]{
+					lambda();
+					p.set_value();
+				} );
+			p.get_future().get();
+		}
+
+		rws::ws_t &
+		ws() noexcept { return *m_ws; }
+
+	private:
+		restinio::request_handling_status_t
+		on_request( restinio::request_handle_t req )
+		{
+			if( restinio::http_connection_header_t::upgrade !=
+				req->header().connection() )
+				return restinio::request_rejected();
+
+			m_ws = rws::upgrade< traits_t >(
+				*req,
+				rws::activation_t::immediate,
+				[]( rws::ws_handle_t, rws::message_handle_t ){} );
+
+			return restinio::request_accepted();
+		}
+
+		http_server_t m_server;
+		other_work_thread_for_server_t< http_server_t > m_other_thread;
+
+		//! Is accessed only on the server thread.
+		rws::ws_handle_t m_ws;
+};
+
+//! Send messages and collect results of their writing.
+class sender_t
+{
+	public:
+		void
+		send( rws::ws_t & ws, std::size_t count )
+		{
+			for( std::size_t i = 0u; i != count; ++i )
+				ws.send_message(
+					rws::final_frame,
+					rws::opcode_t::text_frame,
+					restinio::writable_item_t{ std::to_string( i ) },
+					[this, i]( const restinio::asio_ns::error_code & ec ){
+						std::lock_guard< std::mutex > lock{ m_lock };
+						m_results.emplace_back( i, !ec );
+					} );
+		}
+
+		//! Wait for the specified number of notifications (at most 1s).
+		std::vector< std::pair< std::size_t, bool > >
+		wait_for_results( std::size_t count )
+		{
+			for( int attempt = 0; attempt != 1000; ++attempt )
+			{
+				{
+					std::lock_guard< std::mutex > lock{ m_lock };
+					if( count == m_results.size() )
+						break;
+				}
+				std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+			}
+
+			std::lock_guard< std::mutex > lock{ m_lock };
+			return m_results;
+		}
+
+	private:
+		std::mutex m_lock;
+		std::vector< std::pair< std::size_t, bool > > m_results;
+};
+
+void
+check_messages(
+	restinio::asio_ns::ip::tcp::socket & socket,
+	sender_t & sender,
+	std::size_t count )
+{
+	for( std::size_t i = 0u; i != count; ++i )
+	{
+		const auto frame = read_server_frame( socket );
+		REQUIRE( 0x81 == frame.first );
+		REQUIRE( std::to_string( i ) == frame.second );
+	}
+
+	// Every frame has its own notification.
+	const auto results = sender.wait_for_results( count );
+	REQUIRE( count == results.size() );
+	for( std::size_t i = 0u; i != count; ++i )
+	{
+		REQUIRE( i == results[ i ].first );
+		REQUIRE( results[ i ].second );
+	}
+}
+
+TEST_CASE( "write batching" , "[write_batching]" )
+{
+	ws_server_t server{ std::chrono::microseconds::zero() };
+
+	restinio::asio_ns::io_context io_context;
+	restinio::asio_ns::ip::tcp::socket socket{ io_context };
+
+	connect_and_upgrade( socket );
+	server.wait_for_websocket();
+
+	sender_t sender;
+
+	// More frames than can be written by a single write operation.
+	constexpr std::size_t count = 1000u;
+	server.run_on_server( [&]{ sender.send( server.ws(), count ); } );
+
+	check_messages( socket, sender, count );
+}
+
+TEST_CASE( "write delay" , "[write_batching]" )
+{
+	constexpr std::chrono::milliseconds delay{ 100 };
+	ws_server_t server{ delay };
+
+	restinio::asio_ns::io_context io_context;
+	restinio::asio_ns::ip::tcp::socket socket{ io_context };
+
+	connect_and_upgrade( socket );
+	server.wait_for_websocket();
+
+	sender_t sender;
+	constexpr std::size_t count = 10u;
+
+	const auto started_at = std::chrono::steady_clock::now();
+	server.run_on_server( [&]{ sender.send( server.ws(), count ); } );
+
+	const auto first_frame = read_server_frame( socket );
+	REQUIRE( std::chrono::steady_clock::now() - started_at >= delay );
+	REQUIRE( "0" == first_frame.second );
+
+	// Every other frame has been written with the first one.
+	for( std::size_t i = 1u; i != count; ++i )
+	{
+		REQUIRE( 0u != socket.available() );
+		REQUIRE( std::to_string( i ) == read_server_frame( socket ).second );
+	}
+
+	REQUIRE( count == sender.wait_for_results( count ).size() );
+
+	// A close frame isn't delayed.
+	const auto close_started_at = std::chrono::steady_clock::now();
+	server.run_on_server( [&]{ server.ws().shutdown(); } );
+
+	const auto close_frame = read_server_frame( socket );
+	REQUIRE( std::chrono::steady_clock::now() - close_started_at < delay );
+	REQUIRE( 0x88 == close_frame.first );
+}
@@ -0,0 +1,103 @@
+/*
+	restinio
+*/
+
+/*!
+	Tests for timing wheel timer manager.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <restinio/all.hpp>
+
+using namespace std::chrono_literals;
+
+class fake_ctx_t final : public restinio::tcp_connection_ctx_base_t
+{
+	public:
+		fake_ctx_t( restinio::connection_id_t id )
+			:	restinio::tcp_connection_ctx_base_t{ id }
+		{}
+
+		void
+		check_timeout( restinio::tcp_connection_ctx_handle_t & ) override
+		{
+			++m_checks;
+		}
+
+		std::size_t m_checks{ 0u };
+};
+
+TEST_CASE( "schedule and fire" , "[wheel_timer_manager]" )
+{
+	restinio::asio_ns::io_context io_context;
+
+	auto manager = restinio::single_thread_wheel_timer_manager_t::factory_t{
+			20ms, 2u }.create( io_context );
+
+	auto c1 = std::make_shared< fake_ctx_t >( 1u );
+	auto c2 = std::make_shared< fake_ctx_t >( 2u );
+	auto c3 = std::make_shared< fake_ctx_t >( 3u );
+
+	auto g1 = manager->create_timer_guard();
+	auto g2 = manager->create_timer_guard();
+	auto g3 = manager->create_timer_guard();
+
+	g1.schedule( c1 );
+	g2.schedule( c2 );
+	g3.schedule( c3 );
+	// Rescheduling shouldn't lead to a double invocation.
+	g1.schedule( c1 );
+	g2.cancel();
+
+	manager->start();
+
+	restinio::asio_ns::steady_timer stopper{ io_context };
+	stopper.expires_after( 100ms );
+	stopper.async_wait( [&]( const auto & ) { manager->stop(); } );
+
+	io_context.run();
+
+	REQUIRE( 1u == c1->m_checks );
+	REQUIRE( 0u == c2->m_checks );
+	REQUIRE( 1u == c3->m_checks );
+}
+
+TEST_CASE( "destroyed guard" , "[wheel_timer_manager]" )
+{
+	restinio::asio_ns::io_context io_context;
+
+	auto manager = restinio::wheel_timer_manager_t::factory_t{
+			20ms }.create( io_context );
+
+	auto c1 = std::make_shared< fake_ctx_t >( 1u );
+	auto c2 = std::make_shared< fake_ctx_t >( 2u );
+
+	auto g2 = manager->create_timer_guard();
+	{
+		auto g1 = manager->create_timer_guard();
+		g1.schedule( c1 );
+		g2.schedule( c2 );
+	}
+
+	manager->start();
+
+	restinio::asio_ns::steady_timer stopper{ io_context };
+	stopper.expires_after( 100ms );
+	stopper.async_wait( [&]( const auto & ) { manager->stop(); } );
+
+	io_context.run();
+
+	REQUIRE( 0u == c1->m_checks );
+	REQUIRE( 1u == c2->m_checks );
+}
+
+TEST_CASE( "invalid params" , "[wheel_timer_manager]" )
+{
+	restinio::asio_ns::io_context io_context;
+
+	REQUIRE_THROWS( restinio::wheel_timer_manager_t::factory_t{
+			20ms, 0u }.create( io_context ) );
+	REQUIRE_THROWS( restinio::wheel_timer_manager_t::factory_t{
+			std::chrono::steady_clock::duration{ 3 }, 4u }.create( io_context ) );
+}
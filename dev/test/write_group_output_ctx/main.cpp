@@ -524,3 +524,172 @@ TEST_CASE( "write_group_output_ctx_t two groups" , "[write_group_output_ctx_t][t
 		REQUIRE_FALSE( wg_output.transmitting() );
 	}
 }
+
+TEST_CASE( "write_group_output_ctx_t coalesced groups" , "[write_group_output_ctx_t][trivial][coalesce]" )
+{
+	std::vector< std::string > notifications;
+	const auto make_group = [&]( std::vector< std::string > bufs, std::string tag ) {
+		write_group_t wg{ make_buffers( std::move( bufs ) ) };
+		wg.after_write_notificator(
+			[&notifications, tag]( const asio_ns::error_code & ec ) {
+				notifications.push_back( tag + (ec ? ":error" : ":ok") );
+			} );
+		return wg;
+	};
+
+	{
+		write_group_output_ctx_t wg_output{};
+
+		wg_output.start_next_write_group( make_group( { "A1", "A2" }, "A" ) );
+
+		auto b = make_group( { "B1" }, "B" );
+		REQUIRE( wg_output.can_coalesce( b ) );
+		wg_output.append_write_group( std::move( b ) );
+
+		// Empty group is just a notificator.
+		auto c = make_group( {}, "C" );
+		REQUIRE( wg_output.can_coalesce( c ) );
+		wg_output.append_write_group( std::move( c ) );
+
+		auto d = make_group( { "D1", "D2", "D3" }, "D" );
+		REQUIRE( wg_output.can_coalesce( d ) );
+		wg_output.append_write_group( std::move( d ) );
+
+		write_group_t sf{
+			make_buffers( restinio::sendfile(
+				restinio::null_file_descriptor() /* fake not real */,
+				restinio::file_meta_t{ 1024, std::chrono::system_clock::now() } ) ) };
+		REQUIRE_FALSE( wg_output.can_coalesce( sf ) );
+
+		REQUIRE( 4u == wg_output.write_groups_count() );
+
+		write_group_output_ctx_t::solid_write_operation_variant_t wo{};
+
+		REQUIRE_NOTHROW( wo = wg_output.extract_next_write_operation() );
+		REQUIRE( holds_alternative< trivial_write_operation_t >( wo ) );
+		REQUIRE( 6u == get< trivial_write_operation_t >( wo ).get_trivial_bufs().size() );
+		REQUIRE(
+			concat_bufs(
+				get< trivial_write_operation_t >( wo )
+					.get_trivial_bufs() ) == "A1A2B1D1D2D3" );
+
+		REQUIRE_NOTHROW( wo = wg_output.extract_next_write_operation() );
+		REQUIRE( holds_alternative< none_write_operation_t >( wo ) );
+
+		REQUIRE( notifications.empty() );
+
+		REQUIRE_NOTHROW( wg_output.finish_write_group() );
+		REQUIRE_FALSE( wg_output.transmitting() );
+
+		REQUIRE( notifications ==
+				std::vector< std::string >{ "A:ok", "B:ok", "C:ok", "D:ok" } );
+	}
+
+	notifications.clear();
+
+	{
+		write_group_output_ctx_t wg_output{};
+
+		wg_output.start_next_write_group( make_group( { "A1" }, "A" ) );
+		wg_output.append_write_group( make_group( { "B1" }, "B" ) );
+
+		REQUIRE_NOTHROW( wg_output.extract_next_write_operation() );
+		REQUIRE_NOTHROW( wg_output.fail_write_group(
+				asio_ns::error::make_error_code( asio_ns::error::broken_pipe ) ) );
+		REQUIRE_FALSE( wg_output.transmitting() );
+
+		REQUIRE( notifications ==
+				std::vector< std::string >{ "A:error", "B:error" } );
+	}
+
+	{
+		// Limit for the count of buffers.
+		write_group_output_ctx_t wg_output{};
+
+		wg_output.start_next_write_group(
+			write_group_t{ make_buffers(
+				std::vector< std::string >( 60u, std::string{ "x" } ) ) } );
+
+		REQUIRE( wg_output.can_coalesce(
+				write_group_t{ make_buffers( { "1", "2", "3", "4" } ) } ) );
+		REQUIRE_FALSE( wg_output.can_coalesce(
+				write_group_t{ make_buffers( { "1", "2", "3", "4", "5" } ) } ) );
+	}
+
+	{
+		// Limit for the count of groups (space for them is allocated
+		// on demand).
+		write_group_output_ctx_t wg_output{};
+
+		wg_output.start_next_write_group(
+			write_group_t{ make_buffers( { "A" } ) } );
+
+		std::size_t groups = 1u;
+		while( wg_output.can_coalesce( write_group_t{ make_buffers( {} ) } ) )
+		{
+			wg_output.append_write_group( write_group_t{ make_buffers( {} ) } );
+			++groups;
+		}
+
+		REQUIRE( groups == wg_output.write_groups_count() );
+		REQUIRE( 1u < groups );
+		REQUIRE( groups <= 64u );
+	}
+
+	{
+		// Limit for the size of appended data.
+		write_group_output_ctx_t wg_output{};
+
+		wg_output.start_next_write_group(
+			write_group_t{ make_buffers( { "A" } ) } );
+
+		wg_output.append_write_group(
+			write_group_t{ make_buffers( { std::string( 60u * 1024u, 'x' ) } ) } );
+
+		REQUIRE( wg_output.can_coalesce(
+				write_group_t{ make_buffers( { std::string( 1024u, 'x' ) } ) } ) );
+		REQUIRE_FALSE( wg_output.can_coalesce(
+				write_group_t{ make_buffers( { std::string( 8u * 1024u, 'x' ) } ) } ) );
+	}
+
+	{
+		// Custom limit for the size of appended data.
+		write_group_output_ctx_t wg_output{ 16u };
+		REQUIRE( 16u == wg_output.max_coalesced_bytes() );
+
+		wg_output.start_next_write_group(
+			write_group_t{ make_buffers( { std::string( 100u, 'x' ) } ) } );
+
+		auto small = make_group( { "0123456789" }, "small" );
+		REQUIRE( wg_output.can_coalesce( small ) );
+		wg_output.append_write_group( std::move( small ) );
+
+		auto big = make_group( { "0123456789" }, "big" );
+		REQUIRE_FALSE( wg_output.can_coalesce( big ) );
+		REQUIRE( 2u == wg_output.write_groups_count() );
+
+		write_group_output_ctx_t::solid_write_operation_variant_t wo{};
+		REQUIRE_NOTHROW( wo = wg_output.extract_next_write_operation() );
+		REQUIRE( 2u == get< trivial_write_operation_t >( wo ).get_trivial_bufs().size() );
+	}
+
+	{
+		// Zero limit allows to append only groups without data.
+		write_group_output_ctx_t wg_output{ 0u };
+
+		wg_output.start_next_write_group(
+			write_group_t{ make_buffers( { "A" } ) } );
+
+		REQUIRE( wg_output.can_coalesce( write_group_t{ make_buffers( {} ) } ) );
+		REQUIRE_FALSE( wg_output.can_coalesce(
+				write_group_t{ make_buffers( { "B" } ) } ) );
+	}
+
+	{
+		// Nothing can be coalesced if there is no current group.
+		write_group_output_ctx_t wg_output{};
+
+		REQUIRE_FALSE( wg_output.can_coalesce(
+				write_group_t{ make_buffers( { "A" } ) } ) );
+	}
+}